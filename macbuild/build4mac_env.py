@@ -213,6 +213,7 @@ PythonDictionary= { 'nil'             : None,
 KLayoutExecs  = ['klayout']
 KLayoutExecs += ['strm2cif', 'strm2dxf', 'strm2gds', 'strm2gdstxt', 'strm2oas']
 KLayoutExecs += ['strm2txt', 'strmclip', 'strmcmp',  'strmrun',     'strmxor']
+KLayoutExecs += ['tpworker']
 
 #----------------
 # End of File
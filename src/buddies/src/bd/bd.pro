@@ -21,6 +21,7 @@ SOURCES = \
   strmcmp.cc \
   strmxor.cc \
   strmrun.cc \
+  tpworker.cc \
 
 HEADERS = \
   bdCommon.h \
@@ -55,6 +55,8 @@ BD_PUBLIC int strmcmp (int argc, char *argv[])
   double tolerance = 0.0;
   int max_count = 0;
   bool print_properties = false;
+  int threads = 1;
+  bool parallel_read = false;
 
   tl::CommandLineOptions cmd;
   generic_reader_options_a.add_options (cmd);
@@ -126,6 +128,14 @@ BD_PUBLIC int strmcmp (int argc, char *argv[])
                   "If the value is >1, max-count-1 differences plus one warning about abbreviation is printed. "
                   "A value of 0 means \"no limitation\". To suppress all output, use --silent."
                  )
+      << tl::arg ("--parallel-read",           &parallel_read, "Reads both input files concurrently",
+                  "With this option, the two input files are read in parallel on two threads. This reduces the "
+                  "loading time for large files if enough memory is available to hold both layouts."
+                 )
+      << tl::arg ("-n|--threads=threads",      &threads,    "Specifies the number of threads to use",
+                  "If given, multiple threads are used for comparing the cells. In this mode, cells with "
+                  "identical content are detected by a content hash and not compared in detail."
+                 )
     ;
 
   cmd.brief ("This program will compare two layout files on a per-object basis");
@@ -140,21 +150,14 @@ BD_PUBLIC int strmcmp (int argc, char *argv[])
   db::Layout layout_b;
 
   {
-    db::LoadLayoutOptions load_options;
-    generic_reader_options_a.configure (load_options);
-
-    tl::InputStream stream (infile_a);
-    db::Reader reader (stream);
-    reader.read (layout_a, load_options);
-  }
-
-  {
-    db::LoadLayoutOptions load_options;
-    generic_reader_options_b.configure (load_options);
+    db::LoadLayoutOptions load_options_a, load_options_b;
+    generic_reader_options_a.configure (load_options_a);
+    generic_reader_options_b.configure (load_options_b);
 
-    tl::InputStream stream (infile_b);
-    db::Reader reader (stream);
-    reader.read (layout_b, load_options);
+    db::MultiReader reader;
+    reader.add (infile_a, layout_a, load_options_a);
+    reader.add (infile_b, layout_b, load_options_b);
+    reader.read (parallel_read ? 2 : 0);
   }
 
   unsigned int flags = 0;
@@ -194,6 +197,7 @@ BD_PUBLIC int strmcmp (int argc, char *argv[])
 
   db::Coord tolerance_dbu = db::coord_traits<db::Coord>::rounded (tolerance / std::min (layout_a.dbu (), layout_b.dbu ()));
   bool result = false;
+  unsigned int nthreads = threads > 1 ? (unsigned int) threads : 0;
 
   if (smart_cell_mapping && top_a.empty ()) {
 
@@ -231,10 +235,10 @@ BD_PUBLIC int strmcmp (int argc, char *argv[])
       throw tl::Exception ("'" + top_b + "' is not a valid cell name in second layout");
     }
 
-    result = db::compare_layouts (layout_a, index_a.second, layout_b, index_b.second, flags, tolerance_dbu, max_count, print_properties);
+    result = db::compare_layouts (layout_a, index_a.second, layout_b, index_b.second, flags, tolerance_dbu, max_count, print_properties, nthreads);
 
   } else {
-    result = db::compare_layouts (layout_a, layout_b, flags, tolerance_dbu, max_count, print_properties);
+    result = db::compare_layouts (layout_a, layout_b, flags, tolerance_dbu, max_count, print_properties, nthreads);
   }
 
   if (! result && ! silent) {
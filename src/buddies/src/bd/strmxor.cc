@@ -26,9 +26,14 @@
 #include "dbReader.h"
 #include "dbWriter.h"
 #include "dbSaveLayoutOptions.h"
+#include "dbEdgeProcessor.h"
+#include "dbPolygonGenerators.h"
+#include "dbPolygonTools.h"
 #include "gsiExpression.h"
 #include "tlCommandLineParser.h"
 
+#include <ctime>
+
 class CountingInserter
 {
 public:
@@ -75,14 +80,375 @@ public:
     return m_count;
   }
 
+protected:
+  void add_count (size_t n)
+  {
+    m_count += n;
+  }
+
+private:
+  size_t m_count;
+};
+
+/**
+ *  @brief A minimal GDS2 stream writer producing a single flat cell
+ *
+ *  In contrast to db::Writer, this writer does not need a layout object: the
+ *  elements are written to the stream as they are delivered. Hence the XOR
+ *  output does not need to be held in memory. The header and the cell start
+ *  are written by the constructor, the trailer by "close".
+ */
+class StreamingGDS2Writer
+{
+public:
+  StreamingGDS2Writer (const std::string &path, const std::string &cell_name, double dbu)
+    : m_stream (path), m_closed (false), m_dbu (dbu)
+  {
+    short time_data [6] = { 0, 0, 0, 0, 0, 0 };
+    time_t ti = 0;
+    time (&ti);
+    const struct tm *t = localtime (&ti);
+    if (t) {
+      time_data[0] = t->tm_year + 1900;
+      time_data[1] = t->tm_mon + 1;
+      time_data[2] = t->tm_mday;
+      time_data[3] = t->tm_hour;
+      time_data[4] = t->tm_min;
+      time_data[5] = t->tm_sec;
+    }
+
+    write_record (0x0002, 2);   //  HEADER
+    write_short (600);
+
+    write_record (0x0102, 12 * 2);   //  BGNLIB
+    write_time (time_data);
+    write_time (time_data);
+
+    write_string_record (0x0206, "LIB");   //  LIBNAME
+
+    write_record (0x0305, 8 * 2);   //  UNITS
+    write_double (dbu);
+    write_double (dbu * 1e-6);
+
+    write_record (0x0502, 12 * 2);   //  BGNSTR
+    write_time (time_data);
+    write_time (time_data);
+
+    write_string_record (0x0606, cell_name);   //  STRNAME
+  }
+
+  ~StreamingGDS2Writer ()
+  {
+    //  NOTE: no trailer is written if "close" wasn't called, so a
+    //  truncated file indicates a failed operation.
+  }
+
+  void close ()
+  {
+    if (! m_closed) {
+      write_record (0x0700, 0);   //  ENDSTR
+      write_record (0x0400, 0);   //  ENDLIB
+      m_stream.flush ();
+      m_closed = true;
+    }
+  }
+
+  void write (const db::LayerProperties &lp, const db::Polygon &polygon)
+  {
+    //  GDS2 does not support holes and is limited to 8190 points per XY record
+    bool needs_split = polygon.vertices () > 8000;
+
+    if (polygon.holes () > 0) {
+
+      std::vector<db::Polygon> polygons;
+
+      db::EdgeProcessor ep;
+      ep.insert_sequence (polygon.begin_edge ());
+      db::PolygonContainer pc (polygons);
+      db::PolygonGenerator out (pc, true /*resolve holes*/, needs_split /*min coherence for splitting*/);
+      db::SimpleMerge op;
+      ep.process (out, op);
+
+      for (std::vector<db::Polygon>::const_iterator p = polygons.begin (); p != polygons.end (); ++p) {
+        write (lp, *p);
+      }
+
+    } else if (needs_split) {
+
+      std::vector <db::Polygon> polygons;
+      db::split_polygon (polygon, polygons);
+
+      for (std::vector<db::Polygon>::const_iterator p = polygons.begin (); p != polygons.end (); ++p) {
+        write (lp, *p);
+      }
+
+    } else if (polygon.vertices () > 0) {
+
+      write_record (0x0800, 0);   //  BOUNDARY
+      write_layer (lp, 0x0e02);   //  DATATYPE
+
+      write_record (0x1003, (polygon.vertices () + 1) * 2 * 4);   //  XY
+      for (db::Polygon::polygon_contour_iterator p = polygon.begin_hull (); p != polygon.end_hull (); ++p) {
+        write_point (*p);
+      }
+      write_point (*polygon.begin_hull ());
+
+      write_record (0x1100, 0);   //  ENDEL
+
+    }
+  }
+
+  void write (const db::LayerProperties &lp, const db::Edge &edge)
+  {
+    write_record (0x0900, 0);   //  PATH
+    write_layer (lp, 0x0e02);   //  DATATYPE
+
+    write_record (0x0f03, 4);   //  WIDTH
+    write_int (0);
+
+    write_record (0x1003, 2 * 2 * 4);   //  XY
+    write_point (edge.p1 ());
+    write_point (edge.p2 ());
+
+    write_record (0x1100, 0);   //  ENDEL
+  }
+
+  void write (const db::LayerProperties &lp, const db::Text &text)
+  {
+    write_record (0x0c00, 0);   //  TEXT
+    write_layer (lp, 0x1602);   //  TEXTTYPE
+
+    //  same encoding than db::GDS2WriterBase::write_text
+    if (text.halign () != db::NoHAlign || text.valign () != db::NoVAlign || text.font () != db::NoFont) {
+      short ha = short (text.halign () == db::NoHAlign ? db::HAlignLeft : text.halign ());
+      short va = short (text.valign () == db::NoVAlign ? db::VAlignBottom : text.valign ());
+      write_record (0x1701, 2);   //  PRESENTATION
+      write_short (ha + va * 4);
+    }
+
+    const db::Trans &trans = text.trans ();
+    if (trans.rot () != 0 || text.size () != 0) {
+
+      write_record (0x1a01, 2);   //  STRANS
+      write_short (trans.is_mirror () ? 0x8000 : 0);
+
+      if (text.size () != 0) {
+        write_record (0x1b05, 8);   //  MAG
+        write_double (text.size () * m_dbu);
+      }
+
+      if ((trans.rot () % 4) != 0) {
+        write_record (0x1c05, 8);   //  ANGLE
+        write_double ((trans.rot () % 4) * 90.0);
+      }
+
+    }
+
+    write_record (0x1003, 2 * 4);   //  XY
+    write_point (db::Point () + text.trans ().disp ());
+
+    write_string_record (0x1906, text.string ());   //  STRING
+
+    write_record (0x1100, 0);   //  ENDEL
+  }
+
+private:
+  tl::OutputStream m_stream;
+  bool m_closed;
+  double m_dbu;
+
+  void write_layer (const db::LayerProperties &lp, short type_record)
+  {
+    write_record (0x0d02, 2);   //  LAYER
+    write_short (lp.layer);
+    write_record (type_record, 2);
+    write_short (lp.datatype);
+  }
+
+  void write_point (const db::Point &p)
+  {
+    write_int (p.x ());
+    write_int (p.y ());
+  }
+
+  void write_record (short record, size_t size)
+  {
+    write_short (short (size + 4));
+    write_short (record);
+  }
+
+  void write_string_record (short record, const std::string &s)
+  {
+    size_t n = s.size ();
+    write_record (record, (n + 1) / 2 * 2);
+    m_stream.put (s.c_str (), n);
+    if ((n % 2) != 0) {
+      char z = 0;
+      m_stream.put (&z, 1);
+    }
+  }
+
+  void write_short (int16_t s)
+  {
+    char b[2];
+    b[0] = char ((s >> 8) & 0xff);
+    b[1] = char (s & 0xff);
+    m_stream.put (b, sizeof (b));
+  }
+
+  void write_int (int32_t l)
+  {
+    char b[4];
+    b[0] = char ((l >> 24) & 0xff);
+    b[1] = char ((l >> 16) & 0xff);
+    b[2] = char ((l >> 8) & 0xff);
+    b[3] = char (l & 0xff);
+    m_stream.put (b, sizeof (b));
+  }
+
+  void write_time (const short *t)
+  {
+    for (unsigned int i = 0; i < 6; ++i) {
+      write_short (t [i]);
+    }
+  }
+
+  void write_double (double d)
+  {
+    char b[8];
+
+    b[0] = 0;
+    if (d < 0) {
+      b[0] = char (0x80);
+      d = -d;
+    }
+
+    //  compute the next power of 16 that that value will fit in
+    int e = 0;
+    if (d < 1e-77 /*~16^-64*/) {
+      d = 0;
+    } else {
+      double lg16 = log (d) / log (16.0);
+      e = int (ceil (log (d) / log (16.0)));
+      if (e == lg16) {
+        ++e;
+      }
+    }
+
+    d /= pow (16.0, e - 14);
+
+    tl_assert (e >= -64 && e < 64);
+    b[0] |= ((e + 64) & 0x7f);
+
+    uint64_t m = uint64_t (d + 0.5);
+    for (int i = 7; i > 0; --i) {
+      b[i] = (m & 0xff);
+      m >>= 8;
+    }
+
+    m_stream.put (b, sizeof (b));
+  }
+};
+
+class StreamingInserter
+{
+public:
+  StreamingInserter (StreamingGDS2Writer *writer, const db::LayerProperties &lp)
+    : mp_writer (writer), m_lp (lp), m_count (0)
+  {
+    //  .. nothing yet ..
+  }
+
+  void operator() (const db::Polygon &p)
+  {
+    mp_writer->write (m_lp, p);
+    m_count += 1;
+  }
+
+  void operator() (const db::SimplePolygon &p)
+  {
+    db::Polygon poly;
+    poly.assign_hull (p.begin_hull (), p.end_hull (), false /*no compression*/);
+    mp_writer->write (m_lp, poly);
+    m_count += 1;
+  }
+
+  void operator() (const db::Box &b)
+  {
+    mp_writer->write (m_lp, db::Polygon (b));
+    m_count += 1;
+  }
+
+  void operator() (const db::Path &p)
+  {
+    mp_writer->write (m_lp, p.polygon ());
+    m_count += 1;
+  }
+
+  void operator() (const db::EdgePair &ep)
+  {
+    mp_writer->write (m_lp, ep.normalized ().to_polygon (0));
+    m_count += 1;
+  }
+
+  void operator() (const db::Edge &e)
+  {
+    mp_writer->write (m_lp, e);
+    m_count += 1;
+  }
+
+  void operator() (const db::Text &t)
+  {
+    mp_writer->write (m_lp, t);
+    m_count += 1;
+  }
+
+  size_t count () const
+  {
+    return m_count;
+  }
+
 private:
+  StreamingGDS2Writer *mp_writer;
+  db::LayerProperties m_lp;
   size_t m_count;
 };
 
+/**
+ *  @brief A receiver writing the tile results directly to a GDS2 stream
+ *
+ *  The tiles are written in the order they are finished. With a single thread
+ *  this is the tile order. No result is kept in memory beyond the tile
+ *  currently delivered.
+ */
+class StreamingReceiver
+  : public CountingReceiver
+{
+public:
+  StreamingReceiver (StreamingGDS2Writer *writer, const db::LayerProperties &lp)
+    : mp_writer (writer), m_lp (lp)
+  {
+    //  .. nothing yet ..
+  }
+
+  virtual void put (size_t /*ix*/, size_t /*iy*/, const db::Box &tile, size_t /*id*/, const tl::Variant &obj, double /*dbu*/, const db::ICplxTrans & /*trans*/, bool clip)
+  {
+    //  NOTE: all receivers share the same writer. This is safe as the tiling processor
+    //  serializes the delivery of all outputs.
+    StreamingInserter inserter (mp_writer, m_lp);
+    db::insert_var (inserter, obj, tile, clip);
+    add_count (inserter.count ());
+  }
+
+private:
+  StreamingGDS2Writer *mp_writer;
+  db::LayerProperties m_lp;
+};
+
 struct ResultDescriptor
 {
   ResultDescriptor ()
-    : layer_a (-1), layer_b (-1), layer_output (-1), layout (0), top_cell (0)
+    : layer_a (-1), layer_b (-1), layer_output (-1), layout (0), top_cell (0), streamed (false)
   {
     //  .. nothing yet ..
   }
@@ -91,6 +457,8 @@ struct ResultDescriptor
   int layer_a;
   int layer_b;
   int layer_output;
+  db::LayerProperties lp_output;
+  bool streamed;
   db::Layout *layout;
   db::cell_index_type top_cell;
 
@@ -144,6 +512,8 @@ BD_PUBLIC int strmxor (int argc, char *argv[])
   int tolerance_bump = 10000;
   int threads = 1;
   double tile_size = 0.0;
+  bool parallel_read = false;
+  bool stream_output = false;
 
   tl::CommandLineOptions cmd;
   generic_reader_options_a.add_options (cmd);
@@ -183,6 +553,18 @@ BD_PUBLIC int strmxor (int argc, char *argv[])
                   "If given, multiple threads are used for the XOR computation. This way, multiple cores can "
                   "be utilized."
                  )
+      << tl::arg ("--parallel-read",           &parallel_read, "Reads both input files concurrently",
+                  "With this option, the two input files are read in parallel on two threads. This reduces the "
+                  "loading time for large files if enough memory is available to hold both layouts."
+                 )
+      << tl::arg ("--stream-output",           &stream_output, "Writes the output while the XOR is computed",
+                  "With this option, the XOR results are written to the output file as soon as a tile has been "
+                  "computed. The results are not kept in memory. This is useful in tiling mode (see --tiles) for "
+                  "large layouts with many differences. The output is always written as a flat GDS2 file, "
+                  "so the output file name must indicate GDS2 format (e.g. \".gds\" or \".gds.gz\"). "
+                  "Named layers are not supported. With multiple threads, the order in which the tiles "
+                  "are written is not deterministic."
+                 )
       << tl::arg ("-p|--tiles=size",           &tile_size, "Specifies tiling mode",
                   "In tiling mode, the layout is divided into tiles of the given size. Each tile is computed "
                   "individually. Multiple tiles can be processed in parallel on multiple cores."
@@ -213,25 +595,26 @@ BD_PUBLIC int strmxor (int argc, char *argv[])
     }
   }
 
+  if (stream_output && ! output.empty ()) {
+    //  the streaming writer can only produce GDS2
+    db::SaveLayoutOptions save_options;
+    if (! save_options.set_format_from_filename (output) || save_options.format () != "GDS2") {
+      throw tl::Exception ("--stream-output can only write GDS2 files (use a .gds or .gds.gz file name): " + output);
+    }
+  }
+
   db::Layout layout_a;
   db::Layout layout_b;
 
   {
-    db::LoadLayoutOptions load_options;
-    generic_reader_options_a.configure (load_options);
-
-    tl::InputStream stream (infile_a);
-    db::Reader reader (stream);
-    reader.read (layout_a, load_options);
-  }
-
-  {
-    db::LoadLayoutOptions load_options;
-    generic_reader_options_b.configure (load_options);
-
-    tl::InputStream stream (infile_b);
-    db::Reader reader (stream);
-    reader.read (layout_b, load_options);
+    db::LoadLayoutOptions load_options_a, load_options_b;
+    generic_reader_options_a.configure (load_options_a);
+    generic_reader_options_b.configure (load_options_b);
+
+    db::MultiReader reader;
+    reader.add (infile_a, layout_a, load_options_a);
+    reader.add (infile_b, layout_b, load_options_b);
+    reader.read (parallel_read ? 2 : 0);
   }
 
   if (top_a.empty ()) {
@@ -299,9 +682,12 @@ BD_PUBLIC int strmxor (int argc, char *argv[])
   }
 
   std::auto_ptr<db::Layout> output_layout;
+  std::auto_ptr<StreamingGDS2Writer> output_stream;
   db::cell_index_type output_top = 0;
 
-  if (! output.empty ()) {
+  if (! output.empty () && stream_output) {
+    output_stream.reset (new StreamingGDS2Writer (output, "XOR", proc.dbu ()));
+  } else if (! output.empty ()) {
     output_layout.reset (new db::Layout ());
     output_layout->dbu (proc.dbu ());
     output_top = output_layout->add_cell ("XOR");
@@ -373,7 +759,16 @@ BD_PUBLIC int strmxor (int argc, char *argv[])
         result.layout = output_layout.get ();
         result.top_cell = output_top;
 
-        if (result.layout) {
+        if (output_stream.get ()) {
+          if (lp.layer < 0 || lp.datatype < 0) {
+            throw tl::Exception ("Named layers cannot be written with --stream-output: " + lp.to_string ());
+          }
+          StreamingReceiver *receiver = new StreamingReceiver (output_stream.get (), lp);
+          result.counter = receiver;
+          result.lp_output = lp;
+          result.streamed = true;
+          proc.output (out, 0, receiver, db::ICplxTrans ());
+        } else if (result.layout) {
           result.layer_output = result.layout->insert_layer (lp);
           proc.output (out, *result.layout, result.top_cell, result.layer_output);
         } else {
@@ -404,10 +799,14 @@ BD_PUBLIC int strmxor (int argc, char *argv[])
 
   //  Runs the processor
 
-  if ((! silent && ! no_summary) || result || output_layout.get ()) {
+  if ((! silent && ! no_summary) || result || output_layout.get () || output_stream.get ()) {
     proc.execute ("Running XOR");
   }
 
+  if (output_stream.get ()) {
+    output_stream->close ();
+  }
+
   //  Writes the output layout
 
   if (output_layout.get ()) {
@@ -458,6 +857,8 @@ BD_PUBLIC int strmxor (int argc, char *argv[])
         } else if (! r->second.is_empty ()) {
           if (r->second.layer_output >= 0 && r->second.layout) {
             out = r->second.layout->get_properties (r->second.layer_output).to_string ();
+          } else if (r->second.streamed) {
+            out = r->second.lp_output.to_string ();
           }
           value = tl::to_string (r->second.count ());
         }
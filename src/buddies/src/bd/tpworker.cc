@@ -0,0 +1,93 @@
+
+/*
+
+  KLayout Layout Viewer
+  Copyright (C) 2006-2019 Matthias Koefferlein
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+
+#include "bdCommon.h"
+#include "dbTilingProcessor.h"
+#include "tlCommandLineParser.h"
+#include "tlStream.h"
+#include "gsi.h"
+#include "gsiExpression.h"
+
+#include <cstdio>
+
+#if defined(_WIN32)
+#  include <io.h>
+#  include <fcntl.h>
+#endif
+
+/**
+ *  @brief An output stream delegate writing to stdout in binary mode
+ */
+class StdoutStream
+  : public tl::OutputStreamBase
+{
+public:
+  StdoutStream ()
+  {
+#if defined(_WIN32)
+    _setmode (_fileno (stdout), _O_BINARY);
+#endif
+  }
+
+  virtual void write (const char *b, size_t n)
+  {
+    if (fwrite (b, 1, n, stdout) != n) {
+      throw tl::Exception (tl::to_string (tr ("Write error on stdout")));
+    }
+    fflush (stdout);
+  }
+};
+
+BD_PUBLIC int tpworker (int argc, char *argv[])
+{
+  tl::CommandLineOptions cmd;
+  std::string setup_file, tasks_file;
+
+  cmd << tl::arg ("setup",                      &setup_file, "The setup file",
+                  "This file contains the inputs, variables, outputs and scripts. It is written by the coordinating "
+                  "tiling processor."
+                 )
+      << tl::arg ("tasks",                      &tasks_file, "The task file",
+                  "This file lists the tiles this worker is supposed to compute."
+                 )
+    ;
+
+  cmd.brief ("This program is the worker process of the tiling processor. It computes the tiles given by the "
+             "task file and delivers the results in binary form on stdout. It is started by the tiling processor "
+             "and is not intended to be used directly.");
+
+  cmd.parse (argc, argv);
+
+  //  initialize the GSI class system (Variant binding, Expression support)
+  gsi::initialize ();
+
+  //  initialize the tl::Expression subsystem with GSI-bound classes
+  gsi::initialize_expressions ();
+
+  tl::InputStream setup (setup_file);
+  tl::InputStream tasks (tasks_file);
+
+  StdoutStream stdout_stream;
+  tl::OutputStream results (stdout_stream);
+
+  return db::TilingProcessor::run_worker (setup, tasks, results) ? 0 : 1;
+}
@@ -13,6 +13,7 @@ SUBDIRS = \
   strmcmp \
   strmxor \
   strmrun \
+  tpworker \
 
 strm2cif.depends += bd
 strm2dxf.depends += bd
@@ -24,3 +25,4 @@ strmclip.depends += bd
 strmcmp.depends += bd
 strmxor.depends += bd
 strmrun.depends += bd
+tpworker.depends += bd
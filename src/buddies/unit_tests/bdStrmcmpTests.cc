@@ -181,6 +181,78 @@ TEST(2F)
   );
 }
 
+TEST(2G)
+{
+  tl::CaptureChannel cap;
+
+  std::string input_a = tl::testsrc ();
+  input_a += "/testdata/bd/strmcmp_in.gds";
+
+  std::string input_b = tl::testsrc ();
+  input_b += "/testdata/bd/strmcmp_ref2.gds";
+
+  //  multi-threaded compare: same output as 2A
+  const char *argv[] = { "x", "-n=4", input_a.c_str (), input_b.c_str () };
+
+  EXPECT_EQ (strmcmp (sizeof (argv) / sizeof (argv[0]), (char **) argv), 1);
+
+  EXPECT_EQ (cap.captured_text (),
+    "Boxes differ for layer 8/0 in cell RINGO\n"
+    "Not in b but in a:\n"
+    "  (-1720,1600;23160,2000)\n"
+    "Not in a but in b:\n"
+    "  (-1520,1600;23160,2000)\n"
+    "Texts differ for layer 8/1 in cell RINGO\n"
+    "Not in b but in a:\n"
+    "  ('FB',r0 0,1800)\n"
+    "Not in a but in b:\n"
+    "  ('BF',r0 0,1800)\n"
+    "Layouts differ\n"
+  );
+}
+
+TEST(2H)
+{
+  tl::CaptureChannel cap;
+
+  std::string input_a = tl::testsrc ();
+  input_a += "/testdata/bd/strmcmp_in.gds";
+
+  std::string input_b = tl::testsrc ();
+  input_b += "/testdata/bd/strmcmp_ref2.gds";
+
+  //  multi-threaded compare: same output as 2F
+  const char *argv[] = { "x", "-u", "-n=4", input_a.c_str (), input_b.c_str () };
+
+  EXPECT_EQ (strmcmp (sizeof (argv) / sizeof (argv[0]), (char **) argv), 1);
+
+  EXPECT_EQ (cap.captured_text (),
+    "Bounding boxes differ for cell RINGO, (-1720,-800;25160,3800) vs. (-1700,-800;25160,3800)\n"
+    "Per-layer bounding boxes differ for cell RINGO, layer (8/0), (-1720,-450;25160,3250) vs. (-1520,-450;25160,3250)\n"
+    "Boxes differ for layer 8/0 in cell RINGO\n"
+    "Texts differ for layer 8/1 in cell RINGO\n"
+    "Layouts differ\n"
+  );
+}
+
+TEST(2I)
+{
+  tl::CaptureChannel cap;
+
+  std::string input_a = tl::testsrc ();
+  input_a += "/testdata/bd/strmcmp_in.gds";
+
+  std::string input_b = tl::testsrc ();
+  input_b += "/testdata/bd/strmcmp_ref1.gds";
+
+  //  multi-threaded compare of identical layouts
+  const char *argv[] = { "x", "-n=4", input_a.c_str (), input_b.c_str () };
+
+  EXPECT_EQ (strmcmp (sizeof (argv) / sizeof (argv[0]), (char **) argv), 0);
+
+  EXPECT_EQ (cap.captured_text (), "");
+}
+
 TEST(3A)
 {
   tl::CaptureChannel cap;
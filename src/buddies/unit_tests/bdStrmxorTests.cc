@@ -326,3 +326,107 @@ TEST(6)
     "Layer 10/0 is not present in first layout, but in second\n"
   );
 }
+
+TEST(7)
+{
+  tl::CaptureChannel cap;
+
+  std::string input_a = tl::testsrc ();
+  input_a += "/testdata/bd/strmxor_in1.gds";
+
+  std::string input_b = tl::testsrc ();
+  input_b += "/testdata/bd/strmxor_in2.gds";
+
+  std::string au = tl::testsrc ();
+  au += "/testdata/bd/strmxor_au1.oas";
+
+  std::string output = this->tmp_file ("tmp.oas");
+
+  const char *argv[] = { "x", "--parallel-read", input_a.c_str (), input_b.c_str (), output.c_str () };
+
+  EXPECT_EQ (strmxor (sizeof (argv) / sizeof (argv[0]), (char **) argv), 1);
+
+  db::Layout layout;
+
+  {
+    tl::InputStream stream (output);
+    db::Reader reader (stream);
+    reader.read (layout);
+  }
+
+  db::compare_layouts (this, layout, au, db::NoNormalization);
+  EXPECT_EQ (cap.captured_text (),
+    "Layer 10/0 is not present in first layout, but in second\n"
+    "Result summary (layers without differences are not shown):\n"
+    "\n"
+    "  Layer      Output       Differences (shape count)\n"
+    "  -------------------------------------------------------\n"
+    "  3/0        3/0          30\n"
+    "  6/0        6/0          41\n"
+    "  8/1        8/1          1\n"
+    "  10/0       -            (no such layer in first layout)\n"
+    "\n"
+  );
+}
+
+TEST(8)
+{
+  std::string input_a = tl::testsrc ();
+  input_a += "/testdata/bd/strmxor_in1.gds";
+
+  std::string input_b = tl::testsrc ();
+  input_b += "/testdata/bd/strmxor_in2.gds";
+
+  //  the reference is produced without streaming
+  std::string au = this->tmp_file ("au.gds");
+  std::string au_text;
+
+  {
+    tl::CaptureChannel cap;
+
+    const char *argv[] = { "x", "-p=1.0", input_a.c_str (), input_b.c_str (), au.c_str () };
+
+    EXPECT_EQ (strmxor (sizeof (argv) / sizeof (argv[0]), (char **) argv), 1);
+    au_text = cap.captured_text ();
+  }
+
+  std::string output = this->tmp_file ("tmp.gds");
+
+  tl::CaptureChannel cap;
+
+  const char *argv[] = { "x", "--stream-output", "-p=1.0", "-n=4", input_a.c_str (), input_b.c_str (), output.c_str () };
+
+  EXPECT_EQ (strmxor (sizeof (argv) / sizeof (argv[0]), (char **) argv), 1);
+
+  db::Layout layout;
+
+  {
+    tl::InputStream stream (output);
+    db::Reader reader (stream);
+    reader.read (layout);
+  }
+
+  db::compare_layouts (this, layout, au, db::NoNormalization);
+  EXPECT_EQ (cap.captured_text (), au_text);
+}
+
+TEST(9)
+{
+  std::string input_a = tl::testsrc ();
+  input_a += "/testdata/bd/strmxor_in1.gds";
+
+  std::string input_b = tl::testsrc ();
+  input_b += "/testdata/bd/strmxor_in2.gds";
+
+  //  --stream-output can only produce GDS2
+  std::string output = this->tmp_file ("tmp.oas");
+
+  const char *argv[] = { "x", "--stream-output", "-p=1.0", input_a.c_str (), input_b.c_str (), output.c_str () };
+
+  try {
+    strmxor (sizeof (argv) / sizeof (argv[0]), (char **) argv);
+    EXPECT_EQ (true, false);
+  } catch (tl::Exception &ex) {
+    EXPECT_EQ (ex.msg (), "--stream-output can only write GDS2 files (use a .gds or .gds.gz file name): " + output);
+  }
+}
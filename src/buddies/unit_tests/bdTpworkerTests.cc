@@ -0,0 +1,124 @@
+
+/*
+
+  KLayout Layout Viewer
+  Copyright (C) 2006-2019 Matthias Koefferlein
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+
+#include "tlUnitTest.h"
+#include "tlFileUtils.h"
+#include "tlString.h"
+#include "dbTilingProcessor.h"
+#include "dbLayout.h"
+#include "dbRegion.h"
+#include "dbEdgePairs.h"
+#include "dbEdges.h"
+
+static std::string worker_command ()
+{
+  std::string cmd;
+
+#if defined(__APPLE__)
+  //  NOTE: because of system integrity, MacOS does not inherit DYLD_LIBRARY_PATH to child
+  //  processes like sh. We need to port this variable explicitly.
+  const char *ldpath_name = "DYLD_LIBRARY_PATH";
+  const char *ldpath = getenv (ldpath_name);
+  if (ldpath) {
+    cmd += std::string (ldpath_name) + "=\"" + ldpath + "\"; export " + ldpath_name + "; ";
+  }
+#endif
+
+  cmd += tl::to_shell_argument (tl::combine_path (tl::get_inst_path (), "tpworker"));
+  return cmd;
+}
+
+static void make_layout (db::Layout &ly, unsigned int l1)
+{
+  db::Cell &top = ly.cell (ly.add_cell ("TOP"));
+  for (int i = 0; i < 20; ++i) {
+    for (int j = 0; j < 20; ++j) {
+      top.shapes (l1).insert (db::Box (i * 1000, j * 1000, i * 1000 + 200 + i * 20, j * 1000 + 500));
+    }
+  }
+}
+
+static void run (db::Layout &ly, unsigned int l1, size_t workers, db::Region &sized, db::EdgePairs &width)
+{
+  db::TilingProcessor tp;
+  tp.input ("a", db::RecursiveShapeIterator (ly, ly.cell (*ly.begin_top_down ()), l1));
+  tp.output ("o1", sized);
+  tp.output ("o2", width);
+  tp.var ("d", 300);
+  tp.tile_size (3.0, 3.0);
+  tp.tile_border (1.0, 1.0);
+  tp.set_workers (workers);
+  tp.set_worker_command (worker_command ());
+  tp.queue ("_output(o1, a.sized(d))");
+  tp.queue ("_output(o2, a.width_check(d))");
+  tp.execute ("test");
+}
+
+//  Distributed execution delivers the same results as the in-process one
+TEST(1)
+{
+  db::Layout ly;
+  unsigned int l1 = ly.insert_layer (db::LayerProperties (1, 0));
+  make_layout (ly, l1);
+
+  db::Region sized_local, sized_remote;
+  db::EdgePairs width_local, width_remote;
+
+  run (ly, l1, 0, sized_local, width_local);
+  run (ly, l1, 3, sized_remote, width_remote);
+
+  EXPECT_EQ (sized_local.empty (), false);
+  EXPECT_EQ (width_local.empty (), false);
+
+  EXPECT_EQ ((sized_local ^ sized_remote).empty (), true);
+  EXPECT_EQ (width_local.size (), width_remote.size ());
+
+  db::Edges edges_local, edges_remote;
+  width_local.edges (edges_local);
+  width_remote.edges (edges_remote);
+  EXPECT_EQ ((edges_local ^ edges_remote).empty (), true);
+}
+
+//  Errors of the worker process are reported
+TEST(2)
+{
+  db::Layout ly;
+  unsigned int l1 = ly.insert_layer (db::LayerProperties (1, 0));
+  make_layout (ly, l1);
+
+  db::Region out;
+
+  db::TilingProcessor tp;
+  tp.input ("a", db::RecursiveShapeIterator (ly, ly.cell (*ly.begin_top_down ()), l1));
+  tp.output ("o", out);
+  tp.tile_size (3.0, 3.0);
+  tp.set_workers (2);
+  tp.set_worker_command (worker_command ());
+  tp.queue ("_output(o, a.does_not_exist)");
+
+  try {
+    tp.execute ("test");
+    EXPECT_EQ (true, false);
+  } catch (tl::Exception &ex) {
+    EXPECT_EQ (ex.msg ().find ("does_not_exist") != std::string::npos, true);
+  }
+}
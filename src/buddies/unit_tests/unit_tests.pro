@@ -15,6 +15,7 @@ SOURCES = \
   bdStrmcmpTests.cc \
   bdStrmxorTests.cc \
   bdStrmrunTests.cc \
+  bdTpworkerTests.cc \
 
 
 INCLUDEPATH += $$BD_INC $$DB_INC $$TL_INC $$GSI_INC
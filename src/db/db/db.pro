@@ -52,6 +52,7 @@ SOURCES = \
   dbPCellDeclaration.cc \
   dbPCellHeader.cc \
   dbPCellVariant.cc \
+  dbPCellVariantCache.cc \
   dbPoint.cc \
   dbPolygon.cc \
   dbPolygonTools.cc \
@@ -168,6 +169,7 @@ SOURCES = \
     dbNetlistSpiceWriter.cc \
     dbNetlistWriter.cc \
     dbCellVariants.cc \
+    dbCellContentHash.cc \
     dbDeepEdges.cc \
     dbDeepEdgePairs.cc \
     dbRegionUtils.cc \
@@ -230,6 +232,7 @@ HEADERS = \
   dbPCellDeclaration.h \
   dbPCellHeader.h \
   dbPCellVariant.h \
+  dbPCellVariantCache.h \
   dbPoint.h \
   dbPolygon.h \
   dbPolygonTools.h \
@@ -309,6 +312,8 @@ HEADERS = \
     dbNetlistSpiceWriter.h \
     dbNetlistWriter.h \
     dbCellVariants.h \
+    dbCellContentHash.h \
+    dbDeepCellOperation.h \
     dbDeepEdges.h \
     dbDeepEdgePairs.h \
     dbRegionUtils.h \
@@ -28,6 +28,7 @@
 
 #include "dbBoxConvert.h"
 #include "tlProgress.h"
+#include "tlThreadedWorkers.h"
 
 #include <list>
 #include <vector>
@@ -35,6 +36,8 @@
 #include <set>
 #include <functional>
 #include <memory>
+#include <algorithm>
+#include <limits>
 
 namespace db
 {
@@ -105,6 +108,55 @@ bool bs_boxes_overlap (const Box &b1, const Box &b2, typename Box::coord_type en
   }
 }
 
+/**
+ *  @brief A utility function for the multi-threaded box scanner implementation
+ *
+ *  This function computes up to n - 1 stripe boundaries from the given left
+ *  coordinates such that the stripes receive roughly the same number of
+ *  objects. The "lefts" vector is modified.
+ */
+template <class C>
+void bs_make_stripes (std::vector<C> &lefts, unsigned int n, std::vector<C> &boundaries)
+{
+  boundaries.clear ();
+  if (lefts.empty ()) {
+    return;
+  }
+
+  for (unsigned int i = 1; i < n; ++i) {
+    typename std::vector<C>::iterator nth = lefts.begin () + (lefts.size () * i) / n;
+    std::nth_element (lefts.begin (), nth, lefts.end ());
+    if (boundaries.empty () || *nth > boundaries.back ()) {
+      boundaries.push_back (*nth);
+    }
+  }
+}
+
+/**
+ *  @brief A utility class for the multi-threaded box scanner implementation
+ *
+ *  This worker executes the stripe tasks.
+ */
+template <class Task>
+class bs_stripe_worker
+  : public tl::Worker
+{
+public:
+  bs_stripe_worker ()
+    : tl::Worker ()
+  {
+    //  .. nothing yet ..
+  }
+
+  void perform_task (tl::Task *task)
+  {
+    static_cast<Task *> (task)->perform ();
+  }
+};
+
+template <class Obj, class Prop, class BoxConvert> class box_scanner_stripe_task;
+template <class Obj1, class Prop1, class Obj2, class Prop2, class BoxConvert1, class BoxConvert2> class box_scanner_stripe_task2;
+
 /**
  *  @brief A template for the box scanner output receiver
  *
@@ -169,12 +221,36 @@ public:
    *  @brief Default ctor
    */
   box_scanner (bool report_progress = false, const std::string &progress_desc = std::string ())
-    : m_fill_factor (2), m_scanner_thr (100), 
+    : m_fill_factor (2), m_scanner_thr (100), m_threads (1),
       m_report_progress (report_progress), m_progress_desc (progress_desc)
   {
     //  .. nothing yet ..
   }
 
+  /**
+   *  @brief Sets the number of threads to use
+   *
+   *  With more than one thread, large problems are split into vertical stripes
+   *  which are scanned in parallel. The interactions are reported to the receiver
+   *  from the calling thread after the stripes have been scanned, so the receiver
+   *  does not need to be thread-safe. Each interaction is reported once. In this
+   *  mode, "finish" is called for all objects at the end and "stop" is only
+   *  checked while the interactions are reported. No progress is reported.
+   *  The default is 1 (single-threaded).
+   */
+  void set_threads (unsigned int n)
+  {
+    m_threads = n;
+  }
+
+  /**
+   *  @brief Gets the number of threads to use
+   */
+  unsigned int threads () const
+  {
+    return m_threads;
+  }
+
   /**
    *  @brief Sets the scanner threshold
    *
@@ -292,6 +368,10 @@ public:
       m_pp.erase (wi, m_pp.end ());
     }
 
+    if (m_threads > 1 && m_pp.size () > m_scanner_thr * m_threads) {
+      return process_stripes (rec, enl, bc);
+    }
+
     if (m_pp.size () <= m_scanner_thr) {
 
       //  below m_scanner_thr elements use the brute force approach which is faster in that case
@@ -425,8 +505,146 @@ private:
   container_type m_pp;
   double m_fill_factor;
   size_t m_scanner_thr;
+  unsigned int m_threads;
   bool m_report_progress;
   std::string m_progress_desc;
+
+  template <class Rec, class BoxConvert>
+  bool process_stripes (Rec &rec, typename BoxConvert::box_type::coord_type enl, const BoxConvert &bc)
+  {
+    typedef typename BoxConvert::box_type box_type;
+    typedef typename box_type::coord_type coord_type;
+    typedef box_scanner_stripe_task<Obj, Prop, BoxConvert> task_type;
+
+    //  Each interaction is reported by the stripe containing the larger one of the left
+    //  coordinates of the two boxes. Hence a box needs to go into all stripes
+    //  overlapping the range from its left edge to the right edge plus enlargement.
+
+    std::vector<coord_type> boundaries;
+    {
+      std::vector<coord_type> lefts;
+      lefts.reserve (m_pp.size ());
+      for (iterator_type i = m_pp.begin (); i != m_pp.end (); ++i) {
+        lefts.push_back (bc (*i->first).left ());
+      }
+      bs_make_stripes (lefts, m_threads, boundaries);
+    }
+
+    std::vector<typename task_type::result_type> results (boundaries.size () + 1);
+    std::vector<task_type *> tasks;
+    for (size_t s = 0; s <= boundaries.size (); ++s) {
+      coord_type xmin = (s == 0 ? std::numeric_limits<coord_type>::min () : boundaries [s - 1]);
+      coord_type xmax = (s == boundaries.size () ? std::numeric_limits<coord_type>::max () : boundaries [s]);
+      tasks.push_back (new task_type (enl, bc, xmin, xmax, &results [s]));
+      tasks.back ()->scanner ().set_fill_factor (m_fill_factor);
+      tasks.back ()->scanner ().set_scanner_threshold (m_scanner_thr);
+    }
+
+    for (iterator_type i = m_pp.begin (); i != m_pp.end (); ++i) {
+      box_type b = bc (*i->first);
+      size_t s1 = std::upper_bound (boundaries.begin (), boundaries.end (), b.left ()) - boundaries.begin ();
+      size_t s2 = std::upper_bound (boundaries.begin (), boundaries.end (), std::max (b.left (), coord_type (b.right () + enl - 1))) - boundaries.begin ();
+      for (size_t s = s1; s <= s2; ++s) {
+        tasks [s]->scanner ().insert (i->first, i->second);
+      }
+    }
+
+    //  NOTE: the job takes over the tasks
+    tl::Job<bs_stripe_worker<task_type> > job (m_threads);
+    for (typename std::vector<task_type *>::const_iterator t = tasks.begin (); t != tasks.end (); ++t) {
+      job.schedule (*t);
+    }
+    job.start ();
+    job.wait ();
+
+    for (typename std::vector<typename task_type::result_type>::const_iterator r = results.begin (); r != results.end (); ++r) {
+      for (typename task_type::result_type::const_iterator i = r->begin (); i != r->end (); ++i) {
+        rec.add (i->first.first, i->first.second, i->second.first, i->second.second);
+        if (rec.stop ()) {
+          return false;
+        }
+      }
+    }
+
+    for (iterator_type i = m_pp.begin (); i != m_pp.end (); ++i) {
+      rec.finish (i->first, i->second);
+    }
+
+    return true;
+  }
+};
+
+/**
+ *  @brief A utility class for the multi-threaded box scanner implementation
+ *
+ *  This receiver collects the interactions found inside one stripe.
+ */
+template <class Obj, class Prop, class BoxConvert>
+class bs_stripe_receiver
+{
+public:
+  typedef typename BoxConvert::box_type::coord_type coord_type;
+  typedef std::vector<std::pair<std::pair<const Obj *, Prop>, std::pair<const Obj *, Prop> > > result_type;
+
+  bs_stripe_receiver (const BoxConvert &bc, coord_type xmin, coord_type xmax, result_type *results)
+    : m_bc (bc), m_xmin (xmin), m_xmax (xmax), mp_results (results)
+  {
+    //  .. nothing yet ..
+  }
+
+  void finish (const Obj *, const Prop &) { }
+
+  bool stop () const { return false; }
+
+  void add (const Obj *o1, const Prop &p1, const Obj *o2, const Prop &p2)
+  {
+    coord_type x = std::max (m_bc (*o1).left (), m_bc (*o2).left ());
+    if (x >= m_xmin && x < m_xmax) {
+      mp_results->push_back (std::make_pair (std::make_pair (o1, p1), std::make_pair (o2, p2)));
+    }
+  }
+
+private:
+  BoxConvert m_bc;
+  coord_type m_xmin, m_xmax;
+  result_type *mp_results;
+};
+
+/**
+ *  @brief A utility class for the multi-threaded box scanner implementation
+ *
+ *  This task scans one stripe.
+ */
+template <class Obj, class Prop, class BoxConvert>
+class box_scanner_stripe_task
+  : public tl::Task
+{
+public:
+  typedef bs_stripe_receiver<Obj, Prop, BoxConvert> receiver_type;
+  typedef typename receiver_type::coord_type coord_type;
+  typedef typename receiver_type::result_type result_type;
+
+  box_scanner_stripe_task (coord_type enl, const BoxConvert &bc, coord_type xmin, coord_type xmax, result_type *results)
+    : m_enl (enl), m_receiver (bc, xmin, xmax, results), m_bc (bc)
+  {
+    //  .. nothing yet ..
+  }
+
+  box_scanner<Obj, Prop> &scanner ()
+  {
+    return m_scanner;
+  }
+
+  void perform ()
+  {
+    m_scanner.process (m_receiver, m_enl, m_bc);
+  }
+
+private:
+  box_scanner<Obj, Prop> m_scanner;
+  coord_type m_enl;
+  receiver_type m_receiver;
+  BoxConvert m_bc;
 };
 
 /**
@@ -495,12 +713,30 @@ public:
    *  @brief Default ctor
    */
   box_scanner2 (bool report_progress = false, const std::string &progress_desc = std::string ())
-    : m_fill_factor (2), m_scanner_thr (100),
+    : m_fill_factor (2), m_scanner_thr (100), m_threads (1),
       m_report_progress (report_progress), m_progress_desc (progress_desc)
   {
     //  .. nothing yet ..
   }
 
+  /**
+   *  @brief Sets the number of threads to use
+   *
+   *  See box_scanner::set_threads for details.
+   */
+  void set_threads (unsigned int n)
+  {
+    m_threads = n;
+  }
+
+  /**
+   *  @brief Gets the number of threads to use
+   */
+  unsigned int threads () const
+  {
+    return m_threads;
+  }
+
   /**
    *  @brief Sets the scanner threshold
    *
@@ -672,6 +908,10 @@ public:
         rec.finish2 (i->first, i->second);
       }
 
+    } else if (m_threads > 1 && m_pp1.size () + m_pp2.size () > m_scanner_thr * m_threads) {
+
+      return process_stripes (rec, enl, bc1, bc2);
+
     } else if (m_pp1.size () + m_pp2.size () <= m_scanner_thr) {
 
       //  below m_scanner_thr elements use the brute force approach which is faster in that case
@@ -851,8 +1091,162 @@ private:
   container_type2 m_pp2;
   double m_fill_factor;
   size_t m_scanner_thr;
+  unsigned int m_threads;
   bool m_report_progress;
   std::string m_progress_desc;
+
+  template <class Rec, class BoxConvert1, class BoxConvert2>
+  bool process_stripes (Rec &rec, typename BoxConvert1::box_type::coord_type enl, const BoxConvert1 &bc1, const BoxConvert2 &bc2)
+  {
+    typedef typename BoxConvert1::box_type box_type;
+    typedef typename box_type::coord_type coord_type;
+    typedef box_scanner_stripe_task2<Obj1, Prop1, Obj2, Prop2, BoxConvert1, BoxConvert2> task_type;
+
+    //  See box_scanner::process_stripes for the strategy
+
+    std::vector<coord_type> boundaries;
+    {
+      std::vector<coord_type> lefts;
+      lefts.reserve (m_pp1.size () + m_pp2.size ());
+      for (iterator_type1 i = m_pp1.begin (); i != m_pp1.end (); ++i) {
+        lefts.push_back (bc1 (*i->first).left ());
+      }
+      for (iterator_type2 i = m_pp2.begin (); i != m_pp2.end (); ++i) {
+        lefts.push_back (bc2 (*i->first).left ());
+      }
+      bs_make_stripes (lefts, m_threads, boundaries);
+    }
+
+    std::vector<typename task_type::result_type> results (boundaries.size () + 1);
+    std::vector<task_type *> tasks;
+    for (size_t s = 0; s <= boundaries.size (); ++s) {
+      coord_type xmin = (s == 0 ? std::numeric_limits<coord_type>::min () : boundaries [s - 1]);
+      coord_type xmax = (s == boundaries.size () ? std::numeric_limits<coord_type>::max () : boundaries [s]);
+      tasks.push_back (new task_type (enl, bc1, bc2, xmin, xmax, &results [s]));
+      tasks.back ()->scanner ().set_fill_factor (m_fill_factor);
+      tasks.back ()->scanner ().set_scanner_threshold (m_scanner_thr);
+    }
+
+    for (iterator_type1 i = m_pp1.begin (); i != m_pp1.end (); ++i) {
+      box_type b = bc1 (*i->first);
+      size_t s1 = std::upper_bound (boundaries.begin (), boundaries.end (), b.left ()) - boundaries.begin ();
+      size_t s2 = std::upper_bound (boundaries.begin (), boundaries.end (), std::max (b.left (), coord_type (b.right () + enl - 1))) - boundaries.begin ();
+      for (size_t s = s1; s <= s2; ++s) {
+        tasks [s]->scanner ().insert1 (i->first, i->second);
+      }
+    }
+
+    for (iterator_type2 i = m_pp2.begin (); i != m_pp2.end (); ++i) {
+      box_type b = bc2 (*i->first);
+      size_t s1 = std::upper_bound (boundaries.begin (), boundaries.end (), b.left ()) - boundaries.begin ();
+      size_t s2 = std::upper_bound (boundaries.begin (), boundaries.end (), std::max (b.left (), coord_type (b.right () + enl - 1))) - boundaries.begin ();
+      for (size_t s = s1; s <= s2; ++s) {
+        tasks [s]->scanner ().insert2 (i->first, i->second);
+      }
+    }
+
+    //  NOTE: the job takes over the tasks
+    tl::Job<bs_stripe_worker<task_type> > job (m_threads);
+    for (typename std::vector<task_type *>::const_iterator t = tasks.begin (); t != tasks.end (); ++t) {
+      job.schedule (*t);
+    }
+    job.start ();
+    job.wait ();
+
+    for (typename std::vector<typename task_type::result_type>::const_iterator r = results.begin (); r != results.end (); ++r) {
+      for (typename task_type::result_type::const_iterator i = r->begin (); i != r->end (); ++i) {
+        rec.add (i->first.first, i->first.second, i->second.first, i->second.second);
+        if (rec.stop ()) {
+          return false;
+        }
+      }
+    }
+
+    for (iterator_type1 i = m_pp1.begin (); i != m_pp1.end (); ++i) {
+      rec.finish1 (i->first, i->second);
+    }
+    for (iterator_type2 i = m_pp2.begin (); i != m_pp2.end (); ++i) {
+      rec.finish2 (i->first, i->second);
+    }
+
+    return true;
+  }
+};
+
+/**
+ *  @brief A utility class for the multi-threaded box scanner implementation (twofold version)
+ *
+ *  This receiver collects the interactions found inside one stripe.
+ */
+template <class Obj1, class Prop1, class Obj2, class Prop2, class BoxConvert1, class BoxConvert2>
+class bs_stripe_receiver2
+{
+public:
+  typedef typename BoxConvert1::box_type::coord_type coord_type;
+  typedef std::vector<std::pair<std::pair<const Obj1 *, Prop1>, std::pair<const Obj2 *, Prop2> > > result_type;
+
+  bs_stripe_receiver2 (const BoxConvert1 &bc1, const BoxConvert2 &bc2, coord_type xmin, coord_type xmax, result_type *results)
+    : m_bc1 (bc1), m_bc2 (bc2), m_xmin (xmin), m_xmax (xmax), mp_results (results)
+  {
+    //  .. nothing yet ..
+  }
+
+  void finish1 (const Obj1 *, const Prop1 &) { }
+  void finish2 (const Obj2 *, const Prop2 &) { }
+
+  bool stop () const { return false; }
+
+  void add (const Obj1 *o1, const Prop1 &p1, const Obj2 *o2, const Prop2 &p2)
+  {
+    coord_type x = std::max (m_bc1 (*o1).left (), m_bc2 (*o2).left ());
+    if (x >= m_xmin && x < m_xmax) {
+      mp_results->push_back (std::make_pair (std::make_pair (o1, p1), std::make_pair (o2, p2)));
+    }
+  }
+
+private:
+  BoxConvert1 m_bc1;
+  BoxConvert2 m_bc2;
+  coord_type m_xmin, m_xmax;
+  result_type *mp_results;
+};
+
+/**
+ *  @brief A utility class for the multi-threaded box scanner implementation (twofold version)
+ *
+ *  This task scans one stripe.
+ */
+template <class Obj1, class Prop1, class Obj2, class Prop2, class BoxConvert1, class BoxConvert2>
+class box_scanner_stripe_task2
+  : public tl::Task
+{
+public:
+  typedef bs_stripe_receiver2<Obj1, Prop1, Obj2, Prop2, BoxConvert1, BoxConvert2> receiver_type;
+  typedef typename receiver_type::coord_type coord_type;
+  typedef typename receiver_type::result_type result_type;
+
+  box_scanner_stripe_task2 (coord_type enl, const BoxConvert1 &bc1, const BoxConvert2 &bc2, coord_type xmin, coord_type xmax, result_type *results)
+    : m_enl (enl), m_receiver (bc1, bc2, xmin, xmax, results), m_bc1 (bc1), m_bc2 (bc2)
+  {
+    //  .. nothing yet ..
+  }
+
+  box_scanner2<Obj1, Prop1, Obj2, Prop2> &scanner ()
+  {
+    return m_scanner;
+  }
+
+  void perform ()
+  {
+    m_scanner.process (m_receiver, m_enl, m_bc1, m_bc2);
+  }
+
+private:
+  box_scanner2<Obj1, Prop1, Obj2, Prop2> m_scanner;
+  coord_type m_enl;
+  receiver_type m_receiver;
+  BoxConvert1 m_bc1;
+  BoxConvert2 m_bc2;
 };
 
 /**
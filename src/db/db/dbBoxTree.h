@@ -133,6 +133,11 @@ public:
     return m_bbox;
   }
 
+  const tl::vector<box_type> &boxes () const
+  {
+    return m_boxes;
+  }
+
   void rotate_boxes (int q, const_iterator e, const_iterator o0, const_iterator o1, const_iterator o2, const_iterator o3, const_iterator o4) 
   {
     size_t qi [5] = {
@@ -651,6 +656,12 @@ public:
     return m_bpred (b, m_b);
   }
 
+  template <class PackedBoxes>
+  size_t find (const PackedBoxes &boxes, size_t from, size_t to) const
+  {
+    return boxes.find (m_b, m_bpred, from, to);
+  }
+
 private:
   Box m_b;
   BoxPred m_bpred;
@@ -1273,6 +1284,208 @@ inline void mem_stat (MemStatistics *stat, MemStatistics::purpose_t purpose, int
  *  operations.
  */
 
+/**
+ *  @brief A packed box vector for fast region queries
+ *
+ *  This object holds the boxes of the objects of a sorted box tree in
+ *  "structure of arrays" form: one contiguous array per coordinate. This way,
+ *  region queries do not need to compute the boxes of the objects and can
+ *  check a block of boxes with branch-free comparisons which the compiler can
+ *  turn into SIMD instructions.
+ *
+ *  Empty boxes are stored with left > right and bottom > top. The checks
+ *  include "left <= right", so they never match.
+ */
+template <class Box>
+class box_tree_packed_boxes
+{
+public:
+  typedef Box box_type;
+  typedef typename Box::coord_type coord_type;
+
+  /**
+   *  @brief The number of boxes checked in one block
+   */
+  enum { block_size = 8 };
+
+  box_tree_packed_boxes ()
+  {
+    //  .. nothing yet ..
+  }
+
+  /**
+   *  @brief Fills the arrays from the given box vector
+   */
+  template <class Iter>
+  void assign (Iter from, Iter to)
+  {
+    size_t n = std::distance (from, to);
+
+    clear ();
+    m_l.reserve (n);
+    m_b.reserve (n);
+    m_r.reserve (n);
+    m_t.reserve (n);
+
+    for (Iter i = from; i != to; ++i) {
+      if (i->empty ()) {
+        m_l.push_back (std::numeric_limits<coord_type>::max ());
+        m_b.push_back (std::numeric_limits<coord_type>::max ());
+        m_r.push_back (-std::numeric_limits<coord_type>::max ());
+        m_t.push_back (-std::numeric_limits<coord_type>::max ());
+      } else {
+        m_l.push_back (i->left ());
+        m_b.push_back (i->bottom ());
+        m_r.push_back (i->right ());
+        m_t.push_back (i->top ());
+      }
+    }
+  }
+
+  void clear ()
+  {
+    m_l.clear ();
+    m_b.clear ();
+    m_r.clear ();
+    m_t.clear ();
+  }
+
+  void swap (box_tree_packed_boxes<Box> &other)
+  {
+    m_l.swap (other.m_l);
+    m_b.swap (other.m_b);
+    m_r.swap (other.m_r);
+    m_t.swap (other.m_t);
+  }
+
+  bool empty () const
+  {
+    return m_l.empty ();
+  }
+
+  size_t size () const
+  {
+    return m_l.size ();
+  }
+
+  box_type box (size_t i) const
+  {
+    if (m_l [i] > m_r [i]) {
+      return box_type ();
+    } else {
+      return box_type (m_l [i], m_b [i], m_r [i], m_t [i]);
+    }
+  }
+
+  /**
+   *  @brief Finds the first box in [from,to) touching the search box
+   *  @return The index of the box found or "to" if there is no such box
+   */
+  size_t find (const box_type &sb, const db::boxes_touch<box_type> & /*pred*/, size_t from, size_t to) const
+  {
+    if (sb.empty ()) {
+      return to;
+    } else {
+      return do_find<true> (sb, from, to);
+    }
+  }
+
+  /**
+   *  @brief Finds the first box in [from,to) overlapping the search box
+   *  @return The index of the box found or "to" if there is no such box
+   */
+  size_t find (const box_type &sb, const db::boxes_overlap<box_type> & /*pred*/, size_t from, size_t to) const
+  {
+    if (sb.empty ()) {
+      return to;
+    } else {
+      return do_find<false> (sb, from, to);
+    }
+  }
+
+  /**
+   *  @brief Finds the first box in [from,to) with a generic predicate
+   *  @return The index of the box found or "to" if there is no such box
+   */
+  template <class Pred>
+  size_t find (const box_type &sb, const Pred &pred, size_t from, size_t to) const
+  {
+    while (from < to && ! pred (box (from), sb)) {
+      ++from;
+    }
+    return from;
+  }
+
+  void mem_stat (MemStatistics *stat, MemStatistics::purpose_t purpose, int cat, bool no_self, void *parent) const
+  {
+    if (! no_self) {
+      stat->add (typeid (*this), (void *) this, sizeof (*this), sizeof (*this), parent, purpose, cat);
+    }
+    db::mem_stat (stat, purpose, cat, m_l, true, (void *) this);
+    db::mem_stat (stat, purpose, cat, m_b, true, (void *) this);
+    db::mem_stat (stat, purpose, cat, m_r, true, (void *) this);
+    db::mem_stat (stat, purpose, cat, m_t, true, (void *) this);
+  }
+
+private:
+  std::vector<coord_type> m_l, m_b, m_r, m_t;
+
+  template <bool Touching>
+  static bool matches (coord_type l, coord_type b, coord_type r, coord_type t, const box_type &sb)
+  {
+    if (Touching) {
+      return (l <= sb.right ()) & (sb.left () <= r) & (b <= sb.top ()) & (sb.bottom () <= t) & (l <= r);
+    } else {
+      return (l < sb.right ()) & (sb.left () < r) & (b < sb.top ()) & (sb.bottom () < t) & (l <= r);
+    }
+  }
+
+  template <bool Touching>
+  size_t do_find (const box_type &sb, size_t from, size_t to) const
+  {
+    const coord_type *l = &m_l.front ();
+    const coord_type *b = &m_b.front ();
+    const coord_type *r = &m_r.front ();
+    const coord_type *t = &m_t.front ();
+
+    //  in dense regions, the next element frequently matches already
+    if (from < to && matches<Touching> (l [from], b [from], r [from], t [from], sb)) {
+      return from;
+    }
+
+    //  check full blocks without branches then
+    while (from + block_size <= to) {
+      unsigned int mask = 0;
+      for (unsigned int i = 0; i < block_size; ++i) {
+        mask |= (unsigned int) matches<Touching> (l [from + i], b [from + i], r [from + i], t [from + i], sb) << i;
+      }
+      if (mask != 0) {
+        while ((mask & 1) == 0) {
+          mask >>= 1;
+          ++from;
+        }
+        return from;
+      }
+      from += block_size;
+    }
+
+    //  and the remaining elements one by one
+    while (from < to && ! matches<Touching> (l [from], b [from], r [from], t [from], sb)) {
+      ++from;
+    }
+    return from;
+  }
+};
+
+/**
+ *  @brief Collect memory statistics
+ */
+template <class Box>
+inline void mem_stat (MemStatistics *stat, MemStatistics::purpose_t purpose, int cat, const box_tree_packed_boxes<Box> &x, bool no_self = false, void *parent = 0)
+{
+  x.mem_stat (stat, purpose, cat, no_self, parent);
+}
+
 template <class Tree>
 class unstable_box_tree_flat_it
 {
@@ -1381,22 +1594,13 @@ public:
         down ();
       }
     }
-    while (! at_end ()) {
-      if (check ()) {
-        break;
-      }
-      inc ();
-    }
+    seek ();
   }
 
   unstable_box_tree_it<Tree, Cmp> &operator++ () 
   {
-    while (true) {
-      inc ();
-      if (at_end () || check ()) {
-        break;
-      }
-    }
+    inc ();
+    seek ();
     return *this;
   }
 
@@ -1518,6 +1722,36 @@ private:
     bool ret = m_compare.matches_obj (mp_tree->objects () [m_index + m_offset]);
     return ret;
   }
+
+  //  moves forward to the next element within the search range, starting with the current one
+  void seek ()
+  {
+    const typename Tree::packed_boxes_type *boxes = mp_tree->packed_boxes ();
+
+    while (! at_end ()) {
+
+      if (boxes) {
+
+        //  scan the current bin with the packed boxes
+        size_t from = m_index + m_offset;
+        size_t to = mp_node ? m_index + mp_node->lenq (m_quad) : mp_tree->objects ().size ();
+        size_t f = m_compare.find (*boxes, from, to);
+        if (f < to) {
+          m_offset = f - m_index;
+          return;
+        }
+
+        //  continue with the next bin
+        m_offset = to - m_index - 1;
+
+      } else if (check ()) {
+        return;
+      }
+
+      inc ();
+
+    }
+  }
   
   //  check if the current quad needs visit
   bool need_visit () const
@@ -1660,6 +1894,7 @@ public:
   typedef unstable_box_tree_it<box_tree_type, box_tree_sel_touch_type> touching_iterator;
   typedef unstable_box_tree_it<box_tree_type, box_tree_sel_overlap_type> overlapping_iterator;
   typedef box_tree_picker<box_type, object_type, box_conv_type, obj_vector_type> box_tree_picker_type;
+  typedef box_tree_packed_boxes<box_type> packed_boxes_type;
 
   /**
    *  @brief Creates a empty box tree object 
@@ -1674,7 +1909,7 @@ public:
    *  @brief Copy constructor
    */
   unstable_box_tree (const unstable_box_tree &b)
-    : m_objects (b.m_objects), mp_root (b.mp_root ? b.mp_root->clone () : 0)
+    : m_objects (b.m_objects), m_packed_boxes (b.m_packed_boxes), mp_root (b.mp_root ? b.mp_root->clone () : 0)
   {
     // .. nothing else ..
   }
@@ -1686,6 +1921,7 @@ public:
   {
     clear ();
     m_objects = b.m_objects;
+    m_packed_boxes = b.m_packed_boxes;
     if (b.mp_root) {
       mp_root = b.mp_root->clone ();
     }
@@ -1714,6 +1950,7 @@ public:
    */
   iterator insert (const Obj &o)
   {
+    m_packed_boxes.clear ();
     m_objects.push_back (o);
     return m_objects.end () - 1;
   }
@@ -1731,6 +1968,7 @@ public:
    */
   void resize (size_t n)
   {
+    m_packed_boxes.clear ();
     m_objects.resize (n);
   }
 
@@ -1743,6 +1981,7 @@ public:
   template <class I> 
   void insert (I from, I to)
   {
+    m_packed_boxes.clear ();
     m_objects.insert (m_objects.end (), from, to);
   }
 
@@ -1758,6 +1997,7 @@ public:
    */
   void replace (const_iterator pos, const Obj &obj)
   {
+    m_packed_boxes.clear ();
     m_objects [std::distance (((const box_tree_type *) this)->begin (), pos)] = obj;
   }
 
@@ -1772,6 +2012,7 @@ public:
    */
   void erase (iterator pos)
   {
+    m_packed_boxes.clear ();
     m_objects.erase (pos);
   }
 
@@ -1800,6 +2041,7 @@ public:
 
     tl_assert (pp == pos.end ()); //  not sorted or not inside the element list.
 
+    m_packed_boxes.clear ();
     m_objects.swap (objects);
   }
 
@@ -1814,6 +2056,7 @@ public:
    */
   void erase (iterator from, iterator to)
   {
+    m_packed_boxes.clear ();
     m_objects.erase (from, to);
   }
 
@@ -1831,6 +2074,7 @@ public:
   template <class I>
   void erase_positions (I first, I last)
   {
+    m_packed_boxes.clear ();
     iterator t = begin ();
     for (iterator i = begin (); i != end (); ++i) {
       if (first == last || i != *first) {
@@ -1853,6 +2097,8 @@ public:
    */
   iterator iterator_from_pointer (object_type *p) 
   {
+    //  the object may be modified through the iterator
+    m_packed_boxes.clear ();
     return m_objects.begin () + (p - &m_objects.front ());
   }
   
@@ -1888,6 +2134,7 @@ public:
   void clear ()
   {
     m_objects.clear ();
+    m_packed_boxes.clear ();
     if (mp_root) {
       delete mp_root;
     }
@@ -1958,6 +2205,8 @@ public:
    */
   iterator begin () 
   {
+    //  the objects may be modified through the iterator
+    m_packed_boxes.clear ();
     return m_objects.begin ();
   }
 
@@ -1971,6 +2220,7 @@ public:
    */
   iterator end () 
   {
+    m_packed_boxes.clear ();
     return m_objects.end ();
   }
   
@@ -2036,6 +2286,21 @@ public:
     return mp_root;
   }
 
+  /**
+   *  @brief Access to the packed boxes
+   *
+   *  Packed boxes are only available for sorted trees with "complex" box converters
+   *  which have been split into quads. For the other trees, this method returns 0.
+   *  Every method which modifies the objects or gives non-const access to them
+   *  discards the packed boxes, so the queries fall back to the box converter until
+   *  the tree is sorted again.
+   *  This is mainly used by the iterator implementation
+   */
+  const packed_boxes_type *packed_boxes () const
+  {
+    return m_packed_boxes.empty () ? 0 : &m_packed_boxes;
+  }
+
   /**
    *  @brief Collect memory statistics
    */
@@ -2045,16 +2310,21 @@ public:
       stat->add (typeid (*this), (void *) this, sizeof (*this), sizeof (*this), parent, purpose, cat);
     }
     db::mem_stat (stat, purpose, cat, m_objects, true, (void *) this);
+    db::mem_stat (stat, purpose, cat, m_packed_boxes, true, (void *) this);
   }
 
 private:
   /// The basic object and element vector
   obj_vector_type m_objects;
+  /// The boxes of the objects in sorted order (for complex box converters only)
+  packed_boxes_type m_packed_boxes;
   box_tree_node *mp_root;
 
   /// Sort implementation for simple bboxes - no caching
   void sort (const BoxConv &conv, const db::simple_bbox_tag &/*complexity*/)
   {
+    m_packed_boxes.clear ();
+
     if (m_objects.empty ()) {
       return;
     }
@@ -2080,6 +2350,8 @@ private:
   /// Sort implementation for complex bboxes - with caching
   void sort (const box_conv_type &conv, const db::complex_bbox_tag &/*complexity*/)
   {
+    m_packed_boxes.clear ();
+
     if (m_objects.empty ()) {
       return;
     }
@@ -2092,6 +2364,13 @@ private:
     mp_root = 0;
 
     tree_sort (0, m_objects.begin (), m_objects.end (), picker, picker.bbox (), 0);
+
+    //  the picker's boxes have been rotated along with the objects, so they are in
+    //  sorted order now: keep them for the queries. Small trees are not split into
+    //  quads and are scanned linearly - they don't need the extra memory.
+    if (mp_root) {
+      m_packed_boxes.assign (picker.boxes ().begin (), picker.boxes ().end ());
+    }
   }
 
   template <class CoordPicker>
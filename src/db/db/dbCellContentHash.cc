@@ -0,0 +1,596 @@
+
+/*
+
+  KLayout Layout Viewer
+  Copyright (C) 2006-2019 Matthias Koefferlein
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+
+
+#include "dbCellContentHash.h"
+#include "tlThreadedWorkers.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace db
+{
+
+// -------------------------------------------------------------------------------------------
+//  CellContentHash implementation
+
+std::string
+CellContentHash::to_string () const
+{
+  static const char *digits = "0123456789abcdef";
+
+  std::string s;
+  s.reserve (32);
+  for (int i = 60; i >= 0; i -= 4) {
+    s += digits [(h1 >> i) & 0xf];
+  }
+  for (int i = 60; i >= 0; i -= 4) {
+    s += digits [(h2 >> i) & 0xf];
+  }
+  return s;
+}
+
+// -------------------------------------------------------------------------------------------
+//  A 128 bit hash stream (based on the MurmurHash3 mixing steps)
+
+namespace
+{
+
+inline uint64_t rotl64 (uint64_t x, int r)
+{
+  return (x << r) | (x >> (64 - r));
+}
+
+inline uint64_t fmix64 (uint64_t k)
+{
+  k ^= k >> 33;
+  k *= 0xff51afd7ed558ccdULL;
+  k ^= k >> 33;
+  k *= 0xc4ceb9fe1a85ec53ULL;
+  k ^= k >> 33;
+  return k;
+}
+
+class HashStream
+{
+public:
+  HashStream ()
+    : m_h1 (0x9e3779b97f4a7c15ULL), m_h2 (0x6a09e667f3bcc909ULL), m_n (0)
+  {
+    //  .. nothing yet ..
+  }
+
+  void add (uint64_t v)
+  {
+    const uint64_t c1 = 0x87c37b91114253d5ULL;
+    const uint64_t c2 = 0x4cf5ad432745937fULL;
+
+    uint64_t k1 = rotl64 (v * c1, 31) * c2;
+    m_h1 ^= k1;
+    m_h1 = rotl64 (m_h1, 27) + m_h2;
+    m_h1 = m_h1 * 5 + 0x52dce729;
+
+    uint64_t k2 = rotl64 (v * c2, 33) * c1;
+    m_h2 ^= k2;
+    m_h2 = rotl64 (m_h2, 31) + m_h1;
+    m_h2 = m_h2 * 5 + 0x38495ab5;
+
+    ++m_n;
+  }
+
+  void add_int (int64_t v)
+  {
+    add (uint64_t (v));
+  }
+
+  void add_double (double d)
+  {
+    //  rounding makes the hash insensitive to floating-point noise
+    add_int (int64_t (floor (0.5 + d * 1e9)));
+  }
+
+  void add_string (const char *s)
+  {
+    size_t n = strlen (s);
+    add (uint64_t (n));
+    while (n > 0) {
+      uint64_t w = 0;
+      for (unsigned int i = 0; i < 8 && n > 0; ++i, --n) {
+        w |= uint64_t ((unsigned char) *s++) << (i * 8);
+      }
+      add (w);
+    }
+  }
+
+  void add_hash (const CellContentHash &h)
+  {
+    add (h.h1);
+    add (h.h2);
+  }
+
+  template <class P>
+  void add_point (const P &p)
+  {
+    add_int (p.x ());
+    add_int (p.y ());
+  }
+
+  CellContentHash result () const
+  {
+    uint64_t h1 = m_h1 ^ m_n;
+    uint64_t h2 = m_h2 ^ m_n;
+    h1 += h2;
+    h2 += h1;
+    h1 = fmix64 (h1);
+    h2 = fmix64 (h2);
+    h1 += h2;
+    h2 += h1;
+    return CellContentHash (h1, h2);
+  }
+
+private:
+  uint64_t m_h1, m_h2, m_n;
+};
+
+/**
+ *  @brief Accumulates a hash into a sum
+ *
+ *  Sums are used to form hashes which do not depend on the order of the elements.
+ */
+inline void accumulate (CellContentHash &sum, const CellContentHash &h)
+{
+  sum.h1 += h.h1;
+  sum.h2 += h.h2;
+}
+
+}
+
+static CellContentHash
+properties_hash (const db::Layout &layout, db::properties_id_type prop_id)
+{
+  CellContentHash sum;
+
+  const db::PropertiesRepository &rep = layout.properties_repository ();
+  const db::PropertiesRepository::properties_set &props = rep.properties (prop_id);
+  for (db::PropertiesRepository::properties_set::const_iterator p = props.begin (); p != props.end (); ++p) {
+    HashStream hs;
+    hs.add_string (rep.prop_name (p->first).to_string ());
+    hs.add_string (p->second.to_string ());
+    accumulate (sum, hs.result ());
+  }
+
+  return sum;
+}
+
+static void
+add_contour (HashStream &hs, const db::Polygon::contour_type &ctr)
+{
+  hs.add (uint64_t (ctr.size ()));
+  for (size_t i = 0; i < ctr.size (); ++i) {
+    hs.add_point (ctr [i]);
+  }
+}
+
+static CellContentHash
+shape_hash (const db::Layout &layout, const db::Shape &shape)
+{
+  HashStream hs;
+
+  if (shape.is_box ()) {
+
+    db::Box b = shape.box ();
+    hs.add (1);
+    hs.add_point (b.p1 ());
+    hs.add_point (b.p2 ());
+
+  } else if (shape.is_polygon ()) {
+
+    db::Polygon p;
+    shape.polygon (p);
+    hs.add (2);
+    add_contour (hs, p.hull ());
+    hs.add (uint64_t (p.holes ()));
+    for (unsigned int h = 0; h < p.holes (); ++h) {
+      add_contour (hs, p.hole (h));
+    }
+
+  } else if (shape.is_path ()) {
+
+    db::Path p;
+    shape.path (p);
+    hs.add (3);
+    hs.add_int (p.width ());
+    hs.add_int (p.bgn_ext ());
+    hs.add_int (p.end_ext ());
+    hs.add (p.round () ? 1 : 0);
+    hs.add (uint64_t (p.points ()));
+    for (db::Path::iterator pt = p.begin (); pt != p.end (); ++pt) {
+      hs.add_point (*pt);
+    }
+
+  } else if (shape.is_text ()) {
+
+    db::Text t;
+    shape.text (t);
+    hs.add (4);
+    hs.add_string (t.string ());
+    hs.add_int (t.trans ().rot ());
+    hs.add_point (t.trans ().disp ());
+    hs.add_int (t.size ());
+    hs.add_int (int (t.font ()));
+    hs.add_int (int (t.halign ()));
+    hs.add_int (int (t.valign ()));
+
+  } else if (shape.is_edge ()) {
+
+    db::Edge e = shape.edge ();
+    hs.add (5);
+    hs.add_point (e.p1 ());
+    hs.add_point (e.p2 ());
+
+  } else if (shape.is_edge_pair ()) {
+
+    db::EdgePair ep = shape.edge_pair ();
+    hs.add (6);
+    hs.add_point (ep.first ().p1 ());
+    hs.add_point (ep.first ().p2 ());
+    hs.add_point (ep.second ().p1 ());
+    hs.add_point (ep.second ().p2 ());
+
+  } else {
+
+    //  user objects are not hashed by content
+    hs.add (0);
+
+  }
+
+  if (shape.has_prop_id ()) {
+    hs.add_hash (properties_hash (layout, shape.prop_id ()));
+  }
+
+  return hs.result ();
+}
+
+// -------------------------------------------------------------------------------------------
+//  CellContentHasher implementation
+
+class CellContentHashTask
+  : public tl::Task
+{
+public:
+  CellContentHashTask (CellContentHasher *hasher, db::cell_index_type ci)
+    : tl::Task (), mp_hasher (hasher), m_ci (ci)
+  {
+    //  .. nothing yet ..
+  }
+
+  CellContentHasher *hasher () const
+  {
+    return mp_hasher;
+  }
+
+  db::cell_index_type cell_index () const
+  {
+    return m_ci;
+  }
+
+private:
+  CellContentHasher *mp_hasher;
+  db::cell_index_type m_ci;
+};
+
+class CellContentHashWorker
+  : public tl::Worker
+{
+public:
+  CellContentHashWorker ()
+    : tl::Worker ()
+  {
+    //  .. nothing yet ..
+  }
+
+  void perform_task (tl::Task *task)
+  {
+    CellContentHashTask *hash_task = static_cast<CellContentHashTask *> (task);
+    hash_task->hasher ()->compute_hash (hash_task->cell_index ());
+  }
+};
+
+CellContentHasher::CellContentHasher (const db::Layout &layout)
+  : mp_layout (&layout), m_all_invalid (false), m_with_cell_names (false), m_nthreads (0)
+{
+  //  .. nothing yet ..
+}
+
+void
+CellContentHasher::set_with_cell_names (bool f)
+{
+  if (f != m_with_cell_names) {
+    m_with_cell_names = f;
+    invalidate_all ();
+  }
+}
+
+const CellContentHash &
+CellContentHasher::hash (db::cell_index_type ci)
+{
+  std::map<db::cell_index_type, CellContentHash>::const_iterator h = m_hashes.find (ci);
+  if (h == m_hashes.end () || m_all_invalid || ! m_invalid.empty ()) {
+    update ();
+    h = m_hashes.find (ci);
+    tl_assert (h != m_hashes.end ());
+  }
+
+  return h->second;
+}
+
+void
+CellContentHasher::invalidate (db::cell_index_type ci)
+{
+  m_invalid.insert (ci);
+}
+
+void
+CellContentHasher::invalidate_all ()
+{
+  m_all_invalid = true;
+}
+
+void
+CellContentHasher::update ()
+{
+  const db::Layout &layout = *mp_layout;
+  layout.update ();
+
+  if (m_all_invalid) {
+    m_hashes.clear ();
+    m_all_invalid = false;
+  }
+
+  //  drop the hashes of cells which have been deleted
+
+  for (std::map<db::cell_index_type, CellContentHash>::iterator h = m_hashes.begin (); h != m_hashes.end (); ) {
+    std::map<db::cell_index_type, CellContentHash>::iterator h_next = h;
+    ++h_next;
+    if (! layout.is_valid_cell_index (h->first)) {
+      m_hashes.erase (h);
+    }
+    h = h_next;
+  }
+
+  //  collect the cells to compute: invalidated cells, cells without a hash and their parents
+
+  std::set<db::cell_index_type> todo;
+  std::vector<db::cell_index_type> seeds;
+
+  for (std::set<db::cell_index_type>::const_iterator c = m_invalid.begin (); c != m_invalid.end (); ++c) {
+    if (layout.is_valid_cell_index (*c)) {
+      seeds.push_back (*c);
+    }
+  }
+  m_invalid.clear ();
+
+  for (db::Layout::const_iterator c = layout.begin (); c != layout.end (); ++c) {
+    if (m_hashes.find (c->cell_index ()) == m_hashes.end ()) {
+      seeds.push_back (c->cell_index ());
+    }
+  }
+
+  while (! seeds.empty ()) {
+    db::cell_index_type ci = seeds.back ();
+    seeds.pop_back ();
+    if (todo.insert (ci).second) {
+      const db::Cell &cell = layout.cell (ci);
+      for (db::Cell::parent_cell_iterator pc = cell.begin_parent_cells (); pc != cell.end_parent_cells (); ++pc) {
+        seeds.push_back (*pc);
+      }
+    }
+  }
+
+  if (todo.empty ()) {
+    return;
+  }
+
+  //  Sort the cells into levels bottom-up: a cell's level is one more than the largest level of the
+  //  child cells to compute. The cells of one level are independent and can be computed in parallel.
+  //  NOTE: the hash entries are created beforehand, so m_hashes is not modified structurally while
+  //  the cells are computed.
+
+  std::map<db::cell_index_type, unsigned int> levels;
+  std::vector<std::vector<db::cell_index_type> > cells_per_level;
+
+  for (db::Layout::bottom_up_const_iterator c = layout.begin_bottom_up (); c != layout.end_bottom_up (); ++c) {
+
+    if (todo.find (*c) == todo.end ()) {
+      continue;
+    }
+
+    unsigned int level = 0;
+    for (db::Cell::child_cell_iterator cc = layout.cell (*c).begin_child_cells (); ! cc.at_end (); ++cc) {
+      std::map<db::cell_index_type, unsigned int>::const_iterator l = levels.find (*cc);
+      if (l != levels.end ()) {
+        level = std::max (level, l->second + 1);
+      }
+    }
+
+    levels.insert (std::make_pair (*c, level));
+    if (cells_per_level.size () <= size_t (level)) {
+      cells_per_level.resize (level + 1);
+    }
+    cells_per_level [level].push_back (*c);
+
+    m_hashes [*c] = CellContentHash ();
+
+  }
+
+  if (m_nthreads == 0) {
+
+    for (std::vector<std::vector<db::cell_index_type> >::const_iterator l = cells_per_level.begin (); l != cells_per_level.end (); ++l) {
+      for (std::vector<db::cell_index_type>::const_iterator c = l->begin (); c != l->end (); ++c) {
+        compute_hash (*c);
+      }
+    }
+
+  } else {
+
+    tl::Job<CellContentHashWorker> job (m_nthreads);
+
+    for (std::vector<std::vector<db::cell_index_type> >::const_iterator l = cells_per_level.begin (); l != cells_per_level.end (); ++l) {
+
+      for (std::vector<db::cell_index_type>::const_iterator c = l->begin (); c != l->end (); ++c) {
+        job.schedule (new CellContentHashTask (this, *c));
+      }
+
+      job.start ();
+      job.wait ();
+
+      if (job.has_error ()) {
+        m_all_invalid = true;
+        throw tl::Exception (tl::to_string (tr ("Errors occurred during computing the cell hashes. First error message says:\n")) + job.error_messages ().front ());
+      }
+
+    }
+
+  }
+}
+
+std::vector<std::vector<db::cell_index_type> >
+CellContentHasher::identical_cells ()
+{
+  update ();
+
+  std::map<CellContentHash, std::vector<db::cell_index_type> > cells_by_hash;
+  for (std::map<db::cell_index_type, CellContentHash>::const_iterator h = m_hashes.begin (); h != m_hashes.end (); ++h) {
+    cells_by_hash [h->second].push_back (h->first);
+  }
+
+  std::vector<std::vector<db::cell_index_type> > result;
+  for (std::map<CellContentHash, std::vector<db::cell_index_type> >::iterator c = cells_by_hash.begin (); c != cells_by_hash.end (); ++c) {
+    if (c->second.size () > 1) {
+      result.push_back (std::vector<db::cell_index_type> ());
+      result.back ().swap (c->second);
+    }
+  }
+
+  std::sort (result.begin (), result.end ());
+  return result;
+}
+
+CellContentHash
+CellContentHasher::child_hash (db::cell_index_type ci) const
+{
+  std::map<db::cell_index_type, CellContentHash>::const_iterator h = m_hashes.find (ci);
+  tl_assert (h != m_hashes.end ());
+  return h->second;
+}
+
+void
+CellContentHasher::compute_hash (db::cell_index_type ci)
+{
+  const db::Layout &layout = *mp_layout;
+  const db::Cell &cell = layout.cell (ci);
+
+  //  the shapes: per layer, the layer is identified by its properties
+
+  CellContentHash layers_sum;
+
+  for (db::Layout::layer_iterator l = layout.begin_layers (); l != layout.end_layers (); ++l) {
+
+    const db::Shapes &shapes = cell.shapes ((*l).first);
+    if (shapes.empty ()) {
+      continue;
+    }
+
+    CellContentHash shapes_sum;
+    size_t n = 0;
+    for (db::ShapeIterator s = shapes.begin (db::ShapeIterator::All); ! s.at_end (); ++s, ++n) {
+      accumulate (shapes_sum, shape_hash (layout, *s));
+    }
+
+    const db::LayerProperties &lp = *(*l).second;
+    HashStream hs;
+    hs.add_int (lp.layer);
+    hs.add_int (lp.datatype);
+    hs.add_string (lp.name.c_str ());
+    hs.add (uint64_t (n));
+    hs.add_hash (shapes_sum);
+    accumulate (layers_sum, hs.result ());
+
+  }
+
+  //  the child instances
+
+  CellContentHash insts_sum;
+
+  for (db::Cell::const_iterator i = cell.begin (); ! i.at_end (); ++i) {
+
+    const db::CellInstArray &inst = i->cell_inst ();
+
+    HashStream hs;
+    hs.add_hash (child_hash (inst.object ().cell_index ()));
+
+    db::ICplxTrans t = inst.complex_trans ();
+    hs.add_point (t.disp ());
+    hs.add_double (t.angle ());
+    hs.add_double (t.mag ());
+    hs.add (t.is_mirror () ? 1 : 0);
+
+    db::Vector a, b;
+    unsigned long na = 1, nb = 1;
+    if (inst.is_regular_array (a, b, na, nb)) {
+      hs.add (1);
+      hs.add_point (a);
+      hs.add_point (b);
+      hs.add (uint64_t (na));
+      hs.add (uint64_t (nb));
+    } else if (inst.size () > 1) {
+      hs.add (2);
+      hs.add (uint64_t (inst.size ()));
+      for (db::CellInstArray::iterator ia = inst.begin (); ! ia.at_end (); ++ia) {
+        hs.add_point ((*ia).disp ());
+      }
+    }
+
+    if (i->has_prop_id ()) {
+      hs.add_hash (properties_hash (layout, i->prop_id ()));
+    }
+
+    accumulate (insts_sum, hs.result ());
+
+  }
+
+  HashStream hs;
+  hs.add_hash (layers_sum);
+  hs.add_hash (insts_sum);
+  if (m_with_cell_names) {
+    hs.add_string (layout.cell_name (ci));
+  }
+
+  //  NOTE: the entry has been created by "update", so m_hashes is not modified structurally here
+  std::map<db::cell_index_type, CellContentHash>::iterator h = m_hashes.find (ci);
+  tl_assert (h != m_hashes.end ());
+  h->second = hs.result ();
+}
+
+}
+
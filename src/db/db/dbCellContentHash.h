@@ -0,0 +1,213 @@
+
+/*
+
+  KLayout Layout Viewer
+  Copyright (C) 2006-2019 Matthias Koefferlein
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+
+
+#ifndef HDR_dbCellContentHash
+#define HDR_dbCellContentHash
+
+#include "dbCommon.h"
+#include "dbLayout.h"
+
+#include <map>
+#include <set>
+#include <vector>
+#include <string>
+#include <stdint.h>
+
+namespace db
+{
+
+/**
+ *  @brief A 128 bit content hash value for a cell
+ *
+ *  The hash value is stable: it does not depend on the platform, the layer or cell indexes
+ *  or the order in which shapes and instances have been created. Hence it can be compared
+ *  across layouts and sessions.
+ */
+struct DB_PUBLIC CellContentHash
+{
+  /**
+   *  @brief Creates a null hash
+   */
+  CellContentHash ()
+    : h1 (0), h2 (0)
+  {
+    //  .. nothing yet ..
+  }
+
+  /**
+   *  @brief Creates a hash from the two 64 bit words
+   */
+  CellContentHash (uint64_t _h1, uint64_t _h2)
+    : h1 (_h1), h2 (_h2)
+  {
+    //  .. nothing yet ..
+  }
+
+  bool operator== (const CellContentHash &other) const
+  {
+    return h1 == other.h1 && h2 == other.h2;
+  }
+
+  bool operator!= (const CellContentHash &other) const
+  {
+    return ! operator== (other);
+  }
+
+  bool operator< (const CellContentHash &other) const
+  {
+    if (h1 != other.h1) {
+      return h1 < other.h1;
+    }
+    return h2 < other.h2;
+  }
+
+  /**
+   *  @brief Returns the hash as a string of 32 hex digits
+   */
+  std::string to_string () const;
+
+  uint64_t h1, h2;
+};
+
+/**
+ *  @brief A content hash generator for the cells of a layout
+ *
+ *  This object computes a content hash for each cell. The hash is formed from the shapes
+ *  per layer (the layer is identified by its layer properties) and the child cell instances
+ *  (through the content hash of the child cell, the instance transformation, the array
+ *  definition and the properties). The cell name is not part of the hash, hence two cells
+ *  with identical content but different names will have the same hash.
+ *
+ *  Shapes are hashed by their geometry, so shape references and plain shapes are equivalent.
+ *  Arrays are hashed by their definition, so an array is not equivalent to single
+ *  instances forming the same placements.
+ *
+ *  The hashes are computed bottom-up. Cells on the same hierarchy level can be computed in
+ *  parallel (see "set_threads").
+ *
+ *  The hashes are cached. After the layout has been modified, "invalidate" needs to be called
+ *  for the modified cells. The next access will recompute the hashes of these cells and their
+ *  parents only.
+ *
+ *  The layout must not be modified while the hashes are computed. The hasher keeps a
+ *  reference to the layout, so the layout must exist as long as the hasher is used.
+ */
+class DB_PUBLIC CellContentHasher
+{
+public:
+  /**
+   *  @brief Creates a hasher for the given layout
+   */
+  CellContentHasher (const db::Layout &layout);
+
+  /**
+   *  @brief Sets the number of threads to use
+   *
+   *  A value of 0 (the default) will compute the hashes in the calling thread.
+   */
+  void set_threads (unsigned int nthreads)
+  {
+    m_nthreads = nthreads;
+  }
+
+  /**
+   *  @brief Gets the number of threads to use
+   */
+  unsigned int threads () const
+  {
+    return m_nthreads;
+  }
+
+  /**
+   *  @brief Specifies whether the cell names are included in the hash
+   *
+   *  By default, the cell names are not part of the hash. If they are included, two cells
+   *  will only have the same hash if their names are identical and their children have the
+   *  same names too.
+   */
+  void set_with_cell_names (bool f);
+
+  /**
+   *  @brief Gets a value indicating whether the cell names are included in the hash
+   */
+  bool with_cell_names () const
+  {
+    return m_with_cell_names;
+  }
+
+  /**
+   *  @brief Gets the content hash for the given cell
+   *
+   *  If required, the hashes are updated before.
+   */
+  const CellContentHash &hash (db::cell_index_type ci);
+
+  /**
+   *  @brief Marks the given cell as modified
+   *
+   *  The hash of this cell and the hashes of all cells calling it directly or indirectly
+   *  will be recomputed on the next update.
+   */
+  void invalidate (db::cell_index_type ci);
+
+  /**
+   *  @brief Drops all hashes
+   *
+   *  All hashes will be recomputed on the next update.
+   */
+  void invalidate_all ();
+
+  /**
+   *  @brief Computes the hashes for all cells which don't have a valid hash
+   *
+   *  Usually there is no need to call this method explicitly as it is called on demand.
+   */
+  void update ();
+
+  /**
+   *  @brief Groups the cells of the layout by content
+   *
+   *  The result is a list of groups of cells with identical content hashes. Only groups
+   *  with more than one cell are returned. The cells within a group are sorted by cell index
+   *  and the groups are sorted by their first cell.
+   */
+  std::vector<std::vector<db::cell_index_type> > identical_cells ();
+
+private:
+  friend class CellContentHashWorker;
+
+  const db::Layout *mp_layout;
+  std::map<db::cell_index_type, CellContentHash> m_hashes;
+  std::set<db::cell_index_type> m_invalid;
+  bool m_all_invalid;
+  bool m_with_cell_names;
+  unsigned int m_nthreads;
+
+  void compute_hash (db::cell_index_type ci);
+  CellContentHash child_hash (db::cell_index_type ci) const;
+};
+
+}
+
+#endif
+
@@ -23,22 +23,119 @@
 
 #include "dbCellVariants.h"
 #include "tlUtils.h"
+#include "tlThreadedWorkers.h"
+#include "tlThreads.h"
+
+#include <algorithm>
 
 namespace db
 {
 
 VariantsCollectorBase::VariantsCollectorBase ()
-  : mp_red ()
+  : mp_red (), m_nthreads (0)
 {
   //  .. nothing yet ..
 }
 
 VariantsCollectorBase::VariantsCollectorBase (const TransformationReducer *red)
-  : mp_red (red)
+  : mp_red (red), m_nthreads (0)
 {
   //  .. nothing yet ..
 }
 
+/**
+ *  @brief A task computing the variants or committing the shapes for a single cell
+ *
+ *  If "to_commit" is null, the task computes the variants. Otherwise it commits the shapes.
+ */
+class VariantsCollectorTask
+  : public tl::Task
+{
+public:
+  VariantsCollectorTask (VariantsCollectorBase *collector, db::Layout *layout, db::cell_index_type ci, unsigned int layer, std::map<db::cell_index_type, std::map<db::ICplxTrans, db::Shapes> > *to_commit)
+    : tl::Task (), mp_collector (collector), mp_layout (layout), m_ci (ci), m_layer (layer), mp_to_commit (to_commit)
+  {
+    //  .. nothing yet ..
+  }
+
+  VariantsCollectorBase *collector () const { return mp_collector; }
+  db::Layout *layout () const { return mp_layout; }
+  db::cell_index_type cell_index () const { return m_ci; }
+  unsigned int layer () const { return m_layer; }
+  std::map<db::cell_index_type, std::map<db::ICplxTrans, db::Shapes> > *to_commit () const { return mp_to_commit; }
+
+private:
+  VariantsCollectorBase *mp_collector;
+  db::Layout *mp_layout;
+  db::cell_index_type m_ci;
+  unsigned int m_layer;
+  std::map<db::cell_index_type, std::map<db::ICplxTrans, db::Shapes> > *mp_to_commit;
+};
+
+class VariantsCollectorWorker
+  : public tl::Worker
+{
+public:
+  VariantsCollectorWorker ()
+    : tl::Worker ()
+  {
+    //  .. nothing yet ..
+  }
+
+  void perform_task (tl::Task *task)
+  {
+    perform (*static_cast<VariantsCollectorTask *> (task));
+  }
+
+  static void perform (const VariantsCollectorTask &task)
+  {
+    if (! task.to_commit ()) {
+      task.collector ()->collect_for_cell (*task.layout (), task.cell_index ());
+    } else {
+      task.collector ()->commit_shapes_for_cell (*task.layout (), task.cell_index (), task.layer (), *task.to_commit ());
+    }
+  }
+};
+
+/**
+ *  @brief Runs the tasks for the given cells level by level
+ *
+ *  All cells of one level are independent of each other and are processed concurrently
+ *  if nthreads is not 0. The levels are processed one after another.
+ */
+static void
+run_per_level (unsigned int nthreads, const std::vector<std::vector<db::cell_index_type> > &cells_per_level, VariantsCollectorBase *collector, db::Layout *layout, unsigned int layer, std::map<db::cell_index_type, std::map<db::ICplxTrans, db::Shapes> > *to_commit)
+{
+  if (nthreads == 0) {
+
+    for (std::vector<std::vector<db::cell_index_type> >::const_iterator l = cells_per_level.begin (); l != cells_per_level.end (); ++l) {
+      for (std::vector<db::cell_index_type>::const_iterator c = l->begin (); c != l->end (); ++c) {
+        VariantsCollectorWorker::perform (VariantsCollectorTask (collector, layout, *c, layer, to_commit));
+      }
+    }
+
+  } else {
+
+    tl::Job<VariantsCollectorWorker> job (nthreads);
+
+    for (std::vector<std::vector<db::cell_index_type> >::const_iterator l = cells_per_level.begin (); l != cells_per_level.end (); ++l) {
+
+      for (std::vector<db::cell_index_type>::const_iterator c = l->begin (); c != l->end (); ++c) {
+        job.schedule (new VariantsCollectorTask (collector, layout, *c, layer, to_commit));
+      }
+
+      job.start ();
+      job.wait ();
+
+      if (job.has_error ()) {
+        throw tl::Exception (tl::to_string (tr ("Errors occurred during computing the cell variants. First error message says:\n")) + job.error_messages ().front ());
+      }
+
+    }
+
+  }
+}
+
 void
 VariantsCollectorBase::collect (const db::Layout &layout, const db::Cell &top_cell)
 {
@@ -50,28 +147,69 @@ VariantsCollectorBase::collect (const db::Layout &layout, const db::Cell &top_ce
   std::set<db::cell_index_type> called;
   top_cell.collect_called_cells (called);
 
+  //  Sort the cells into levels: a cell's level is one more than the largest level of its parents.
+  //  Hence the variants of all parents are known when a level is processed and the cells of
+  //  one level can be computed independently.
+  //  NOTE: the variant maps are created beforehand, so m_variants is not modified structurally
+  //  while the cells are processed.
+
+  std::map<db::cell_index_type, unsigned int> levels;
+  levels.insert (std::make_pair (top_cell.cell_index (), 0));
+
+  std::vector<std::vector<db::cell_index_type> > cells_per_level;
+
   for (db::Layout::top_down_const_iterator c = layout.begin_top_down (); c != layout.end_top_down (); ++c) {
 
     if (called.find (*c) == called.end ()) {
       continue;
     }
 
-    //  collect the parent variants per parent cell
+    unsigned int level = 0;
+    for (db::Cell::parent_cell_iterator pc = layout.cell (*c).begin_parent_cells (); pc != layout.cell (*c).end_parent_cells (); ++pc) {
+      std::map<db::cell_index_type, unsigned int>::const_iterator l = levels.find (*pc);
+      if (l != levels.end ()) {
+        level = std::max (level, l->second + 1);
+      }
+    }
 
-    std::map<db::cell_index_type, std::map<db::ICplxTrans, size_t> > variants_per_parent_cell;
-    for (db::Cell::parent_inst_iterator pi = layout.cell (*c).begin_parent_insts (); ! pi.at_end (); ++pi) {
-      std::map<db::ICplxTrans, size_t> &variants = variants_per_parent_cell [pi->inst ().object ().cell_index ()];
-      add_variant (variants, pi->child_inst ().cell_inst (), mp_red->is_translation_invariant ());
+    levels.insert (std::make_pair (*c, level));
+    if (cells_per_level.size () <= size_t (level)) {
+      cells_per_level.resize (level + 1);
     }
+    cells_per_level [level].push_back (*c);
+
+    m_variants [*c];
 
-    //  compute the resulting variants
+  }
 
-    std::map<db::ICplxTrans, size_t> &new_variants = m_variants [*c];
+  run_per_level (m_nthreads, cells_per_level, this, const_cast<db::Layout *> (&layout), 0, 0);
+}
 
-    for (std::map<db::cell_index_type, std::map<db::ICplxTrans, size_t> >::const_iterator pv = variants_per_parent_cell.begin (); pv != variants_per_parent_cell.end (); ++pv) {
-      product (variants (pv->first), pv->second, new_variants);
-    }
+void
+VariantsCollectorBase::collect_for_cell (const db::Layout &layout, db::cell_index_type ci)
+{
+  //  collect the parent variants per parent cell
 
+  std::map<db::cell_index_type, variant_counts_type> variants_per_parent_cell;
+  for (db::Cell::parent_inst_iterator pi = layout.cell (ci).begin_parent_insts (); ! pi.at_end (); ++pi) {
+    variant_counts_type &variants = variants_per_parent_cell [pi->inst ().object ().cell_index ()];
+    add_variant (variants, pi->child_inst ().cell_inst (), mp_red->is_translation_invariant ());
+  }
+
+  //  compute the resulting variants
+
+  variant_counts_type new_variants;
+
+  for (std::map<db::cell_index_type, variant_counts_type>::const_iterator pv = variants_per_parent_cell.begin (); pv != variants_per_parent_cell.end (); ++pv) {
+    product (variants (pv->first), pv->second, new_variants);
+  }
+
+  //  NOTE: the map is created by "collect", so we don't modify m_variants here
+  std::map<db::cell_index_type, std::map<db::ICplxTrans, size_t> >::iterator vv = m_variants.find (ci);
+  tl_assert (vv != m_variants.end ());
+
+  for (variant_counts_type::const_iterator v = new_variants.begin (); v != new_variants.end (); ++v) {
+    vv->second [v->first] += v->second;
   }
 }
 
@@ -192,44 +330,87 @@ VariantsCollectorBase::commit_shapes (db::Layout &layout, db::Cell &top_cell, un
   top_cell.collect_called_cells (called);
   called.insert (top_cell.cell_index ());
 
+  //  Sort the cells into levels bottom-up: a cell's level is one more than the largest level of its children.
+  //  The cells of one level can then be processed independently.
+  //  NOTE: the "to_commit" entries are created beforehand, so to_commit is not modified structurally
+  //  while the cells are processed. Empty entries are equivalent to missing ones and are removed in the end.
+
+  std::map<db::cell_index_type, unsigned int> levels;
+  std::vector<std::vector<db::cell_index_type> > cells_per_level;
+
   for (db::Layout::bottom_up_const_iterator c = layout.begin_bottom_up (); c != layout.end_bottom_up (); ++c) {
 
     if (called.find (*c) == called.end ()) {
       continue;
     }
 
-    db::Cell &cell = layout.cell (*c);
+    unsigned int level = 0;
+    for (db::Cell::child_cell_iterator cc = layout.cell (*c).begin_child_cells (); ! cc.at_end (); ++cc) {
+      std::map<db::cell_index_type, unsigned int>::const_iterator l = levels.find (*cc);
+      if (l != levels.end ()) {
+        level = std::max (level, l->second + 1);
+      }
+    }
 
-    std::map<db::ICplxTrans, size_t> &vvc = m_variants [*c];
-    if (vvc.size () > 1) {
+    levels.insert (std::make_pair (*c, level));
+    if (cells_per_level.size () <= size_t (level)) {
+      cells_per_level.resize (level + 1);
+    }
+    cells_per_level [level].push_back (*c);
 
-      for (std::map<db::ICplxTrans, size_t>::const_iterator vc = vvc.begin (); vc != vvc.end (); ++vc) {
+    to_commit [*c];
 
-        for (db::Cell::const_iterator i = cell.begin (); ! i.at_end (); ++i) {
+  }
+
+  run_per_level (m_nthreads, cells_per_level, this, &layout, layer, &to_commit);
+
+  for (std::map<db::cell_index_type, std::map<db::ICplxTrans, db::Shapes> >::iterator tc = to_commit.begin (); tc != to_commit.end (); ) {
+    std::map<db::cell_index_type, std::map<db::ICplxTrans, db::Shapes> >::iterator tc_next = tc;
+    ++tc_next;
+    if (tc->second.empty ()) {
+      to_commit.erase (tc);
+    }
+    tc = tc_next;
+  }
+}
+
+void
+VariantsCollectorBase::commit_shapes_for_cell (db::Layout &layout, db::cell_index_type ci, unsigned int layer, std::map<db::cell_index_type, std::map<db::ICplxTrans, db::Shapes> > &to_commit) const
+{
+  db::Cell &cell = layout.cell (ci);
+
+  const std::map<db::ICplxTrans, size_t> &vvc = variants (ci);
+  if (vvc.size () > 1) {
 
-          std::map<db::cell_index_type, std::map<db::ICplxTrans, db::Shapes> >::const_iterator tc = to_commit.find (i->cell_index ());
-          if (tc != to_commit.end ()) {
+    //  NOTE: the entry is created by "commit_shapes", so we don't modify to_commit here
+    std::map<db::cell_index_type, std::map<db::ICplxTrans, db::Shapes> >::iterator tp = to_commit.find (ci);
+    tl_assert (tp != to_commit.end ());
 
-            const std::map<db::ICplxTrans, db::Shapes> &vt = tc->second;
+    //  NOTE: this will add one more commit slot for propagation ... but we don't clean up.
+    //  When would a cleanup happen?
+    std::map<db::ICplxTrans, db::Shapes> &propagated = tp->second;
 
-            //  NOTE: this will add one more commit slot for propagation ... but we don't clean up.
-            //  When would a cleanup happen?
-            std::map<db::ICplxTrans, db::Shapes> &propagated = to_commit [*c];
+    for (std::map<db::ICplxTrans, size_t>::const_iterator vc = vvc.begin (); vc != vvc.end (); ++vc) {
 
-            for (db::CellInstArray::iterator ia = i->begin (); ! ia.at_end (); ++ia) {
+      for (db::Cell::const_iterator i = cell.begin (); ! i.at_end (); ++i) {
 
-              db::ICplxTrans t = i->complex_trans (*ia);
-              db::ICplxTrans rt = mp_red->reduce (vc->first * t);
-              std::map<db::ICplxTrans, db::Shapes>::const_iterator v = vt.find (rt);
-              if (v != vt.end ()) {
+        std::map<db::cell_index_type, std::map<db::ICplxTrans, db::Shapes> >::const_iterator tc = to_commit.find (i->cell_index ());
+        if (tc != to_commit.end () && ! tc->second.empty ()) {
 
-                db::Shapes &ps = propagated [vc->first];
-                tl::ident_map<db::Layout::properties_id_type> pm;
+          const std::map<db::ICplxTrans, db::Shapes> &vt = tc->second;
 
-                for (db::Shapes::shape_iterator si = v->second.begin (db::ShapeIterator::All); ! si.at_end (); ++si) {
-                  ps.insert (*si, t, pm);
-                }
+          for (db::CellInstArray::iterator ia = i->begin (); ! ia.at_end (); ++ia) {
 
+            db::ICplxTrans t = i->complex_trans (*ia);
+            db::ICplxTrans rt = mp_red->reduce (vc->first * t);
+            std::map<db::ICplxTrans, db::Shapes>::const_iterator v = vt.find (rt);
+            if (v != vt.end ()) {
+
+              db::Shapes &ps = propagated [vc->first];
+              tl::ident_map<db::Layout::properties_id_type> pm;
+
+              for (db::Shapes::shape_iterator si = v->second.begin (db::ShapeIterator::All); ! si.at_end (); ++si) {
+                ps.insert (*si, t, pm);
               }
 
             }
@@ -240,40 +421,37 @@ VariantsCollectorBase::commit_shapes (db::Layout &layout, db::Cell &top_cell, un
 
       }
 
-    } else {
+    }
 
-      //  single variant -> we can commit any shapes we have kept for this cell directly to the cell
+  } else {
 
-      std::map<db::cell_index_type, std::map<db::ICplxTrans, db::Shapes> >::iterator l = to_commit.find (*c);
-      if (l != to_commit.end ()) {
-        tl_assert (l->second.size () == 1);
-        cell.shapes (layer).insert (l->second.begin ()->second);
-        to_commit.erase (l);
-      }
+    //  single variant -> we can commit any shapes we have kept for this cell directly to the cell
+    //  NOTE: the shapes are collected in a local container first, so the layout only needs to be locked
+    //  while inserting them into the cell.
 
-      //  for child cells, pull everything that needs to be committed to the parent
+    db::Shapes shapes (false);
 
-      for (db::Cell::const_iterator i = cell.begin (); ! i.at_end (); ++i) {
+    //  for child cells, pull everything that needs to be committed to the parent
 
-        std::map<db::cell_index_type, std::map<db::ICplxTrans, db::Shapes> >::const_iterator tc = to_commit.find (i->cell_index ());
-        if (tc != to_commit.end ()) {
+    for (db::Cell::const_iterator i = cell.begin (); ! i.at_end (); ++i) {
 
-          const std::map<db::ICplxTrans, db::Shapes> &vt = tc->second;
+      std::map<db::cell_index_type, std::map<db::ICplxTrans, db::Shapes> >::const_iterator tc = to_commit.find (i->cell_index ());
+      if (tc != to_commit.end () && ! tc->second.empty ()) {
 
-          for (db::CellInstArray::iterator ia = i->begin (); ! ia.at_end (); ++ia) {
+        const std::map<db::ICplxTrans, db::Shapes> &vt = tc->second;
 
-            db::ICplxTrans t = i->complex_trans (*ia);
-            db::ICplxTrans rt = mp_red->reduce (vvc.begin ()->first * t);
-            std::map<db::ICplxTrans, db::Shapes>::const_iterator v = vt.find (rt);
+        for (db::CellInstArray::iterator ia = i->begin (); ! ia.at_end (); ++ia) {
 
-            if (v != vt.end ()) {
+          db::ICplxTrans t = i->complex_trans (*ia);
+          db::ICplxTrans rt = mp_red->reduce (vvc.begin ()->first * t);
+          std::map<db::ICplxTrans, db::Shapes>::const_iterator v = vt.find (rt);
 
-              tl::ident_map<db::Layout::properties_id_type> pm;
+          if (v != vt.end ()) {
 
-              for (db::Shapes::shape_iterator si = v->second.begin (db::ShapeIterator::All); ! si.at_end (); ++si) {
-                cell.shapes (layer).insert (*si, t, pm);
-              }
+            tl::ident_map<db::Layout::properties_id_type> pm;
 
+            for (db::Shapes::shape_iterator si = v->second.begin (db::ShapeIterator::All); ! si.at_end (); ++si) {
+              shapes.insert (*si, t, pm);
             }
 
           }
@@ -284,6 +462,27 @@ VariantsCollectorBase::commit_shapes (db::Layout &layout, db::Cell &top_cell, un
 
     }
 
+    std::map<db::cell_index_type, std::map<db::ICplxTrans, db::Shapes> >::iterator l = to_commit.find (ci);
+    bool has_own_shapes = (l != to_commit.end () && ! l->second.empty ());
+
+    if (has_own_shapes || ! shapes.empty ()) {
+
+      tl::MutexLocker locker (&layout.lock ());
+
+      if (has_own_shapes) {
+        tl_assert (l->second.size () == 1);
+        cell.shapes (layer).insert (l->second.begin ()->second);
+      }
+
+      cell.shapes (layer).insert (shapes);
+
+    }
+
+    //  the shapes are committed now: an empty entry is equivalent to a missing one
+    if (l != to_commit.end ()) {
+      l->second.clear ();
+    }
+
   }
 }
 
@@ -311,7 +510,7 @@ VariantsCollectorBase::has_variants () const
 }
 
 void
-VariantsCollectorBase::add_variant (std::map<db::ICplxTrans, size_t> &variants, const db::CellInstArray &inst, bool tl_invariant) const
+VariantsCollectorBase::add_variant (variant_counts_type &variants, const db::CellInstArray &inst, bool tl_invariant) const
 {
   if (tl_invariant) {
     add_variant_tl_invariant (variants, inst);
@@ -321,7 +520,7 @@ VariantsCollectorBase::add_variant (std::map<db::ICplxTrans, size_t> &variants,
 }
 
 void
-VariantsCollectorBase::add_variant_non_tl_invariant (std::map<db::ICplxTrans, size_t> &variants, const db::CellInstArray &inst) const
+VariantsCollectorBase::add_variant_non_tl_invariant (variant_counts_type &variants, const db::CellInstArray &inst) const
 {
   if (inst.is_complex ()) {
     for (db::CellInstArray::iterator i = inst.begin (); ! i.at_end (); ++i) {
@@ -335,7 +534,7 @@ VariantsCollectorBase::add_variant_non_tl_invariant (std::map<db::ICplxTrans, si
 }
 
 void
-VariantsCollectorBase::add_variant_tl_invariant (std::map<db::ICplxTrans, size_t> &variants, const db::CellInstArray &inst) const
+VariantsCollectorBase::add_variant_tl_invariant (variant_counts_type &variants, const db::CellInstArray &inst) const
 {
   if (inst.is_complex ()) {
     variants [mp_red->reduce (inst.complex_trans ())] += inst.size ();
@@ -345,10 +544,10 @@ VariantsCollectorBase::add_variant_tl_invariant (std::map<db::ICplxTrans, size_t
 }
 
 void
-VariantsCollectorBase::product (const std::map<db::ICplxTrans, size_t> &v1, const std::map<db::ICplxTrans, size_t> &v2, std::map<db::ICplxTrans, size_t> &prod) const
+VariantsCollectorBase::product (const std::map<db::ICplxTrans, size_t> &v1, const variant_counts_type &v2, variant_counts_type &prod) const
 {
   for (std::map<db::ICplxTrans, size_t>::const_iterator i = v1.begin (); i != v1.end (); ++i) {
-    for (std::map<db::ICplxTrans, size_t>::const_iterator j = v2.begin (); j != v2.end (); ++j) {
+    for (variant_counts_type::const_iterator j = v2.begin (); j != v2.end (); ++j) {
       prod [mp_red->reduce (i->first * j->first)] += i->second * j->second;
     }
   }
@@ -27,12 +27,16 @@
 
 #include "dbTrans.h"
 #include "dbLayout.h"
+#include "dbHash.h"
 
 #include <memory>
+#include <unordered_map>
 
 namespace db
 {
 
+class VariantsCollectorWorker;
+
 /**
  *  @brief The reducer interface
  *
@@ -173,6 +177,9 @@ private:
  *
  *  The cell variants are build from the cell instances and are accumulated over
  *  the hierarchy path.
+ *
+ *  "collect" and "commit_shapes" can employ multiple threads (see "set_threads").
+ *  In that case, cells on the same hierarchy level are processed concurrently.
  */
 class DB_PUBLIC VariantsCollectorBase
 {
@@ -225,14 +232,39 @@ public:
    */
   bool has_variants () const;
 
+  /**
+   *  @brief Sets the number of threads to use for "collect" and "commit_shapes"
+   *
+   *  A value of 0 (the default) will make these methods run in the calling thread.
+   */
+  void set_threads (unsigned int nthreads)
+  {
+    m_nthreads = nthreads;
+  }
+
+  /**
+   *  @brief Gets the number of threads to use
+   */
+  unsigned int threads () const
+  {
+    return m_nthreads;
+  }
+
 private:
+  friend class VariantsCollectorWorker;
+
+  typedef std::unordered_map<db::ICplxTrans, size_t> variant_counts_type;
+
   std::map<db::cell_index_type, std::map<db::ICplxTrans, size_t> > m_variants;
   const TransformationReducer *mp_red;
-
-  void add_variant (std::map<db::ICplxTrans, size_t> &variants, const db::CellInstArray &inst, bool tl_invariant) const;
-  void add_variant_non_tl_invariant (std::map<db::ICplxTrans, size_t> &variants, const db::CellInstArray &inst) const;
-  void add_variant_tl_invariant (std::map<db::ICplxTrans, size_t> &variants, const db::CellInstArray &inst) const;
-  void product (const std::map<db::ICplxTrans, size_t> &v1, const std::map<db::ICplxTrans, size_t> &v2, std::map<db::ICplxTrans, size_t> &prod) const;
+  unsigned int m_nthreads;
+
+  void collect_for_cell (const db::Layout &layout, db::cell_index_type ci);
+  void commit_shapes_for_cell (db::Layout &layout, db::cell_index_type ci, unsigned int layer, std::map<db::cell_index_type, std::map<db::ICplxTrans, db::Shapes> > &to_commit) const;
+  void add_variant (variant_counts_type &variants, const db::CellInstArray &inst, bool tl_invariant) const;
+  void add_variant_non_tl_invariant (variant_counts_type &variants, const db::CellInstArray &inst) const;
+  void add_variant_tl_invariant (variant_counts_type &variants, const db::CellInstArray &inst) const;
+  void product (const std::map<db::ICplxTrans, size_t> &v1, const variant_counts_type &v2, variant_counts_type &prod) const;
   void copy_shapes (db::Layout &layout, db::cell_index_type ci_to, db::cell_index_type ci_from) const;
   void create_var_instances (db::Cell &in_cell, std::vector<db::CellInstArrayWithProperties> &inst, const db::ICplxTrans &for_var, const std::map<db::cell_index_type, std::map<db::ICplxTrans, db::cell_index_type> > &var_table, bool tl_invariant) const;
   void create_var_instances_non_tl_invariant (db::Cell &in_cell, std::vector<db::CellInstArrayWithProperties> &inst, const db::ICplxTrans &for_var, const std::map<db::cell_index_type, std::map<db::ICplxTrans, db::cell_index_type> > &var_table) const;
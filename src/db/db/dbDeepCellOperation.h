@@ -0,0 +1,222 @@
+
+/*
+
+  KLayout Layout Viewer
+  Copyright (C) 2006-2019 Matthias Koefferlein
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+
+
+#ifndef HDR_dbDeepCellOperation
+#define HDR_dbDeepCellOperation
+
+#include "dbCommon.h"
+#include "dbLayout.h"
+#include "dbCellVariants.h"
+#include "tlThreadedWorkers.h"
+
+#include <map>
+#include <vector>
+
+namespace db
+{
+
+/**
+ *  @brief The interface for a cell-local operation on a deep layer
+ *
+ *  A cell-local operation computes the output of a cell from the shapes of this cell
+ *  alone. "compute" is called once for every cell and variant. It may be called from
+ *  different threads concurrently, hence it must not modify the layout.
+ *
+ *  The results are delivered in the coordinate system of the cell.
+ */
+template <class Result>
+class DB_PUBLIC_TEMPLATE deep_cell_operation
+{
+public:
+  deep_cell_operation () { }
+  virtual ~deep_cell_operation () { }
+
+  /**
+   *  @brief Computes the results for the given cell
+   *
+   *  @param cell The cell to compute the results for
+   *  @param tr The variant's transformation (unit transformation without variants)
+   *  @param results Receives the results
+   */
+  virtual void compute (const db::Cell &cell, const db::ICplxTrans &tr, std::vector<Result> &results) const = 0;
+};
+
+/**
+ *  @brief Delivers the results of a cell operation into a shape container
+ *
+ *  Polygons are stored as polygon references.
+ */
+template <class Result>
+struct deep_cell_operation_delivery
+{
+  static void put (db::Layout & /*layout*/, db::Shapes &shapes, const std::vector<Result> &results)
+  {
+    for (typename std::vector<Result>::const_iterator r = results.begin (); r != results.end (); ++r) {
+      shapes.insert (*r);
+    }
+  }
+};
+
+template <>
+struct deep_cell_operation_delivery<db::Polygon>
+{
+  static void put (db::Layout &layout, db::Shapes &shapes, const std::vector<db::Polygon> &results)
+  {
+    for (std::vector<db::Polygon>::const_iterator r = results.begin (); r != results.end (); ++r) {
+      shapes.insert (db::PolygonRef (*r, layout.shape_repository ()));
+    }
+  }
+};
+
+/**
+ *  @brief The task for a cell operation
+ */
+template <class Result>
+class deep_cell_operation_task
+  : public tl::Task
+{
+public:
+  typedef std::map<db::cell_index_type, std::map<db::ICplxTrans, db::Shapes> > to_commit_type;
+
+  deep_cell_operation_task (const deep_cell_operation<Result> *op, db::Layout *layout, const db::VariantsCollectorBase *vars, db::cell_index_type ci, unsigned int output_layer, to_commit_type *to_commit)
+    : tl::Task (), mp_op (op), mp_layout (layout), mp_vars (vars), m_ci (ci), m_output_layer (output_layer), mp_to_commit (to_commit)
+  {
+    //  .. nothing yet ..
+  }
+
+  /**
+   *  @brief Computes and delivers the results for the task's cell
+   *
+   *  The results of one cell and variant are computed without locking. They are delivered
+   *  in one step while the layout is locked.
+   */
+  void perform () const
+  {
+    const db::Cell &cell = mp_layout->cell (m_ci);
+    std::vector<Result> results;
+
+    if (! mp_vars) {
+
+      mp_op->compute (cell, db::ICplxTrans (), results);
+
+      tl::MutexLocker locker (&mp_layout->lock ());
+      deep_cell_operation_delivery<Result>::put (*mp_layout, mp_layout->cell (m_ci).shapes (m_output_layer), results);
+
+    } else {
+
+      const std::map<db::ICplxTrans, size_t> &vv = mp_vars->variants (m_ci);
+      for (std::map<db::ICplxTrans, size_t>::const_iterator v = vv.begin (); v != vv.end (); ++v) {
+
+        results.clear ();
+        mp_op->compute (cell, v->first, results);
+
+        tl::MutexLocker locker (&mp_layout->lock ());
+        if (vv.size () == 1) {
+          deep_cell_operation_delivery<Result>::put (*mp_layout, mp_layout->cell (m_ci).shapes (m_output_layer), results);
+        } else {
+          deep_cell_operation_delivery<Result>::put (*mp_layout, (*mp_to_commit) [m_ci] [v->first], results);
+        }
+
+      }
+
+    }
+  }
+
+private:
+  const deep_cell_operation<Result> *mp_op;
+  db::Layout *mp_layout;
+  const db::VariantsCollectorBase *mp_vars;
+  db::cell_index_type m_ci;
+  unsigned int m_output_layer;
+  to_commit_type *mp_to_commit;
+};
+
+/**
+ *  @brief The worker for a cell operation
+ */
+template <class Result>
+class deep_cell_operation_worker
+  : public tl::Worker
+{
+public:
+  deep_cell_operation_worker ()
+    : tl::Worker ()
+  {
+    //  .. nothing yet ..
+  }
+
+  void perform_task (tl::Task *task)
+  {
+    static_cast<deep_cell_operation_task<Result> *> (task)->perform ();
+  }
+};
+
+/**
+ *  @brief Runs a cell-local operation on all cells of a layout
+ *
+ *  @param op The operation
+ *  @param layout The layout of the deep layer
+ *  @param vars The variants (0 if the operation does not require variants)
+ *  @param output_layer The layer to which the results are written
+ *  @param to_commit Receives the results for cells with more than one variant (see DeepLayer::commit_shapes)
+ *  @param nthreads The number of threads to use (0 for computing the results in the calling thread)
+ *
+ *  The cells are independent, so they are distributed over the given number of threads.
+ *  As each cell's results are delivered at once, the output is the same as if
+ *  the cells had been processed one after another.
+ */
+template <class Result>
+void run_deep_cell_operation (const deep_cell_operation<Result> &op, db::Layout &layout, const db::VariantsCollectorBase *vars, unsigned int output_layer, std::map<db::cell_index_type, std::map<db::ICplxTrans, db::Shapes> > &to_commit, unsigned int nthreads)
+{
+  //  avoids updates while we work on the layout
+  layout.update ();
+  db::LayoutLocker layout_update_locker (&layout);
+
+  if (nthreads == 0) {
+
+    for (db::Layout::iterator c = layout.begin (); c != layout.end (); ++c) {
+      deep_cell_operation_task<Result> (&op, &layout, vars, c->cell_index (), output_layer, &to_commit).perform ();
+    }
+
+  } else {
+
+    tl::Job<deep_cell_operation_worker<Result> > job (nthreads);
+
+    for (db::Layout::iterator c = layout.begin (); c != layout.end (); ++c) {
+      job.schedule (new deep_cell_operation_task<Result> (&op, &layout, vars, c->cell_index (), output_layer, &to_commit));
+    }
+
+    job.start ();
+    job.wait ();
+
+    if (job.has_error ()) {
+      throw tl::Exception (tl::to_string (tr ("Errors occurred during processing the cells. First error message says:\n")) + job.error_messages ().front ());
+    }
+
+  }
+}
+
+}
+
+#endif
+
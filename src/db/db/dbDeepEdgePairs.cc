@@ -27,6 +27,7 @@
 #include "dbDeepRegion.h"
 #include "dbCellMapping.h"
 #include "dbLayoutUtils.h"
+#include "dbDeepCellOperation.h"
 
 #include <sstream>
 
@@ -241,42 +242,91 @@ EdgePairsDelegate *DeepEdgePairs::filtered (const EdgePairFilterBase &filter) co
   return AsIfFlatEdgePairs::filtered (filter);
 }
 
-RegionDelegate *DeepEdgePairs::polygons (db::Coord e) const
+namespace
 {
-  db::DeepLayer new_layer = m_deep_layer.derived ();
-  db::Layout &layout = const_cast<db::Layout &> (m_deep_layer.layout ());
 
-  for (db::Layout::iterator c = layout.begin (); c != layout.end (); ++c) {
-    db::Shapes &output = c->shapes (new_layer.layer ());
-    for (db::Shapes::shape_iterator s = c->shapes (m_deep_layer.layer ()).begin (db::ShapeIterator::EdgePairs); ! s.at_end (); ++s) {
-      db::Polygon poly = s->edge_pair ().normalized ().to_polygon (e);
+/**
+ *  @brief The cell operation converting edge pairs to polygons
+ */
+class EdgePairsToPolygonsCellOperation
+  : public db::deep_cell_operation<db::Polygon>
+{
+public:
+  EdgePairsToPolygonsCellOperation (unsigned int layer, db::Coord e)
+    : m_layer (layer), m_e (e)
+  {
+    //  .. nothing yet ..
+  }
+
+  virtual void compute (const db::Cell &cell, const db::ICplxTrans & /*tr*/, std::vector<db::Polygon> &results) const
+  {
+    for (db::Shapes::shape_iterator s = cell.shapes (m_layer).begin (db::ShapeIterator::EdgePairs); ! s.at_end (); ++s) {
+      db::Polygon poly = s->edge_pair ().normalized ().to_polygon (m_e);
       if (poly.vertices () >= 3) {
-        output.insert (poly);
+        results.push_back (poly);
       }
     }
   }
 
-  return new db::DeepRegion (new_layer);
-}
+private:
+  unsigned int m_layer;
+  db::Coord m_e;
+};
 
-EdgesDelegate *DeepEdgePairs::generic_edges (bool first, bool second) const
+/**
+ *  @brief The cell operation delivering the edges of edge pairs
+ */
+class EdgePairsToEdgesCellOperation
+  : public db::deep_cell_operation<db::Edge>
 {
-  db::DeepLayer new_layer = m_deep_layer.derived ();
-  db::Layout &layout = const_cast<db::Layout &> (m_deep_layer.layout ());
+public:
+  EdgePairsToEdgesCellOperation (unsigned int layer, bool first, bool second)
+    : m_layer (layer), m_first (first), m_second (second)
+  {
+    //  .. nothing yet ..
+  }
 
-  for (db::Layout::iterator c = layout.begin (); c != layout.end (); ++c) {
-    db::Shapes &output = c->shapes (new_layer.layer ());
-    for (db::Shapes::shape_iterator s = c->shapes (m_deep_layer.layer ()).begin (db::ShapeIterator::EdgePairs); ! s.at_end (); ++s) {
+  virtual void compute (const db::Cell &cell, const db::ICplxTrans & /*tr*/, std::vector<db::Edge> &results) const
+  {
+    for (db::Shapes::shape_iterator s = cell.shapes (m_layer).begin (db::ShapeIterator::EdgePairs); ! s.at_end (); ++s) {
       db::EdgePair ep = s->edge_pair ();
-      if (first) {
-        output.insert (ep.first ());
+      if (m_first) {
+        results.push_back (ep.first ());
       }
-      if (second) {
-        output.insert (ep.second ());
+      if (m_second) {
+        results.push_back (ep.second ());
       }
     }
   }
 
+private:
+  unsigned int m_layer;
+  bool m_first, m_second;
+};
+
+}
+
+RegionDelegate *DeepEdgePairs::polygons (db::Coord e) const
+{
+  db::DeepLayer new_layer = m_deep_layer.derived ();
+  db::Layout &layout = const_cast<db::Layout &> (m_deep_layer.layout ());
+
+  std::map<db::cell_index_type, std::map<db::ICplxTrans, db::Shapes> > to_commit;
+  EdgePairsToPolygonsCellOperation op (m_deep_layer.layer (), e);
+  db::run_deep_cell_operation (op, layout, 0, new_layer.layer (), to_commit, m_deep_layer.store ()->threads ());
+
+  return new db::DeepRegion (new_layer);
+}
+
+EdgesDelegate *DeepEdgePairs::generic_edges (bool first, bool second) const
+{
+  db::DeepLayer new_layer = m_deep_layer.derived ();
+  db::Layout &layout = const_cast<db::Layout &> (m_deep_layer.layout ());
+
+  std::map<db::cell_index_type, std::map<db::ICplxTrans, db::Shapes> > to_commit;
+  EdgePairsToEdgesCellOperation op (m_deep_layer.layer (), first, second);
+  db::run_deep_cell_operation (op, layout, 0, new_layer.layer (), to_commit, m_deep_layer.store ()->threads ());
+
   return new db::DeepEdges (new_layer);
 }
 
@@ -29,6 +29,7 @@
 #include "dbHierNetworkProcessor.h"
 #include "dbCellGraphUtils.h"
 #include "dbCellVariants.h"
+#include "dbDeepCellOperation.h"
 #include "dbEdgeBoolean.h"
 #include "dbCellMapping.h"
 #include "dbLayoutUtils.h"
@@ -445,6 +446,7 @@ DeepEdges::length_type DeepEdges::length (const db::Box &box) const
 
     db::MagnificationReducer red;
     db::cell_variants_collector<db::MagnificationReducer> vars (red);
+    vars.set_threads (m_merged_edges.store ()->threads ());
     vars.collect (m_merged_edges.layout (), m_merged_edges.initial_cell ());
 
     DeepEdges::length_type l = 0;
@@ -502,40 +504,77 @@ DeepEdges::processed_to_polygons (const EdgeToPolygonProcessorBase &filter) cons
 namespace
 {
 
-template <class Result> struct delivery;
-
-template <>
-struct delivery<db::Polygon>
+/**
+ *  @brief The cell operation implementing the edge processors
+ */
+template <class Result>
+class EdgeProcessorCellOperation
+  : public db::deep_cell_operation<Result>
 {
-  delivery (db::Layout *layout, db::Shapes *shapes)
-    : mp_layout (layout), mp_shapes (shapes)
-  { }
+public:
+  EdgeProcessorCellOperation (unsigned int layer, const edge_processor<Result> *filter)
+    : m_layer (layer), mp_filter (filter)
+  {
+    //  .. nothing yet ..
+  }
 
-  void put (const db::Polygon &result)
+  virtual void compute (const db::Cell &cell, const db::ICplxTrans &tr, std::vector<Result> &results) const
   {
-    tl::MutexLocker locker (&mp_layout->lock ());
-    mp_shapes->insert (db::PolygonRef (result, mp_layout->shape_repository ()));
+    bool is_unity = tr.is_unity ();
+    db::ICplxTrans trinv = tr.inverted ();
+    std::vector<Result> heap;
+
+    const db::Shapes &shapes = cell.shapes (m_layer);
+    for (db::Shapes::shape_iterator si = shapes.begin (db::ShapeIterator::Edges); ! si.at_end (); ++si) {
+
+      heap.clear ();
+
+      if (is_unity) {
+        mp_filter->process (si->edge (), heap);
+        results.insert (results.end (), heap.begin (), heap.end ());
+      } else {
+        mp_filter->process (si->edge ().transformed (tr), heap);
+        for (typename std::vector<Result>::const_iterator i = heap.begin (); i != heap.end (); ++i) {
+          results.push_back (i->transformed (trinv));
+        }
+      }
+
+    }
   }
 
 private:
-  db::Layout *mp_layout;
-  db::Shapes *mp_shapes;
+  unsigned int m_layer;
+  const edge_processor<Result> *mp_filter;
 };
 
-template <class Result>
-struct delivery
+/**
+ *  @brief The cell operation implementing the edge filters
+ */
+class EdgeFilterCellOperation
+  : public db::deep_cell_operation<db::Shape>
 {
-  delivery (db::Layout *, db::Shapes *shapes)
-    : mp_shapes (shapes)
-  { }
+public:
+  EdgeFilterCellOperation (unsigned int layer, const EdgeFilterBase *filter)
+    : m_layer (layer), mp_filter (filter)
+  {
+    //  .. nothing yet ..
+  }
 
-  void put (const Result &result)
+  virtual void compute (const db::Cell &cell, const db::ICplxTrans &tr, std::vector<db::Shape> &results) const
   {
-    mp_shapes->insert (result);
+    bool is_unity = tr.is_unity ();
+
+    const db::Shapes &shapes = cell.shapes (m_layer);
+    for (db::Shapes::shape_iterator si = shapes.begin (db::ShapeIterator::Edges); ! si.at_end (); ++si) {
+      if (mp_filter->selected (is_unity ? si->edge () : si->edge ().transformed (tr))) {
+        results.push_back (*si);
+      }
+    }
   }
 
 private:
-  db::Shapes *mp_shapes;
+  unsigned int m_layer;
+  const EdgeFilterBase *mp_filter;
 };
 
 }
@@ -553,6 +592,7 @@ DeepEdges::processed_impl (const edge_processor<Result> &filter) const
 
     vars.reset (new db::VariantsCollectorBase (filter.vars ()));
 
+    vars->set_threads (m_deep_layer.store ()->threads ());
     vars->collect (m_deep_layer.layout (), m_deep_layer.initial_cell ());
 
     if (filter.wants_variants ()) {
@@ -563,7 +603,6 @@ DeepEdges::processed_impl (const edge_processor<Result> &filter) const
 
   db::Layout &layout = const_cast<db::Layout &> (m_deep_layer.layout ());
 
-  std::vector<Result> heap;
   std::map<db::cell_index_type, std::map<db::ICplxTrans, db::Shapes> > to_commit;
 
   std::auto_ptr<OutputContainer> res (new OutputContainer (m_deep_layer.derived ()));
@@ -571,52 +610,8 @@ DeepEdges::processed_impl (const edge_processor<Result> &filter) const
     res->set_merged_semantics (false);
   }
 
-  for (db::Layout::iterator c = layout.begin (); c != layout.end (); ++c) {
-
-    const db::Shapes &s = c->shapes (filter.requires_raw_input () ? m_deep_layer.layer () : m_merged_edges.layer ());
-
-    if (vars.get ()) {
-
-      const std::map<db::ICplxTrans, size_t> &vv = vars->variants (c->cell_index ());
-      for (std::map<db::ICplxTrans, size_t>::const_iterator v = vv.begin (); v != vv.end (); ++v) {
-
-        db::Shapes *st;
-        if (vv.size () == 1) {
-          st = & c->shapes (res->deep_layer ().layer ());
-        } else {
-          st = & to_commit [c->cell_index ()] [v->first];
-        }
-
-        delivery<Result> delivery (&layout, st);
-
-        const db::ICplxTrans &tr = v->first;
-        db::ICplxTrans trinv = tr.inverted ();
-
-        for (db::Shapes::shape_iterator si = s.begin (db::ShapeIterator::Edges); ! si.at_end (); ++si) {
-          heap.clear ();
-          filter.process (si->edge ().transformed (tr), heap);
-          for (typename std::vector<Result>::const_iterator i = heap.begin (); i != heap.end (); ++i) {
-            delivery.put (i->transformed (trinv));
-          }
-        }
-
-      }
-
-    } else {
-
-      db::Shapes &st = c->shapes (res->deep_layer ().layer ());
-      delivery<Result> delivery (&layout, &st);
-
-      for (db::Shapes::shape_iterator si = s.begin (db::ShapeIterator::Edges); ! si.at_end (); ++si) {
-        filter.process (si->edge (), heap);
-        for (typename std::vector<Result>::const_iterator i = heap.begin (); i != heap.end (); ++i) {
-          delivery.put (*i);
-        }
-      }
-
-    }
-
-  }
+  EdgeProcessorCellOperation<Result> op (filter.requires_raw_input () ? m_deep_layer.layer () : m_merged_edges.layer (), &filter);
+  db::run_deep_cell_operation (op, layout, vars.get (), res->deep_layer ().layer (), to_commit, m_deep_layer.store ()->threads ());
 
   if (! to_commit.empty () && vars.get ()) {
     res->deep_layer ().commit_shapes (*vars, to_commit);
@@ -647,6 +642,7 @@ DeepEdges::filtered (const EdgeFilterBase &filter) const
 
     vars.reset (new db::VariantsCollectorBase (filter.vars ()));
 
+    vars->set_threads (m_deep_layer.store ()->threads ());
     vars->collect (m_deep_layer.layout (), m_deep_layer.initial_cell ());
 
     if (filter.wants_variants ()) {
@@ -659,45 +655,9 @@ DeepEdges::filtered (const EdgeFilterBase &filter) const
   std::map<db::cell_index_type, std::map<db::ICplxTrans, db::Shapes> > to_commit;
 
   std::auto_ptr<db::DeepEdges> res (new db::DeepEdges (m_deep_layer.derived ()));
-  for (db::Layout::iterator c = layout.begin (); c != layout.end (); ++c) {
-
-    const db::Shapes &s = c->shapes (filter.requires_raw_input () ? m_deep_layer.layer () : m_merged_edges.layer ());
-
-    if (vars.get ()) {
-
-      const std::map<db::ICplxTrans, size_t> &vv = vars->variants (c->cell_index ());
-      for (std::map<db::ICplxTrans, size_t>::const_iterator v = vv.begin (); v != vv.end (); ++v) {
 
-        db::Shapes *st;
-        if (vv.size () == 1) {
-          st = & c->shapes (res->deep_layer ().layer ());
-        } else {
-          st = & to_commit [c->cell_index ()] [v->first];
-        }
-
-        const db::ICplxTrans &tr = v->first;
-
-        for (db::Shapes::shape_iterator si = s.begin (db::ShapeIterator::Edges); ! si.at_end (); ++si) {
-          if (filter.selected (si->edge ().transformed (tr))) {
-            st->insert (*si);
-          }
-        }
-
-      }
-
-    } else {
-
-      db::Shapes &st = c->shapes (res->deep_layer ().layer ());
-
-      for (db::Shapes::shape_iterator si = s.begin (db::ShapeIterator::Edges); ! si.at_end (); ++si) {
-        if (filter.selected (si->edge ())) {
-          st.insert (*si);
-        }
-      }
-
-    }
-
-  }
+  EdgeFilterCellOperation op (filter.requires_raw_input () ? m_deep_layer.layer () : m_merged_edges.layer (), &filter);
+  db::run_deep_cell_operation (op, layout, vars.get (), res->deep_layer ().layer (), to_commit, m_deep_layer.store ()->threads ());
 
   if (! to_commit.empty () && vars.get ()) {
     res->deep_layer ().commit_shapes (*vars, to_commit);
@@ -1005,6 +965,7 @@ RegionDelegate *DeepEdges::extended (coord_type ext_b, coord_type ext_e, coord_t
   //  dots formally don't have an orientation, hence the interpretation is x and y.
   db::MagnificationReducer red;
   db::cell_variants_collector<db::MagnificationReducer> vars (red);
+  vars.set_threads (m_merged_edges.store ()->threads ());
   vars.collect (m_merged_edges.layout (), m_merged_edges.initial_cell ());
 
   std::map<db::cell_index_type, std::map<db::ICplxTrans, db::Shapes> > to_commit;
@@ -38,6 +38,7 @@
 #include "dbCellGraphUtils.h"
 #include "dbPolygonTools.h"
 #include "dbCellVariants.h"
+#include "dbDeepCellOperation.h"
 #include "dbLocalOperationUtils.h"
 #include "tlTimer.h"
 
@@ -644,6 +645,7 @@ DeepRegion::area (const db::Box &box) const
     ensure_merged_polygons_valid ();
 
     db::cell_variants_collector<db::MagnificationReducer> vars;
+    vars.set_threads (m_merged_polygons.store ()->threads ());
     vars.collect (m_merged_polygons.layout (), m_merged_polygons.initial_cell ());
 
     DeepRegion::area_type a = 0;
@@ -677,6 +679,7 @@ DeepRegion::perimeter (const db::Box &box) const
     ensure_merged_polygons_valid ();
 
     db::cell_variants_collector<db::MagnificationReducer> vars;
+    vars.set_threads (m_merged_polygons.store ()->threads ());
     vars.collect (m_merged_polygons.layout (), m_merged_polygons.initial_cell ());
 
     DeepRegion::perimeter_type p = 0;
@@ -714,6 +717,226 @@ DeepRegion::to_string (size_t nmax) const
   return db::AsIfFlatRegion::to_string (nmax);
 }
 
+namespace
+{
+
+/**
+ *  @brief The cell operation implementing the grid check
+ */
+class GridCheckCellOperation
+  : public db::deep_cell_operation<db::EdgePair>
+{
+public:
+  GridCheckCellOperation (unsigned int layer, db::Coord gx, db::Coord gy)
+    : m_layer (layer), m_gx (gx), m_gy (gy)
+  {
+    //  .. nothing yet ..
+  }
+
+  virtual void compute (const db::Cell &cell, const db::ICplxTrans &tr, std::vector<db::EdgePair> &results) const
+  {
+    db::Shapes markers;
+
+    const db::Shapes &shapes = cell.shapes (m_layer);
+    for (db::Shapes::shape_iterator si = shapes.begin (db::ShapeIterator::All); ! si.at_end (); ++si) {
+      db::Polygon poly;
+      si->polygon (poly);
+      AsIfFlatRegion::produce_markers_for_grid_check (poly, tr, m_gx, m_gy, markers);
+    }
+
+    for (db::Shapes::shape_iterator m = markers.begin (db::ShapeIterator::EdgePairs); ! m.at_end (); ++m) {
+      results.push_back (m->edge_pair ());
+    }
+  }
+
+private:
+  unsigned int m_layer;
+  db::Coord m_gx, m_gy;
+};
+
+/**
+ *  @brief The cell operation implementing the angle check
+ */
+class AngleCheckCellOperation
+  : public db::deep_cell_operation<db::EdgePair>
+{
+public:
+  AngleCheckCellOperation (unsigned int layer, double min, double max, bool inverse)
+    : m_layer (layer), m_min (min), m_max (max), m_inverse (inverse)
+  {
+    //  .. nothing yet ..
+  }
+
+  virtual void compute (const db::Cell &cell, const db::ICplxTrans & /*tr*/, std::vector<db::EdgePair> &results) const
+  {
+    db::Shapes markers;
+
+    const db::Shapes &shapes = cell.shapes (m_layer);
+    for (db::Shapes::shape_iterator si = shapes.begin (db::ShapeIterator::All); ! si.at_end (); ++si) {
+      db::Polygon poly;
+      si->polygon (poly);
+      AsIfFlatRegion::produce_markers_for_angle_check (poly, db::UnitTrans (), m_min, m_max, m_inverse, markers);
+    }
+
+    for (db::Shapes::shape_iterator m = markers.begin (db::ShapeIterator::EdgePairs); ! m.at_end (); ++m) {
+      results.push_back (m->edge_pair ());
+    }
+  }
+
+private:
+  unsigned int m_layer;
+  double m_min, m_max;
+  bool m_inverse;
+};
+
+/**
+ *  @brief The cell operation implementing "snapped"
+ */
+class SnapCellOperation
+  : public db::deep_cell_operation<db::Polygon>
+{
+public:
+  SnapCellOperation (unsigned int layer, db::Coord gx, db::Coord gy)
+    : m_layer (layer), m_gx (gx), m_gy (gy)
+  {
+    //  .. nothing yet ..
+  }
+
+  virtual void compute (const db::Cell &cell, const db::ICplxTrans &tr, std::vector<db::Polygon> &results) const
+  {
+    db::ICplxTrans trinv = tr.inverted ();
+    std::vector<db::Point> heap;
+
+    const db::Shapes &shapes = cell.shapes (m_layer);
+    for (db::Shapes::shape_iterator si = shapes.begin (db::ShapeIterator::All); ! si.at_end (); ++si) {
+      db::Polygon poly;
+      si->polygon (poly);
+      poly.transform (tr);
+      results.push_back (AsIfFlatRegion::snapped_polygon (poly, m_gx, m_gy, heap).transformed (trinv));
+    }
+  }
+
+private:
+  unsigned int m_layer;
+  db::Coord m_gx, m_gy;
+};
+
+/**
+ *  @brief The cell operation implementing "edges"
+ */
+class PolygonToEdgesCellOperation
+  : public db::deep_cell_operation<db::Edge>
+{
+public:
+  PolygonToEdgesCellOperation (unsigned int layer, const EdgeFilterBase *filter)
+    : m_layer (layer), mp_filter (filter)
+  {
+    //  .. nothing yet ..
+  }
+
+  virtual void compute (const db::Cell &cell, const db::ICplxTrans &tr, std::vector<db::Edge> &results) const
+  {
+    const db::Shapes &shapes = cell.shapes (m_layer);
+    for (db::Shapes::shape_iterator si = shapes.begin (db::ShapeIterator::All); ! si.at_end (); ++si) {
+
+      db::Polygon poly;
+      si->polygon (poly);
+
+      for (db::Polygon::polygon_edge_iterator e = poly.begin_edge (); ! e.at_end (); ++e) {
+        if (! mp_filter || mp_filter->selected ((*e).transformed (tr))) {
+          results.push_back (*e);
+        }
+      }
+
+    }
+  }
+
+private:
+  unsigned int m_layer;
+  const EdgeFilterBase *mp_filter;
+};
+
+/**
+ *  @brief The cell operation implementing the polygon processors
+ */
+template <class Result>
+class PolygonProcessorCellOperation
+  : public db::deep_cell_operation<Result>
+{
+public:
+  PolygonProcessorCellOperation (unsigned int layer, const polygon_processor<Result> *filter)
+    : m_layer (layer), mp_filter (filter)
+  {
+    //  .. nothing yet ..
+  }
+
+  virtual void compute (const db::Cell &cell, const db::ICplxTrans &tr, std::vector<Result> &results) const
+  {
+    bool is_unity = tr.is_unity ();
+    db::ICplxTrans trinv = tr.inverted ();
+    std::vector<Result> heap;
+
+    const db::Shapes &shapes = cell.shapes (m_layer);
+    for (db::Shapes::shape_iterator si = shapes.begin (db::ShapeIterator::All); ! si.at_end (); ++si) {
+
+      db::Polygon poly;
+      si->polygon (poly);
+
+      heap.clear ();
+
+      if (is_unity) {
+        mp_filter->process (poly, heap);
+        results.insert (results.end (), heap.begin (), heap.end ());
+      } else {
+        poly.transform (tr);
+        mp_filter->process (poly, heap);
+        for (typename std::vector<Result>::const_iterator i = heap.begin (); i != heap.end (); ++i) {
+          results.push_back (i->transformed (trinv));
+        }
+      }
+
+    }
+  }
+
+private:
+  unsigned int m_layer;
+  const polygon_processor<Result> *mp_filter;
+};
+
+/**
+ *  @brief The cell operation implementing the polygon filters
+ */
+class PolygonFilterCellOperation
+  : public db::deep_cell_operation<db::Shape>
+{
+public:
+  PolygonFilterCellOperation (unsigned int layer, const PolygonFilterBase *filter)
+    : m_layer (layer), mp_filter (filter)
+  {
+    //  .. nothing yet ..
+  }
+
+  virtual void compute (const db::Cell &cell, const db::ICplxTrans &tr, std::vector<db::Shape> &results) const
+  {
+    bool is_unity = tr.is_unity ();
+
+    const db::Shapes &shapes = cell.shapes (m_layer);
+    for (db::Shapes::shape_iterator si = shapes.begin (db::ShapeIterator::All); ! si.at_end (); ++si) {
+      db::Polygon poly;
+      si->polygon (poly);
+      if (mp_filter->selected (is_unity ? poly : poly.transformed (tr))) {
+        results.push_back (*si);
+      }
+    }
+  }
+
+private:
+  unsigned int m_layer;
+  const PolygonFilterBase *mp_filter;
+};
+
+}
+
 EdgePairsDelegate *
 DeepRegion::grid_check (db::Coord gx, db::Coord gy) const
 {
@@ -735,37 +958,14 @@ DeepRegion::grid_check (db::Coord gx, db::Coord gy) const
   db::Layout &layout = m_merged_polygons.layout ();
 
   db::cell_variants_collector<db::GridReducer> vars (gx);
+  vars.set_threads (m_merged_polygons.store ()->threads ());
   vars.collect (layout, m_merged_polygons.initial_cell ());
 
   std::map<db::cell_index_type, std::map<db::ICplxTrans, db::Shapes> > to_commit;
   std::auto_ptr<db::DeepEdgePairs> res (new db::DeepEdgePairs (m_merged_polygons.derived ()));
 
-  for (db::Layout::iterator c = layout.begin (); c != layout.end (); ++c) {
-
-    const db::Shapes &shapes = c->shapes (m_merged_polygons.layer ());
-
-    const std::map<db::ICplxTrans, size_t> &vv = vars.variants (c->cell_index ());
-    for (std::map<db::ICplxTrans, size_t>::const_iterator v = vv.begin (); v != vv.end (); ++v) {
-
-      db::Shapes *markers;
-      if (vv.size () == 1) {
-        markers = & c->shapes (res->deep_layer ().layer ());
-      } else {
-        markers = & to_commit [c->cell_index ()] [v->first];
-      }
-
-      for (db::Shapes::shape_iterator si = shapes.begin (db::ShapeIterator::All); ! si.at_end (); ++si) {
-
-        db::Polygon poly;
-        si->polygon (poly);
-
-        AsIfFlatRegion::produce_markers_for_grid_check (poly, v->first, gx, gy, *markers);
-
-      }
-
-    }
-
-  }
+  GridCheckCellOperation op (m_merged_polygons.layer (), gx, gy);
+  db::run_deep_cell_operation (op, layout, &vars, res->deep_layer ().layer (), to_commit, m_merged_polygons.store ()->threads ());
 
   //  propagate the markers with a similar algorithm used for producing the variants
   res->deep_layer ().commit_shapes (vars, to_commit);
@@ -780,20 +980,11 @@ DeepRegion::angle_check (double min, double max, bool inverse) const
 
   db::Layout &layout = m_merged_polygons.layout ();
 
+  std::map<db::cell_index_type, std::map<db::ICplxTrans, db::Shapes> > to_commit;
   std::auto_ptr<db::DeepEdgePairs> res (new db::DeepEdgePairs (m_merged_polygons.derived ()));
 
-  for (db::Layout::iterator c = layout.begin (); c != layout.end (); ++c) {
-
-    const db::Shapes &shapes = c->shapes (m_merged_polygons.layer ());
-    db::Shapes &markers = c->shapes (res->deep_layer ().layer ());
-
-    for (db::Shapes::shape_iterator si = shapes.begin (db::ShapeIterator::All); ! si.at_end (); ++si) {
-      db::Polygon poly;
-      si->polygon (poly);
-      AsIfFlatRegion::produce_markers_for_angle_check (poly, db::UnitTrans (), min, max, inverse, markers);
-    }
-
-  }
+  AngleCheckCellOperation op (m_merged_polygons.layer (), min, max, inverse);
+  db::run_deep_cell_operation (op, layout, 0, res->deep_layer ().layer (), to_commit, m_merged_polygons.store ()->threads ());
 
   return res.release ();
 }
@@ -818,36 +1009,21 @@ DeepRegion::snapped (db::Coord gx, db::Coord gy)
 
   db::cell_variants_collector<db::GridReducer> vars (gx);
 
+  vars.set_threads (m_merged_polygons.store ()->threads ());
   vars.collect (m_merged_polygons.layout (), m_merged_polygons.initial_cell ());
 
   //  NOTE: m_merged_polygons is mutable, so why is the const_cast needed?
   const_cast<db::DeepLayer &> (m_merged_polygons).separate_variants (vars);
 
   db::Layout &layout = m_merged_polygons.layout ();
-  std::vector<db::Point> heap;
 
+  std::map<db::cell_index_type, std::map<db::ICplxTrans, db::Shapes> > to_commit;
   std::auto_ptr<db::DeepRegion> res (new db::DeepRegion (m_merged_polygons.derived ()));
-  for (db::Layout::iterator c = layout.begin (); c != layout.end (); ++c) {
 
-    const std::map<db::ICplxTrans, size_t> &v = vars.variants (c->cell_index ());
-    tl_assert (v.size () == size_t (1));
-    const db::ICplxTrans &tr = v.begin ()->first;
-    db::ICplxTrans trinv = tr.inverted ();
-
-    const db::Shapes &s = c->shapes (m_merged_polygons.layer ());
-    db::Shapes &st = c->shapes (res->deep_layer ().layer ());
-    db::PolygonRefToShapesGenerator pr (&layout, &st);
-
-    for (db::Shapes::shape_iterator si = s.begin (db::ShapeIterator::All); ! si.at_end (); ++si) {
-
-      db::Polygon poly;
-      si->polygon (poly);
-      poly.transform (tr);
-      pr.put (snapped_polygon (poly, gx, gy, heap).transformed (trinv));
-
-    }
-
-  }
+  //  NOTE: after separating the variants, there is a single variant per cell, so nothing is left to commit
+  SnapCellOperation op (m_merged_polygons.layer (), gx, gy);
+  db::run_deep_cell_operation (op, layout, &vars, res->deep_layer ().layer (), to_commit, m_merged_polygons.store ()->threads ());
+  tl_assert (to_commit.empty ());
 
   return res.release ();
 }
@@ -863,6 +1039,7 @@ DeepRegion::edges (const EdgeFilterBase *filter) const
 
     vars.reset (new db::VariantsCollectorBase (filter->vars ()));
 
+    vars->set_threads (m_merged_polygons.store ()->threads ());
     vars->collect (m_merged_polygons.layout (), m_merged_polygons.initial_cell ());
 
     //  NOTE: m_merged_polygons is mutable, so why is the const_cast needed?
@@ -872,33 +1049,12 @@ DeepRegion::edges (const EdgeFilterBase *filter) const
 
   db::Layout &layout = m_merged_polygons.layout ();
 
+  std::map<db::cell_index_type, std::map<db::ICplxTrans, db::Shapes> > to_commit;
   std::auto_ptr<db::DeepEdges> res (new db::DeepEdges (m_merged_polygons.derived ()));
-  for (db::Layout::iterator c = layout.begin (); c != layout.end (); ++c) {
 
-    db::ICplxTrans tr;
-    if (vars.get ()) {
-      const std::map<db::ICplxTrans, size_t> &v = vars->variants (c->cell_index ());
-      tl_assert (v.size () == size_t (1));
-      tr = v.begin ()->first;
-    }
-
-    const db::Shapes &s = c->shapes (m_merged_polygons.layer ());
-    db::Shapes &st = c->shapes (res->deep_layer ().layer ());
-
-    for (db::Shapes::shape_iterator si = s.begin (db::ShapeIterator::All); ! si.at_end (); ++si) {
-
-      db::Polygon poly;
-      si->polygon (poly);
-
-      for (db::Polygon::polygon_edge_iterator e = poly.begin_edge (); ! e.at_end (); ++e) {
-        if (! filter || filter->selected ((*e).transformed (tr))) {
-          st.insert (*e);
-        }
-      }
-
-    }
-
-  }
+  PolygonToEdgesCellOperation op (m_merged_polygons.layer (), filter);
+  db::run_deep_cell_operation (op, layout, vars.get (), res->deep_layer ().layer (), to_commit, m_merged_polygons.store ()->threads ());
+  tl_assert (to_commit.empty ());
 
   res->set_is_merged (true);
   return res.release ();
@@ -929,47 +1085,6 @@ DeepRegion::processed (const PolygonProcessorBase &filter) const
   return processed_impl<db::Polygon, db::DeepRegion> (filter);
 }
 
-namespace
-{
-
-template <class Result> struct delivery;
-
-template <>
-struct delivery<db::Polygon>
-{
-  delivery (db::Layout *layout, db::Shapes *shapes)
-    : mp_layout (layout), mp_shapes (shapes)
-  { }
-
-  void put (const db::Polygon &result)
-  {
-    tl::MutexLocker locker (&mp_layout->lock ());
-    mp_shapes->insert (db::PolygonRef (result, mp_layout->shape_repository ()));
-  }
-
-private:
-  db::Layout *mp_layout;
-  db::Shapes *mp_shapes;
-};
-
-template <class Result>
-struct delivery
-{
-  delivery (db::Layout *, db::Shapes *shapes)
-    : mp_shapes (shapes)
-  { }
-
-  void put (const Result &result)
-  {
-    mp_shapes->insert (result);
-  }
-
-private:
-  db::Shapes *mp_shapes;
-};
-
-}
-
 template <class Result, class OutputContainer>
 OutputContainer *
 DeepRegion::processed_impl (const polygon_processor<Result> &filter) const
@@ -983,6 +1098,7 @@ DeepRegion::processed_impl (const polygon_processor<Result> &filter) const
 
     vars.reset (new db::VariantsCollectorBase (filter.vars ()));
 
+    vars->set_threads (m_deep_layer.store ()->threads ());
     vars->collect (m_deep_layer.layout (), m_deep_layer.initial_cell ());
 
     if (filter.wants_variants ()) {
@@ -993,7 +1109,6 @@ DeepRegion::processed_impl (const polygon_processor<Result> &filter) const
 
   db::Layout &layout = const_cast<db::Layout &> (m_deep_layer.layout ());
 
-  std::vector<Result> heap;
   std::map<db::cell_index_type, std::map<db::ICplxTrans, db::Shapes> > to_commit;
 
   std::auto_ptr<OutputContainer> res (new OutputContainer (m_deep_layer.derived ()));
@@ -1001,58 +1116,8 @@ DeepRegion::processed_impl (const polygon_processor<Result> &filter) const
     res->set_merged_semantics (false);
   }
 
-  for (db::Layout::iterator c = layout.begin (); c != layout.end (); ++c) {
-
-    const db::Shapes &s = c->shapes (filter.requires_raw_input () ? m_deep_layer.layer () : m_merged_polygons.layer ());
-
-    if (vars.get ()) {
-
-      const std::map<db::ICplxTrans, size_t> &vv = vars->variants (c->cell_index ());
-      for (std::map<db::ICplxTrans, size_t>::const_iterator v = vv.begin (); v != vv.end (); ++v) {
-
-        db::Shapes *st;
-        if (vv.size () == 1) {
-          st = & c->shapes (res->deep_layer ().layer ());
-        } else {
-          st = & to_commit [c->cell_index ()] [v->first];
-        }
-
-        delivery<Result> delivery (&layout, st);
-
-        const db::ICplxTrans &tr = v->first;
-        db::ICplxTrans trinv = tr.inverted ();
-
-        for (db::Shapes::shape_iterator si = s.begin (db::ShapeIterator::All); ! si.at_end (); ++si) {
-          db::Polygon poly;
-          si->polygon (poly);
-          poly.transform (tr);
-          heap.clear ();
-          filter.process (poly, heap);
-          for (typename std::vector<Result>::const_iterator i = heap.begin (); i != heap.end (); ++i) {
-            delivery.put (i->transformed (trinv));
-          }
-        }
-
-      }
-
-    } else {
-
-      db::Shapes &st = c->shapes (res->deep_layer ().layer ());
-      delivery<Result> delivery (&layout, &st);
-
-      for (db::Shapes::shape_iterator si = s.begin (db::ShapeIterator::All); ! si.at_end (); ++si) {
-        db::Polygon poly;
-        si->polygon (poly);
-        heap.clear ();
-        filter.process (poly, heap);
-        for (typename std::vector<Result>::const_iterator i = heap.begin (); i != heap.end (); ++i) {
-          delivery.put (*i);
-        }
-      }
-
-    }
-
-  }
+  PolygonProcessorCellOperation<Result> op (filter.requires_raw_input () ? m_deep_layer.layer () : m_merged_polygons.layer (), &filter);
+  db::run_deep_cell_operation (op, layout, vars.get (), res->deep_layer ().layer (), to_commit, m_deep_layer.store ()->threads ());
 
   if (! to_commit.empty () && vars.get ()) {
     res->deep_layer ().commit_shapes (*vars, to_commit);
@@ -1083,6 +1148,7 @@ DeepRegion::filtered (const PolygonFilterBase &filter) const
 
     vars.reset (new db::VariantsCollectorBase (filter.vars ()));
 
+    vars->set_threads (m_deep_layer.store ()->threads ());
     vars->collect (m_deep_layer.layout (), m_deep_layer.initial_cell ());
 
     if (filter.wants_variants ()) {
@@ -1095,49 +1161,9 @@ DeepRegion::filtered (const PolygonFilterBase &filter) const
   std::map<db::cell_index_type, std::map<db::ICplxTrans, db::Shapes> > to_commit;
 
   std::auto_ptr<db::DeepRegion> res (new db::DeepRegion (m_deep_layer.derived ()));
-  for (db::Layout::iterator c = layout.begin (); c != layout.end (); ++c) {
-
-    const db::Shapes &s = c->shapes (filter.requires_raw_input () ? m_deep_layer.layer () : m_merged_polygons.layer ());
-
-    if (vars.get ()) {
-
-      const std::map<db::ICplxTrans, size_t> &vv = vars->variants (c->cell_index ());
-      for (std::map<db::ICplxTrans, size_t>::const_iterator v = vv.begin (); v != vv.end (); ++v) {
 
-        db::Shapes *st;
-        if (vv.size () == 1) {
-          st = & c->shapes (res->deep_layer ().layer ());
-        } else {
-          st = & to_commit [c->cell_index ()] [v->first];
-        }
-
-        const db::ICplxTrans &tr = v->first;
-
-        for (db::Shapes::shape_iterator si = s.begin (db::ShapeIterator::All); ! si.at_end (); ++si) {
-          db::Polygon poly;
-          si->polygon (poly);
-          if (filter.selected (poly.transformed (tr))) {
-            st->insert (*si);
-          }
-        }
-
-      }
-
-    } else {
-
-      db::Shapes &st = c->shapes (res->deep_layer ().layer ());
-
-      for (db::Shapes::shape_iterator si = s.begin (db::ShapeIterator::All); ! si.at_end (); ++si) {
-        db::Polygon poly;
-        si->polygon (poly);
-        if (filter.selected (poly)) {
-          st.insert (*si);
-        }
-      }
-
-    }
-
-  }
+  PolygonFilterCellOperation op (filter.requires_raw_input () ? m_deep_layer.layer () : m_merged_polygons.layer (), &filter);
+  db::run_deep_cell_operation (op, layout, vars.get (), res->deep_layer ().layer (), to_commit, m_deep_layer.store ()->threads ());
 
   if (! to_commit.empty () && vars.get ()) {
     res->deep_layer ().commit_shapes (*vars, to_commit);
@@ -1231,6 +1257,7 @@ DeepRegion::sized (coord_type d, unsigned int mode) const
   db::Layout &layout = m_merged_polygons.layout ();
 
   db::cell_variants_collector<db::MagnificationReducer> vars;
+  vars.set_threads (m_merged_polygons.store ()->threads ());
   vars.collect (m_merged_polygons.layout (), m_merged_polygons.initial_cell ());
 
   //  NOTE: m_merged_polygons is mutable, so why is the const_cast needed?
@@ -1303,6 +1330,7 @@ DeepRegion::sized (coord_type dx, coord_type dy, unsigned int mode) const
   db::Layout &layout = m_merged_polygons.layout ();
 
   db::cell_variants_collector<db::XYAnisotropyAndMagnificationReducer> vars;
+  vars.set_threads (m_merged_polygons.store ()->threads ());
   vars.collect (m_merged_polygons.layout (), m_merged_polygons.initial_cell ());
 
   //  NOTE: m_merged_polygons is mutable, so why is the const_cast needed?
@@ -553,6 +553,72 @@ DeepLayer DeepShapeStore::create_polygon_layer (const db::RecursiveShapeIterator
   return DeepLayer (this, layout_index, layer_index);
 }
 
+std::vector<DeepLayer> DeepShapeStore::create_polygon_layers (const db::RecursiveShapeIterator &si, const std::vector<unsigned int> &layers, double max_area_ratio, size_t max_vertex_count, const db::ICplxTrans &trans)
+{
+  std::vector<DeepLayer> result;
+  if (layers.empty ()) {
+    return result;
+  }
+
+  if (layers.size () == 1) {
+    db::RecursiveShapeIterator iter (si);
+    iter.set_layer (layers.front ());
+    result.push_back (create_polygon_layer (iter, max_area_ratio, max_vertex_count, trans));
+    return result;
+  }
+
+  if (max_area_ratio == 0.0) {
+    max_area_ratio = m_max_area_ratio;
+  }
+  if (max_vertex_count == 0) {
+    max_vertex_count = m_max_vertex_count;
+  }
+
+  db::RecursiveShapeIterator iter (si);
+  iter.set_layers (layers);
+
+  unsigned int layout_index = layout_for_iter (iter, trans);
+
+  db::Layout &layout = m_layouts[layout_index]->layout;
+  db::HierarchyBuilder &builder = m_layouts[layout_index]->builder;
+
+  std::map<unsigned int, unsigned int> layer_map;
+  for (std::vector<unsigned int>::const_iterator l = layers.begin (); l != layers.end (); ++l) {
+    if (layer_map.find (*l) == layer_map.end ()) {
+      layer_map.insert (std::make_pair (*l, layout.insert_layer ()));
+    }
+  }
+
+  //  The chain of operators for producing clipped and reduced polygon references
+  db::PolygonReferenceHierarchyBuilderShapeReceiver refs (& layout, m_text_enlargement, m_text_property_name);
+  db::ReducingHierarchyBuilderShapeReceiver red (&refs, max_area_ratio, max_vertex_count);
+  db::ClippingHierarchyBuilderShapeReceiver clip (&red);
+
+  //  Build the working hierarchy for all layers from the recursive shape iterator
+  try {
+
+    tl::SelfTimer timer (tl::verbosity () >= 41, tl::to_string (tr ("Building working hierarchy (multiple layers)")));
+
+    builder.set_target_layers (layer_map);
+    builder.set_shape_receiver (&clip);
+    iter.push (& builder);
+    builder.set_shape_receiver (0);
+    builder.set_target_layers (std::map<unsigned int, unsigned int> ());
+
+  } catch (...) {
+    builder.set_shape_receiver (0);
+    builder.set_target_layers (std::map<unsigned int, unsigned int> ());
+    throw;
+  }
+
+  result.reserve (layers.size ());
+  for (std::vector<unsigned int>::const_iterator l = layers.begin (); l != layers.end (); ++l) {
+    result.push_back (DeepLayer (this, layout_index, layer_map [*l]));
+  }
+
+  return result;
+}
+
 DeepLayer DeepShapeStore::empty_layer (unsigned int layout_index) const
 {
   return DeepLayer (const_cast<DeepShapeStore *> (this), layout_index, m_layouts[layout_index]->empty_layer ());
@@ -307,6 +307,20 @@ public:
    */
   DeepLayer create_polygon_layer (const db::RecursiveShapeIterator &si, double max_area_ratio = 0.0, size_t max_vertex_count = 0, const ICplxTrans &trans = db::ICplxTrans ());
 
+  /**
+   *  @brief Inserts multiple polygon layers into the deep shape store in a single pass
+   *
+   *  This method is equivalent to calling "create_polygon_layer" for each of the given
+   *  source layers with "si" configured for this layer. The difference is that the
+   *  source hierarchy is traversed only once for all layers. The layer configuration
+   *  of "si" is ignored.
+   *
+   *  The returned deep layers correspond to the source layers given in "layers".
+   *  If a region is set on "si", the working hierarchy is built for the combination
+   *  of all layers and is not shared with the single-layer working hierarchies.
+   */
+  std::vector<DeepLayer> create_polygon_layers (const db::RecursiveShapeIterator &si, const std::vector<unsigned int> &layers, double max_area_ratio = 0.0, size_t max_vertex_count = 0, const ICplxTrans &trans = db::ICplxTrans ());
+
   /**
    *  @brief Inserts an edge layer into the deep shape store
    *
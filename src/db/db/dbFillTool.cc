@@ -27,6 +27,7 @@
 #include "dbRegion.h"
 #include "dbCell.h"
 #include "tlIntervalMap.h"
+#include "tlThreadedWorkers.h"
 
 namespace db
 {
@@ -382,9 +383,16 @@ rasterize_extended (const db::Polygon &fp, const db::Box &fc_bbox, db::AreaMap &
   return true;
 }
 
-DB_PUBLIC bool 
-fill_region (db::Cell *cell, const db::Polygon &fp0, db::cell_index_type fill_cell_index, const db::Box &fc_bbox, const db::Point &origin, bool enhanced_fill, 
-             std::vector <db::Polygon> *remaining_parts, const db::Vector &fill_margin)
+/**
+ *  @brief Computes the fill cell placements for a single polygon
+ *
+ *  This function does not modify the layout: the fill cell placements are delivered
+ *  as cell instance arrays in "fill_arrays". Adjacent columns with the same vertical extension
+ *  are combined into two-dimensional arrays.
+ */
+static bool
+fill_polygon_impl (std::vector<db::CellInstArray> &fill_arrays, const db::Polygon &fp0, db::cell_index_type fill_cell_index, const db::Box &fc_bbox, const db::Point &origin, bool enhanced_fill,
+                   std::vector <db::Polygon> *remaining_parts, const db::Vector &fill_margin)
 {
   std::vector <db::Polygon> filled_regions;
   db::EdgeProcessor ep;
@@ -431,9 +439,18 @@ fill_region (db::Cell *cell, const db::Polygon &fp0, db::cell_index_type fill_ce
 
       db::AreaMap::area_type amax = am.pixel_area ();
 
-      //  Create the fill cell instances
+      //  The runs of the previous column: (j, jj) -> index of the array in "columns"
+      std::map<std::pair<size_t, size_t>, size_t> prev_runs, runs;
+
+      //  The column runs: (i, j, jj) and the number of columns
+      std::vector<std::pair<std::pair<size_t, std::pair<size_t, size_t> >, size_t> > columns;
+
+      //  Collect the vertical runs of fill cells per column and combine runs with
+      //  identical extension in adjacent columns
       for (size_t i = 0; i < nx; ++i) {
 
+        runs.clear ();
+
         for (size_t j = 0; j < ny; ) {
 
           size_t jj = j + 1;
@@ -445,31 +462,53 @@ fill_region (db::Cell *cell, const db::Polygon &fp0, db::cell_index_type fill_ce
 
             ninsts += (jj - j);
 
-            db::Vector p0 (am.p0 () - fc_bbox.p1 ());
-            p0 += db::Vector (db::Coord (i) * fc_bbox.width (), db::Coord (j) * fc_bbox.height ());
-
-            db::CellInstArray array;
-
-            if (jj > j + 1) {
-              array = db::CellInstArray (db::CellInst (fill_cell_index), db::Trans (p0), db::Vector (0, fc_bbox.height ()), db::Vector (fc_bbox.width (), 0), (unsigned long) (jj - j), 1);
+            std::pair<size_t, size_t> run (j, jj);
+            std::map<std::pair<size_t, size_t>, size_t>::const_iterator pr = prev_runs.find (run);
+            if (pr != prev_runs.end ()) {
+              columns [pr->second].second += 1;
+              runs.insert (*pr);
             } else {
-              array = db::CellInstArray (db::CellInst (fill_cell_index), db::Trans (p0));
+              runs.insert (std::make_pair (run, columns.size ()));
+              columns.push_back (std::make_pair (std::make_pair (i, run), size_t (1)));
             }
 
-            cell->insert (array);
-
-            if (remaining_parts) {
-              db::Box filled_box = array.raw_bbox () * fc_bbox; 
-              filled_regions.push_back (db::Polygon (filled_box.enlarged (fill_margin)));
-            }
-            any_fill = true;
-
           }
 
           j = jj;
 
         }
 
+        prev_runs.swap (runs);
+
+      }
+
+      //  Create the fill cell instances
+      for (std::vector<std::pair<std::pair<size_t, std::pair<size_t, size_t> >, size_t> >::const_iterator c = columns.begin (); c != columns.end (); ++c) {
+
+        size_t i = c->first.first;
+        size_t j = c->first.second.first;
+        size_t jj = c->first.second.second;
+        size_t ni = c->second;
+
+        db::Vector p0 (am.p0 () - fc_bbox.p1 ());
+        p0 += db::Vector (db::Coord (i) * fc_bbox.width (), db::Coord (j) * fc_bbox.height ());
+
+        db::CellInstArray array;
+
+        if (jj > j + 1 || ni > 1) {
+          array = db::CellInstArray (db::CellInst (fill_cell_index), db::Trans (p0), db::Vector (0, fc_bbox.height ()), db::Vector (fc_bbox.width (), 0), (unsigned long) (jj - j), (unsigned long) ni);
+        } else {
+          array = db::CellInstArray (db::CellInst (fill_cell_index), db::Trans (p0));
+        }
+
+        fill_arrays.push_back (array);
+
+        if (remaining_parts) {
+          db::Box filled_box = array.raw_bbox () * fc_bbox;
+          filled_regions.push_back (db::Polygon (filled_box.enlarged (fill_margin)));
+        }
+        any_fill = true;
+
       }
 
     }
@@ -496,20 +535,137 @@ fill_region (db::Cell *cell, const db::Polygon &fp0, db::cell_index_type fill_ce
   }
 }
 
+DB_PUBLIC bool 
+fill_region (db::Cell *cell, const db::Polygon &fp0, db::cell_index_type fill_cell_index, const db::Box &fc_bbox, const db::Point &origin, bool enhanced_fill, 
+             std::vector <db::Polygon> *remaining_parts, const db::Vector &fill_margin)
+{
+  std::vector<db::CellInstArray> fill_arrays;
+  bool any_fill = fill_polygon_impl (fill_arrays, fp0, fill_cell_index, fc_bbox, origin, enhanced_fill, remaining_parts, fill_margin);
+  cell->insert (fill_arrays.begin (), fill_arrays.end ());
+  return any_fill;
+}
+
+namespace
+{
+
+/**
+ *  @brief The fill parameters and the per-polygon results for the multi-threaded fill
+ */
+struct FillJobData
+{
+  FillJobData (const std::vector<db::Polygon> &_polygons, db::cell_index_type _fill_cell_index, const db::Box &_fc_box, const db::Point &_origin, bool _enhanced_fill, bool _want_remaining_parts, const db::Vector &_fill_margin)
+    : polygons (_polygons), fill_cell_index (_fill_cell_index), fc_box (_fc_box), origin (_origin), enhanced_fill (_enhanced_fill), want_remaining_parts (_want_remaining_parts), fill_margin (_fill_margin),
+      fill_arrays (_polygons.size ()), remaining_parts (_polygons.size ()), filled (_polygons.size (), false)
+  {
+    //  .. nothing yet ..
+  }
+
+  void fill (size_t from, size_t to)
+  {
+    for (size_t i = from; i < to; ++i) {
+      filled [i] = fill_polygon_impl (fill_arrays [i], polygons [i], fill_cell_index, fc_box, origin, enhanced_fill, want_remaining_parts ? &remaining_parts [i] : 0, fill_margin);
+    }
+  }
+
+  const std::vector<db::Polygon> &polygons;
+  db::cell_index_type fill_cell_index;
+  db::Box fc_box;
+  db::Point origin;
+  bool enhanced_fill;
+  bool want_remaining_parts;
+  db::Vector fill_margin;
+
+  std::vector<std::vector<db::CellInstArray> > fill_arrays;
+  std::vector<std::vector<db::Polygon> > remaining_parts;
+  //  NOTE: not using std::vector<bool> because this one is not thread-safe on element level
+  std::vector<char> filled;
+};
+
+class FillTask
+  : public tl::Task
+{
+public:
+  FillTask (FillJobData *data, size_t from, size_t to)
+    : tl::Task (), mp_data (data), m_from (from), m_to (to)
+  {
+    //  .. nothing yet ..
+  }
+
+  void perform ()
+  {
+    mp_data->fill (m_from, m_to);
+  }
+
+private:
+  FillJobData *mp_data;
+  size_t m_from, m_to;
+};
+
+class FillWorker
+  : public tl::Worker
+{
+public:
+  FillWorker ()
+    : tl::Worker ()
+  {
+    //  .. nothing yet ..
+  }
+
+  void perform_task (tl::Task *task)
+  {
+    static_cast<FillTask *> (task)->perform ();
+  }
+};
+
+}
+
 DB_PUBLIC void
 fill_region (db::Cell *cell, const db::Region &fr, db::cell_index_type fill_cell_index, const db::Box &fc_box, const db::Point &origin, bool enhanced_fill, 
-             db::Region *remaining_parts, const db::Vector &fill_margin, db::Region *remaining_polygons)
+             db::Region *remaining_parts, const db::Vector &fill_margin, db::Region *remaining_polygons, unsigned int nthreads)
 {
+  std::vector<db::Polygon> polygons;
+  for (db::Region::const_iterator p = fr.begin_merged (); !p.at_end (); ++p) {
+    polygons.push_back (*p);
+  }
+
+  FillJobData data (polygons, fill_cell_index, fc_box, origin, enhanced_fill, remaining_parts != 0, fill_margin);
+
+  if (nthreads > 0 && polygons.size () > 1) {
+
+    //  distribute the polygons over the workers in chunks which are small enough to balance the load
+    size_t chunk = std::max (size_t (1), std::min (size_t (100), polygons.size () / (size_t (nthreads) * 4)));
+
+    tl::Job<FillWorker> job (nthreads);
+    for (size_t i = 0; i < polygons.size (); i += chunk) {
+      job.schedule (new FillTask (&data, i, std::min (polygons.size (), i + chunk)));
+    }
+
+    job.start ();
+    job.wait ();
+
+    if (job.has_error ()) {
+      throw tl::Exception (tl::to_string (tr ("Errors occurred during fill. First error message says:\n")) + job.error_messages ().front ());
+    }
+
+  } else {
+    data.fill (0, polygons.size ());
+  }
+
+  //  insert the fill cells in bulk and collect the remaining parts in the order of the input polygons
+
+  std::vector<db::CellInstArray> fill_arrays;
   std::vector<db::Polygon> rem_pp, rem_poly;
 
-  for (db::Region::const_iterator p = fr.begin_merged (); !p.at_end (); ++p) {
-    if (!fill_region (cell, *p, fill_cell_index, fc_box, origin, enhanced_fill, remaining_parts ? &rem_pp : 0, fill_margin)) {
-      if (remaining_polygons) {
-        rem_poly.push_back (*p);
-      }
+  for (size_t i = 0; i < polygons.size (); ++i) {
+    fill_arrays.insert (fill_arrays.end (), data.fill_arrays [i].begin (), data.fill_arrays [i].end ());
+    rem_pp.insert (rem_pp.end (), data.remaining_parts [i].begin (), data.remaining_parts [i].end ());
+    if (! data.filled [i] && remaining_polygons) {
+      rem_poly.push_back (polygons [i]);
     }
   }
 
+  cell->insert (fill_arrays.begin (), fill_arrays.end ());
+
   if (remaining_parts == &fr) {
     remaining_parts->clear ();
   }
@@ -530,3 +686,4 @@ fill_region (db::Cell *cell, const db::Region &fr, db::cell_index_type fill_cell
 }
 
 }
+
@@ -46,6 +46,9 @@ class Region;
  *  @param fill_margin Only used if remaining_parts is not 0 (see there)
  *
  *  Return value: true, if the polygon could be filled, false if no fill tile at all could be applied (remaining_parts will not be fed in that case)
+ *
+ *  Fill cells are placed as regular arrays: adjacent columns of fill cells with the same vertical extension
+ *  are combined into one two-dimensional array.
  */
 
 DB_PUBLIC bool 
@@ -59,11 +62,15 @@ fill_region (db::Cell *cell, const db::Polygon &fp, db::cell_index_type fill_cel
  *  remaining_parts (if non-null) will receive the non-filled parts of partially filled polygons. 
  *  fill_margin will specify the margin around the filled area when computing (through subtraction of the tiled area) the remaining_parts.
  *  remaining_polygons (if non-null) will receive the polygons which could not be filled at all.
+ *
+ *  If nthreads is non-zero, the polygons are filled on the given number of worker threads. The fill
+ *  cell placements are collected and inserted into the cell in bulk in the order of the input polygons,
+ *  hence the result does not depend on the number of threads.
  */
 
 DB_PUBLIC void
 fill_region (db::Cell *cell, const db::Region &fr, db::cell_index_type fill_cell_index, const db::Box &fc_box, const db::Point &origin, bool enhanced_fill, 
-             db::Region *remaining_parts = 0, const db::Vector &fill_margin = db::Vector (), db::Region *remaining_polygons = 0);
+             db::Region *remaining_parts = 0, const db::Vector &fill_margin = db::Vector (), db::Region *remaining_polygons = 0, unsigned int nthreads = 0);
 
 }
 
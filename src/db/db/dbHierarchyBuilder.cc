@@ -345,10 +345,18 @@ HierarchyBuilder::new_inst_member (const RecursiveShapeIterator *iter, const db:
 }
 
 void
-HierarchyBuilder::shape (const RecursiveShapeIterator * /*iter*/, const db::Shape &shape, const db::ICplxTrans & /*trans*/, const db::Box &region, const box_tree_type *complex_region)
+HierarchyBuilder::shape (const RecursiveShapeIterator *iter, const db::Shape &shape, const db::ICplxTrans & /*trans*/, const db::Box &region, const box_tree_type *complex_region)
 {
+  unsigned int target_layer = m_target_layer;
+  if (! m_target_layers.empty ()) {
+    std::map<unsigned int, unsigned int>::const_iterator l = m_target_layers.find (iter->layer ());
+    if (l != m_target_layers.end ()) {
+      target_layer = l->second;
+    }
+  }
+
   for (std::vector<db::Cell *>::const_iterator c = m_cell_stack.back ().second.begin (); c != m_cell_stack.back ().second.end (); ++c) {
-    db::Shapes &shapes = (*c)->shapes (m_target_layer);
+    db::Shapes &shapes = (*c)->shapes (target_layer);
     mp_pipe->push (shape, m_trans, region, complex_region, &shapes);
   }
 }
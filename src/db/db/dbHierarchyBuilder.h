@@ -239,6 +239,20 @@ public:
     m_target_layer = target_layer;
   }
 
+  /**
+   *  @brief Sets a source to target layer map
+   *
+   *  With a layer map, shapes are put into the target layer registered for the
+   *  source layer they are taken from. Together with a multi-layer recursive shape
+   *  iterator, this allows building many layers in a single pass over the hierarchy.
+   *  Shapes from source layers not listed in the map go to the default target layer.
+   *  Pass an empty map to disable the mapping.
+   */
+  void set_target_layers (const std::map<unsigned int, unsigned int> &layer_map)
+  {
+    m_target_layers = layer_map;
+  }
+
   /**
    *  @brief Reset the builder - performs a new initial pass
    */
@@ -314,6 +328,7 @@ private:
   cell_map_type::const_iterator m_cm_entry;
   bool m_cm_new_entry;
   unsigned int m_target_layer;
+  std::map<unsigned int, unsigned int> m_target_layers;
   std::vector<std::pair<bool, std::vector<db::Cell *> > > m_cell_stack;
   db::Cell *mp_initial_cell;
 
@@ -114,6 +114,20 @@ public:
     }
   }
 
+  virtual size_t mem_size () const
+  {
+    db::MemStatisticsSimple ms;
+    db::mem_stat (&ms, db::MemStatistics::None, 0, m_insts, true);
+    return sizeof (*this) + ms.size ();
+  }
+
+  virtual void compact ()
+  {
+    if (m_insts.capacity () > m_insts.size ()) {
+      std::vector<Inst> (m_insts).swap (m_insts);
+    }
+  }
+
 private:
   bool m_insert;
   std::vector<Inst> m_insts;
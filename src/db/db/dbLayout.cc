@@ -36,6 +36,7 @@
 #include "tlLog.h"
 #include "tlInternational.h"
 #include "tlProgress.h"
+#include "tlThreadedWorkers.h"
 #include "tlAssert.h"
 
 
@@ -1738,24 +1739,7 @@ Layout::get_pcell_variant_dict (pcell_id_type pcell_id, const std::map<std::stri
   pcell_variant_type *variant = header->get_variant (*this, parameters);
   if (! variant) {
 
-    std::string b (header->get_name ());
-    if (m_cell_map.find (b.c_str ()) != m_cell_map.end ()) {
-      b = uniquify_cell_name (b.c_str ());
-    }
-
-    //  create a new cell 
-    cell_index_type new_index = allocate_new_cell ();
-
-    variant = new pcell_variant_type (new_index, *this, pcell_id, parameters);
-    m_cells.push_back_ptr (variant);
-    m_cell_ptrs [new_index] = variant;
-
-    //  enter it's index and cell_name
-    register_cell_name (b.c_str (), new_index);
-
-    if (manager () && manager ()->transacting ()) {
-      manager ()->queue (this, new NewRemoveCellOp (new_index, m_cell_names [new_index], false /*new*/, 0));
-    }
+    variant = create_pcell_variant (pcell_id, parameters);
 
     // produce the layout
     variant->update ();
@@ -1777,31 +1761,226 @@ Layout::get_pcell_variant (pcell_id_type pcell_id, const std::vector<tl::Variant
   pcell_variant_type *variant = header->get_variant (*this, parameters);
   if (! variant) {
 
-    std::string b (header->get_name ());
-    if (m_cell_map.find (b.c_str ()) != m_cell_map.end ()) {
-      b = uniquify_cell_name (b.c_str ());
+    variant = create_pcell_variant (pcell_id, parameters);
+
+    // produce the layout
+    variant->update ();
+
+  }
+
+  return variant->cell_index ();
+}
+
+Layout::pcell_variant_type *
+Layout::create_pcell_variant (pcell_id_type pcell_id, const std::vector<tl::Variant> &parameters)
+{
+  pcell_header_type *header = pcell_header (pcell_id);
+  tl_assert (header != 0);
+
+  std::string b (header->get_name ());
+  if (m_cell_map.find (b.c_str ()) != m_cell_map.end ()) {
+    b = uniquify_cell_name (b.c_str ());
+  }
+
+  //  create a new cell 
+  cell_index_type new_index = allocate_new_cell ();
+
+  pcell_variant_type *variant = new pcell_variant_type (new_index, *this, pcell_id, parameters);
+  m_cells.push_back_ptr (variant);
+  m_cell_ptrs [new_index] = variant;
+
+  //  enter it's index and cell_name
+  register_cell_name (b.c_str (), new_index);
+
+  if (manager () && manager ()->transacting ()) {
+    manager ()->queue (this, new NewRemoveCellOp (new_index, m_cell_names [new_index], false /*new*/, 0));
+  }
+
+  return variant;
+}
+
+namespace
+{
+
+/**
+ *  @brief Describes a PCell variant produced on a worker thread
+ */
+struct PCellProductionItem
+{
+  PCellProductionItem ()
+    : variant (0), layout (0), cell (0), failed (false)
+  { }
+
+  db::PCellVariant *variant;
+  std::vector<unsigned int> layer_ids;
+  std::vector<std::pair<unsigned int, db::LayerProperties> > layers;
+  db::Layout *layout;
+  db::Cell *cell;
+  bool failed;
+};
+
+class PCellProductionTask
+  : public tl::Task
+{
+public:
+  PCellProductionTask (const db::PCellDeclaration *decl, double dbu, PCellProductionItem *item)
+    : tl::Task (), mp_decl (decl), m_dbu (dbu), mp_item (item)
+  {
+    //  .. nothing yet ..
+  }
+
+  void perform ()
+  {
+    //  set up a private layout with the same layer indexes than the target layout
+    db::Layout *layout = new db::Layout ();
+    mp_item->layout = layout;
+
+    layout->dbu (m_dbu);
+    for (std::vector<std::pair<unsigned int, db::LayerProperties> >::const_iterator l = mp_item->layers.begin (); l != mp_item->layers.end (); ++l) {
+      layout->insert_layer (l->first, l->second);
     }
 
-    //  create a new cell 
-    cell_index_type new_index = allocate_new_cell ();
+    mp_item->cell = &layout->cell (layout->add_cell ());
 
-    variant = new pcell_variant_type (new_index, *this, pcell_id, parameters);
-    m_cells.push_back_ptr (variant);
-    m_cell_ptrs [new_index] = variant;
+    try {
+      mp_decl->produce (*layout, mp_item->layer_ids, mp_item->variant->parameters (), *mp_item->cell);
+    } catch (...) {
+      //  will be produced again in the main thread which reports the error
+      mp_item->failed = true;
+    }
+  }
 
-    //  enter it's index and cell_name
-    register_cell_name (b.c_str (), new_index);
+private:
+  const db::PCellDeclaration *mp_decl;
+  double m_dbu;
+  PCellProductionItem *mp_item;
+};
 
-    if (manager () && manager ()->transacting ()) {
-      manager ()->queue (this, new NewRemoveCellOp (new_index, m_cell_names [new_index], false /*new*/, 0));
+class PCellProductionWorker
+  : public tl::Worker
+{
+public:
+  PCellProductionWorker ()
+    : tl::Worker ()
+  {
+    //  .. nothing yet ..
+  }
+
+  void perform_task (tl::Task *task)
+  {
+    static_cast<PCellProductionTask *> (task)->perform ();
+  }
+};
+
+}
+
+std::vector<cell_index_type>
+Layout::get_pcell_variants (pcell_id_type pcell_id, const std::vector<std::vector<tl::Variant> > &parameters, unsigned int threads)
+{
+  pcell_header_type *header = pcell_header (pcell_id);
+  tl_assert (header != 0);
+
+  const db::PCellDeclaration *decl = header->declaration ();
+
+  std::vector<cell_index_type> result;
+  result.reserve (parameters.size ());
+
+  if (threads == 0 || ! decl || ! decl->can_produce_concurrently ()) {
+    for (std::vector<std::vector<tl::Variant> >::const_iterator p = parameters.begin (); p != parameters.end (); ++p) {
+      result.push_back (get_pcell_variant (pcell_id, *p));
     }
+    return result;
+  }
 
-    // produce the layout
-    variant->update ();
+  //  create the variant cells first - this also unifies identical parameter sets
+
+  std::vector<pcell_variant_type *> new_variants;
+
+  for (std::vector<std::vector<tl::Variant> >::const_iterator p = parameters.begin (); p != parameters.end (); ++p) {
+
+    std::vector<tl::Variant> buffer;
+    const std::vector<tl::Variant> &pp = gauge_parameters (*p, decl, buffer);
+
+    pcell_variant_type *variant = header->get_variant (*this, pp);
+    if (! variant) {
+      variant = create_pcell_variant (pcell_id, pp);
+      new_variants.push_back (variant);
+    }
+
+    result.push_back (variant->cell_index ());
 
   }
 
-  return variant->cell_index ();
+  //  determine the layers in the main thread as this may create new layers
+
+  std::list<PCellProductionItem> items;
+
+  for (std::vector<pcell_variant_type *>::const_iterator v = new_variants.begin (); v != new_variants.end (); ++v) {
+
+    std::vector<unsigned int> layer_ids;
+    try {
+      layer_ids = header->get_layer_indices (*this, (*v)->parameters ());
+    } catch (tl::Exception &) {
+      //  the regular update will report the error
+      (*v)->update ();
+      continue;
+    }
+
+    if ((*v)->update_from_cache (layer_ids)) {
+      continue;
+    }
+
+    items.push_back (PCellProductionItem ());
+    PCellProductionItem &item = items.back ();
+    item.variant = *v;
+    item.layer_ids = layer_ids;
+
+    std::set<unsigned int> layers (layer_ids.begin (), layer_ids.end ());
+    for (std::set<unsigned int>::const_iterator l = layers.begin (); l != layers.end (); ++l) {
+      item.layers.push_back (std::make_pair (*l, get_properties (*l)));
+    }
+
+  }
+
+  if (items.size () == 1) {
+
+    items.front ().variant->update ();
+
+  } else if (! items.empty ()) {
+
+    try {
+
+      tl::Job<PCellProductionWorker> job (threads);
+      for (std::list<PCellProductionItem>::iterator i = items.begin (); i != items.end (); ++i) {
+        job.schedule (new PCellProductionTask (decl, dbu (), &*i));
+      }
+
+      job.start ();
+      job.wait ();
+
+      //  take over the results - variants with instances or errors are produced again
+
+      for (std::list<PCellProductionItem>::iterator i = items.begin (); i != items.end (); ++i) {
+        if (! i->failed && i->cell && i->cell->begin ().at_end ()) {
+          i->variant->update_from (*i->cell, i->layer_ids);
+        } else {
+          i->variant->update ();
+        }
+        delete i->layout;
+        i->layout = 0;
+      }
+
+    } catch (...) {
+      for (std::list<PCellProductionItem>::iterator i = items.begin (); i != items.end (); ++i) {
+        delete i->layout;
+        i->layout = 0;
+      }
+      throw;
+    }
+
+  }
+
+  return result;
 }
 
 const Layout::pcell_header_type *
@@ -2119,6 +2298,8 @@ Layout::recover_proxy_as (cell_index_type cell_index, std::vector <std::string>:
       return false;
     }
 
+    tl::MutexLocker locker (&lib->lock ());
+
     db::Cell *lib_cell = lib->layout ().recover_proxy (from + 1, to);
     if (lib_cell) {
       get_lib_proxy_as (lib, lib_cell->cell_index (), cell_index, layer_mapping);
@@ -2179,6 +2360,8 @@ Layout::recover_proxy (std::vector <std::string>::const_iterator from, std::vect
       return 0;
     }
 
+    tl::MutexLocker locker (&lib->lock ());
+
     db::Cell *lib_cell = lib->layout ().recover_proxy (from + 1, to);
     if (lib_cell) {
       cell_index_type cell_index = get_lib_proxy (lib, lib_cell->cell_index ());
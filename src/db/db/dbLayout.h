@@ -791,6 +791,21 @@ public:
    */
   cell_index_type get_pcell_variant_dict (pcell_id_type pcell_id, const std::map<std::string, tl::Variant> &p);
 
+  /**
+   *  @brief Gets the PCell variants for several parameter sets
+   *
+   *  This method is equivalent to calling get_pcell_variant for each parameter set. If the
+   *  PCell declaration supports concurrent production (see PCellDeclaration::can_produce_concurrently)
+   *  and "threads" is larger than zero, the new variants are produced into private layouts
+   *  on "threads" worker threads and taken over into this layout afterwards.
+   *
+   *  @param pcell_id The Id of the PCell declaration
+   *  @param parameters The PCell parameter sets
+   *  @param threads The number of worker threads (0 for serial production)
+   *  @return The indexes of the variant cells in the order of the parameter sets
+   */
+  std::vector<cell_index_type> get_pcell_variants (pcell_id_type pcell_id, const std::vector<std::vector<tl::Variant> > &parameters, unsigned int threads);
+
   /** 
    *  @brief Get a PCell variant and replace the given cell
    *
@@ -1726,6 +1741,11 @@ private:
    */
   void do_insert_layer (unsigned int index, bool special = false);
 
+  /**
+   *  @brief Creates a new PCell variant cell without producing the layout
+   */
+  pcell_variant_type *create_pcell_variant (pcell_id_type pcell_id, const std::vector<tl::Variant> &parameters);
+
   /**
    *  @brief Implementation of prune_cell and prune_subcells
    */
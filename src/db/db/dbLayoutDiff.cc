@@ -26,8 +26,14 @@
 #include "dbCellMapping.h"
 #include "dbFuzzyCellMapping.h"
 #include "dbLayoutUtils.h"
+#include "dbCellContentHash.h"
+#include "dbHash.h"
 #include "tlLog.h"
 #include "tlExceptions.h"
+#include "tlThreadedWorkers.h"
+
+#include <unordered_map>
+#include <algorithm>
 
 namespace db
 {
@@ -507,6 +513,172 @@ make_path_compare_func (db::Coord tolerance)
   return pair_compare_func<db::Path, db::properties_id_type, PathCompareOpWithTolerance, std_compare_func<db::properties_id_type> > (PathCompareOpWithTolerance (tolerance), std_compare_func<db::properties_id_type> ());
 }
 
+/**
+ *  @brief Hash functions compatible with the compare operators above for zero tolerance
+ *
+ *  Objects which are equivalent in terms of the compare operator need to have the same hash value.
+ */
+struct EdgeHashFunc
+{
+  size_t operator() (const db::Edge &e) const
+  {
+    return std::hfunc (e);
+  }
+};
+
+struct BoxHashFunc
+{
+  size_t operator() (const db::Box &b) const
+  {
+    return std::hfunc (b);
+  }
+};
+
+struct TextHashFunc
+{
+  size_t operator() (const db::Text &t) const
+  {
+    size_t h = std::hfunc (std::string (t.string ()));
+    h = std::hfunc (t.trans ().rot (), h);
+    h = std::hfunc (t.size (), h);
+    return std::hfunc (t.trans ().disp (), h);
+  }
+};
+
+struct PolygonHashFunc
+{
+  size_t operator() (const db::Polygon &p) const
+  {
+    //  the compare operator compares the edge sets, hence the hash must not depend on the edge order
+    size_t h = 0;
+    for (db::Polygon::polygon_edge_iterator e = p.begin_edge (); ! e.at_end (); ++e) {
+      h += std::hfunc (*e);
+    }
+    h = std::hfunc (p.vertices (), h);
+    return std::hfunc (p.holes (), h);
+  }
+};
+
+struct PathHashFunc
+{
+  size_t operator() (const db::Path &p) const
+  {
+    //  NOTE: PathCompareOpWithTolerance does not compare the points, hence they are not hashed
+    size_t h = std::hfunc (p.width ());
+    h = std::hfunc (p.bgn_ext (), h);
+    h = std::hfunc (p.end_ext (), h);
+    h = std::hfunc (p.round (), h);
+    return std::hfunc (p.points (), h);
+  }
+};
+
+/**
+ *  @brief A hash function for a pair of object and properties ID
+ */
+template <class A, class B, class HA>
+struct pair_hash_func
+{
+  size_t operator() (const std::pair<A, B> &p) const
+  {
+    return std::hcombine (HA () (p.first), std::hfunc (p.second));
+  }
+};
+
+/**
+ *  @brief Hash and equality functions working on pointers for use with the hashed reduction
+ */
+template <class X, class H>
+struct ptr_hash_func
+{
+  size_t operator() (const X *x) const
+  {
+    return m_h (*x);
+  }
+
+  H m_h;
+};
+
+template <class X, class Op>
+struct ptr_equal_func
+{
+  ptr_equal_func (const Op &op)
+    : m_op (op)
+  {
+    //  .. nothing yet ..
+  }
+
+  bool operator() (const X *a, const X *b) const
+  {
+    return ! m_op (*a, *b) && ! m_op (*b, *a);
+  }
+
+  Op m_op;
+};
+
+/**
+ *  @brief Reduces two vectors to the objects not present in the other one using a hash multiset
+ *
+ *  This is equivalent to "reduce" without iteration (i.e. for zero tolerance), but avoids sorting
+ *  the full vectors. Only the remaining objects are sorted, so the result is identical to "reduce".
+ */
+template <class X, class Op, class H>
+void reduce_hashed (std::vector<X> &a, std::vector<X> &b, Op op, H)
+{
+  if (! a.empty () && ! b.empty ()) {
+
+    typedef std::unordered_map<const X *, size_t, ptr_hash_func<X, H>, ptr_equal_func<X, Op> > count_map;
+    count_map counts (a.size (), ptr_hash_func<X, H> (), ptr_equal_func<X, Op> (op));
+
+    for (typename std::vector<X>::const_iterator ra = a.begin (); ra != a.end (); ++ra) {
+      counts.insert (std::make_pair (&*ra, size_t (0))).first->second += 1;
+    }
+
+    typename std::vector<X>::iterator wb = b.begin ();
+    for (typename std::vector<X>::iterator rb = b.begin (); rb != b.end (); ++rb) {
+      typename count_map::iterator c = counts.find (&*rb);
+      if (c != counts.end () && c->second > 0) {
+        c->second -= 1;
+      } else {
+        if (wb != rb) {
+          *wb = *rb;
+        }
+        ++wb;
+      }
+    }
+    b.erase (wb, b.end ());
+
+    //  NOTE: the remaining counts tell how many of the equivalent objects of a are not matched
+    std::vector<X> a_only;
+    for (typename std::vector<X>::const_iterator ra = a.begin (); ra != a.end (); ++ra) {
+      typename count_map::iterator c = counts.find (&*ra);
+      if (c->second > 0) {
+        c->second -= 1;
+        a_only.push_back (*ra);
+      }
+    }
+
+    counts.clear ();
+    a.swap (a_only);
+
+  }
+
+  std::sort (a.begin (), a.end (), op);
+  std::sort (b.begin (), b.end (), op);
+}
+
+/**
+ *  @brief Reduces two vectors: employs the hashed version for zero tolerance
+ */
+template <class X, class Op, class H>
+void reduce_with_tolerance (std::vector<X> &a, std::vector<X> &b, Op op, H h, db::Coord tolerance)
+{
+  if (tolerance > 0) {
+    reduce (a, b, op, true);
+  } else {
+    reduce_hashed (a, b, op, h);
+  }
+}
+
 static void
 collect_polygons (const db::Layout & /*l*/, const db::Cell *c, unsigned int layer, unsigned int flags, std::vector< std::pair<db::Polygon, db::properties_id_type> > &shapes, PropertyMapper &pn)
 {
@@ -601,8 +773,444 @@ collect_paths (const db::Layout &, const db::Cell *c, unsigned int layer, unsign
   }
 }
 
+/**
+ *  @brief The differences found for one layer of a cell pair
+ */
+struct LayerDiffData
+{
+  LayerDiffData ()
+    : bbox_differs (false)
+  {
+    //  .. nothing yet ..
+  }
+
+  bool empty () const
+  {
+    return ! bbox_differs &&
+           polygons_a.empty () && polygons_b.empty () &&
+           paths_a.empty () && paths_b.empty () &&
+           texts_a.empty () && texts_b.empty () &&
+           boxes_a.empty () && boxes_b.empty () &&
+           edges_a.empty () && edges_b.empty ();
+  }
+
+  bool bbox_differs;
+  db::Box bbox_a, bbox_b;
+  std::vector <std::pair <db::Polygon, db::properties_id_type> > polygons_a, polygons_b;
+  std::vector <std::pair <db::Path, db::properties_id_type> > paths_a, paths_b;
+  std::vector <std::pair <db::Text, db::properties_id_type> > texts_a, texts_b;
+  std::vector <std::pair <db::Box, db::properties_id_type> > boxes_a, boxes_b;
+  std::vector <std::pair <db::Edge, db::properties_id_type> > edges_a, edges_b;
+};
+
+/**
+ *  @brief The differences found for a cell pair
+ *
+ *  Layer differences are kept per index of the common layer.
+ */
+struct CellDiffData
+{
+  CellDiffData ()
+    : bbox_differs (false)
+  {
+    //  .. nothing yet ..
+  }
+
+  bool bbox_differs;
+  db::Box bbox_a, bbox_b;
+  std::vector <db::CellInstArrayWithProperties> insts_a, insts_b;
+  std::vector <db::CellInstArrayWithProperties> anotb, bnota;
+  std::map <size_t, LayerDiffData> layers;
+};
+
+/**
+ *  @brief The context of the cell by cell compare
+ *
+ *  The cell pairs are compared independently. When multiple threads are used, the
+ *  property mappers must be prepared before, so they are not modified during the compare.
+ */
+struct DiffContext
+{
+  const db::Layout *a, *b;
+  unsigned int flags;
+  db::Coord tolerance;
+  bool verbose;
+  std::vector<db::LayerProperties> common_layers;
+  std::vector<std::pair<bool, unsigned int> > layers_a, layers_b;
+  std::vector <std::string> common_cells;
+  std::vector <db::cell_index_type> common_cells_a, common_cells_b;
+  std::map <db::cell_index_type, db::cell_index_type> common_cell_indices_a, common_cell_indices_b;
+  std::vector<bool> skip;
+  db::PropertyMapper *prop_normalize_a, *prop_normalize_b;
+  db::PropertyMapper *prop_remap_to_a, *prop_remap_to_b;
+};
+
+/**
+ *  @brief Compares the given cell pair and collects the differences
+ *
+ *  In silent mode, the compare stops at the first difference.
+ *
+ *  @return True, if differences are found
+ */
 static bool
-do_compare_layouts (const db::Layout &a, const db::Cell *top_a, const db::Layout &b, const db::Cell *top_b, unsigned int flags, db::Coord tolerance, DifferenceReceiver &r)
+compare_cells (const DiffContext &ctx, unsigned int cci, CellDiffData &d)
+{
+  if (! ctx.skip.empty () && ctx.skip [cci]) {
+    //  cells are known to be identical
+    return false;
+  }
+
+  const db::Layout &a = *ctx.a;
+  const db::Layout &b = *ctx.b;
+  unsigned int flags = ctx.flags;
+  bool silent = (flags & layout_diff::f_silent) != 0;
+  bool differs = false;
+
+  const db::Cell *cell_a = &a.cell (ctx.common_cells_a [cci]);
+  const db::Cell *cell_b = &b.cell (ctx.common_cells_b [cci]);
+
+  if (!ctx.verbose && cell_a->bbox () != cell_b->bbox ()) {
+    differs = true;
+    d.bbox_differs = true;
+    d.bbox_a = cell_a->bbox ();
+    d.bbox_b = cell_b->bbox ();
+    if (silent) {
+      return true;
+    }
+  }
+
+  collect_insts (a, cell_a, flags, ctx.common_cell_indices_a, d.insts_a, *ctx.prop_normalize_a);
+  collect_insts (b, cell_b, flags, ctx.common_cell_indices_b, d.insts_b, *ctx.prop_normalize_b);
+
+  std::set_difference (d.insts_a.begin (), d.insts_a.end (), d.insts_b.begin (), d.insts_b.end (), std::back_inserter (d.anotb));
+
+  rewrite_instances_to (d.anotb, flags, ctx.common_cells_a, *ctx.prop_remap_to_a);
+  collect_insts_of_unmapped_cells (a, cell_a, flags, ctx.common_cell_indices_a, d.anotb);
+
+  std::set_difference (d.insts_b.begin (), d.insts_b.end (), d.insts_a.begin (), d.insts_a.end (), std::back_inserter (d.bnota));
+
+  rewrite_instances_to (d.bnota, flags, ctx.common_cells_b, *ctx.prop_remap_to_b);
+  collect_insts_of_unmapped_cells (b, cell_b, flags, ctx.common_cell_indices_b, d.bnota);
+
+  if (! d.anotb.empty () || ! d.bnota.empty ()) {
+    differs = true;
+    if (silent) {
+      return true;
+    }
+  }
+
+  //  the full instance lists are only required for reporting differences in verbose mode
+  if (! ctx.verbose || ! differs) {
+    std::vector <db::CellInstArrayWithProperties> ().swap (d.insts_a);
+    std::vector <db::CellInstArrayWithProperties> ().swap (d.insts_b);
+  }
+
+  //  compare layer by layer
+
+  for (size_t li = 0; li < ctx.common_layers.size (); ++li) {
+
+    bool is_valid_a = ctx.layers_a [li].first, is_valid_b = ctx.layers_b [li].first;
+    unsigned int layer_a = ctx.layers_a [li].second, layer_b = ctx.layers_b [li].second;
+
+    LayerDiffData ld;
+
+    if (!ctx.verbose && is_valid_a && is_valid_b && cell_a->bbox (layer_a) != cell_b->bbox (layer_b)) {
+      ld.bbox_differs = true;
+      ld.bbox_a = cell_a->bbox (layer_a);
+      ld.bbox_b = cell_b->bbox (layer_b);
+    }
+
+    //  compare polygons
+
+    if (ld.empty () || ! silent) {
+
+      if (is_valid_a) {
+        collect_polygons (a, cell_a, layer_a, flags, ld.polygons_a, *ctx.prop_normalize_a);
+      }
+      if (is_valid_b) {
+        collect_polygons (b, cell_b, layer_b, flags, ld.polygons_b, *ctx.prop_normalize_b);
+      }
+
+      reduce_with_tolerance (ld.polygons_a, ld.polygons_b, make_polygon_compare_func (ctx.tolerance), pair_hash_func<db::Polygon, db::properties_id_type, PolygonHashFunc> (), ctx.tolerance);
+
+    }
+
+    //  compare paths
+
+    if (! (flags & db::layout_diff::f_paths_as_polygons) && (ld.empty () || ! silent)) {
+
+      if (is_valid_a) {
+        collect_paths (a, cell_a, layer_a, flags, ld.paths_a, *ctx.prop_normalize_a);
+      }
+      if (is_valid_b) {
+        collect_paths (b, cell_b, layer_b, flags, ld.paths_b, *ctx.prop_normalize_b);
+      }
+
+      reduce_with_tolerance (ld.paths_a, ld.paths_b, make_path_compare_func (ctx.tolerance), pair_hash_func<db::Path, db::properties_id_type, PathHashFunc> (), ctx.tolerance);
+
+    }
+
+    //  compare texts
+
+    if (ld.empty () || ! silent) {
+
+      if (is_valid_a) {
+        collect_texts (a, cell_a, layer_a, flags, ld.texts_a, *ctx.prop_normalize_a);
+      }
+      if (is_valid_b) {
+        collect_texts (b, cell_b, layer_b, flags, ld.texts_b, *ctx.prop_normalize_b);
+      }
+
+      reduce_with_tolerance (ld.texts_a, ld.texts_b, make_text_compare_func (ctx.tolerance), pair_hash_func<db::Text, db::properties_id_type, TextHashFunc> (), ctx.tolerance);
+
+    }
+
+    //  compare boxes (unless this is done by the polygon compare code)
+
+    if (! (flags & db::layout_diff::f_boxes_as_polygons) && (ld.empty () || ! silent)) {
+
+      if (is_valid_a) {
+        collect_boxes (a, cell_a, layer_a, flags, ld.boxes_a, *ctx.prop_normalize_a);
+      }
+      if (is_valid_b) {
+        collect_boxes (b, cell_b, layer_b, flags, ld.boxes_b, *ctx.prop_normalize_b);
+      }
+
+      reduce_with_tolerance (ld.boxes_a, ld.boxes_b, make_box_compare_func (ctx.tolerance), pair_hash_func<db::Box, db::properties_id_type, BoxHashFunc> (), ctx.tolerance);
+
+    }
+
+    //  compare edges
+
+    if (ld.empty () || ! silent) {
+
+      if (is_valid_a) {
+        collect_edges (a, cell_a, layer_a, flags, ld.edges_a, *ctx.prop_normalize_a);
+      }
+      if (is_valid_b) {
+        collect_edges (b, cell_b, layer_b, flags, ld.edges_b, *ctx.prop_normalize_b);
+      }
+
+      reduce_with_tolerance (ld.edges_a, ld.edges_b, make_edge_compare_func (ctx.tolerance), pair_hash_func<db::Edge, db::properties_id_type, EdgeHashFunc> (), ctx.tolerance);
+
+    }
+
+    if (! ld.empty ()) {
+      differs = true;
+      std::swap (d.layers [li], ld);
+      if (silent) {
+        return true;
+      }
+    }
+
+  }
+
+  return differs;
+}
+
+/**
+ *  @brief Delivers the differences collected for a cell pair to the receiver
+ *
+ *  @return False, if the compare should stop (silent mode and differences found)
+ */
+static bool
+report_cell_differences (const DiffContext &ctx, unsigned int cci, const CellDiffData &d, const db::PropertiesRepository &pr, DifferenceReceiver &r, bool &differs)
+{
+  const db::Layout &a = *ctx.a;
+  const db::Layout &b = *ctx.b;
+  bool silent = (ctx.flags & layout_diff::f_silent) != 0;
+
+  if (tl::verbosity () >= 30) {
+    tl::info << "Layout diff - compare cell " << a.cell_name (ctx.common_cells_a [cci]) << " and " << b.cell_name (ctx.common_cells_b [cci]);
+  }
+
+  r.begin_cell (ctx.common_cells [cci], ctx.common_cells_a [cci], ctx.common_cells_b [cci]);
+
+  if (d.bbox_differs) {
+    differs = true;
+    if (silent) {
+      return false;
+    }
+    r.bbox_differs (d.bbox_a, d.bbox_b);
+  }
+
+  if (! d.anotb.empty () || ! d.bnota.empty ()) {
+
+    differs = true;
+
+    if (silent) {
+      return false;
+    }
+
+    r.begin_inst_differences ();
+
+    if (ctx.verbose) {
+
+      r.instances_in_a (d.insts_a, ctx.common_cells, pr);
+      r.instances_in_b (d.insts_b, ctx.common_cells, pr);
+
+      r.instances_in_a_only (d.anotb, a);
+      r.instances_in_b_only (d.bnota, b);
+
+    }
+
+    r.end_inst_differences ();
+
+  }
+
+  for (size_t li = 0; li < ctx.common_layers.size (); ++li) {
+
+    if (tl::verbosity () >= 40) {
+      tl::info << "Layout diff - compare layer " << ctx.common_layers [li].to_string ();
+    }
+
+    r.begin_layer (ctx.common_layers [li], ctx.layers_a [li].second, ctx.layers_a [li].first, ctx.layers_b [li].second, ctx.layers_b [li].first);
+
+    std::map <size_t, LayerDiffData>::const_iterator l = d.layers.find (li);
+    if (l != d.layers.end ()) {
+
+      const LayerDiffData &ld = l->second;
+
+      if (ld.bbox_differs) {
+        differs = true;
+        if (silent) {
+          return false;
+        }
+        r.per_layer_bbox_differs (ld.bbox_a, ld.bbox_b);
+      }
+
+      if (!ld.polygons_a.empty () || !ld.polygons_b.empty ()) {
+        differs = true;
+        if (silent) {
+          return false;
+        }
+        r.begin_polygon_differences ();
+        if (ctx.verbose) {
+          r.detailed_diff (pr, ld.polygons_a, ld.polygons_b);
+        }
+        r.end_polygon_differences ();
+      }
+
+      if (!ld.paths_a.empty () || !ld.paths_b.empty ()) {
+        differs = true;
+        if (silent) {
+          return false;
+        }
+        r.begin_path_differences ();
+        if (ctx.verbose) {
+          r.detailed_diff (pr, ld.paths_a, ld.paths_b);
+        }
+        r.end_path_differences ();
+      }
+
+      if (!ld.texts_a.empty () || !ld.texts_b.empty ()) {
+        differs = true;
+        if (silent) {
+          return false;
+        }
+        r.begin_text_differences ();
+        if (ctx.verbose) {
+          r.detailed_diff (pr, ld.texts_a, ld.texts_b);
+        }
+        r.end_text_differences ();
+      }
+
+      if (!ld.boxes_a.empty () || !ld.boxes_b.empty ()) {
+        differs = true;
+        if (silent) {
+          return false;
+        }
+        r.begin_box_differences ();
+        if (ctx.verbose) {
+          r.detailed_diff (pr, ld.boxes_a, ld.boxes_b);
+        }
+        r.end_box_differences ();
+      }
+
+      if (!ld.edges_a.empty () || !ld.edges_b.empty ()) {
+        differs = true;
+        if (silent) {
+          return false;
+        }
+        r.begin_edge_differences ();
+        if (ctx.verbose) {
+          r.detailed_diff (pr, ld.edges_a, ld.edges_b);
+        }
+        r.end_edge_differences ();
+      }
+
+    }
+
+    r.end_layer ();
+
+  }
+
+  r.end_cell ();
+
+  return true;
+}
+
+/**
+ *  @brief A task comparing one cell pair
+ */
+class LayoutDiffTask
+  : public tl::Task
+{
+public:
+  LayoutDiffTask (const DiffContext *ctx, unsigned int cci, CellDiffData *result)
+    : tl::Task (), mp_ctx (ctx), m_cci (cci), mp_result (result)
+  {
+    //  .. nothing yet ..
+  }
+
+  void perform ()
+  {
+    compare_cells (*mp_ctx, m_cci, *mp_result);
+  }
+
+private:
+  const DiffContext *mp_ctx;
+  unsigned int m_cci;
+  CellDiffData *mp_result;
+};
+
+class LayoutDiffWorker
+  : public tl::Worker
+{
+public:
+  LayoutDiffWorker ()
+    : tl::Worker ()
+  {
+    //  .. nothing yet ..
+  }
+
+  void perform_task (tl::Task *task)
+  {
+    static_cast<LayoutDiffTask *> (task)->perform ();
+  }
+};
+
+/**
+ *  @brief Maps all properties IDs of the source layout, so the mapper is not modified later
+ */
+static void
+prepare_property_mapper (db::PropertyMapper &pm, const db::Layout &source)
+{
+  const db::PropertiesRepository &rep = source.properties_repository ();
+  for (db::PropertiesRepository::iterator p = rep.begin (); p != rep.end (); ++p) {
+    pm (p->first);
+  }
+}
+
+/**
+ *  @brief The number of cell pairs compared in one parallel batch
+ *
+ *  The differences of one batch are kept until they are reported.
+ */
+const size_t diff_batch_size = 1000;
+
+static bool
+do_compare_layouts (const db::Layout &a, const db::Cell *top_a, const db::Layout &b, const db::Cell *top_b, unsigned int flags, db::Coord tolerance, DifferenceReceiver &r, unsigned int nthreads)
 {
   bool differs = false;
 
@@ -813,251 +1421,123 @@ do_compare_layouts (const db::Layout &a, const db::Cell *top_a, const db::Layout
     tl::info << "Layout diff - cell by cell compare";
   }
 
-  std::vector <db::CellInstArrayWithProperties> insts_a;
-  std::vector <db::CellInstArrayWithProperties> insts_b;
-  std::vector <std::pair <db::Polygon, db::properties_id_type> > polygons_a;
-  std::vector <std::pair <db::Polygon, db::properties_id_type> > polygons_b;
-  std::vector <std::pair <db::Path, db::properties_id_type> > paths_a;
-  std::vector <std::pair <db::Path, db::properties_id_type> > paths_b;
-  std::vector <std::pair <db::Text, db::properties_id_type> > texts_a;
-  std::vector <std::pair <db::Text, db::properties_id_type> > texts_b;
-  std::vector <std::pair <db::Box, db::properties_id_type> > boxes_a;
-  std::vector <std::pair <db::Box, db::properties_id_type> > boxes_b;
-  std::vector <std::pair <db::Edge, db::properties_id_type> > edges_a;
-  std::vector <std::pair <db::Edge, db::properties_id_type> > edges_b;
-
-  for (unsigned int cci = 0; cci < common_cells.size (); ++cci) {
-
-    const db::Cell *cell_a = &a.cell (common_cells_a [cci]);
-    const db::Cell *cell_b = &b.cell (common_cells_b [cci]);
-
-    if (tl::verbosity () >= 30) {
-      tl::info << "Layout diff - compare cell " << a.cell_name (cell_a->cell_index ()) << " and " << b.cell_name (cell_b->cell_index ());
+  DiffContext ctx;
+  ctx.a = &a;
+  ctx.b = &b;
+  ctx.flags = flags;
+  ctx.tolerance = tolerance;
+  ctx.verbose = verbose;
+  ctx.common_layers.swap (common_layers);
+  ctx.common_cells.swap (common_cells);
+  ctx.common_cells_a.swap (common_cells_a);
+  ctx.common_cells_b.swap (common_cells_b);
+  ctx.common_cell_indices_a.swap (common_cell_indices_a);
+  ctx.common_cell_indices_b.swap (common_cell_indices_b);
+  ctx.prop_normalize_a = &prop_normalize_a;
+  ctx.prop_normalize_b = &prop_normalize_b;
+  ctx.prop_remap_to_a = &prop_remap_to_a;
+  ctx.prop_remap_to_b = &prop_remap_to_b;
+
+  for (std::vector<db::LayerProperties>::const_iterator cl = ctx.common_layers.begin (); cl != ctx.common_layers.end (); ++cl) {
+
+    std::map<db::LayerProperties, unsigned int, db::LPLogicalLessFunc>::const_iterator la = layers_a.find (*cl);
+    if (la != layers_a.end ()) {
+      ctx.layers_a.push_back (std::make_pair (true, la->second));
+    } else {
+      ctx.layers_a.push_back (std::make_pair (false, 0));
     }
 
-    r.begin_cell (common_cells [cci], common_cells_a [cci], common_cells_b [cci]); 
-
-    if (!verbose && cell_a->bbox () != cell_b->bbox ()) {
-      differs = true;
-      if (flags & layout_diff::f_silent) {
-        return false;
-      }
-      r.bbox_differs (cell_a->bbox (), cell_b->bbox ());
+    std::map<db::LayerProperties, unsigned int, db::LPLogicalLessFunc>::const_iterator lb = layers_b.find (*cl);
+    if (lb != layers_b.end ()) {
+      ctx.layers_b.push_back (std::make_pair (true, lb->second));
+    } else {
+      ctx.layers_b.push_back (std::make_pair (false, 0));
     }
 
-    collect_insts (a, cell_a, flags, common_cell_indices_a, insts_a, prop_normalize_a);
-    collect_insts (b, cell_b, flags, common_cell_indices_b, insts_b, prop_normalize_b);
-
-    std::vector <db::CellInstArrayWithProperties> anotb;
-    std::set_difference (insts_a.begin (), insts_a.end (), insts_b.begin (), insts_b.end (), std::back_inserter (anotb));
-
-    rewrite_instances_to (anotb, flags, common_cells_a, prop_remap_to_a);
-    collect_insts_of_unmapped_cells (a, cell_a, flags, common_cell_indices_a, anotb);
-
-    std::vector <db::CellInstArrayWithProperties> bnota;
-    std::set_difference (insts_b.begin (), insts_b.end (), insts_a.begin (), insts_a.end (), std::back_inserter (bnota));
+  }
 
-    rewrite_instances_to (bnota, flags, common_cells_b, prop_remap_to_b);
-    collect_insts_of_unmapped_cells (b, cell_b, flags, common_cell_indices_b, bnota);
+  if (nthreads == 0) {
 
-    if (! anotb.empty () || ! bnota.empty ()) {
+    for (unsigned int cci = 0; cci < ctx.common_cells.size (); ++cci) {
 
-      differs = true;
+      CellDiffData d;
+      compare_cells (ctx, cci, d);
 
-      if (flags & layout_diff::f_silent) {
+      if (! report_cell_differences (ctx, cci, d, n.properties_repository (), r, differs)) {
         return false;
       }
 
-      r.begin_inst_differences ();
-
-      if (verbose) {
-
-        r.instances_in_a (insts_a, common_cells, n.properties_repository ());
-        r.instances_in_b (insts_b, common_cells, n.properties_repository ());
-
-        r.instances_in_a_only (anotb, a);
-        r.instances_in_b_only (bnota, b);
-
-      }
-
-      r.end_inst_differences ();
+      ++progress;
 
     }
 
+  } else {
 
-    //  compare layer by layer
-    
-    for (std::vector<db::LayerProperties>::const_iterator cl = common_layers.begin (); cl != common_layers.end (); ++cl) {
+    //  prepare for parallel operation: the layouts and property mappers must not be modified
+    //  by the workers
 
-      if (tl::verbosity () >= 40) {
-        tl::info << "Layout diff - compare layer " << cl->to_string ();
-      }
+    a.update ();
+    b.update ();
 
-      bool is_valid_a = false, is_valid_b = false;
-      unsigned int layer_a = 0, layer_b = 0;
+    prepare_property_mapper (prop_normalize_a, a);
+    prepare_property_mapper (prop_normalize_b, b);
+    prepare_property_mapper (prop_remap_to_a, n);
+    prepare_property_mapper (prop_remap_to_b, n);
 
-      if (layers_a.find (*cl) != layers_a.end ()) { 
-        layer_a = layers_a.find (*cl)->second;
-        is_valid_a = true;
-      }
-      
-      if (layers_b.find (*cl) != layers_b.end ()) {
-        layer_b = layers_b.find (*cl)->second;
-        is_valid_b = true;
-      }
+    //  Cells with identical content hashes (including the cell names, so the child cells are
+    //  mapped identically) are identical and don't need to be compared. This is not possible
+    //  with smart cell mapping as the child cells may be mapped differently.
 
-      r.begin_layer (*cl, layer_a, is_valid_a, layer_b, is_valid_b);
+    if (! (flags & layout_diff::f_smart_cell_mapping)) {
 
-      if (!verbose && is_valid_a && is_valid_b && cell_a->bbox (layer_a) != cell_b->bbox (layer_b)) {
-        differs = true;
-        if (flags & layout_diff::f_silent) {
-          return false;
-        }
-        r.per_layer_bbox_differs (cell_a->bbox (layer_a), cell_b->bbox (layer_b));
-      }
-
-      //  compare polygons
-
-      polygons_a.clear();
-      polygons_b.clear();
-      if (is_valid_a) {
-        collect_polygons (a, cell_a, layer_a, flags, polygons_a, prop_normalize_a);
-      } 
-      if (is_valid_b) {
-        collect_polygons (b, cell_b, layer_b, flags, polygons_b, prop_normalize_b);
+      if (tl::verbosity () >= 20) {
+        tl::info << "Layout diff - computing cell hashes";
       }
 
-      reduce (polygons_a, polygons_b, make_polygon_compare_func (tolerance), tolerance > 0);
+      db::CellContentHasher hasher_a (a), hasher_b (b);
+      hasher_a.set_threads (nthreads);
+      hasher_a.set_with_cell_names (true);
+      hasher_b.set_threads (nthreads);
+      hasher_b.set_with_cell_names (true);
 
-      if (!polygons_a.empty () || !polygons_b.empty ()) {
-        differs = true;
-        if (flags & layout_diff::f_silent) {
-          return false;
-        }
-        r.begin_polygon_differences ();
-        if (verbose) {
-          r.detailed_diff (n.properties_repository (), polygons_a, polygons_b);
-        }
-        r.end_polygon_differences ();
+      ctx.skip.reserve (ctx.common_cells.size ());
+      for (unsigned int cci = 0; cci < ctx.common_cells.size (); ++cci) {
+        ctx.skip.push_back (hasher_a.hash (ctx.common_cells_a [cci]) == hasher_b.hash (ctx.common_cells_b [cci]));
       }
 
+    }
 
-      //  compare paths
+    tl::Job<LayoutDiffWorker> job (nthreads);
 
-      if (! (flags & db::layout_diff::f_paths_as_polygons)) {
+    for (size_t from = 0; from < ctx.common_cells.size (); from += diff_batch_size) {
 
-        paths_a.clear();
-        paths_b.clear();
-        if (is_valid_a) {
-          collect_paths (a, cell_a, layer_a, flags, paths_a, prop_normalize_a);
-        }
-        if (is_valid_b) {
-          collect_paths (b, cell_b, layer_b, flags, paths_b, prop_normalize_b);
-        }
-
-        reduce (paths_a, paths_b, make_path_compare_func (tolerance), tolerance > 0);
-
-        if (!paths_a.empty () || !paths_b.empty ()) {
-          differs = true;
-          if (flags & layout_diff::f_silent) {
-            return false;
-          }
-          r.begin_path_differences ();
-          if (verbose) {
-            r.detailed_diff (n.properties_repository (), paths_a, paths_b);
-          }
-          r.end_path_differences ();
-        }
+      size_t to = std::min (ctx.common_cells.size (), from + diff_batch_size);
 
+      std::vector<CellDiffData> results (to - from);
+      for (size_t cci = from; cci < to; ++cci) {
+        job.schedule (new LayoutDiffTask (&ctx, (unsigned int) cci, &results [cci - from]));
       }
 
-      //  compare texts
+      job.start ();
+      job.wait ();
 
-      texts_a.clear();
-      texts_b.clear();
-      if (is_valid_a) {
-        collect_texts (a, cell_a, layer_a, flags, texts_a, prop_normalize_a);
-      }
-      if (is_valid_b) {
-        collect_texts (b, cell_b, layer_b, flags, texts_b, prop_normalize_b);
+      if (job.has_error ()) {
+        throw tl::Exception (tl::to_string (tr ("Errors occurred during layout diff. First error message says:\n")) + job.error_messages ().front ());
       }
 
-      reduce (texts_a, texts_b, make_text_compare_func (tolerance), tolerance > 0);
+      //  report the results in the original order
+      for (size_t cci = from; cci < to; ++cci) {
 
-      if (!texts_a.empty () || !texts_b.empty ()) {
-        differs = true;
-        if (flags & layout_diff::f_silent) {
+        if (! report_cell_differences (ctx, (unsigned int) cci, results [cci - from], n.properties_repository (), r, differs)) {
           return false;
         }
-        r.begin_text_differences ();
-        if (verbose) {
-          r.detailed_diff (n.properties_repository (), texts_a, texts_b);
-        }
-        r.end_text_differences ();
-      }
-
-      //  compare boxes (unless this is done by the polygon compare code)
-      
-      if (! (flags & db::layout_diff::f_boxes_as_polygons)) {
-
-        boxes_a.clear();
-        boxes_b.clear();
-        if (is_valid_a) {
-          collect_boxes (a, cell_a, layer_a, flags, boxes_a, prop_normalize_a);
-        }
-        if (is_valid_b) {
-          collect_boxes (b, cell_b, layer_b, flags, boxes_b, prop_normalize_b);
-        }
 
-        reduce (boxes_a, boxes_b, make_box_compare_func (tolerance), tolerance > 0);
-
-        if (!boxes_a.empty () || !boxes_b.empty ()) {
-          differs = true;
-          if (flags & layout_diff::f_silent) {
-            return false;
-          }
-          r.begin_box_differences ();
-          if (verbose) {
-            r.detailed_diff (n.properties_repository (), boxes_a, boxes_b);
-          }
-          r.end_box_differences ();
-        }
+        ++progress;
 
       }
 
-      //  compare edges
-
-      edges_a.clear();
-      edges_b.clear();
-      if (is_valid_a) {
-        collect_edges (a, cell_a, layer_a, flags, edges_a, prop_normalize_a);
-      }
-      if (is_valid_b) {
-        collect_edges (b, cell_b, layer_b, flags, edges_b, prop_normalize_b);
-      }
-
-      reduce (edges_a, edges_b, make_edge_compare_func (tolerance), tolerance > 0);
-
-      if (!edges_a.empty () || !edges_b.empty ()) {
-        differs = true;
-        if (flags & layout_diff::f_silent) {
-          return false;
-        }
-        r.begin_edge_differences ();
-        if (verbose) {
-          r.detailed_diff (n.properties_repository (), edges_a, edges_b);
-        }
-        r.end_edge_differences ();
-      }
-
-      r.end_layer ();
-
     }
 
-    r.end_cell ();
-
-    ++progress;
-
   }
 
   return ! differs;
@@ -1065,15 +1545,15 @@ do_compare_layouts (const db::Layout &a, const db::Cell *top_a, const db::Layout
 }
 
 bool
-compare_layouts (const db::Layout &a, const db::Layout &b, unsigned int flags, db::Coord tolerance, DifferenceReceiver &r)
+compare_layouts (const db::Layout &a, const db::Layout &b, unsigned int flags, db::Coord tolerance, DifferenceReceiver &r, unsigned int nthreads)
 {
-  return do_compare_layouts (a, 0, b, 0, flags, tolerance, r);
+  return do_compare_layouts (a, 0, b, 0, flags, tolerance, r, nthreads);
 }
 
 bool
-compare_layouts (const db::Layout &a, db::cell_index_type top_a, const db::Layout &b, db::cell_index_type top_b, unsigned int flags, db::Coord tolerance, DifferenceReceiver &r)
+compare_layouts (const db::Layout &a, db::cell_index_type top_a, const db::Layout &b, db::cell_index_type top_b, unsigned int flags, db::Coord tolerance, DifferenceReceiver &r, unsigned int nthreads)
 {
-  return do_compare_layouts (a, &a.cell (top_a), b, &b.cell (top_b), flags, tolerance, r);
+  return do_compare_layouts (a, &a.cell (top_a), b, &b.cell (top_b), flags, tolerance, r, nthreads);
 }
 
 // -------------------------------------------------------------------------------
@@ -1560,21 +2040,21 @@ PrintingDifferenceReceiver::end_cell ()
 //  Implementation of a printing diff 
 
 bool
-compare_layouts (const db::Layout &a, const db::Layout &b, unsigned int flags, db::Coord tolerance, size_t max_count, bool print_properties)
+compare_layouts (const db::Layout &a, const db::Layout &b, unsigned int flags, db::Coord tolerance, size_t max_count, bool print_properties, unsigned int nthreads)
 {
   PrintingDifferenceReceiver r;
   r.set_max_count (max_count);
   r.set_print_properties (print_properties);
-  return compare_layouts (a, b, flags, tolerance, r);
+  return compare_layouts (a, b, flags, tolerance, r, nthreads);
 }
 
 bool
-compare_layouts (const db::Layout &a, db::cell_index_type top_a, const db::Layout &b, db::cell_index_type top_b, unsigned int flags, db::Coord tolerance, size_t max_count, bool print_properties)
+compare_layouts (const db::Layout &a, db::cell_index_type top_a, const db::Layout &b, db::cell_index_type top_b, unsigned int flags, db::Coord tolerance, size_t max_count, bool print_properties, unsigned int nthreads)
 {
   PrintingDifferenceReceiver r;
   r.set_max_count (max_count);
   r.set_print_properties (print_properties);
-  return compare_layouts (a, top_a, b, top_b, flags, tolerance, r);
+  return compare_layouts (a, top_a, b, top_b, flags, tolerance, r, nthreads);
 }
 
 }
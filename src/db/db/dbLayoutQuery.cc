@@ -150,6 +150,7 @@ public:
   { 
     if (m_needs_eval) {
       eval.parse (m_expression, arg.m_pattern, true);
+      m_expression.compile ();
     } else {
       m_pattern = arg.m_pattern;
     }
@@ -177,6 +178,16 @@ private:
 // --------------------------------------------------------------------------------
 //  ShapeFilter definition and implementation
 
+/**
+ *  @brief Specifies how the shape filter confines the shapes to a search region
+ */
+enum ShapeFilterRegionMode
+{
+  NoRegion = 0,
+  TouchingRegion = 1,
+  OverlappingRegion = 2
+};
+
 struct ShapeFilterPropertyIDs
 {
   ShapeFilterPropertyIDs (LayoutQuery *q)
@@ -202,10 +213,17 @@ class DB_PUBLIC ShapeFilterState
   : public FilterStateBase
 {
 public:
-  ShapeFilterState (const FilterBase *filter, const db::LayerMap &layers, db::ShapeIterator::flags_type flags, tl::Eval &eval, db::Layout *layout, bool reading, const ShapeFilterPropertyIDs &pids)
+  ShapeFilterState (const FilterBase *filter, const db::LayerMap &layers, db::ShapeIterator::flags_type flags, ShapeFilterRegionMode region_mode, const db::DBox &region, bool region_in_dbu, tl::Eval &eval, db::Layout *layout, bool reading, const ShapeFilterPropertyIDs &pids)
     : FilterStateBase (filter, layout, eval),
-      m_flags (flags), mp_parent (0), m_reading (reading), m_pids (pids), m_lindex (0)
+      m_flags (flags), m_region_mode (region_mode), mp_parent (0), m_reading (reading), m_pids (pids), m_lindex (0)
   {
+    //  the search region is given in micrometer units unless it is taken from a "where" condition
+    if (region_in_dbu) {
+      m_region = db::Box (region);
+    } else {
+      m_region = db::CplxTrans (layout->dbu ()).inverted () * region;
+    }
+
     //  get the layers which we have to look for
     for (db::Layout::layer_iterator l = layout->begin_layers (); l != layout->end_layers (); ++l) {
       if (layers.is_empty () || layers.logical (*(*l).second).first) {
@@ -230,7 +248,7 @@ public:
     m_lindex = 0;
     if (mp_parent) {
       while (m_layers.size () > m_lindex) {
-        m_shape = mp_parent->shapes (m_layers [m_lindex]).begin (m_flags);
+        m_shape = begin_shapes (m_layers [m_lindex]);
         if (m_shape.at_end ()) {
           ++m_lindex;
         } else {
@@ -259,7 +277,7 @@ public:
         while (m_shape.at_end ()) {
           ++m_lindex;
           if (m_layers.size () > m_lindex) {
-            m_shape = mp_parent->shapes (m_layers [m_lindex]).begin (m_flags);
+            m_shape = begin_shapes (m_layers [m_lindex]);
             m_ignored.clear ();
           } else {
             break;
@@ -321,6 +339,8 @@ public:
 
 private:
   db::ShapeIterator::flags_type m_flags;
+  ShapeFilterRegionMode m_region_mode;
+  db::Box m_region;
   const db::Cell *mp_parent;
   bool m_reading;
   ShapeFilterPropertyIDs m_pids;
@@ -329,17 +349,41 @@ private:
   db::ShapeIterator m_shape;
   db::Shape m_s;
   std::set<db::Shape> m_ignored;
+
+  db::ShapeIterator begin_shapes (unsigned int layer) const
+  {
+    //  With a search region, the shape's box trees are used to deliver the shapes.
+    //  Layers whose bounding box is outside the region are skipped entirely.
+    if (m_region_mode == TouchingRegion) {
+      if (mp_parent->bbox (layer).touches (m_region)) {
+        return mp_parent->shapes (layer).begin_touching (m_region, m_flags);
+      } else {
+        return db::ShapeIterator ();
+      }
+    } else if (m_region_mode == OverlappingRegion) {
+      if (mp_parent->bbox (layer).overlaps (m_region)) {
+        return mp_parent->shapes (layer).begin_overlapping (m_region, m_flags);
+      } else {
+        return db::ShapeIterator ();
+      }
+    } else {
+      return mp_parent->shapes (layer).begin (m_flags);
+    }
+  }
 };
 
 class DB_PUBLIC ShapeFilter
   : public FilterBracket
 {
 public:
-  ShapeFilter (LayoutQuery *q, const db::LayerMap &layers, db::ShapeIterator::flags_type flags, bool reading)
+  ShapeFilter (LayoutQuery *q, const db::LayerMap &layers, db::ShapeIterator::flags_type flags, ShapeFilterRegionMode region_mode, const db::DBox &region, bool region_in_dbu, bool reading)
     : FilterBracket (q), 
       m_pids (q),
       m_layers (layers),
       m_flags (flags), 
+      m_region_mode (region_mode),
+      m_region (region),
+      m_region_in_dbu (region_in_dbu),
       m_reading (reading)
   {
     // .. nothing yet ..
@@ -347,12 +391,12 @@ public:
 
   FilterStateBase *do_create_state (db::Layout *layout, tl::Eval &eval) const
   {
-    return new ShapeFilterState (this, m_layers, m_flags, eval, layout, m_reading, m_pids);
+    return new ShapeFilterState (this, m_layers, m_flags, m_region_mode, m_region, m_region_in_dbu, eval, layout, m_reading, m_pids);
   }
 
   FilterBase *clone (LayoutQuery *q) const
   {
-    return new ShapeFilter (q, m_layers, m_flags, m_reading);
+    return new ShapeFilter (q, m_layers, m_flags, m_region_mode, m_region, m_region_in_dbu, m_reading);
   }
 
   virtual void dump (unsigned int l) const
@@ -360,7 +404,16 @@ public:
     for (unsigned int i = 0; i < l; ++i) {
       std::cout << "  ";
     }
-    std::cout << "ShapeFilter (" << m_layers.to_string () << ", " << (int)m_flags << ") :" << std::endl;
+    std::cout << "ShapeFilter (" << m_layers.to_string () << ", " << (int)m_flags;
+    if (m_region_mode == TouchingRegion) {
+      std::cout << ", touching " << m_region.to_string ();
+    } else if (m_region_mode == OverlappingRegion) {
+      std::cout << ", overlapping " << m_region.to_string ();
+    }
+    if (m_region_mode != NoRegion && m_region_in_dbu) {
+      std::cout << " (dbu)";
+    }
+    std::cout << ") :" << std::endl;
     FilterBracket::dump (l + 1);
   }
 
@@ -368,6 +421,9 @@ private:
   ShapeFilterPropertyIDs m_pids;
   db::LayerMap m_layers;
   db::ShapeIterator::flags_type m_flags;
+  ShapeFilterRegionMode m_region_mode;
+  db::DBox m_region;
+  bool m_region_in_dbu;
   bool m_reading;
 };
 
@@ -1478,6 +1534,7 @@ public:
   {
     if (! do_expression.empty ()) {
       eval.parse (m_do_expression, do_expression, true);
+      m_do_expression.compile ();
     }
   }
 
@@ -1643,10 +1700,12 @@ public:
     for (std::vector<std::string>::const_iterator e = expressions.begin (); e != expressions.end (); ++e) {
       m_expressions.push_back (tl::Expression ());
       eval.parse (m_expressions.back (), *e, true);
+      m_expressions.back ().compile ();
     }
 
     if (! sort_expression.empty ()) {
       eval.parse (m_sort_expression, sort_expression, true);
+      m_sort_expression.compile ();
       m_has_sorting = true;
     }
   }
@@ -1807,6 +1866,7 @@ public:
     : FilterStateBase (filter, layout, eval), m_select (false)
   {
     eval.parse (m_expression, expr, true);
+    m_expression.compile ();
   }
 
   virtual void reset (FilterStateBase *previous) 
@@ -2254,6 +2314,63 @@ parse_cell_filter (tl::Extractor &ex, LayoutQuery *q, FilterBracket *bracket, bo
   }
 }
 
+/**
+ *  @brief Derives a search region from a "where" condition of a shape query
+ *
+ *  If the condition starts with a term like "bbox.touches(Box.new(l,b,r,t))" (or "shape.bbox",
+ *  "shape_bbox" and "overlaps") which is required for the whole condition to be true, the
+ *  box is used as a search region in database units. The condition is evaluated nevertheless,
+ *  so this is merely an optimization.
+ */
+static bool
+region_from_condition (const std::string &expr, ShapeFilterRegionMode &region_mode, db::DBox &region)
+{
+  tl::Extractor ex (expr.c_str ());
+
+  if (! (ex.test ("shape_bbox") || (ex.test ("shape") && ex.test (".") && ex.test ("bbox")) || ex.test ("bbox"))) {
+    return false;
+  }
+
+  ShapeFilterRegionMode mode = NoRegion;
+  if (! ex.test (".")) {
+    return false;
+  } else if (ex.test ("touches")) {
+    mode = TouchingRegion;
+  } else if (ex.test ("overlaps")) {
+    mode = OverlappingRegion;
+  } else {
+    return false;
+  }
+
+  long long c [4];
+  if (! (ex.test ("(") && ex.test ("Box") && ex.test (".") && ex.test ("new") && ex.test ("("))) {
+    return false;
+  }
+  for (unsigned int i = 0; i < 4; ++i) {
+    if ((i > 0 && ! ex.test (",")) || ! ex.try_read (c [i])) {
+      return false;
+    }
+  }
+  if (! (ex.test (")") && ex.test (")"))) {
+    return false;
+  }
+
+  //  the term needs to be the full condition or the first operand of a plain conjunction
+  if (! ex.at_end ()) {
+    if (! ex.test ("&&")) {
+      return false;
+    }
+    std::string rest (ex.skip ());
+    if (rest.find ("||") != std::string::npos || rest.find ("?") != std::string::npos || rest.find (";") != std::string::npos) {
+      return false;
+    }
+  }
+
+  region_mode = mode;
+  region = db::DBox (db::Box (db::Coord (c [0]), db::Coord (c [1]), db::Coord (c [2]), db::Coord (c [3])));
+  return true;
+}
+
 void
 parse_filter (tl::Extractor &ex, LayoutQuery *q, FilterBracket *bracket, bool reading)
 {
@@ -2287,6 +2404,19 @@ parse_filter (tl::Extractor &ex, LayoutQuery *q, FilterBracket *bracket, bool re
       lm.map_expr (ex, 0);
     }
 
+    ShapeFilterRegionMode region_mode = NoRegion;
+    db::DBox region;
+
+    if (ex.test ("touching")) {
+      region_mode = TouchingRegion;
+      ex.test ("box");
+      ex.read (region);
+    } else if (ex.test ("overlapping")) {
+      region_mode = OverlappingRegion;
+      ex.test ("box");
+      ex.read (region);
+    }
+
     ex.test ("of") || ex.test ("from");
 
     std::auto_ptr<FilterBracket> b (new FilterBracket (q));
@@ -2298,14 +2428,25 @@ parse_filter (tl::Extractor &ex, LayoutQuery *q, FilterBracket *bracket, bool re
     bracket->add_child (f);
     bracket->connect_entry (f);
 
+    bool has_condition = false;
+    bool region_in_dbu = false;
+    std::string expr;
+
+    if (ex.test ("where")) {
+      has_condition = true;
+      expr = tl::Eval::parse_expr (ex, true);
+      //  a bounding box predicate in the condition confines the shape search
+      if (region_mode == NoRegion) {
+        region_in_dbu = region_from_condition (expr, region_mode, region);
+      }
+    }
+
     fl = f;
-    f = new ShapeFilter (q, lm, shapes, reading);
+    f = new ShapeFilter (q, lm, shapes, region_mode, region, region_in_dbu, reading);
     bracket->add_child (f);
     fl->connect (f);
 
-    if (ex.test ("where")) {
-
-      std::string expr = tl::Eval::parse_expr (ex, true);
+    if (has_condition) {
 
       fl = f;
       f = new ConditionalFilter (q, expr);
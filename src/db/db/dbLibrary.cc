@@ -30,13 +30,13 @@ namespace db
 {
 
 Library::Library()
-  : m_id (0), m_layout (true)
+  : m_id (0), m_layout (true), m_threads (0)
 {
   // .. nothing yet ..
 }
 
 Library::Library(const Library &d)
-  : gsi::ObjectBase (), m_name (d.m_name), m_description (d.m_description), m_id (0), m_layout (d.m_layout)
+  : gsi::ObjectBase (), m_name (d.m_name), m_description (d.m_description), m_id (0), m_layout (d.m_layout), m_threads (d.m_threads)
 {
   // .. nothing yet ..
 }
@@ -116,6 +116,8 @@ Library::remap_to (db::Library *other)
     //  We do PCell resolution before the library proxy resolution. The reason is that 
     //  PCell's may generate library proxies in their instantiation. Hence we must instantiate
     //  the PCells before we can resolve them.
+    std::map<pcell_id_type, std::pair<std::vector<db::LibraryProxy *>, std::vector<std::vector<tl::Variant> > > > pcell_batches;
+
     for (std::vector<std::pair<db::LibraryProxy *, db::PCellVariant *> >::const_iterator lp = pcells_to_map.begin (); lp != pcells_to_map.end (); ++lp) {
 
       db::cell_index_type ci = lp->first->Cell::cell_index ();
@@ -146,9 +148,11 @@ Library::remap_to (db::Library *other)
 
         } else {
 
-          //  map pcell parameters by name
+          //  map pcell parameters by name - the variants are produced in one batch per PCell below
           std::map<std::string, tl::Variant> param_by_name = lib_pcell->parameters_by_name ();
-          lp->first->remap (other->get_id (), other->layout ().get_pcell_variant (pn.second, new_pcell_decl->map_parameters (param_by_name)));
+          std::pair<std::vector<db::LibraryProxy *>, std::vector<std::vector<tl::Variant> > > &batch = pcell_batches [pn.second];
+          batch.first.push_back (lp->first);
+          batch.second.push_back (new_pcell_decl->map_parameters (param_by_name));
 
         }
 
@@ -156,6 +160,13 @@ Library::remap_to (db::Library *other)
 
     }
 
+    for (std::map<pcell_id_type, std::pair<std::vector<db::LibraryProxy *>, std::vector<std::vector<tl::Variant> > > >::const_iterator b = pcell_batches.begin (); b != pcell_batches.end (); ++b) {
+      std::vector<db::cell_index_type> cells = other->layout ().get_pcell_variants (b->first, b->second.second, other->threads ());
+      for (size_t i = 0; i < cells.size (); ++i) {
+        b->second.first [i]->remap (other->get_id (), cells [i]);
+      }
+    }
+
     for (std::vector<db::LibraryProxy *>::const_iterator lp = lib_cells_to_map.begin (); lp != lib_cells_to_map.end (); ++lp) {
 
       db::cell_index_type ci = (*lp)->Cell::cell_index ();
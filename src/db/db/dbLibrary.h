@@ -28,6 +28,7 @@
 #include "gsiObject.h"
 #include "dbLayout.h"
 #include "tlTypeTraits.h"
+#include "tlThreads.h"
 
 #include <string>
 
@@ -169,6 +170,39 @@ public:
    */
   void remap_to (db::Library *other);
 
+  /**
+   *  @brief Sets the number of threads used for producing PCell variants
+   *
+   *  If this number is larger than zero, PCell variants of this library are produced on
+   *  the given number of worker threads when the proxies of a replaced library are remapped
+   *  to this one (see "remap_to") and the PCell supports concurrent production (see
+   *  PCellDeclaration::can_produce_concurrently).
+   */
+  void set_threads (unsigned int n)
+  {
+    m_threads = n;
+  }
+
+  /**
+   *  @brief Gets the number of threads used for producing PCell variants
+   */
+  unsigned int threads () const
+  {
+    return m_threads;
+  }
+
+  /**
+   *  @brief Gets the lock for resolving library references
+   *
+   *  Resolving a library reference may create new cells (i.e. PCell variants) in the
+   *  library's layout. Readers running in different threads need to hold this lock
+   *  while they resolve references into this library.
+   */
+  tl::Mutex &lock ()
+  {
+    return m_lock;
+  }
+
 private:
   std::string m_name;
   std::string m_description;
@@ -177,6 +211,8 @@ private:
   db::Layout m_layout;
   std::map<db::Layout *, int> m_referrers;
   std::map<db::cell_index_type, int> m_refcount;
+  tl::Mutex m_lock;
+  unsigned int m_threads;
 
   // no copying.
   Library &operator=(const Library &);
@@ -35,19 +35,24 @@ namespace db
 {
 
 static LibraryManager *sp_instance (0);
+static tl::Mutex s_instance_lock;
 
 LibraryManager &
 LibraryManager::instance ()
 {
+  //  NOTE: the lock is always taken - reading sp_instance outside the lock is a data race
+  tl::MutexLocker locker (&s_instance_lock);
   if (sp_instance == 0) {
-    sp_instance = new LibraryManager ();
+    LibraryManager *lm = new LibraryManager ();
     tl::StaticObjects::reg (&sp_instance);
+    sp_instance = lm;
   }
   return *sp_instance;
 }
 
 bool LibraryManager::initialized () 
 {
+  tl::MutexLocker locker (&s_instance_lock);
   return sp_instance != 0;
 }
 
@@ -68,6 +73,8 @@ LibraryManager::~LibraryManager ()
 std::pair<bool, lib_id_type> 
 LibraryManager::lib_by_name (const std::string &name) const
 {
+  tl::MutexLocker locker (&m_lock);
+
   iterator l = m_lib_by_name.find (name);
   if (l == m_lib_by_name.end ()) {
     return std::make_pair (false, lib_id_type (0));
@@ -83,15 +90,26 @@ LibraryManager::delete_lib (Library *library)
     return;
   }
 
-  m_lib_by_name.erase (library->get_name ());
+  bool found = false;
+
+  {
+    tl::MutexLocker locker (&m_lock);
 
-  for (lib_id_type id = 0; id < m_libs.size (); ++id) {
-    if (m_libs [id] == library) {
-      library->remap_to (0);
-      delete library;
-      m_libs [id] = 0;
+    m_lib_by_name.erase (library->get_name ());
+
+    for (lib_id_type id = 0; id < m_libs.size (); ++id) {
+      if (m_libs [id] == library) {
+        m_libs [id] = 0;
+        found = true;
+      }
     }
   }
+
+  //  NOTE: remapping happens outside the lock as it may look up libraries
+  if (found) {
+    library->remap_to (0);
+    delete library;
+  }
 }
 
 lib_id_type 
@@ -100,29 +118,50 @@ LibraryManager::register_lib (Library *library)
   library->keep (); //  marks the library owned by the C++ side of GSI
 
   lib_id_type id;
-  for (id = 0; id < m_libs.size (); ++id) {
-    if (m_libs [id] == 0) {
-      break;
+  Library *old_lib = 0;
+
+  {
+    tl::MutexLocker locker (&m_lock);
+
+    for (id = 0; id < m_libs.size (); ++id) {
+      if (m_libs [id] == 0) {
+        break;
+      }
+    }
+
+    if (id == m_libs.size ()) {
+      m_libs.push_back (library);
+    } else {
+      m_libs [id] = library;
+    }
+
+    library->set_id (id);
+
+    lib_name_map::iterator ln = m_lib_by_name.find (library->get_name ());
+    if (ln != m_lib_by_name.end ()) {
+      old_lib = m_libs [ln->second];
     }
   }
 
-  if (id == m_libs.size ()) {
-    m_libs.push_back (library);
-  } else {
-    m_libs [id] = library;
+  //  if the new library replaces the old one, remap existing library proxies before deleting the library
+  //  NOTE: remapping happens outside the lock as it may look up libraries
+  if (old_lib) {
+    old_lib->remap_to (library);
   }
 
-  library->set_id (id);
+  {
+    tl::MutexLocker locker (&m_lock);
 
-  //  if the new library replaces the old one, remap existing library proxies before deleting the library
-  lib_name_map::iterator ln = m_lib_by_name.find (library->get_name ());
-  if (ln != m_lib_by_name.end () && m_libs [ln->second]) {
-    m_libs [ln->second]->remap_to (library);
-    delete m_libs [ln->second];
-    m_libs [ln->second] = 0;
+    if (old_lib) {
+      m_libs [old_lib->get_id ()] = 0;
+    }
+
+    m_lib_by_name.insert (std::make_pair (library->get_name (), id)).first->second = id;
   }
 
-  m_lib_by_name.insert (std::make_pair (library->get_name (), id)).first->second = id;
+  if (old_lib) {
+    delete old_lib;
+  }
 
   changed_event ();
 
@@ -132,6 +171,8 @@ LibraryManager::register_lib (Library *library)
 Library *
 LibraryManager::lib (lib_id_type id) const
 {
+  tl::MutexLocker locker (&m_lock);
+
   if (id >= m_libs.size ()) {
     return 0;
   } else {
@@ -142,14 +183,18 @@ LibraryManager::lib (lib_id_type id) const
 void
 LibraryManager::clear ()
 {
-  if (m_libs.empty ()) {
-    return;
-  }
-
   //  empty the library table before we delete them - this avoid accesses to invalid libraries while doing so.    
   std::vector<Library *> libs;
-  libs.swap (m_libs);
-  m_lib_by_name.clear ();
+
+  {
+    tl::MutexLocker locker (&m_lock);
+    libs.swap (m_libs);
+    m_lib_by_name.clear ();
+  }
+
+  if (libs.empty ()) {
+    return;
+  }
 
   for (std::vector<Library *>::iterator l = libs.begin (); l != libs.end (); ++l) {
     if (*l) {
@@ -29,6 +29,7 @@
 #include "dbTypes.h"
 #include "tlClassRegistry.h"
 #include "tlEvents.h"
+#include "tlThreads.h"
 
 #include <map>
 #include <vector>
@@ -46,6 +47,9 @@ class Library;
  *
  *  The LibraryManager implements tl::Observed and delivers a signal when the library collection
  *  changes.
+ *
+ *  Library lookups are thread-safe, so readers running in different threads can
+ *  resolve library references.
  */
 class DB_PUBLIC LibraryManager
 {
@@ -146,6 +150,7 @@ public:
 private:
   std::vector<Library *> m_libs;
   lib_name_map m_lib_by_name;
+  mutable tl::Mutex m_lock;
 
   LibraryManager ();
 };
@@ -36,7 +36,8 @@ namespace db
 Manager::Manager ()
   : m_transactions (),
     m_current (m_transactions.begin ()), 
-    m_opened (false), m_replay (false)
+    m_opened (false), m_replay (false),
+    m_max_memory (0), m_memory_used (0)
 {
   //  .. nothing yet ..
 }
@@ -100,13 +101,44 @@ void
 Manager::erase_transactions (transactions_t::iterator from, transactions_t::iterator to)
 {
   for (transactions_t::iterator i = from; i != to; ++i) {
-    for (operations_t::iterator o = i->first.begin (); o != i->first.end (); ++o) {
+    for (operations_t::iterator o = i->operations.begin (); o != i->operations.end (); ++o) {
       delete o->second;
     }
+    m_memory_used -= i->mem_size;
   }
   m_transactions.erase (from, to);
 }
 
+void
+Manager::set_max_memory (size_t max_memory)
+{
+  m_max_memory = max_memory;
+  if (! m_opened && ! m_replay) {
+    limit_memory ();
+  }
+}
+
+void
+Manager::limit_memory ()
+{
+  if (m_max_memory == 0) {
+    return;
+  }
+
+  //  discard the oldest transactions, but keep the last one which can be undone
+  transactions_t::iterator last = m_current;
+  if (last == m_transactions.begin ()) {
+    return;
+  }
+  --last;
+
+  transactions_t::iterator t = m_transactions.begin ();
+  while (m_memory_used > m_max_memory && t != last) {
+    ++t;
+    erase_transactions (m_transactions.begin (), t);
+  }
+}
+
 Manager::transaction_id_t 
 Manager::transaction (const std::string &description, transaction_id_t join_with)
 {
@@ -114,18 +146,18 @@ Manager::transaction (const std::string &description, transaction_id_t join_with
 
     //  close transactions that are still open (was an assertion before)
     if (m_opened) {
-      tl::warn << tl::to_string (tr ("Transaction still opened: ")) << m_current->second;
+      tl::warn << tl::to_string (tr ("Transaction still opened: ")) << m_current->description;
       commit ();
     }
 
     tl_assert (! m_replay);
 
     if (! m_transactions.empty () && reinterpret_cast<transaction_id_t> (& m_transactions.back ()) == join_with) {
-      m_transactions.back ().second = description;
+      m_transactions.back ().description = description;
     } else {
       //  delete all following transactions and add a new one
       erase_transactions (m_current, m_transactions.end ());
-      m_transactions.push_back (transaction_t (operations_t (), description));
+      m_transactions.push_back (transaction_t (description));
     }
     m_current = m_transactions.end ();
     --m_current;
@@ -153,8 +185,22 @@ Manager::commit ()
     m_opened = false;
 
     //  delete transactions that are empty
-    if (m_current->first.begin () != m_current->first.end ()) {
+    if (m_current->operations.begin () != m_current->operations.end ()) {
+
+      //  update the memory statistics - a joined transaction is accounted for again
+      size_t mem_size = sizeof (transaction_t);
+      for (operations_t::iterator o = m_current->operations.begin (); o != m_current->operations.end (); ++o) {
+        o->second->compact ();
+        mem_size += o->second->mem_size () + sizeof (operation_t);
+      }
+      m_memory_used -= m_current->mem_size;
+      m_current->mem_size = mem_size;
+      m_memory_used += mem_size;
+
       ++m_current;
+
+      limit_memory ();
+
     } else {
       erase_transactions (m_current, m_transactions.end ());
       m_current = m_transactions.end ();
@@ -177,11 +223,11 @@ Manager::undo ()
   m_replay = true;
   --m_current;
 
-  tl::RelativeProgress progress (tl::to_string (tr ("Undoing")), m_current->first.size (), 10);
+  tl::RelativeProgress progress (tl::to_string (tr ("Undoing")), m_current->operations.size (), 10);
 
   try {
 
-    for (operations_t::reverse_iterator o = m_current->first.rbegin (); o != m_current->first.rend (); ++o) {
+    for (operations_t::reverse_iterator o = m_current->operations.rbegin (); o != m_current->operations.rend (); ++o) {
 
       tl_assert (o->second->is_done ());
       db::Object *obj = object_by_id (o->first);
@@ -212,12 +258,12 @@ Manager::redo ()
   tl_assert (! m_opened);
   tl_assert (! m_replay);
 
-  tl::RelativeProgress progress (tl::to_string (tr ("Redoing")), m_current->first.size (), 10);
+  tl::RelativeProgress progress (tl::to_string (tr ("Redoing")), m_current->operations.size (), 10);
 
   try {
 
     m_replay = true;
-    for (operations_t::iterator o = m_current->first.begin (); o != m_current->first.end (); ++o) {
+    for (operations_t::iterator o = m_current->operations.begin (); o != m_current->operations.end (); ++o) {
 
       tl_assert (! o->second->is_done ());
       db::Object *obj = object_by_id (o->first);
@@ -245,7 +291,7 @@ Manager::available_undo () const
   } else {
     transactions_t::const_iterator t = m_current;
     --t;
-    return std::make_pair (true, t->second);
+    return std::make_pair (true, t->description);
   }
 }
 
@@ -255,7 +301,7 @@ Manager::available_redo () const
   if (m_opened || m_current == m_transactions.end ()) {
     return std::make_pair (false, std::string (""));
   } else {
-    return std::make_pair (true, m_current->second);
+    return std::make_pair (true, m_current->description);
   }
 }
 
@@ -265,10 +311,10 @@ Manager::last_queued (db::Object *object)
   tl_assert (m_opened);
   tl_assert (! m_replay);
 
-  if (m_current->first.empty () || m_current->first.back ().first != object->id ()) {
+  if (m_current->operations.empty () || m_current->operations.back ().first != object->id ()) {
     return 0;
   } else {
-    return m_current->first.back ().second;
+    return m_current->operations.back ().second;
   }
 }
 
@@ -288,7 +334,7 @@ Manager::queue (db::Object *object, db::Op *op)
       op->set_done (true);
     }
 
-    m_current->first.push_back (std::make_pair (object->id (), op));
+    m_current->operations.push_back (std::make_pair (object->id (), op));
 
   }
 }
@@ -66,6 +66,29 @@ public:
   {
     return m_done;
   }
+
+  /**
+   *  @brief Gets the approximate memory used by this operation in bytes
+   *
+   *  This value is used to enforce the memory limit of the undo buffer (see
+   *  Manager::set_max_memory). Operations holding larger amounts of data should
+   *  reimplement this method.
+   */
+  virtual size_t mem_size () const
+  {
+    return sizeof (Op);
+  }
+
+  /**
+   *  @brief Releases memory not required for undo and redo
+   *
+   *  This method is called when the transaction is committed. Operations collecting
+   *  objects in growing containers can trim these here.
+   */
+  virtual void compact ()
+  {
+    //  .. nothing yet ..
+  }
 };
 
 /**
@@ -218,6 +241,31 @@ public:
    */
   void clear ();
 
+  /**
+   *  @brief Sets the memory limit for the undo buffer
+   *
+   *  If the memory used by the transactions exceeds this limit (in bytes), the oldest transactions
+   *  are discarded when a transaction is committed. The latest transaction is always kept, so it
+   *  can be undone. A value of 0 (the default) disables the limit.
+   */
+  void set_max_memory (size_t max_memory);
+
+  /**
+   *  @brief Gets the memory limit for the undo buffer
+   */
+  size_t max_memory () const
+  {
+    return m_max_memory;
+  }
+
+  /**
+   *  @brief Gets the approximate memory used by the committed transactions in bytes
+   */
+  size_t memory_used () const
+  {
+    return m_memory_used;
+  }
+
   /**
    *  @brief Query if we are within a transaction
    */
@@ -240,15 +288,29 @@ private:
 
   typedef std::pair<db::Manager::ident_t, db::Op *> operation_t;
   typedef std::list<operation_t> operations_t;
-  typedef std::pair<operations_t, std::string> transaction_t;
+
+  struct transaction_t
+  {
+    transaction_t (const std::string &d)
+      : description (d), mem_size (0)
+    { }
+
+    operations_t operations;
+    std::string description;
+    size_t mem_size;
+  };
+
   typedef std::list<transaction_t> transactions_t;
 
   transactions_t m_transactions;
   transactions_t::iterator m_current;
   bool m_opened;
   bool m_replay;
+  size_t m_max_memory;
+  size_t m_memory_used;
 
   void erase_transactions (transactions_t::iterator from, transactions_t::iterator to);
+  void limit_memory ();
 };
 
 /**
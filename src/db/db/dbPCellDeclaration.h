@@ -428,6 +428,37 @@ public:
     return db::Trans ();
   }
 
+  /**
+   *  @brief Returns a key identifying the implementation for the persistent variant cache
+   *
+   *  If this method returns a non-empty string, the geometry produced for a variant may be
+   *  taken from the persistent variant cache (see db::PCellVariantCache) instead of calling
+   *  "produce". The key should change whenever the implementation changes (e.g. a hash of the
+   *  code) and include everything besides the parameters and layers the result depends on
+   *  (e.g. the technology). The default implementation returns an empty string which disables
+   *  caching for this PCell.
+   */
+  virtual std::string cache_key () const
+  {
+    return std::string ();
+  }
+
+  /**
+   *  @brief Returns a value indicating whether variants can be produced on worker threads
+   *
+   *  If this method returns true, "produce" may be called concurrently for different variants.
+   *  Each call receives a private layout with the same database unit as the target layout.
+   *  This layout only has the layers given by "layer_ids" (with the same indexes and properties
+   *  as in the target layout). The implementation must not use shared state, must not access
+   *  other layers and must not create cell instances.
+   *  PCells implemented in scripts are always produced serially. The default implementation
+   *  returns false.
+   */
+  virtual bool can_produce_concurrently () const
+  {
+    return false;
+  }
+
   /**
    *  @brief Add a reference to this object
    *
@@ -23,6 +23,8 @@
 
 #include "dbPCellVariant.h"
 #include "dbPCellHeader.h"
+#include "dbPCellVariantCache.h"
+#include "dbLayoutUtils.h"
 
 #include "tlLog.h"
 
@@ -150,14 +152,19 @@ PCellVariant::update (ImportLayerMapping *layer_mapping)
   PCellHeader *header = pcell_header ();
   if (header && header->declaration ()) {
 
-    db::property_names_id_type pn = layout ()->properties_repository ().prop_name_id (tl::Variant ("name"));
-    db::property_names_id_type dn = layout ()->properties_repository ().prop_name_id (tl::Variant ("description"));
-
     std::vector<unsigned int> layer_ids;
     try {
+
       layer_ids = header->get_layer_indices (*layout (), m_parameters, layer_mapping);
+      if (update_from_cache (layer_ids)) {
+        return;
+      }
+
       header->declaration ()->produce (*layout (), layer_ids, m_parameters, *this);
       m_display_name = header->declaration ()->get_display_name (m_parameters);
+
+      store_in_cache (layer_ids);
+
     } catch (tl::Exception &ex) {
       if (layer_ids.empty ()) {
         tl::error << ex.msg ();
@@ -167,6 +174,83 @@ PCellVariant::update (ImportLayerMapping *layer_mapping)
       }
     }
 
+    produce_guiding_shapes ();
+
+  }
+}
+
+bool
+PCellVariant::update_from_cache (const std::vector<unsigned int> &layer_ids)
+{
+  tl_assert (layout () != 0);
+
+  clear_shapes ();
+  clear_insts ();
+
+  PCellHeader *header = pcell_header ();
+  if (! header || ! header->declaration ()) {
+    return false;
+  }
+
+  db::PCellVariantCache &cache = db::PCellVariantCache::instance ();
+  std::string cache_key = cache.key_for (*header->declaration (), *layout (), layer_ids, m_parameters);
+  if (cache_key.empty () || ! cache.fetch (cache_key, *this, layer_ids, m_display_name)) {
+    return false;
+  }
+
+  produce_guiding_shapes ();
+  return true;
+}
+
+void
+PCellVariant::update_from (const db::Cell &source, const std::vector<unsigned int> &layer_ids)
+{
+  tl_assert (layout () != 0);
+  tl_assert (source.layout () != 0);
+  tl_assert (source.begin ().at_end ());
+
+  clear_shapes ();
+  clear_insts ();
+
+  PCellHeader *header = pcell_header ();
+  if (! header || ! header->declaration ()) {
+    return;
+  }
+
+  db::PropertyMapper pm (*layout (), *source.layout ());
+
+  std::set<unsigned int> layers_seen;
+  for (std::vector<unsigned int>::const_iterator l = layer_ids.begin (); l != layer_ids.end (); ++l) {
+    if (layers_seen.insert (*l).second) {
+      shapes (*l).insert_transformed (source.shapes (*l), db::Trans (), pm);
+    }
+  }
+
+  m_display_name = header->declaration ()->get_display_name (m_parameters);
+
+  store_in_cache (layer_ids);
+  produce_guiding_shapes ();
+}
+
+void
+PCellVariant::store_in_cache (const std::vector<unsigned int> &layer_ids)
+{
+  db::PCellVariantCache &cache = db::PCellVariantCache::instance ();
+  std::string cache_key = cache.key_for (*pcell_header ()->declaration (), *layout (), layer_ids, m_parameters);
+  if (! cache_key.empty ()) {
+    cache.store (cache_key, *this, layer_ids, m_display_name);
+  }
+}
+
+void
+PCellVariant::produce_guiding_shapes ()
+{
+  PCellHeader *header = pcell_header ();
+  if (header && header->declaration ()) {
+
+    db::property_names_id_type pn = layout ()->properties_repository ().prop_name_id (tl::Variant ("name"));
+    db::property_names_id_type dn = layout ()->properties_repository ().prop_name_id (tl::Variant ("description"));
+
     //  produce the shape parameters on the guiding shape layer so they can be edited
     size_t i = 0;
     const std::vector<db::PCellParameterDeclaration> &pcp = header->declaration ()->parameter_declarations ();
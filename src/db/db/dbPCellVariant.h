@@ -120,6 +120,23 @@ public:
    */
   virtual void update (ImportLayerMapping *layer_mapping = 0);
 
+  /**
+   *  @brief Updates the layout from the persistent variant cache
+   *
+   *  "layer_ids" are the target layers as delivered by PCellHeader::get_layer_indices.
+   *  Returns false if there is no cache entry for this variant. In that case, the cell is empty.
+   */
+  bool update_from_cache (const std::vector<unsigned int> &layer_ids);
+
+  /**
+   *  @brief Updates the layout from a cell produced in a different layout
+   *
+   *  This method is used to take over a variant produced in a private layout on a worker
+   *  thread (see Layout::get_pcell_variants). The source cell must not have instances and
+   *  the layer indexes given by "layer_ids" must denote the same layers in both layouts.
+   */
+  void update_from (const db::Cell &source, const std::vector<unsigned int> &layer_ids);
+
   /**
    *  @brief Tell, if this cell is a proxy cell
    *
@@ -149,6 +166,9 @@ protected:
   }
 
 private:
+  void produce_guiding_shapes ();
+  void store_in_cache (const std::vector<unsigned int> &layer_ids);
+
   pcell_parameters_type m_parameters;
   mutable std::string m_display_name;
   size_t m_pcell_id;
@@ -0,0 +1,554 @@
+
+/*
+
+  KLayout Layout Viewer
+  Copyright (C) 2006-2019 Matthias Koefferlein
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+
+
+#include "dbPCellVariantCache.h"
+#include "dbPCellDeclaration.h"
+#include "dbLayout.h"
+#include "dbCell.h"
+#include "tlStream.h"
+#include "tlFileUtils.h"
+#include "tlString.h"
+#include "tlLog.h"
+
+#include <cstdio>
+#include <set>
+
+namespace db
+{
+
+// -------------------------------------------------------------------------------
+//  Encoding primitives
+//
+//  The cache file is a gzip compressed byte stream:
+//
+//    "KLPCV1" <key> <display-name> <#layers> <layer> ...
+//
+//  with strings given as <length> <bytes> and for each layer:
+//
+//    <#shapes> <shape> ...
+//
+//  Each shape starts with a type byte, followed by the shape's data. All integers
+//  are written as variable-length integers with 7 bits per byte, signed integers
+//  are zigzag encoded. Point lists are delta encoded.
+
+static const char *cache_file_magic = "KLPCV1";
+
+enum cached_shape_type
+{
+  cs_box = 1,
+  cs_polygon = 2,
+  cs_path = 3,
+  cs_text = 4,
+  cs_edge = 5,
+  cs_edge_pair = 6
+};
+
+namespace
+{
+
+class CacheWriter
+{
+public:
+  void put_uint (uint64_t v)
+  {
+    while (v >= 0x80) {
+      m_buffer.push_back (char (v | 0x80));
+      v >>= 7;
+    }
+    m_buffer.push_back (char (v));
+  }
+
+  void put_int (int64_t v)
+  {
+    put_uint ((uint64_t (v) << 1) ^ uint64_t (v >> 63));
+  }
+
+  void put_string (const std::string &s)
+  {
+    put_uint (s.size ());
+    m_buffer.insert (m_buffer.end (), s.begin (), s.end ());
+  }
+
+  void put_point (const db::Point &p)
+  {
+    put_int (p.x ());
+    put_int (p.y ());
+  }
+
+  template <class Iter>
+  void put_points (Iter from, Iter to, size_t n)
+  {
+    put_uint (n);
+    db::Point pl;
+    for (Iter p = from; p != to; ++p) {
+      put_int (int64_t ((*p).x ()) - int64_t (pl.x ()));
+      put_int (int64_t ((*p).y ()) - int64_t (pl.y ()));
+      pl = *p;
+    }
+  }
+
+  const std::string &data () const
+  {
+    return m_buffer;
+  }
+
+private:
+  std::string m_buffer;
+};
+
+class CacheReader
+{
+public:
+  CacheReader (const std::string &data)
+    : mp_data (data.c_str ()), mp_end (data.c_str () + data.size ())
+  {
+    //  .. nothing yet ..
+  }
+
+  uint64_t get_uint ()
+  {
+    uint64_t v = 0;
+    unsigned int s = 0;
+    while (true) {
+      if (mp_data == mp_end || s > 63) {
+        throw tl::Exception (tl::to_string (tr ("Corrupt PCell variant cache file")));
+      }
+      unsigned char c = (unsigned char) *mp_data++;
+      v |= uint64_t (c & 0x7f) << s;
+      if ((c & 0x80) == 0) {
+        return v;
+      }
+      s += 7;
+    }
+  }
+
+  int64_t get_int ()
+  {
+    uint64_t v = get_uint ();
+    return int64_t (v >> 1) ^ -int64_t (v & 1);
+  }
+
+  db::Coord get_coord ()
+  {
+    return db::Coord (get_int ());
+  }
+
+  std::string get_string ()
+  {
+    size_t n = size_t (get_uint ());
+    if (size_t (mp_end - mp_data) < n) {
+      throw tl::Exception (tl::to_string (tr ("Corrupt PCell variant cache file")));
+    }
+    std::string s (mp_data, n);
+    mp_data += n;
+    return s;
+  }
+
+  db::Point get_point ()
+  {
+    db::Coord x = get_coord ();
+    db::Coord y = get_coord ();
+    return db::Point (x, y);
+  }
+
+  void get_points (std::vector<db::Point> &pts)
+  {
+    pts.clear ();
+    size_t n = size_t (get_uint ());
+    db::Point pl;
+    for (size_t i = 0; i < n; ++i) {
+      db::Coord dx = get_coord ();
+      db::Coord dy = get_coord ();
+      pl += db::Vector (dx, dy);
+      pts.push_back (pl);
+    }
+  }
+
+private:
+  const char *mp_data, *mp_end;
+};
+
+}
+
+static uint64_t
+hash_key (const std::string &key)
+{
+  //  FNV-1a
+  uint64_t h = 0xcbf29ce484222325ull;
+  for (std::string::const_iterator c = key.begin (); c != key.end (); ++c) {
+    h ^= uint64_t ((unsigned char) *c);
+    h *= 0x100000001b3ull;
+  }
+  return h;
+}
+
+static bool
+encode_shapes (CacheWriter &writer, const db::Shapes &shapes)
+{
+  writer.put_uint (shapes.size ());
+
+  for (db::ShapeIterator s = shapes.begin (db::ShapeIterator::All); ! s.at_end (); ++s) {
+
+    if (s->has_prop_id ()) {
+      return false;
+    }
+
+    if (s->is_box ()) {
+
+      writer.put_uint (cs_box);
+      db::Box b = s->box ();
+      writer.put_point (b.p1 ());
+      writer.put_point (b.p2 ());
+
+    } else if (s->is_polygon () || s->is_simple_polygon ()) {
+
+      writer.put_uint (cs_polygon);
+      db::Polygon poly;
+      s->polygon (poly);
+      writer.put_uint (poly.holes ());
+      writer.put_points (poly.begin_hull (), poly.end_hull (), poly.hull ().size ());
+      for (unsigned int h = 0; h < poly.holes (); ++h) {
+        writer.put_points (poly.begin_hole (h), poly.end_hole (h), poly.hole (h).size ());
+      }
+
+    } else if (s->is_path ()) {
+
+      writer.put_uint (cs_path);
+      db::Path path;
+      s->path (path);
+      writer.put_int (path.width ());
+      writer.put_int (path.bgn_ext ());
+      writer.put_int (path.end_ext ());
+      writer.put_uint (path.round () ? 1 : 0);
+      writer.put_points (path.begin (), path.end (), path.points ());
+
+    } else if (s->is_text ()) {
+
+      writer.put_uint (cs_text);
+      db::Text text;
+      s->text (text);
+      writer.put_string (text.string ());
+      writer.put_uint (text.trans ().rot ());
+      writer.put_point (db::Point () + text.trans ().disp ());
+      writer.put_int (text.size ());
+      writer.put_int (int (text.font ()));
+      writer.put_int (int (text.halign ()));
+      writer.put_int (int (text.valign ()));
+
+    } else if (s->is_edge ()) {
+
+      writer.put_uint (cs_edge);
+      db::Edge e = s->edge ();
+      writer.put_point (e.p1 ());
+      writer.put_point (e.p2 ());
+
+    } else if (s->is_edge_pair ()) {
+
+      writer.put_uint (cs_edge_pair);
+      db::EdgePair ep = s->edge_pair ();
+      writer.put_point (ep.first ().p1 ());
+      writer.put_point (ep.first ().p2 ());
+      writer.put_point (ep.second ().p1 ());
+      writer.put_point (ep.second ().p2 ());
+
+    } else {
+      //  user objects and others are not cached
+      return false;
+    }
+
+  }
+
+  return true;
+}
+
+static void
+decode_shapes (CacheReader &reader, db::Shapes &shapes)
+{
+  std::vector<db::Point> pts;
+
+  size_t n = size_t (reader.get_uint ());
+  for (size_t i = 0; i < n; ++i) {
+
+    unsigned int t = (unsigned int) reader.get_uint ();
+
+    if (t == cs_box) {
+
+      db::Point p1 = reader.get_point ();
+      db::Point p2 = reader.get_point ();
+      shapes.insert (db::Box (p1, p2));
+
+    } else if (t == cs_polygon) {
+
+      unsigned int holes = (unsigned int) reader.get_uint ();
+
+      db::Polygon poly;
+      reader.get_points (pts);
+      poly.assign_hull (pts.begin (), pts.end (), false /*don't compress*/);
+      for (unsigned int h = 0; h < holes; ++h) {
+        reader.get_points (pts);
+        poly.insert_hole (pts.begin (), pts.end (), false /*don't compress*/);
+      }
+
+      shapes.insert (poly);
+
+    } else if (t == cs_path) {
+
+      db::Coord w = reader.get_coord ();
+      db::Coord bgn_ext = reader.get_coord ();
+      db::Coord end_ext = reader.get_coord ();
+      bool round = reader.get_uint () != 0;
+      reader.get_points (pts);
+      shapes.insert (db::Path (pts.begin (), pts.end (), w, bgn_ext, end_ext, round));
+
+    } else if (t == cs_text) {
+
+      std::string s = reader.get_string ();
+      int rot = int (reader.get_uint ());
+      db::Point d = reader.get_point ();
+      db::Coord size = reader.get_coord ();
+      db::Font font = db::Font (reader.get_int ());
+      db::HAlign halign = db::HAlign (reader.get_int ());
+      db::VAlign valign = db::VAlign (reader.get_int ());
+      shapes.insert (db::Text (s, db::Trans (rot, d - db::Point ()), size, font, halign, valign));
+
+    } else if (t == cs_edge) {
+
+      db::Point p1 = reader.get_point ();
+      db::Point p2 = reader.get_point ();
+      shapes.insert (db::Edge (p1, p2));
+
+    } else if (t == cs_edge_pair) {
+
+      db::Point p1 = reader.get_point ();
+      db::Point p2 = reader.get_point ();
+      db::Point p3 = reader.get_point ();
+      db::Point p4 = reader.get_point ();
+      shapes.insert (db::EdgePair (db::Edge (p1, p2), db::Edge (p3, p4)));
+
+    } else {
+      throw tl::Exception (tl::to_string (tr ("Corrupt PCell variant cache file")));
+    }
+
+  }
+}
+
+// -------------------------------------------------------------------------------
+//  PCellVariantCache implementation
+
+PCellVariantCache::PCellVariantCache ()
+  : m_enabled (false)
+{
+  //  .. nothing yet ..
+}
+
+PCellVariantCache &
+PCellVariantCache::instance ()
+{
+  static PCellVariantCache s_instance;
+  return s_instance;
+}
+
+void
+PCellVariantCache::set_path (const std::string &path)
+{
+  if (! path.empty () && ! tl::file_exists (path) && ! tl::mkpath (path)) {
+    throw tl::Exception (tl::to_string (tr ("Unable to create PCell variant cache directory: ")) + path);
+  }
+
+  tl::MutexLocker locker (&m_lock);
+  m_path = path;
+  m_enabled = ! path.empty ();
+}
+
+std::string
+PCellVariantCache::path () const
+{
+  tl::MutexLocker locker (&m_lock);
+  return m_path;
+}
+
+bool
+PCellVariantCache::enabled () const
+{
+  tl::MutexLocker locker (&m_lock);
+  return m_enabled;
+}
+
+std::string
+PCellVariantCache::key_for (const db::PCellDeclaration &decl, const db::Layout &layout, const std::vector<unsigned int> &layer_ids, const std::vector<tl::Variant> &parameters) const
+{
+  if (! enabled ()) {
+    return std::string ();
+  }
+
+  std::string ck = decl.cache_key ();
+  if (ck.empty ()) {
+    return std::string ();
+  }
+
+  std::string key;
+  key += decl.name ();
+  key += "\n";
+  key += ck;
+  key += "\n";
+  key += tl::to_string (layout.dbu ());
+  key += "\n";
+
+  for (std::vector<unsigned int>::const_iterator l = layer_ids.begin (); l != layer_ids.end (); ++l) {
+    if (l != layer_ids.begin ()) {
+      key += ";";
+    }
+    if (layout.is_valid_layer (*l)) {
+      key += layout.get_properties (*l).to_string ();
+    }
+  }
+  key += "\n";
+
+  for (std::vector<tl::Variant>::const_iterator p = parameters.begin (); p != parameters.end (); ++p) {
+    if (p != parameters.begin ()) {
+      key += ",";
+    }
+    key += p->to_parsable_string ();
+  }
+
+  return key;
+}
+
+std::string
+PCellVariantCache::file_for (const std::string &key) const
+{
+  return tl::combine_path (path (), tl::sprintf ("%016llx.pcv.gz", (unsigned long long) hash_key (key)));
+}
+
+bool
+PCellVariantCache::fetch (const std::string &key, db::Cell &cell, const std::vector<unsigned int> &layer_ids, std::string &display_name) const
+{
+  std::string fn = file_for (key);
+  if (! tl::file_exists (fn)) {
+    return false;
+  }
+
+  try {
+
+    std::string data;
+    {
+      tl::InputStream is (fn);
+      data = is.read_all ();
+    }
+
+    CacheReader reader (data);
+    if (reader.get_string () != cache_file_magic) {
+      return false;
+    }
+    //  hash collisions are detected by comparing the full key
+    if (reader.get_string () != key) {
+      return false;
+    }
+
+    display_name = reader.get_string ();
+
+    size_t nlayers = size_t (reader.get_uint ());
+    if (nlayers != layer_ids.size ()) {
+      return false;
+    }
+
+    for (std::vector<unsigned int>::const_iterator l = layer_ids.begin (); l != layer_ids.end (); ++l) {
+      decode_shapes (reader, cell.shapes (*l));
+    }
+
+    return true;
+
+  } catch (tl::Exception &ex) {
+
+    //  corrupt or unreadable files are ignored - the PCell will be produced again
+    tl::warn << tl::to_string (tr ("Ignoring PCell variant cache file ")) << fn << ": " << ex.msg ();
+
+    for (std::vector<unsigned int>::const_iterator l = layer_ids.begin (); l != layer_ids.end (); ++l) {
+      cell.shapes (*l).clear ();
+    }
+
+    return false;
+
+  }
+}
+
+bool
+PCellVariantCache::store (const std::string &key, const db::Cell &cell, const std::vector<unsigned int> &layer_ids, const std::string &display_name) const
+{
+  if (! cell.begin ().at_end ()) {
+    return false;
+  }
+
+  //  shapes on other layers than the PCell's ones would be lost
+  std::set<unsigned int> layer_set (layer_ids.begin (), layer_ids.end ());
+  for (unsigned int l = 0; l < cell.layers (); ++l) {
+    if (layer_set.find (l) == layer_set.end () && ! cell.shapes (l).empty ()) {
+      return false;
+    }
+  }
+
+  CacheWriter writer;
+  writer.put_string (cache_file_magic);
+  writer.put_string (key);
+  writer.put_string (display_name);
+  writer.put_uint (layer_ids.size ());
+
+  for (std::vector<unsigned int>::const_iterator l = layer_ids.begin (); l != layer_ids.end (); ++l) {
+    if (! encode_shapes (writer, cell.shapes (*l))) {
+      return false;
+    }
+  }
+
+  std::string fn = file_for (key);
+
+  std::string tmp_fn;
+
+  try {
+
+    //  write to a unique temporary file in the same directory first, so readers never see partial files
+    tmp_fn = tl::make_tmp_file (tl::filename (fn) + ".", tl::dirname (fn));
+
+    {
+      tl::OutputStream os (tmp_fn, tl::OutputStream::OM_Zlib);
+      os.put (writer.data ().c_str (), writer.data ().size ());
+    }
+
+    if (rename (tmp_fn.c_str (), fn.c_str ()) != 0) {
+      //  another process may have written the file in the meantime
+      tl::rm_file (tmp_fn);
+      return false;
+    }
+
+    return true;
+
+  } catch (tl::Exception &ex) {
+    tl::warn << tl::to_string (tr ("Unable to write PCell variant cache file ")) << fn << ": " << ex.msg ();
+    if (! tmp_fn.empty ()) {
+      tl::rm_file (tmp_fn);
+    }
+    return false;
+  }
+}
+
+}
+
@@ -0,0 +1,126 @@
+
+/*
+
+  KLayout Layout Viewer
+  Copyright (C) 2006-2019 Matthias Koefferlein
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+
+
+#ifndef HDR_dbPCellVariantCache
+#define HDR_dbPCellVariantCache
+
+#include "dbCommon.h"
+#include "dbTypes.h"
+#include "tlThreads.h"
+#include "tlVariant.h"
+
+#include <string>
+#include <vector>
+
+namespace db
+{
+
+class Layout;
+class Cell;
+class PCellDeclaration;
+
+/**
+ *  @brief A persistent, on-disk cache for the geometry of PCell variants
+ *
+ *  Producing PCell variants can be expensive, specifically for PCells implemented
+ *  in scripts. This cache stores the geometry produced for a variant in a compact
+ *  binary file and restores it later without calling the PCell's "produce" method.
+ *
+ *  The cache is opt-in: it needs to be enabled by setting a cache directory and
+ *  only PCells providing a non-empty "cache_key" (see PCellDeclaration::cache_key)
+ *  take part. The cache key is supposed to identify the implementation (e.g. a hash
+ *  of the code and the technology the PCell depends on) so that cache entries become
+ *  invalid when the implementation changes.
+ *
+ *  The entries are identified by the PCell's name, the cache key, the database unit,
+ *  the target layers and the parameters. Only variants consisting of boxes, polygons,
+ *  paths, texts, edges and edge pairs without properties and without child instances
+ *  are cached. Other variants are produced as usual.
+ */
+class DB_PUBLIC PCellVariantCache
+{
+public:
+  /**
+   *  @brief Gets the singleton instance
+   */
+  static PCellVariantCache &instance ();
+
+  /**
+   *  @brief Sets the cache directory
+   *
+   *  An empty path disables the cache. The directory is created if required.
+   */
+  void set_path (const std::string &path);
+
+  /**
+   *  @brief Gets the cache directory
+   */
+  std::string path () const;
+
+  /**
+   *  @brief Gets a value indicating whether the cache is enabled
+   */
+  bool enabled () const;
+
+  /**
+   *  @brief Computes the key for a PCell variant
+   *
+   *  Returns an empty string if the cache is not enabled or the PCell does not take
+   *  part in caching.
+   */
+  std::string key_for (const db::PCellDeclaration &decl, const db::Layout &layout, const std::vector<unsigned int> &layer_ids, const std::vector<tl::Variant> &parameters) const;
+
+  /**
+   *  @brief Restores the geometry for the given key into the cell
+   *
+   *  "layer_ids" are the target layers in the order of the PCell's layer declarations.
+   *  The display name is restored into "display_name".
+   *  Returns false if there is no valid entry for this key.
+   */
+  bool fetch (const std::string &key, db::Cell &cell, const std::vector<unsigned int> &layer_ids, std::string &display_name) const;
+
+  /**
+   *  @brief Stores the geometry of the cell under the given key
+   *
+   *  Returns false if the cell cannot be cached (e.g. because it has instances) or
+   *  the entry cannot be written.
+   */
+  bool store (const std::string &key, const db::Cell &cell, const std::vector<unsigned int> &layer_ids, const std::string &display_name) const;
+
+  /**
+   *  @brief Gets the file path used for the given key
+   */
+  std::string file_for (const std::string &key) const;
+
+private:
+  PCellVariantCache ();
+
+  mutable tl::Mutex m_lock;
+  std::string m_path;
+  bool m_enabled;
+};
+
+}
+
+#endif
+
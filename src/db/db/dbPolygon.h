@@ -985,6 +985,48 @@ public:
     std::swap (mp_points, d.mp_points);
   }
 
+  /**
+   *  @brief Gets the number of points the contour keeps in storage
+   *
+   *  This is the number of points required for "assign_external".
+   */
+  size_type stored_points () const
+  {
+    return m_size;
+  }
+
+  /**
+   *  @brief Copies the given contour into external storage
+   *
+   *  "storage" must provide space for d.stored_points () points. The contour does
+   *  not take ownership of the storage, so "release_external" must be called
+   *  before the contour is destroyed. This feature is intended for repositories
+   *  which allocate their objects in an arena.
+   */
+  void assign_external (const polygon_contour<C> &d, point_type *storage)
+  {
+    release ();
+    m_size = d.m_size;
+    if (d.mp_points != 0) {
+      point_type *pp = (point_type *) ((size_t) d.mp_points & ~3);
+      for (unsigned int i = 0; i < m_size; ++i) {
+        storage[i] = pp[i];
+      }
+      mp_points = (point_type *)((size_t) storage | ((size_t) d.mp_points & 3));
+    }
+  }
+
+  /**
+   *  @brief Detaches the contour from external storage
+   *
+   *  See "assign_external" for details. The contour will be empty after this operation.
+   */
+  void release_external ()
+  {
+    mp_points = 0;
+    m_size = 0;
+  }
+
   /**
    *  @brief Collect memory statistics
    */
@@ -2306,6 +2348,49 @@ public:
     return copy;
   }
 
+  /**
+   *  @brief Gets the number of points the polygon keeps in storage
+   *
+   *  This is the number of points required for "assign_external".
+   */
+  size_t stored_points () const
+  {
+    size_t n = 0;
+    for (typename contour_list_type::const_iterator c = m_ctrs.begin (); c != m_ctrs.end (); ++c) {
+      n += c->stored_points ();
+    }
+    return n;
+  }
+
+  /**
+   *  @brief Copies the given polygon and places the points into external storage
+   *
+   *  See polygon_contour::assign_external for details.
+   */
+  void assign_external (const polygon<C> &d, point_type *storage)
+  {
+    release_external ();
+    m_ctrs.clear ();
+    m_ctrs.resize (d.m_ctrs.size ());
+    for (size_t i = 0; i < m_ctrs.size (); ++i) {
+      m_ctrs [i].assign_external (d.m_ctrs [i], storage);
+      storage += d.m_ctrs [i].stored_points ();
+    }
+    m_bbox = d.m_bbox;
+  }
+
+  /**
+   *  @brief Detaches the polygon from external storage
+   *
+   *  See polygon_contour::release_external for details.
+   */
+  void release_external ()
+  {
+    for (typename contour_list_type::iterator c = m_ctrs.begin (); c != m_ctrs.end (); ++c) {
+      c->release_external ();
+    }
+  }
+
   void mem_stat (MemStatistics *stat, MemStatistics::purpose_t purpose, int cat, bool no_self = false, void *parent = 0) const
   {
     db::mem_stat (stat, purpose, cat, m_ctrs, no_self, parent);
@@ -2980,6 +3065,37 @@ public:
     return double (box ().area ()) / double (area ());
   }
 
+  /**
+   *  @brief Gets the number of points the polygon keeps in storage
+   *
+   *  This is the number of points required for "assign_external".
+   */
+  size_t stored_points () const
+  {
+    return m_hull.stored_points ();
+  }
+
+  /**
+   *  @brief Copies the given polygon and places the points into external storage
+   *
+   *  See polygon_contour::assign_external for details.
+   */
+  void assign_external (const simple_polygon<C> &d, point_type *storage)
+  {
+    m_hull.assign_external (d.m_hull, storage);
+    m_bbox = d.m_bbox;
+  }
+
+  /**
+   *  @brief Detaches the polygon from external storage
+   *
+   *  See polygon_contour::release_external for details.
+   */
+  void release_external ()
+  {
+    m_hull.release_external ();
+  }
+
   void mem_stat (MemStatistics *stat, MemStatistics::purpose_t purpose, int cat, bool no_self = false, void *parent = 0) const
   {
     db::mem_stat (stat, purpose, cat, m_hull, no_self, parent);
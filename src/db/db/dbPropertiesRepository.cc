@@ -34,7 +34,7 @@ namespace db
 //  PropertiesRepository implementation
 
 PropertiesRepository::PropertiesRepository (db::LayoutStateModel *state_model)
-  : mp_state_model (state_model)
+  : m_component_table_end_id (0), m_indexes_valid (true), mp_state_model (state_model)
 {
   //  install empty property set
   properties_set empty_set;
@@ -46,18 +46,52 @@ PropertiesRepository &
 PropertiesRepository::operator= (const PropertiesRepository &d)
 {
   if (&d != this) {
+
+    tl::MutexLocker locker (&m_lock);
+    tl::MutexLocker other_locker (&d.m_lock);
+
     m_propnames_by_id            = d.m_propnames_by_id;
     m_propname_ids_by_name       = d.m_propname_ids_by_name;
     m_properties_by_id           = d.m_properties_by_id;
-    m_properties_ids_by_set      = d.m_properties_ids_by_set;
-    m_properties_component_table = d.m_properties_component_table;
+
+    //  the hash table refers to our own sets, so we need to rebuild it
+    rebuild_indexes ();
+
   }
   return *this;
 }
 
+void
+PropertiesRepository::rebuild_indexes ()
+{
+  m_properties_ids_by_hash.clear ();
+  for (non_const_iterator p = m_properties_by_id.begin (); p != m_properties_by_id.end (); ++p) {
+    m_properties_ids_by_hash.insert (std::make_pair (hash_of (p->second), p));
+  }
+
+  //  the component table is rebuilt on demand
+  m_properties_component_table.clear ();
+  m_component_table_end_id = 0;
+
+  m_indexes_valid = true;
+}
+
+size_t
+PropertiesRepository::hash_of (const properties_set &props)
+{
+  size_t h = props.size ();
+  for (properties_set::const_iterator p = props.begin (); p != props.end (); ++p) {
+    h = (h << 4) ^ (h >> 4) ^ size_t (p->first);
+    h = (h << 4) ^ (h >> 4) ^ p->second.hash ();
+  }
+  return h;
+}
+
 std::pair<bool, property_names_id_type>
 PropertiesRepository::get_id_of_name (const tl::Variant &name) const
 {
+  tl::MutexLocker locker (&m_lock);
+
   std::map <tl::Variant, property_names_id_type>::const_iterator pi = m_propname_ids_by_name.find (name);
   if (pi == m_propname_ids_by_name.end ()) {
     return std::make_pair (false, property_names_id_type (0));
@@ -69,6 +103,8 @@ PropertiesRepository::get_id_of_name (const tl::Variant &name) const
 property_names_id_type 
 PropertiesRepository::prop_name_id (const tl::Variant &name)
 {
+  tl::MutexLocker locker (&m_lock);
+
   std::map <tl::Variant, property_names_id_type>::const_iterator pi = m_propname_ids_by_name.find (name);
   if (pi == m_propname_ids_by_name.end ()) {
     property_names_id_type id = m_propnames_by_id.size ();
@@ -80,50 +116,79 @@ PropertiesRepository::prop_name_id (const tl::Variant &name)
   }
 }
 
-void 
-PropertiesRepository::change_properties (property_names_id_type id, const properties_set &new_props)
+void
+PropertiesRepository::add_to_component_table (properties_id_type id, const properties_set &props) const
+{
+  for (properties_set::const_iterator nv = props.begin (); nv != props.end (); ++nv) {
+    m_properties_component_table.insert (std::make_pair (*nv, properties_id_vector ())).first->second.push_back (id);
+  }
+}
+
+void
+PropertiesRepository::remove_from_component_table (properties_id_type id, const properties_set &props) const
 {
-  const properties_set &old_props = properties (id);
-
-  std::map <properties_set, properties_id_type>::const_iterator pi = m_properties_ids_by_set.find (old_props);
-  if (pi != m_properties_ids_by_set.end ()) {
-
-    //  erase the id from the component table
-    for (properties_set::const_iterator nv = old_props.begin (); nv != old_props.end (); ++nv) {
-      if (m_properties_component_table.find (*nv) != m_properties_component_table.end ()) {
-        properties_id_vector &v = m_properties_component_table [*nv];
-        for (size_t i = 0; i < v.size (); ) {
-          if (v[i] == id) {
-            v.erase (v.begin () + i);
-          } else {
-            ++i;
-          }
+  for (properties_set::const_iterator nv = props.begin (); nv != props.end (); ++nv) {
+    std::map <name_value_pair, properties_id_vector>::iterator t = m_properties_component_table.find (*nv);
+    if (t != m_properties_component_table.end ()) {
+      properties_id_vector &v = t->second;
+      for (size_t i = 0; i < v.size (); ) {
+        if (v[i] == id) {
+          v.erase (v.begin () + i);
+        } else {
+          ++i;
         }
       }
     }
+  }
+}
 
-    //  and insert again
-    m_properties_ids_by_set.erase (old_props);
-    m_properties_ids_by_set.insert (std::make_pair (new_props, id));
+void 
+PropertiesRepository::change_properties (property_names_id_type id, const properties_set &new_props)
+{
+  {
+    tl::MutexLocker locker (&m_lock);
 
-    m_properties_by_id [id] = new_props;
+    if (! m_indexes_valid) {
+      rebuild_indexes ();
+    }
+
+    non_const_iterator p = m_properties_by_id.find (id);
+    if (p == m_properties_by_id.end ()) {
+      return;
+    }
 
-    for (properties_set::const_iterator nv = new_props.begin (); nv != new_props.end (); ++nv) {
-      m_properties_component_table.insert (std::make_pair (*nv, properties_id_vector ())).first->second.push_back (id);
+    //  remove the entry from the hash table
+    std::pair<properties_hash_table::iterator, properties_hash_table::iterator> hr = m_properties_ids_by_hash.equal_range (hash_of (p->second));
+    for (properties_hash_table::iterator h = hr.first; h != hr.second; ++h) {
+      if (h->second == p) {
+        m_properties_ids_by_hash.erase (h);
+        break;
+      }
     }
 
-    //  signal the change of the properties ID's. This way for example, the layer views
-    //  can recompute the property selectors
-    if (mp_state_model) {
-      mp_state_model->prop_ids_changed ();
+    //  update the component table unless the id is not part of it yet
+    if (id < m_component_table_end_id) {
+      remove_from_component_table (id, p->second);
+      add_to_component_table (id, new_props);
     }
 
+    //  and insert again
+    p->second = new_props;
+    m_properties_ids_by_hash.insert (std::make_pair (hash_of (new_props), p));
+  }
+
+  //  signal the change of the properties ID's. This way for example, the layer views
+  //  can recompute the property selectors
+  if (mp_state_model) {
+    mp_state_model->prop_ids_changed ();
   }
 }
 
 void 
 PropertiesRepository::change_name (property_names_id_type id, const tl::Variant &new_name)
 {
+  tl::MutexLocker locker (&m_lock);
+
   std::map <property_names_id_type, tl::Variant>::iterator pi = m_propnames_by_id.find (id);
   tl_assert (pi != m_propnames_by_id.end ());
   pi->second = new_name;
@@ -134,38 +199,50 @@ PropertiesRepository::change_name (property_names_id_type id, const tl::Variant
 const tl::Variant &
 PropertiesRepository::prop_name (property_names_id_type id) const
 {
+  tl::MutexLocker locker (&m_lock);
   return m_propnames_by_id.find (id)->second;
 }
 
 properties_id_type 
 PropertiesRepository::properties_id (const properties_set &props)
 {
-  std::map <properties_set, properties_id_type>::const_iterator pi = m_properties_ids_by_set.find (props);
-  if (pi == m_properties_ids_by_set.end ()) {
+  size_t h = hash_of (props);
+  properties_id_type id = 0;
+
+  {
+    tl::MutexLocker locker (&m_lock);
 
-    properties_id_type id = m_properties_ids_by_set.size ();
-    m_properties_ids_by_set.insert (std::make_pair (props, id));
-    m_properties_by_id.insert (std::make_pair (id, props));
-    for (properties_set::const_iterator nv = props.begin (); nv != props.end (); ++nv) {
-      m_properties_component_table.insert (std::make_pair (*nv, properties_id_vector ())).first->second.push_back (id);
+    if (! m_indexes_valid) {
+      rebuild_indexes ();
     }
 
-    //  signal the change of the properties ID's. This way for example, the layer views
-    //  can recompute the property selectors
-    if (mp_state_model) {
-      mp_state_model->prop_ids_changed ();
+    std::pair<properties_hash_table::const_iterator, properties_hash_table::const_iterator> hr = m_properties_ids_by_hash.equal_range (h);
+    for (properties_hash_table::const_iterator i = hr.first; i != hr.second; ++i) {
+      if (i->second->second == props) {
+        return i->second->first;
+      }
     }
 
-    return id;
+    //  NOTE: ids are assigned densely, so the new set goes to the end of the map
+    id = m_properties_by_id.size ();
+    non_const_iterator p = m_properties_by_id.insert (m_properties_by_id.end (), std::make_pair (id, props));
+    m_properties_ids_by_hash.insert (std::make_pair (h, p));
+  }
 
-  } else {
-    return pi->second;
+  //  signal the change of the properties ID's. This way for example, the layer views
+  //  can recompute the property selectors
+  if (mp_state_model) {
+    mp_state_model->prop_ids_changed ();
   }
+
+  return id;
 }
 
 const PropertiesRepository::properties_set &
 PropertiesRepository::properties (properties_id_type id) const
 {
+  tl::MutexLocker locker (&m_lock);
+
   iterator p = m_properties_by_id.find (id);
   if (p != m_properties_by_id.end ()) {
     return p->second;
@@ -178,16 +255,29 @@ PropertiesRepository::properties (properties_id_type id) const
 bool
 PropertiesRepository::is_valid_properties_id (properties_id_type id) const
 {
+  tl::MutexLocker locker (&m_lock);
   return m_properties_by_id.find (id) != m_properties_by_id.end ();
 }
 
-const PropertiesRepository::properties_id_vector &
+PropertiesRepository::properties_id_vector
 PropertiesRepository::properties_ids_by_name_value (const name_value_pair &nv) const
 {
+  tl::MutexLocker locker (&m_lock);
+
+  //  bring the component table up to date
+  if (! m_indexes_valid) {
+    const_cast<PropertiesRepository *> (this)->rebuild_indexes ();
+  }
+  if (m_component_table_end_id < properties_id_type (m_properties_by_id.size ())) {
+    for (iterator p = m_properties_by_id.lower_bound (m_component_table_end_id); p != m_properties_by_id.end (); ++p) {
+      add_to_component_table (p->first, p->second);
+    }
+    m_component_table_end_id = m_properties_by_id.size ();
+  }
+
   std::map <name_value_pair, properties_id_vector>::const_iterator idv = m_properties_component_table.find (nv);
   if (idv == m_properties_component_table.end ()) {
-    static properties_id_vector empty;
-    return empty;
+    return properties_id_vector ();
   } else {
     return idv->second;
   }
@@ -29,10 +29,12 @@
 #include "dbMemStatistics.h"
 
 #include "tlVariant.h"
+#include "tlThreads.h"
 
 #include <vector>
 #include <string>
 #include <map>
+#include <unordered_map>
 
 namespace db
 {
@@ -46,6 +48,13 @@ class LayoutStateModel;
  *  an unique Id which can be stored with a object_with_properties element.
  *  For performance reasons property names (which are strings) are not
  *  stored as such but as integers.
+ *
+ *  Property sets are interned through a hash table, so looking up the Id
+ *  for a set does not require comparing complete sets.
+ *  The lookup and translation methods are thread-safe, so readers and processors
+ *  running in multiple threads may share a repository. The iterators
+ *  and the "non_const" methods are not protected and must not be used while
+ *  other threads modify the repository.
  */
 
 class DB_PUBLIC PropertiesRepository
@@ -112,7 +121,7 @@ public:
    *  @brief Associate a name with a name Id
    * 
    *  This method will return the name associated with the given Id.
-   *  It will assert if the Id is not a valid one.
+   *  The Id must be a valid one.
    */
   const tl::Variant &prop_name (property_names_id_type id) const;
   
@@ -140,9 +149,13 @@ public:
 
   /**
    *  @brief Iterate over Id/Properties sets (non-const)
+   *
+   *  As the sets may be modified through the iterator, the lookup tables are
+   *  rebuilt on the next lookup.
    */
   non_const_iterator begin_non_const () 
   {
+    m_indexes_valid = false;
     return m_properties_by_id.begin ();
   }
 
@@ -192,8 +205,13 @@ public:
    *  For a given name/value pair, this method returns a vector of ids
    *  of property sets that contain the given name/value pair. This method
    *  is intended for use with the properties_id resolution algorithm.
+   *
+   *  The table behind this method is built on demand, so the first call
+   *  after new property sets have been added takes somewhat longer.
+   *  The vector is returned by value as the table may change when other
+   *  threads add property sets.
    */
-  const properties_id_vector &properties_ids_by_name_value (const name_value_pair &nv) const;
+  properties_id_vector properties_ids_by_name_value (const name_value_pair &nv) const;
 
   /**
    *  @brief Translate a properties id from one repository to this one
@@ -219,19 +237,32 @@ public:
     db::mem_stat (stat, purpose, cat, m_propnames_by_id, true, parent);
     db::mem_stat (stat, purpose, cat, m_propname_ids_by_name, true, parent);
     db::mem_stat (stat, purpose, cat, m_properties_by_id, true, parent);
-    db::mem_stat (stat, purpose, cat, m_properties_ids_by_set, true, parent);
     db::mem_stat (stat, purpose, cat, m_properties_component_table, true, parent);
+
+    //  NOTE: the hash table nodes are estimated as value plus next pointer
+    size_t hs = sizeof (void *) * m_properties_ids_by_hash.bucket_count () + (sizeof (properties_hash_table::value_type) + sizeof (void *)) * m_properties_ids_by_hash.size ();
+    stat->add (typeid (properties_hash_table), (void *) &m_properties_ids_by_hash, hs, hs, parent, purpose, cat);
   }
 
 private:
+  typedef std::unordered_multimap <size_t, non_const_iterator> properties_hash_table;
+
   std::map <property_names_id_type, tl::Variant> m_propnames_by_id;
   std::map <tl::Variant, property_names_id_type> m_propname_ids_by_name;
 
   std::map <properties_id_type, properties_set> m_properties_by_id;
-  std::map <properties_set, properties_id_type> m_properties_ids_by_set;
-  std::map <name_value_pair, properties_id_vector> m_properties_component_table;
+  properties_hash_table m_properties_ids_by_hash;
+  mutable std::map <name_value_pair, properties_id_vector> m_properties_component_table;
+  mutable properties_id_type m_component_table_end_id;
+  bool m_indexes_valid;
 
   db::LayoutStateModel *mp_state_model;
+  mutable tl::Mutex m_lock;
+
+  static size_t hash_of (const properties_set &props);
+  void add_to_component_table (properties_id_type id, const properties_set &props) const;
+  void remove_from_component_table (properties_id_type id, const properties_set &props) const;
+  void rebuild_indexes ();
 
   PropertiesRepository (const PropertiesRepository &d);
 };
@@ -24,6 +24,7 @@
 #include "dbReader.h"
 #include "dbStream.h"
 #include "tlClassRegistry.h"
+#include "tlThreadedWorkers.h"
 
 namespace db
 {
@@ -74,5 +75,94 @@ Reader::~Reader ()
   }
 }
 
+// ---------------------------------------------------------------
+//  MultiReader implementation
+
+class MultiReaderTask
+  : public tl::Task
+{
+public:
+  MultiReaderTask (const std::string &path, db::Layout *layout, const db::LoadLayoutOptions *options)
+    : tl::Task (), m_path (path), mp_layout (layout), mp_options (options)
+  {
+    //  .. nothing yet ..
+  }
+
+  void read () const
+  {
+    MultiReader::read_file (m_path, *mp_layout, *mp_options);
+  }
+
+private:
+  std::string m_path;
+  db::Layout *mp_layout;
+  const db::LoadLayoutOptions *mp_options;
+};
+
+class MultiReaderWorker
+  : public tl::Worker
+{
+public:
+  MultiReaderWorker ()
+    : tl::Worker ()
+  {
+    //  .. nothing yet ..
+  }
+
+  void perform_task (tl::Task *task)
+  {
+    static_cast<MultiReaderTask *> (task)->read ();
+  }
+};
+
+MultiReader::MultiReader ()
+{
+  //  .. nothing yet ..
+}
+
+void
+MultiReader::add (const std::string &path, db::Layout &layout, const db::LoadLayoutOptions &options)
+{
+  m_entries.push_back (Entry (path, &layout, options));
+}
+
+void
+MultiReader::read_file (const std::string &path, db::Layout &layout, const db::LoadLayoutOptions &options)
+{
+  tl::InputStream stream (path);
+  db::Reader reader (stream);
+  reader.read (layout, options);
+}
+
+void
+MultiReader::read (int threads)
+{
+  std::vector<Entry> entries;
+  entries.swap (m_entries);
+
+  if (threads <= 0 || entries.size () < 2) {
+
+    for (std::vector<Entry>::const_iterator e = entries.begin (); e != entries.end (); ++e) {
+      read_file (e->path, *e->layout, e->options);
+    }
+
+  } else {
+
+    tl::Job<MultiReaderWorker> job (std::min (threads, int (entries.size ())));
+
+    for (std::vector<Entry>::const_iterator e = entries.begin (); e != entries.end (); ++e) {
+      job.schedule (new MultiReaderTask (e->path, e->layout, &e->options));
+    }
+
+    job.start ();
+    job.wait ();
+
+    if (job.has_error ()) {
+      throw db::ReaderException (tl::to_string (tr ("Errors occurred while reading the layouts. First error message says:\n")) + job.error_messages ().front ());
+    }
+
+  }
+}
+
 }
 
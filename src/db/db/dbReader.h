@@ -178,6 +178,78 @@ private:
   tl::InputStream &m_stream;
 };
 
+/**
+ *  @brief A reader for loading multiple layouts concurrently
+ *
+ *  Files are registered together with their target layouts using "add".
+ *  "read" will then load the files into the layouts, each file on a separate
+ *  worker thread. The layouts must be distinct objects and must not be
+ *  accessed otherwise while "read" is executing.
+ */
+class DB_PUBLIC MultiReader
+{
+public:
+  /**
+   *  @brief Constructor
+   */
+  MultiReader ();
+
+  /**
+   *  @brief Registers a file for reading
+   *
+   *  @param path The path of the file to read (may be gzip compressed)
+   *  @param layout The layout object to read the file into
+   *  @param options The options to use for reading this file
+   */
+  void add (const std::string &path, db::Layout &layout, const db::LoadLayoutOptions &options);
+
+  /**
+   *  @brief Reads the files
+   *
+   *  @param threads The number of threads to use. If 0, the files are read one after another in the calling thread.
+   *
+   *  Errors are reported by throwing a db::ReaderException after all files have been read.
+   *  The registered files are cleared after reading.
+   */
+  void read (int threads);
+
+  /**
+   *  @brief Gets the number of registered files
+   */
+  size_t size () const
+  {
+    return m_entries.size ();
+  }
+
+  /**
+   *  @brief Clears the list of files to read
+   */
+  void clear ()
+  {
+    m_entries.clear ();
+  }
+
+  /**
+   *  @brief Reads a single file into the given layout
+   *  This method is used for reading the files in the worker threads.
+   */
+  static void read_file (const std::string &path, db::Layout &layout, const db::LoadLayoutOptions &options);
+
+private:
+  struct Entry
+  {
+    Entry (const std::string &_path, db::Layout *_layout, const db::LoadLayoutOptions &_options)
+      : path (_path), layout (_layout), options (_options)
+    { }
+
+    std::string path;
+    db::Layout *layout;
+    db::LoadLayoutOptions options;
+  };
+
+  std::vector<Entry> m_entries;
+};
+
 }
 
 #endif
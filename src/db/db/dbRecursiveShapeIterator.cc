@@ -82,6 +82,9 @@ RecursiveShapeIterator &RecursiveShapeIterator::operator= (const RecursiveShapeI
     m_inst_quad_id = d.m_inst_quad_id;
     m_inst_quad_id_stack = d.m_inst_quad_id_stack;
     m_shape_quad_id = d.m_shape_quad_id;
+    m_partitioned = d.m_partitioned;
+    m_partition_min = d.m_partition_min;
+    m_partition_max = d.m_partition_max;
 
   }
   return *this;
@@ -106,6 +109,8 @@ RecursiveShapeIterator::RecursiveShapeIterator ()
   m_needs_reinit = false;
   m_inst_quad_id = 0;
   m_shape_quad_id = 0;
+  m_partitioned = false;
+  m_partition_min = m_partition_max = 0;
 }
 
 RecursiveShapeIterator::RecursiveShapeIterator (const shapes_type &shapes)
@@ -286,6 +291,8 @@ RecursiveShapeIterator::init ()
   m_shape_quad_id = 0;
   mp_cell = 0;
   m_current_layer = 0;
+  m_partitioned = false;
+  m_partition_min = m_partition_max = 0;
 }
 
 void
@@ -360,6 +367,59 @@ RecursiveShapeIterator::confine_region (const region_type &region)
   m_needs_reinit = true;
 }
 
+std::vector<RecursiveShapeIterator>
+RecursiveShapeIterator::partition (unsigned int n) const
+{
+  std::vector<RecursiveShapeIterator> parts;
+
+  box_type bx = bbox ();
+  if (n < 2 || bx.empty () || m_partitioned || bx.width () < n) {
+    parts.push_back (*this);
+    parts.back ().reset ();
+    return parts;
+  }
+
+  //  Confining the region to the stripes is only exact if all transformations
+  //  map boxes to boxes.
+  bool confine = true;
+  if (mp_layout) {
+    for (db::Layout::const_iterator c = mp_layout->begin (); c != mp_layout->end () && confine; ++c) {
+      for (db::Cell::const_iterator i = c->begin (); ! i.at_end () && confine; ++i) {
+        if (i->cell_inst ().is_complex () && ! i->cell_inst ().complex_trans ().is_ortho ()) {
+          confine = false;
+        }
+      }
+    }
+  }
+
+  parts.reserve (n);
+
+  for (unsigned int i = 0; i < n; ++i) {
+
+    db::Coord x1 = bx.left () + db::Coord ((int64_t (bx.width ()) * i) / n);
+    db::Coord x2 = bx.left () + db::Coord ((int64_t (bx.width ()) * (i + 1)) / n);
+
+    parts.push_back (*this);
+    RecursiveShapeIterator &part = parts.back ();
+
+    part.m_partitioned = true;
+    part.m_partition_min = (i == 0 ? std::numeric_limits<db::Coord>::min () : x1);
+    part.m_partition_max = (i + 1 == n ? std::numeric_limits<db::Coord>::max () : x2);
+
+    if (confine) {
+      //  NOTE: the stripe is enlarged by one DBU, so in overlapping mode, degenerated shapes
+      //  (texts, axis-parallel edges) on the stripe or bbox borders are still found. The left-edge
+      //  filter ensures they are delivered by one part only.
+      part.confine_region (box_type (x1, bx.bottom (), x2, bx.top ()).enlarged (db::Vector (1, 1)));
+    }
+
+    part.reset ();
+
+  }
+
+  return parts;
+}
+
 void
 RecursiveShapeIterator::set_layer (unsigned int layer)
 {
@@ -367,6 +427,9 @@ RecursiveShapeIterator::set_layer (unsigned int layer)
     m_has_layers = false;
     m_layers.clear ();
     m_layer = layer;
+    if (mp_layout) {
+      m_box_convert = db::box_convert<db::CellInst> (*mp_layout, layer);
+    }
     m_needs_reinit = true;
   }
 }
@@ -378,6 +441,9 @@ RecursiveShapeIterator::set_layers (const std::vector<unsigned int> &layers)
     m_has_layers = true;
     m_layers = layers;
     m_layer = 0;
+    if (mp_layout) {
+      m_box_convert = db::box_convert<db::CellInst> (*mp_layout);
+    }
     m_needs_reinit = true;
   }
 }
@@ -605,6 +671,33 @@ RecursiveShapeIterator::skip_shape_iter_for_complex_region () const
   }
 }
 
+void
+RecursiveShapeIterator::skip_shapes () const
+{
+  if (! m_local_complex_region_stack.empty ()) {
+    skip_shape_iter_for_complex_region ();
+  }
+
+  if (m_partitioned) {
+
+    //  skip shapes belonging to other parts
+    while (! m_shape.at_end ()) {
+
+      db::Coord l = (m_trans * m_shape->bbox ()).left ();
+      if (l >= m_partition_min && l < m_partition_max) {
+        break;
+      }
+
+      ++m_shape;
+      if (! m_local_complex_region_stack.empty ()) {
+        skip_shape_iter_for_complex_region ();
+      }
+
+    }
+
+  }
+}
+
 void
 RecursiveShapeIterator::skip_inst_iter_for_complex_region () const
 {
@@ -638,10 +731,7 @@ RecursiveShapeIterator::next (RecursiveShapeReceiver *receiver)
   if (! at_end ()) {
 
     ++m_shape;
-
-    if (! m_local_complex_region_stack.empty ()) {
-      skip_shape_iter_for_complex_region ();
-    }
+    skip_shapes ();
 
     if (! mp_shapes && m_shape.at_end ()) {
       next_shape (receiver);
@@ -832,9 +922,7 @@ RecursiveShapeIterator::start_shapes () const
 
   m_shape_quad_id = 0;
 
-  if (! m_local_complex_region_stack.empty ()) {
-    skip_shape_iter_for_complex_region ();
-  }
+  skip_shapes ();
 }
 
 void
@@ -850,10 +938,8 @@ RecursiveShapeIterator::new_layer () const
 
   m_shape_quad_id = 0;
 
-  //  skip instance quad if possible
-  if (! m_local_complex_region_stack.empty ()) {
-    skip_shape_iter_for_complex_region ();
-  }
+  //  skip shape quad if possible
+  skip_shapes ();
 }
 
 void 
@@ -372,6 +372,24 @@ public:
    */
   void confine_region (const region_type &region);
 
+  /**
+   *  @brief Splits the iteration into independent parts
+   *
+   *  This method delivers up to n iterators which together deliver the same shapes
+   *  than this iterator, each shape being delivered by exactly one of them. The
+   *  parts can be used in different threads for example. The iterators are reset.
+   *
+   *  The parts are formed by vertical stripes of the iterator's bounding box. A shape
+   *  belongs to the stripe which contains the left edge of the shape's bounding box
+   *  in the top cell. Each part confines the search region to its stripe, so
+   *  instances outside the stripe are not visited. As this is not exact for instances
+   *  with arbitrary-angle rotations, layouts having such instances are not confined.
+   *  In this case each part visits all shapes, but delivers only its own ones.
+   *
+   *  If the iterator is empty, a single copy of this iterator is returned.
+   */
+  std::vector<RecursiveShapeIterator> partition (unsigned int n) const;
+
   /**
    *  @brief Gets a flag indicating whether overlapping shapes are selected when a region is used
    */
@@ -741,11 +759,14 @@ private:
   mutable size_t m_inst_quad_id;
   mutable std::vector<size_t> m_inst_quad_id_stack;
   mutable size_t m_shape_quad_id;
+  bool m_partitioned;
+  db::Coord m_partition_min, m_partition_max;
 
   void init ();
   void init_region (const region_type &region);
   void init_region (const box_type &region);
   void skip_shape_iter_for_complex_region () const;
+  void skip_shapes () const;
   void skip_inst_iter_for_complex_region () const;
   void validate (RecursiveShapeReceiver *receiver) const;
   void start_shapes () const;
@@ -32,6 +32,8 @@
 #include "dbMemStatistics.h"
 
 #include <set>
+#include <vector>
+#include <new>
 
 namespace db {
 
@@ -122,6 +124,200 @@ private:
   set_type m_set;
 };
 
+/**
+ *  @brief A repository which allocates the shapes and their points from an arena
+ *
+ *  Polygons are heavy on small allocations: every polygon needs at least one
+ *  for the point list. As shapes are never removed from a repository, the
+ *  repository can place the shapes and their points into larger memory
+ *  chunks which are freed together when the repository is destroyed.
+ *  This saves allocation overhead and keeps shapes inserted consecutively
+ *  close in memory.
+ *
+ *  The shape type needs to provide "stored_points", "assign_external" and
+ *  "release_external" (see db::polygon_contour).
+ */
+
+template <class Sh>
+class arena_repository
+{
+public:
+  typedef typename Sh::coord_type coord_type;
+  typedef typename Sh::point_type point_type;
+
+  /**
+   *  @brief The standard constructor
+   */
+  arena_repository ()
+    : m_set (), mp_free (0), m_free_bytes (0)
+  {
+    //  .. nothing yet ..
+  }
+
+  /**
+   *  @brief The copy constructor
+   */
+  arena_repository (const arena_repository<Sh> &d)
+    : m_set (), mp_free (0), m_free_bytes (0)
+  {
+    insert_from (d);
+  }
+
+  /**
+   *  @brief The destructor
+   */
+  ~arena_repository ()
+  {
+    clear ();
+  }
+
+  /**
+   *  @brief Assignment
+   */
+  arena_repository<Sh> &operator= (const arena_repository<Sh> &d)
+  {
+    if (&d != this) {
+      clear ();
+      insert_from (d);
+    }
+    return *this;
+  }
+
+  /**
+   *  @brief Insert a shape into the repository
+   *
+   *  Inserts a shape into the repository.
+   *
+   *  @return A pointer to the instance of the identical shape
+   */
+  const Sh *insert (const Sh &shape)
+  {
+    typename set_type::iterator f = m_set.lower_bound (&shape);
+    if (f != m_set.end () && ! (shape < **f)) {
+      return *f;
+    }
+
+    size_t npoints = shape.stored_points ();
+    char *mem = allocate (sizeof (Sh) + npoints * sizeof (point_type));
+
+    Sh *sh = new (mem) Sh ();
+    sh->assign_external (shape, reinterpret_cast<point_type *> (mem + sizeof (Sh)));
+
+    m_set.insert (f, sh);
+    return sh;
+  }
+
+  /**
+   *  @brief Report the number of shapes in this repository
+   */
+  size_t size () const
+  {
+    return m_set.size ();
+  }
+
+  void mem_stat (MemStatistics *stat, MemStatistics::purpose_t purpose, int cat, bool no_self, void *parent) const
+  {
+    if (! no_self) {
+      stat->add (typeid (*this), (void *) this, sizeof (*this), sizeof (*this), parent, purpose, cat);
+    }
+    for (typename set_type::const_iterator s = m_set.begin (); s != m_set.end (); ++s) {
+      stat->add (typeid (const Sh *), (void *) &*s, sizeof (const Sh *), sizeof (const Sh *), (void *) this, purpose, cat);
+    }
+    //  the shapes and their points live inside the chunks
+    for (std::vector<std::pair<char *, size_t> >::const_iterator c = m_chunks.begin (); c != m_chunks.end (); ++c) {
+      size_t used = (c->first + c->second == mp_free + m_free_bytes) ? c->second - m_free_bytes : c->second;
+      stat->add (typeid (char []), (void *) c->first, c->second, used, (void *) this, purpose, cat);
+    }
+  }
+
+private:
+  struct deref_less
+  {
+    bool operator() (const Sh *a, const Sh *b) const
+    {
+      return *a < *b;
+    }
+  };
+
+  typedef std::set<const Sh *, deref_less> set_type;
+
+  //  Chunk size in bytes - larger requests get a chunk of their own
+  enum { chunk_size = 65536 };
+  //  Alignment of the objects inside the chunks
+  enum { chunk_align = sizeof (double) > sizeof (void *) ? sizeof (double) : sizeof (void *) };
+
+  set_type m_set;
+  std::vector<std::pair<char *, size_t> > m_chunks;
+  char *mp_free;
+  size_t m_free_bytes;
+
+  char *allocate (size_t n)
+  {
+    n = (n + chunk_align - 1) & ~size_t (chunk_align - 1);
+
+    if (n > chunk_size / 4) {
+      char *mem = new char [n];
+      m_chunks.push_back (std::make_pair (mem, n));
+      return mem;
+    }
+
+    if (n > m_free_bytes) {
+      mp_free = new char [chunk_size];
+      m_free_bytes = chunk_size;
+      m_chunks.push_back (std::make_pair (mp_free, size_t (chunk_size)));
+    }
+
+    char *mem = mp_free;
+    mp_free += n;
+    m_free_bytes -= n;
+    return mem;
+  }
+
+  void insert_from (const arena_repository<Sh> &d)
+  {
+    for (typename set_type::const_iterator s = d.m_set.begin (); s != d.m_set.end (); ++s) {
+      insert (**s);
+    }
+  }
+
+  void clear ()
+  {
+    for (typename set_type::const_iterator s = m_set.begin (); s != m_set.end (); ++s) {
+      Sh *sh = const_cast<Sh *> (*s);
+      sh->release_external ();
+      sh->~Sh ();
+    }
+    m_set.clear ();
+
+    for (std::vector<std::pair<char *, size_t> >::const_iterator c = m_chunks.begin (); c != m_chunks.end (); ++c) {
+      delete [] c->first;
+    }
+    m_chunks.clear ();
+    mp_free = 0;
+    m_free_bytes = 0;
+  }
+};
+
+/**
+ *  @brief The repository specialization for polygons
+ */
+template <class C>
+class repository<db::polygon<C> >
+  : public arena_repository<db::polygon<C> >
+{
+  //  .. nothing yet ..
+};
+
+/**
+ *  @brief The repository specialization for simple polygons
+ */
+template <class C>
+class repository<db::simple_polygon<C> >
+  : public arena_repository<db::simple_polygon<C> >
+{
+  //  .. nothing yet ..
+};
+
 /**
  *  @brief Collect memory statistics
  */
@@ -1652,6 +1652,20 @@ public:
     }
   }
 
+  virtual size_t mem_size () const
+  {
+    db::MemStatisticsSimple ms;
+    db::mem_stat (&ms, db::MemStatistics::None, 0, m_shapes, true);
+    return sizeof (*this) + ms.size ();
+  }
+
+  virtual void compact ()
+  {
+    if (m_shapes.capacity () > m_shapes.size ()) {
+      std::vector<Sh> (m_shapes).swap (m_shapes);
+    }
+  }
+
   static void queue_or_append (db::Manager *manager, db::Shapes *shapes, bool insert, const Sh &sh)
   {
     db::layer_op<Sh, StableTag> *old_op = dynamic_cast <db::layer_op<Sh, StableTag> *> (manager->last_queued (shapes));
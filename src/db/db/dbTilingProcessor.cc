@@ -27,9 +27,13 @@
 #include "tlProgress.h"
 #include "tlThreadedWorkers.h"
 #include "tlThreads.h"
+#include "tlFileUtils.h"
+#include "tlString.h"
 #include "gsiDecl.h"
 
 #include <cmath>
+#include <cstring>
+#include <list>
 
 namespace db
 {
@@ -271,6 +275,455 @@ private:
   db::EdgePairs *mp_edge_pairs;
 };
 
+// ----------------------------------------------------------------------------------
+//  The binary exchange format for the worker processes
+
+/**
+ *  @brief Writes the binary exchange format
+ *
+ *  Integers are written as variable-length numbers, point lists are
+ *  delta-encoded.
+ */
+class TileStreamWriter
+{
+public:
+  TileStreamWriter (tl::OutputStream &os)
+    : mp_os (&os)
+  {
+    //  .. nothing yet ..
+  }
+
+  void write_byte (unsigned char b)
+  {
+    mp_os->put ((const char *) &b, 1);
+  }
+
+  void write_unsigned (uint64_t v)
+  {
+    while (v >= 0x80) {
+      write_byte ((unsigned char) ((v & 0x7f) | 0x80));
+      v >>= 7;
+    }
+    write_byte ((unsigned char) v);
+  }
+
+  void write_signed (int64_t v)
+  {
+    if (v < 0) {
+      write_unsigned ((uint64_t (-(v + 1)) << 1) | 1);
+    } else {
+      write_unsigned (uint64_t (v) << 1);
+    }
+  }
+
+  void write_double (double d)
+  {
+    uint64_t bits = 0;
+    memcpy (&bits, &d, sizeof (bits));
+    for (unsigned int i = 0; i < 8; ++i) {
+      write_byte ((unsigned char) (bits >> (i * 8)));
+    }
+  }
+
+  void write_string (const std::string &s)
+  {
+    write_unsigned (s.size ());
+    mp_os->put (s.c_str (), s.size ());
+  }
+
+  void write_dbox (const db::DBox &b)
+  {
+    write_byte (b.empty () ? 0 : 1);
+    if (! b.empty ()) {
+      write_double (b.left ());
+      write_double (b.bottom ());
+      write_double (b.right ());
+      write_double (b.top ());
+    }
+  }
+
+  void write_box (const db::Box &b)
+  {
+    write_byte (b.empty () ? 0 : 1);
+    if (! b.empty ()) {
+      write_signed (b.left ());
+      write_signed (b.bottom ());
+      write_signed (b.right ());
+      write_signed (b.top ());
+    }
+  }
+
+  void write_edge (const db::Edge &e)
+  {
+    write_signed (e.p1 ().x ());
+    write_signed (e.p1 ().y ());
+    write_signed (e.dx ());
+    write_signed (e.dy ());
+  }
+
+  void write_edge_pair (const db::EdgePair &ep)
+  {
+    write_edge (ep.first ());
+    write_edge (ep.second ());
+  }
+
+  void write_polygon (const db::Polygon &poly)
+  {
+    write_unsigned (poly.holes () + 1);
+    for (unsigned int c = 0; c <= poly.holes (); ++c) {
+      const db::Polygon::contour_type &ctr = poly.contour (c);
+      write_unsigned (ctr.size ());
+      db::Point pl;
+      for (size_t i = 0; i < ctr.size (); ++i) {
+        db::Point p = ctr [i];
+        write_signed (p.x () - pl.x ());
+        write_signed (p.y () - pl.y ());
+        pl = p;
+      }
+    }
+  }
+
+  void write_variant (const tl::Variant &v)
+  {
+    if (v.is_nil ()) {
+      write_unsigned (0);
+    } else if (v.is_bool ()) {
+      write_unsigned (1);
+      write_byte (v.to_bool () ? 1 : 0);
+    } else if (v.is_long () || v.is_longlong () || v.is_char ()) {
+      write_unsigned (2);
+      write_signed (v.to_longlong ());
+    } else if (v.is_ulong () || v.is_ulonglong () || v.is_id ()) {
+      write_unsigned (3);
+      write_unsigned (v.to_ulonglong ());
+    } else if (v.is_double ()) {
+      write_unsigned (4);
+      write_double (v.to_double ());
+    } else if (v.is_a_string ()) {
+      write_unsigned (5);
+      write_string (v.to_string ());
+    } else if (v.is_list ()) {
+      write_unsigned (6);
+      write_unsigned (v.size ());
+      for (tl::Variant::const_iterator i = v.begin (); i != v.end (); ++i) {
+        write_variant (*i);
+      }
+    } else if (v.is_user<db::Region> ()) {
+      const db::Region &region = v.to_user<db::Region> ();
+      write_unsigned (10);
+      write_byte (region.merged_semantics () ? 1 : 0);
+      for (db::Region::const_iterator p = region.begin (); ! p.at_end (); ++p) {
+        write_unsigned (1);
+        write_polygon (*p);
+      }
+      write_unsigned (0);
+    } else if (v.is_user<db::Edges> ()) {
+      const db::Edges &edges = v.to_user<db::Edges> ();
+      write_unsigned (11);
+      write_byte (edges.merged_semantics () ? 1 : 0);
+      for (db::Edges::const_iterator e = edges.begin (); ! e.at_end (); ++e) {
+        write_unsigned (1);
+        write_edge (*e);
+      }
+      write_unsigned (0);
+    } else if (v.is_user<db::EdgePairs> ()) {
+      const db::EdgePairs &edge_pairs = v.to_user<db::EdgePairs> ();
+      write_unsigned (12);
+      for (db::EdgePairs::const_iterator ep = edge_pairs.begin (); ! ep.at_end (); ++ep) {
+        write_unsigned (1);
+        write_edge_pair (*ep);
+      }
+      write_unsigned (0);
+    } else if (v.is_user<db::Box> ()) {
+      write_unsigned (13);
+      write_box (v.to_user<db::Box> ());
+    } else if (v.is_user<db::Polygon> ()) {
+      write_unsigned (14);
+      write_polygon (v.to_user<db::Polygon> ());
+    } else if (v.is_user<db::Edge> ()) {
+      write_unsigned (15);
+      write_edge (v.to_user<db::Edge> ());
+    } else if (v.is_user<db::EdgePair> ()) {
+      write_unsigned (16);
+      write_edge_pair (v.to_user<db::EdgePair> ());
+    } else {
+      throw tl::Exception (tl::to_string (tr ("This object cannot be transferred from or to a tiling processor worker process: %s")), v.to_parsable_string ());
+    }
+  }
+
+private:
+  tl::OutputStream *mp_os;
+};
+
+/**
+ *  @brief Reads the binary exchange format
+ */
+class TileStreamReader
+{
+public:
+  TileStreamReader (tl::InputStream &is)
+    : mp_is (&is)
+  {
+    //  .. nothing yet ..
+  }
+
+  unsigned char read_byte ()
+  {
+    const char *b = mp_is->get (1);
+    if (! b) {
+      throw tl::Exception (tl::to_string (tr ("Unexpected end of data in tiling processor worker exchange")));
+    }
+    return (unsigned char) *b;
+  }
+
+  uint64_t read_unsigned ()
+  {
+    uint64_t v = 0;
+    unsigned int shift = 0;
+    unsigned char b;
+    do {
+      b = read_byte ();
+      v |= uint64_t (b & 0x7f) << shift;
+      shift += 7;
+    } while ((b & 0x80) != 0);
+    return v;
+  }
+
+  int64_t read_signed ()
+  {
+    uint64_t v = read_unsigned ();
+    if ((v & 1) != 0) {
+      return -int64_t (v >> 1) - 1;
+    } else {
+      return int64_t (v >> 1);
+    }
+  }
+
+  double read_double ()
+  {
+    uint64_t bits = 0;
+    for (unsigned int i = 0; i < 8; ++i) {
+      bits |= uint64_t (read_byte ()) << (i * 8);
+    }
+    double d = 0.0;
+    memcpy (&d, &bits, sizeof (d));
+    return d;
+  }
+
+  std::string read_string ()
+  {
+    size_t n = size_t (read_unsigned ());
+    if (n == 0) {
+      return std::string ();
+    }
+    const char *b = mp_is->get (n);
+    if (! b) {
+      throw tl::Exception (tl::to_string (tr ("Unexpected end of data in tiling processor worker exchange")));
+    }
+    return std::string (b, n);
+  }
+
+  db::DBox read_dbox ()
+  {
+    if (read_byte () == 0) {
+      return db::DBox ();
+    }
+    double l = read_double ();
+    double b = read_double ();
+    double r = read_double ();
+    double t = read_double ();
+    return db::DBox (l, b, r, t);
+  }
+
+  db::Box read_box ()
+  {
+    if (read_byte () == 0) {
+      return db::Box ();
+    }
+    db::Coord l = db::Coord (read_signed ());
+    db::Coord b = db::Coord (read_signed ());
+    db::Coord r = db::Coord (read_signed ());
+    db::Coord t = db::Coord (read_signed ());
+    return db::Box (l, b, r, t);
+  }
+
+  db::Edge read_edge ()
+  {
+    db::Coord x = db::Coord (read_signed ());
+    db::Coord y = db::Coord (read_signed ());
+    db::Coord dx = db::Coord (read_signed ());
+    db::Coord dy = db::Coord (read_signed ());
+    return db::Edge (db::Point (x, y), db::Point (x + dx, y + dy));
+  }
+
+  db::EdgePair read_edge_pair ()
+  {
+    db::Edge a = read_edge ();
+    db::Edge b = read_edge ();
+    return db::EdgePair (a, b);
+  }
+
+  void read_polygon (db::Polygon &poly)
+  {
+    poly.clear ();
+
+    size_t nc = size_t (read_unsigned ());
+    for (size_t c = 0; c < nc; ++c) {
+
+      m_points.clear ();
+      size_t n = size_t (read_unsigned ());
+      db::Point pl;
+      for (size_t i = 0; i < n; ++i) {
+        db::Coord dx = db::Coord (read_signed ());
+        db::Coord dy = db::Coord (read_signed ());
+        pl = db::Point (pl.x () + dx, pl.y () + dy);
+        m_points.push_back (pl);
+      }
+
+      if (c == 0) {
+        poly.assign_hull (m_points.begin (), m_points.end (), false /*don't compress*/);
+      } else {
+        poly.insert_hole (m_points.begin (), m_points.end (), false /*don't compress*/);
+      }
+
+    }
+  }
+
+  tl::Variant read_variant ()
+  {
+    unsigned int type = (unsigned int) read_unsigned ();
+
+    if (type == 0) {
+      return tl::Variant ();
+    } else if (type == 1) {
+      return tl::Variant (read_byte () != 0);
+    } else if (type == 2) {
+      return tl::Variant ((long long) read_signed ());
+    } else if (type == 3) {
+      return tl::Variant ((unsigned long long) read_unsigned ());
+    } else if (type == 4) {
+      return tl::Variant (read_double ());
+    } else if (type == 5) {
+      return tl::Variant (read_string ());
+    } else if (type == 6) {
+      size_t n = size_t (read_unsigned ());
+      tl::Variant list = tl::Variant::empty_list ();
+      for (size_t i = 0; i < n; ++i) {
+        list.push (read_variant ());
+      }
+      return list;
+    } else if (type == 10) {
+      db::Region region;
+      region.set_merged_semantics (read_byte () != 0);
+      db::Polygon poly;
+      while (read_unsigned () != 0) {
+        read_polygon (poly);
+        region.insert (poly);
+      }
+      return tl::Variant (region);
+    } else if (type == 11) {
+      db::Edges edges;
+      edges.set_merged_semantics (read_byte () != 0);
+      while (read_unsigned () != 0) {
+        edges.insert (read_edge ());
+      }
+      return tl::Variant (edges);
+    } else if (type == 12) {
+      db::EdgePairs edge_pairs;
+      while (read_unsigned () != 0) {
+        edge_pairs.insert (read_edge_pair ());
+      }
+      return tl::Variant (edge_pairs);
+    } else if (type == 13) {
+      return tl::Variant (read_box ());
+    } else if (type == 14) {
+      db::Polygon poly;
+      read_polygon (poly);
+      return tl::Variant (poly);
+    } else if (type == 15) {
+      return tl::Variant (read_edge ());
+    } else if (type == 16) {
+      return tl::Variant (read_edge_pair ());
+    } else {
+      throw tl::Exception (tl::to_string (tr ("Invalid object type in tiling processor worker exchange: %d")), int (type));
+    }
+  }
+
+private:
+  tl::InputStream *mp_is;
+  std::vector<db::Point> m_points;
+};
+
+//  Record types of the worker's result stream
+enum TileStreamRecord
+{
+  TSR_End = 0,
+  TSR_Put = 1,
+  TSR_TaskDone = 2,
+  TSR_Error = 3
+};
+
+static const char *tile_stream_magic = "KLayout-TilingProcessor-1";
+
+/**
+ *  @brief The output receiver of the worker process
+ *
+ *  This receiver writes the output objects to the result stream. "id" is the
+ *  index of the output channel in the coordinating process.
+ */
+class TileWorkerOutputReceiver
+  : public db::TileOutputReceiver
+{
+public:
+  TileWorkerOutputReceiver (TileStreamWriter *writer)
+    : mp_writer (writer)
+  {
+    //  .. nothing yet ..
+  }
+
+  void put (size_t ix, size_t iy, const db::Box &tile, size_t id, const tl::Variant &obj, double /*dbu*/, const db::ICplxTrans & /*trans*/, bool clip)
+  {
+    mp_writer->write_unsigned (TSR_Put);
+    mp_writer->write_unsigned (ix);
+    mp_writer->write_unsigned (iy);
+    mp_writer->write_box (tile);
+    mp_writer->write_unsigned (id);
+    mp_writer->write_byte (clip ? 1 : 0);
+    mp_writer->write_variant (obj);
+  }
+
+private:
+  TileStreamWriter *mp_writer;
+};
+
+/**
+ *  @brief A container for temporary files which are removed when the container is destroyed
+ */
+class TemporaryFiles
+{
+public:
+  TemporaryFiles () { }
+
+  ~TemporaryFiles ()
+  {
+    for (std::vector<std::string>::const_iterator f = m_files.begin (); f != m_files.end (); ++f) {
+      tl::rm_file (*f);
+    }
+  }
+
+  std::string make (const std::string &prefix)
+  {
+    m_files.push_back (tl::make_tmp_file (prefix));
+    return m_files.back ();
+  }
+
+private:
+  std::vector<std::string> m_files;
+};
+
+// ----------------------------------------------------------------------------------
+//  The tiling processor job
+
 class TilingProcessorJob
   : public tl::JobBase
 {
@@ -373,6 +826,33 @@ private:
   size_t m_script_index;
 };
 
+/**
+ *  @brief A task representing one worker process
+ */
+class TilingProcessorRemoteTask
+  : public tl::Task
+{
+public:
+  TilingProcessorRemoteTask (const std::string &setup_file, const std::string &tasks_file)
+    : m_setup_file (setup_file), m_tasks_file (tasks_file)
+  {
+    //  .. nothing yet ..
+  }
+
+  const std::string &setup_file () const
+  {
+    return m_setup_file;
+  }
+
+  const std::string &tasks_file () const
+  {
+    return m_tasks_file;
+  }
+
+private:
+  std::string m_setup_file, m_tasks_file;
+};
+
 class TilingProcessorWorker
   : public tl::Worker
 {
@@ -389,12 +869,17 @@ public:
     if (tile_task) {
       do_perform (tile_task);
     }
+    TilingProcessorRemoteTask *remote_task = dynamic_cast <TilingProcessorRemoteTask *> (task);
+    if (remote_task) {
+      do_perform_remote (remote_task);
+    }
   }
 
 private:
   TilingProcessorJob *mp_job;
 
   void do_perform (const TilingProcessorTask *task);
+  void do_perform_remote (const TilingProcessorRemoteTask *task);
 };
 
 class TilingProcessorReceiverFunction
@@ -536,6 +1021,62 @@ TilingProcessorWorker::do_perform (const TilingProcessorTask *tile_task)
   mp_job->next_progress ();
 }
 
+void
+TilingProcessorWorker::do_perform_remote (const TilingProcessorRemoteTask *remote_task)
+{
+  std::string cmd = mp_job->processor ()->worker_command () + " " + tl::to_shell_argument (remote_task->setup_file ()) + " " + tl::to_shell_argument (remote_task->tasks_file ());
+
+  if (tl::verbosity () >= 20) {
+    tl::info << "TilingProcessor: starting worker process " << cmd;
+  }
+
+  tl::InputPipe pipe (cmd);
+  tl::InputStream is (pipe);
+  TileStreamReader reader (is);
+
+  try {
+
+    while (true) {
+
+      unsigned int rec = (unsigned int) reader.read_unsigned ();
+
+      if (rec == TSR_End) {
+        break;
+      } else if (rec == TSR_Put) {
+
+        size_t ix = size_t (reader.read_unsigned ());
+        size_t iy = size_t (reader.read_unsigned ());
+        db::Box tile = reader.read_box ();
+        size_t index = size_t (reader.read_unsigned ());
+        bool clip = (reader.read_byte () != 0);
+        tl::Variant obj = reader.read_variant ();
+
+        mp_job->processor ()->put_remote (ix, iy, tile, index, obj, clip);
+
+      } else if (rec == TSR_TaskDone) {
+        mp_job->next_progress ();
+      } else if (rec == TSR_Error) {
+        throw tl::Exception (reader.read_string ());
+      } else {
+        throw tl::Exception (tl::to_string (tr ("Invalid record in tiling processor worker output: %d")), int (rec));
+      }
+
+    }
+
+  } catch (tl::Exception &ex) {
+    int ret = pipe.wait ();
+    if (ret != 0) {
+      throw tl::Exception (tl::to_string (tr ("Worker process failed (exit code %d): %s\n%s")), ret, cmd, ex.msg ());
+    }
+    throw;
+  }
+
+  int ret = pipe.wait ();
+  if (ret != 0) {
+    throw tl::Exception (tl::to_string (tr ("Worker process failed (exit code %d): %s")), ret, cmd);
+  }
+}
+
 tl::Worker *
 TilingProcessorJob::create_worker ()
 {
@@ -552,7 +1093,8 @@ TilingProcessor::TilingProcessor ()
     m_tile_origin_x (0.0), m_tile_origin_y (0.0),
     m_tile_origin_given (false),
     m_tile_bx (0.0), m_tile_by (0.0),
-    m_threads (0), m_dbu (0.001), m_dbu_specific (0.001), m_dbu_specific_set (false),
+    m_threads (0), m_workers (0),
+    m_dbu (0.001), m_dbu_specific (0.001), m_dbu_specific_set (false),
     m_scale_to_dbu (true)
 {
   //  .. nothing yet ..
@@ -620,6 +1162,28 @@ TilingProcessor::set_threads (size_t n)
   m_threads = n;
 }
 
+void  
+TilingProcessor::set_workers (size_t n)
+{
+  m_workers = n;
+}
+
+void  
+TilingProcessor::set_worker_command (const std::string &cmd)
+{
+  m_worker_command = cmd;
+}
+
+std::string
+TilingProcessor::worker_command () const
+{
+  if (m_worker_command.empty ()) {
+    return tl::to_shell_argument (tl::combine_path (tl::get_inst_path (), "tpworker"));
+  } else {
+    return m_worker_command;
+  }
+}
+
 void  
 TilingProcessor::queue (const std::string &script)
 {
@@ -630,6 +1194,7 @@ void
 TilingProcessor::var (const std::string &name, const tl::Variant &value)
 {
   m_top_eval.set_var (name, value);
+  m_vars.push_back (std::make_pair (name, value));
 }
 
 
@@ -750,6 +1315,213 @@ TilingProcessor::put (size_t ix, size_t iy, const db::Box &tile, const std::vect
   m_outputs[index].receiver->put (ix, iy, tile, m_outputs[index].id, args[1], dbu (), m_outputs[index].trans, clip);
 }
 
+void 
+TilingProcessor::put_remote (size_t ix, size_t iy, const db::Box &tile, size_t index, const tl::Variant &obj, bool clip)
+{
+  tl::MutexLocker locker (&m_output_mutex);
+
+  if (index >= m_outputs.size ()) {
+    throw tl::Exception (tl::to_string (tr ("Invalid output channel in tiling processor worker output")));
+  }
+
+  m_outputs[index].receiver->put (ix, iy, tile, m_outputs[index].id, obj, dbu (), m_outputs[index].trans, clip);
+}
+
+void
+TilingProcessor::write_setup (tl::OutputStream &os) const
+{
+  TileStreamWriter writer (os);
+
+  writer.write_string (tile_stream_magic);
+
+  writer.write_double (dbu ());
+  writer.write_dbox (m_frame);
+
+  writer.write_unsigned (m_vars.size ());
+  for (std::vector<std::pair<std::string, tl::Variant> >::const_iterator v = m_vars.begin (); v != m_vars.end (); ++v) {
+    writer.write_string (v->first);
+    writer.write_variant (v->second);
+  }
+
+  //  The inputs are flattened into the computation database unit. Polygons are kept as
+  //  polygons for edge inputs too, so the worker sees the same shapes than a local
+  //  tile would see.
+  writer.write_unsigned (m_inputs.size ());
+  for (std::vector<InputSpec>::const_iterator i = m_inputs.begin (); i != m_inputs.end (); ++i) {
+
+    writer.write_string (i->name);
+    writer.write_byte (i->region ? 1 : 0);
+    writer.write_byte (i->merged_semantics ? 1 : 0);
+
+    double input_dbu = dbu ();
+    if (scale_to_dbu () && i->iter.layout ()) {
+      input_dbu = i->iter.layout ()->dbu ();
+    }
+
+    db::ICplxTrans trans = db::ICplxTrans (input_dbu / dbu ()) * i->trans;
+
+    db::Polygon poly;
+    for (db::RecursiveShapeIterator si = i->iter; ! si.at_end (); ++si) {
+      if (si->is_polygon () || si->is_path () || si->is_box ()) {
+        si->polygon (poly);
+        writer.write_unsigned (1);
+        writer.write_polygon (poly.transformed (trans * si.trans ()));
+      } else if (! i->region && si->is_edge ()) {
+        writer.write_unsigned (2);
+        writer.write_edge (si->edge ().transformed (trans * si.trans ()));
+      }
+    }
+
+    writer.write_unsigned (0);
+
+  }
+
+  writer.write_unsigned (m_outputs.size ());
+  for (std::vector<OutputSpec>::const_iterator o = m_outputs.begin (); o != m_outputs.end (); ++o) {
+    writer.write_string (o->name);
+  }
+
+  writer.write_unsigned (m_scripts.size ());
+  for (std::vector<std::string>::const_iterator s = m_scripts.begin (); s != m_scripts.end (); ++s) {
+    writer.write_string (*s);
+  }
+}
+
+static void
+write_tasks (tl::OutputStream &os, bool has_tiles, const std::vector<const TilingProcessorTask *> &tasks)
+{
+  TileStreamWriter writer (os);
+
+  writer.write_string (tile_stream_magic);
+
+  writer.write_byte (has_tiles ? 1 : 0);
+
+  writer.write_unsigned (tasks.size ());
+  for (std::vector<const TilingProcessorTask *>::const_iterator t = tasks.begin (); t != tasks.end (); ++t) {
+    writer.write_string ((*t)->tile_desc ());
+    writer.write_unsigned ((*t)->ix ());
+    writer.write_unsigned ((*t)->iy ());
+    writer.write_dbox ((*t)->clip_box ());
+    writer.write_dbox ((*t)->region ());
+    writer.write_unsigned ((*t)->script_index ());
+  }
+}
+
+static void
+read_magic (TileStreamReader &reader)
+{
+  if (reader.read_string () != tile_stream_magic) {
+    throw tl::Exception (tl::to_string (tr ("Invalid tiling processor worker setup or task file")));
+  }
+}
+
+bool
+TilingProcessor::run_worker (tl::InputStream &setup, tl::InputStream &tasks, tl::OutputStream &results)
+{
+  TileStreamWriter writer (results);
+
+  try {
+
+    TilingProcessor proc;
+
+    //  the input shapes - they need to stay alive while the processor runs
+    std::list<db::Shapes> input_shapes;
+
+    TileStreamReader setup_reader (setup);
+    read_magic (setup_reader);
+
+    proc.set_dbu (setup_reader.read_double ());
+    proc.set_frame (setup_reader.read_dbox ());
+
+    size_t nvars = size_t (setup_reader.read_unsigned ());
+    for (size_t i = 0; i < nvars; ++i) {
+      std::string name = setup_reader.read_string ();
+      proc.var (name, setup_reader.read_variant ());
+    }
+
+    size_t ninputs = size_t (setup_reader.read_unsigned ());
+    for (size_t i = 0; i < ninputs; ++i) {
+
+      std::string name = setup_reader.read_string ();
+      bool region = (setup_reader.read_byte () != 0);
+      bool merged_semantics = (setup_reader.read_byte () != 0);
+
+      input_shapes.push_back (db::Shapes (false));
+      db::Shapes &shapes = input_shapes.back ();
+
+      db::Polygon poly;
+      unsigned int type;
+      while ((type = (unsigned int) setup_reader.read_unsigned ()) != 0) {
+        if (type == 1) {
+          setup_reader.read_polygon (poly);
+          shapes.insert (poly);
+        } else {
+          shapes.insert (setup_reader.read_edge ());
+        }
+      }
+
+      shapes.update ();
+
+      proc.input (name, db::RecursiveShapeIterator (shapes), db::ICplxTrans (), region, merged_semantics);
+
+    }
+
+    size_t noutputs = size_t (setup_reader.read_unsigned ());
+    for (size_t i = 0; i < noutputs; ++i) {
+      proc.output (setup_reader.read_string (), i, new TileWorkerOutputReceiver (&writer), db::ICplxTrans ());
+    }
+
+    size_t nscripts = size_t (setup_reader.read_unsigned ());
+    for (size_t i = 0; i < nscripts; ++i) {
+      proc.queue (setup_reader.read_string ());
+    }
+
+    TileStreamReader tasks_reader (tasks);
+    read_magic (tasks_reader);
+
+    bool has_tiles = (tasks_reader.read_byte () != 0);
+
+    TilingProcessorJob job (&proc, 0, has_tiles);
+    TilingProcessorWorker worker (&job);
+
+    size_t ntasks = size_t (tasks_reader.read_unsigned ());
+    for (size_t i = 0; i < ntasks; ++i) {
+
+      std::string tile_desc = tasks_reader.read_string ();
+      size_t ix = size_t (tasks_reader.read_unsigned ());
+      size_t iy = size_t (tasks_reader.read_unsigned ());
+      db::DBox clip_box = tasks_reader.read_dbox ();
+      db::DBox region = tasks_reader.read_dbox ();
+      size_t si = size_t (tasks_reader.read_unsigned ());
+      if (si >= proc.m_scripts.size ()) {
+        throw tl::Exception (tl::to_string (tr ("Invalid script index in tiling processor worker task file")));
+      }
+
+      TilingProcessorTask task (tile_desc, ix, iy, clip_box, region, proc.m_scripts [si], si);
+      worker.perform_task (&task);
+
+      writer.write_unsigned (TSR_TaskDone);
+      results.flush ();
+
+    }
+
+  } catch (tl::Exception &ex) {
+    writer.write_unsigned (TSR_Error);
+    writer.write_string (ex.msg ());
+    results.flush ();
+    return false;
+  } catch (std::exception &ex) {
+    writer.write_unsigned (TSR_Error);
+    writer.write_string (ex.what ());
+    results.flush ();
+    return false;
+  }
+
+  writer.write_unsigned (TSR_End);
+  results.flush ();
+  return true;
+}
+
 void  
 TilingProcessor::execute (const std::string &desc)
 {
@@ -814,7 +1586,12 @@ TilingProcessor::execute (const std::string &desc)
   //  is just a single tile.
   bool has_tiles = (ntiles_w > 1 || ntiles_h > 1 || ! m_frame.empty ());
 
-  TilingProcessorJob job (this, int (m_threads), has_tiles);
+  //  worker processes are only employed in tiled mode
+  bool distributed = (has_tiles && m_workers > 0);
+
+  TilingProcessorJob job (this, int (distributed ? m_workers : m_threads), has_tiles);
+
+  std::vector<TilingProcessorTask *> tasks;
 
   double l = 0.0, b = 0.0;
 
@@ -843,7 +1620,7 @@ TilingProcessor::execute (const std::string &desc)
 
         size_t si = 0;
         for (std::vector <std::string>::const_iterator s = m_scripts.begin (); s != m_scripts.end (); ++s, ++si) {
-          job.schedule (new TilingProcessorTask (tile_desc, ix, iy, clip_box, region, *s, si));
+          tasks.push_back (new TilingProcessorTask (tile_desc, ix, iy, clip_box, region, *s, si));
         }
 
       }
@@ -856,11 +1633,64 @@ TilingProcessor::execute (const std::string &desc)
 
     size_t si = 0;
     for (std::vector <std::string>::const_iterator s = m_scripts.begin (); s != m_scripts.end (); ++s, ++si) {
-      job.schedule (new TilingProcessorTask ("all", 0, 0, db::DBox (), db::DBox (), *s, si));
+      tasks.push_back (new TilingProcessorTask ("all", 0, 0, db::DBox (), db::DBox (), *s, si));
+    }
+
+  }
+
+  //  the temporary files live until the job has finished
+  TemporaryFiles tmp_files;
+
+  if (distributed) {
+
+    //  The tasks are distributed round-robin over the worker processes. The
+    //  setup file is shared by all workers.
+    try {
+
+      std::string setup_file = tmp_files.make ("klayout_tp");
+      {
+        tl::OutputStream os (setup_file);
+        write_setup (os);
+      }
+
+      for (size_t w = 0; w < m_workers && w < tasks.size (); ++w) {
+
+        std::vector<const TilingProcessorTask *> worker_tasks;
+        for (size_t t = w; t < tasks.size (); t += m_workers) {
+          worker_tasks.push_back (tasks [t]);
+        }
+
+        std::string tasks_file = tmp_files.make ("klayout_tp");
+        {
+          tl::OutputStream os (tasks_file);
+          write_tasks (os, has_tiles, worker_tasks);
+        }
+
+        job.schedule (new TilingProcessorRemoteTask (setup_file, tasks_file));
+
+      }
+
+    } catch (...) {
+      for (std::vector<TilingProcessorTask *>::const_iterator t = tasks.begin (); t != tasks.end (); ++t) {
+        delete *t;
+      }
+      throw;
+    }
+
+    for (std::vector<TilingProcessorTask *>::const_iterator t = tasks.begin (); t != tasks.end (); ++t) {
+      delete *t;
+    }
+
+  } else {
+
+    for (std::vector<TilingProcessorTask *>::const_iterator t = tasks.begin (); t != tasks.end (); ++t) {
+      job.schedule (*t);
     }
 
   }
 
+  tasks.clear ();
+
   //  TODO: there should be a general scheme of how thread-specific progress is merged
   //  into a global one ..
   size_t todo_count = ntiles_w * ntiles_h * m_scripts.size ();
@@ -37,6 +37,7 @@
 #include "tlExpression.h"
 #include "tlTypeTraits.h"
 #include "tlThreads.h"
+#include "tlStream.h"
 
 namespace db
 {
@@ -413,6 +414,12 @@ bool insert_var (X &inserter, const tl::Variant &obj, const db::Box &tile, bool
  *   _output     output the data: _output(name, object)
  *   _count      report a count for a specific output for display during execution
  *   <name>      fetch the input <name> as specified in the "input" method
+ *
+ *  Instead of threads, the tiles can be distributed over worker processes
+ *  (see "set_workers"). The worker processes receive the flattened input and
+ *  the variables through a temporary setup file and deliver their output in a
+ *  compact binary form through a pipe. The coordinating process feeds the
+ *  output into the receivers.
  */
 class DB_PUBLIC TilingProcessor
 {
@@ -602,6 +609,49 @@ public:
     return m_threads;
   }
 
+  /**
+   *  @brief Specifies the number of worker processes to use
+   *
+   *  If this number is non-zero, the tiles are computed by the given number of
+   *  worker processes instead of threads. Worker processes are only employed in
+   *  tiled mode. All inputs, variables and outputs must be representable in the
+   *  binary exchange format (regions, edge and edge pair collections, simple
+   *  geometric objects, numbers, strings and lists of those).
+   */
+  void set_workers (size_t n);
+
+  /**
+   *  @brief Gets the number of worker processes used
+   */
+  size_t workers () const
+  {
+    return m_workers;
+  }
+
+  /**
+   *  @brief Sets the command which starts a worker process
+   *
+   *  The command is given the setup file and the task file as arguments.
+   *  It is expected to deliver the results on stdout.
+   *  The default is the "tpworker" program from the installation path.
+   */
+  void set_worker_command (const std::string &cmd);
+
+  /**
+   *  @brief Gets the command which starts a worker process
+   */
+  std::string worker_command () const;
+
+  /**
+   *  @brief Implements the worker process
+   *
+   *  Reads the setup and the tasks from the given streams, executes the tasks
+   *  and writes the results to the given output stream.
+   *  Returns false, if one of the tasks failed. In that case, the error message
+   *  has been written to the output stream.
+   */
+  static bool run_worker (tl::InputStream &setup, tl::InputStream &tasks, tl::OutputStream &results);
+
   /**
    *  @brief Queue a script for execution with "execute"
    *
@@ -645,6 +695,8 @@ private:
   std::vector<InputSpec>::const_iterator end_inputs () const { return m_inputs.end (); }
 
   void put (size_t ix, size_t iy, const db::Box &tile, const std::vector<tl::Variant> &args);
+  void put_remote (size_t ix, size_t iy, const db::Box &tile, size_t index, const tl::Variant &obj, bool clip);
+  void write_setup (tl::OutputStream &os) const;
   tl::Variant receiver (const std::vector<tl::Variant> &args);
   tl::Eval &top_eval () { return m_top_eval; }
 
@@ -658,10 +710,13 @@ private:
   bool m_tile_origin_given;
   double m_tile_bx, m_tile_by;
   size_t m_threads;
+  size_t m_workers;
+  std::string m_worker_command;
   double m_dbu, m_dbu_specific;
   bool m_dbu_specific_set;
   bool m_scale_to_dbu;
   std::vector<std::string> m_scripts;
+  std::vector<std::pair<std::string, tl::Variant> > m_vars;
   tl::Mutex m_output_mutex;
   tl::Eval m_top_eval;
 };
@@ -1584,12 +1584,12 @@ fill_region1 (db::Cell *cell, const db::Region &fr, db::cell_index_type fill_cel
 
 static void
 fill_region2 (db::Cell *cell, const db::Region &fr, db::cell_index_type fill_cell_index, const db::Box &fc_box, const db::Point *origin,
-              db::Region *remaining_parts, const db::Vector &fill_margin, db::Region *remaining_polygons)
+              db::Region *remaining_parts, const db::Vector &fill_margin, db::Region *remaining_polygons, unsigned int threads)
 {
   if (fc_box.empty () || fc_box.width () == 0 || fc_box.height () == 0) {
     throw tl::Exception (tl::to_string (tr ("Invalid fill cell footprint (empty or zero width/height)")));
   }
-  db::fill_region (cell, fr, fill_cell_index, fc_box, origin ? *origin : db::Point (), origin == 0, remaining_parts, fill_margin, remaining_polygons);
+  db::fill_region (cell, fr, fill_cell_index, fc_box, origin ? *origin : db::Point (), origin == 0, remaining_parts, fill_margin, remaining_polygons, threads);
 }
 
 static db::Instance cell_inst_dtransform_simple (db::Cell *cell, const db::Instance &inst, const db::DTrans &t)
@@ -1792,15 +1792,15 @@ Class<db::Cell> decl_Cell ("db", "Cell",
     "\n"
     "This method has been introduced in version 0.23."
   ) + 
-  gsi::method_ext ("write", &write_simple,
+  gsi::release_gil (gsi::method_ext ("write", &write_simple,
     "@brief Writes the cell to a layout file\n"
     "@args file_name\n"
     "The format of the file will be determined from the file name. Only the cell and "
     "it's subtree below will be saved.\n"
     "\n"
     "This method has been introduced in version 0.23.\n"
-  ) +
-  gsi::method_ext ("write", &write_options,
+  )) +
+  gsi::release_gil (gsi::method_ext ("write", &write_options,
     "@brief Writes the cell to a layout file\n"
     "@args file_name, options\n"
     "The format of the file will be determined from the file name. Only the cell and "
@@ -1809,7 +1809,7 @@ Class<db::Cell> decl_Cell ("db", "Cell",
     "scaling etc.\n"
     "\n"
     "This method has been introduced in version 0.23.\n"
-  ) +
+  )) +
   gsi::method ("shapes", (db::Cell::shapes_type &(db::Cell::*) (unsigned int)) &db::Cell::shapes,
     "@brief Returns the shapes list of the given layer\n"
     "@args layer_index\n"
@@ -2020,9 +2020,8 @@ Class<db::Cell> decl_Cell ("db", "Cell",
     "\n"
     "This method has been introduced in version 0.23.\n"
   ) +
-  gsi::method_ext ("fill_region", &fill_region2,
+  gsi::method_ext ("fill_region", &fill_region2, gsi::arg ("region"), gsi::arg ("fill_cell_index"), gsi::arg ("fc_box"), gsi::arg ("origin"), gsi::arg ("remaining_parts"), gsi::arg ("fill_margin"), gsi::arg ("remaining_polygons"), gsi::arg ("threads", (unsigned int) 0),
     "@brief Fills the given region with cells of the given type (extended version)\n"
-    "@args region, fill_cell_index, fc_box, origin, remaining_parts, fill_margin, remaining_polygons\n"
     "@param region The region to fill\n"
     "@param fill_cell_index The fill cell to place\n"
     "@param fc_box The fill cell's footprint\n"
@@ -2030,6 +2029,7 @@ Class<db::Cell> decl_Cell ("db", "Cell",
     "@param remaining_parts See explanation below\n"
     "@param fill_margin See explanation below\n"
     "@param remaining_polygons See explanation below\n"
+    "@param threads The number of worker threads to use (0 for single-threaded operation)\n"
     "\n"
     "First of all, this method behaves like the simple form. In addition, it can be configured to return information about the "
     "parts which could not be filled. Those can be full polygons from the input (without a chance to fill) or parts of original polygons "
@@ -2062,7 +2062,10 @@ Class<db::Cell> decl_Cell ("db", "Cell",
     "end\n"
     "@/code\n"
     "\n"
-    "This method has been introduced in version 0.23.\n"
+    "If 'threads' is non-zero, the polygons of the region are filled on the given number of worker threads. "
+    "The fill cell instances are produced in the same order than in the single-threaded case.\n"
+    "\n"
+    "This method has been introduced in version 0.23. The 'threads' argument has been added in version 0.26.\n"
   ) +
   gsi::method_ext ("begin_shapes_rec", &begin_shapes_rec, 
     "@brief Delivers a recursive shape iterator for the shapes below the cell on the given layer\n"
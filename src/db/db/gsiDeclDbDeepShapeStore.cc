@@ -22,10 +22,28 @@
 
 #include "gsiDecl.h"
 #include "dbDeepShapeStore.h"
+#include "dbDeepRegion.h"
+#include "dbRegion.h"
 
 namespace gsi
 {
 
+static std::vector<db::Region> create_regions (db::DeepShapeStore *dss, const db::RecursiveShapeIterator &si, const std::vector<unsigned int> &layers, const db::ICplxTrans &trans, double area_ratio, size_t max_vertex_count)
+{
+  std::vector<db::DeepLayer> dls = dss->create_polygon_layers (si, layers, area_ratio, max_vertex_count, trans);
+
+  std::vector<db::Region> regions;
+  regions.reserve (dls.size ());
+  for (std::vector<db::DeepLayer>::const_iterator dl = dls.begin (); dl != dls.end (); ++dl) {
+    //  NOTE: swapping avoids copying the deep layer
+    db::Region r (new db::DeepRegion (*dl));
+    regions.push_back (db::Region ());
+    regions.back ().swap (r);
+  }
+
+  return regions;
+}
+
 Class<db::DeepShapeStore> decl_dbDeepShapeStore ("db", "DeepShapeStore",
   gsi::method ("instance_count", &db::DeepShapeStore::instance_count,
     "@hide\n"
@@ -84,6 +102,23 @@ Class<db::DeepShapeStore> decl_dbDeepShapeStore ("db", "DeepShapeStore",
   ) +
   gsi::method ("text_enlargement", &db::DeepShapeStore::text_enlargement,
     "@brief Gets the text enlargement value.\n"
+  ) +
+  gsi::method_ext ("create_regions", &create_regions, gsi::arg ("shape_iterator"), gsi::arg ("layers"), gsi::arg ("trans", db::ICplxTrans (), "unity"), gsi::arg ("area_ratio", 0.0), gsi::arg ("max_vertex_count", size_t (0)),
+    "@brief Creates deep regions for several layers in a single pass\n"
+    "\n"
+    "This method delivers one deep region for each layer given in 'layers'. The result is the same "
+    "as creating the regions one by one with the deep region constructor (see \\Region#new) and a shape "
+    "iterator configured for the respective layer. As the source hierarchy is traversed only once for "
+    "all layers, this method is faster than creating the regions one by one. The layer configuration "
+    "of 'shape_iterator' is ignored.\n"
+    "\n"
+    "@param shape_iterator The recursive shape iterator which delivers the hierarchy to take\n"
+    "@param layers The source layers\n"
+    "@param trans The transformation to apply when storing the layout data\n"
+    "@param area_ratio The maximum ratio of bounding box to polygon area before polygons are split\n"
+    "@param max_vertex_count The maximum number of points per polygon before polygons are split\n"
+    "\n"
+    "This method has been introduced in version 0.26.\n"
   ),
   "@brief An opaque layout heap for the deep region processor\n"
   "\n"
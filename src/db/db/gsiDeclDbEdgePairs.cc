@@ -22,6 +22,7 @@
 
 
 #include "gsiDecl.h"
+#include "gsiDeclDbHelpers.h"
 
 #include "dbEdgePairs.h"
 #include "dbEdges.h"
@@ -169,6 +170,35 @@ static void insert_e (db::EdgePairs *e, const db::EdgePairs &a)
   }
 }
 
+static std::vector<char> edge_pair_coordinates (const db::EdgePairs *ep)
+{
+  std::vector<char> data;
+  gsi::coord_buffer_writer<db::Coord> w (data, ep->size () * 8);
+  for (db::EdgePairs::const_iterator p = ep->begin (); ! p.at_end (); ++p) {
+    w.put (p->first ().x1 ());
+    w.put (p->first ().y1 ());
+    w.put (p->first ().x2 ());
+    w.put (p->first ().y2 ());
+    w.put (p->second ().x1 ());
+    w.put (p->second ().y1 ());
+    w.put (p->second ().x2 ());
+    w.put (p->second ().y2 ());
+  }
+  return data;
+}
+
+static void insert_edge_pair_coordinates (db::EdgePairs *ep, const std::vector<char> &data)
+{
+  gsi::coord_buffer_reader<db::Coord> r (data, 8);
+  for (size_t i = 0; i < r.tuples (); ++i) {
+    db::Coord c[8];
+    for (unsigned int j = 0; j < 8; ++j) {
+      c[j] = r.get ();
+    }
+    ep->insert (db::Edge (c[0], c[1], c[2], c[3]), db::Edge (c[4], c[5], c[6], c[7]));
+  }
+}
+
 static bool is_deep (const db::EdgePairs *ep)
 {
   return dynamic_cast<const db::DeepEdgePairs *> (ep->delegate ()) != 0;
@@ -312,6 +342,26 @@ Class<db::EdgePairs> decl_EdgePairs ("db", "EdgePairs",
     "@brief Inserts an edge pair into the collection\n"
     "@args edge_pair\n"
   ) +
+  method_ext ("edge_pair_coordinates", &edge_pair_coordinates,
+    "@brief Gets the coordinates of all edge pairs as a byte array\n"
+    "\n"
+    "For each edge pair, the byte array holds eight coordinates as native integers (32 bit, 64 bit "
+    "in builds with 64 bit coordinates): x1, y1, x2, y2 of the first edge followed by x1, y1, x2, y2 of "
+    "the second edge. In Python, the byte array is delivered as a 'bytes' object which can be mapped "
+    "to a NumPy array, e.g. 'numpy.frombuffer(ep.edge_pair_coordinates(), dtype=numpy.int32).reshape(-1, 8)'. "
+    "This is much faster than iterating the edge pairs.\n"
+    "\n"
+    "This method has been introduced in version 0.26."
+  ) +
+  method_ext ("insert_edge_pair_coordinates", &insert_edge_pair_coordinates, gsi::arg ("data"),
+    "@brief Inserts edge pairs from a byte array of coordinates\n"
+    "@param data The coordinates in the format delivered by \\edge_pair_coordinates\n"
+    "\n"
+    "In Python, any object supporting the buffer protocol can be passed - e.g. a NumPy array of "
+    "the matching integer type.\n"
+    "\n"
+    "This method has been introduced in version 0.26."
+  ) +
   method_ext ("is_deep?", &is_deep,
     "@brief Returns true if the edge pair collection is a deep (hierarchical) one\n"
     "\n"
@@ -697,7 +697,7 @@ Class<db::Edges> dec_Edges ("db", "Edges",
   method_ext ("insert", &insert_a2, gsi::arg ("edges"),
     "@brief Inserts all edges from the array into this edge collection\n"
   ) +
-  method ("merge", (db::Edges &(db::Edges::*) ()) &db::Edges::merge,
+  gsi::release_gil (method ("merge", (db::Edges &(db::Edges::*) ()) &db::Edges::merge,
     "@brief Merge the edges\n"
     "\n"
     "@return The edge collection after the edges have been merged (self).\n"
@@ -705,8 +705,8 @@ Class<db::Edges> dec_Edges ("db", "Edges",
     "Merging joins parallel edges which overlap or touch.\n"
     "Crossing edges are not merged.\n"
     "If the edge collection is already merged, this method does nothing\n"
-  ) +
-  method ("merged", (db::Edges (db::Edges::*) () const) &db::Edges::merged,
+  )) +
+  gsi::release_gil (method ("merged", (db::Edges (db::Edges::*) () const) &db::Edges::merged,
     "@brief Returns the merged edge collection\n"
     "\n"
     "@return The edge collection after the edges have been merged.\n"
@@ -714,8 +714,8 @@ Class<db::Edges> dec_Edges ("db", "Edges",
     "Merging joins parallel edges which overlap or touch.\n"
     "Crossing edges are not merged.\n"
     "In contrast to \\merge, this method does not modify the edge collection but returns a merged copy.\n"
-  ) +
-  method ("&", (db::Edges (db::Edges::*)(const db::Edges &) const) &db::Edges::operator&, gsi::arg ("other"),
+  )) +
+  gsi::release_gil (method ("&", (db::Edges (db::Edges::*)(const db::Edges &) const) &db::Edges::operator&, gsi::arg ("other"),
     "@brief Returns the boolean AND between self and the other edge collection\n"
     "\n"
     "@return The result of the boolean AND operation\n"
@@ -723,8 +723,8 @@ Class<db::Edges> dec_Edges ("db", "Edges",
     "The boolean AND operation will return all parts of the edges in this collection which "
     "are coincident with parts of the edges in the other collection."
     "The result will be a merged edge collection.\n"
-  ) + 
-  method ("&=", (db::Edges &(db::Edges::*)(const db::Edges &)) &db::Edges::operator&=, gsi::arg ("other"),
+  )) + 
+  gsi::release_gil (method ("&=", (db::Edges &(db::Edges::*)(const db::Edges &)) &db::Edges::operator&=, gsi::arg ("other"),
     "@brief Performs the boolean AND between self and the other edge collection\n"
     "\n"
     "@return The edge collection after modification (self)\n"
@@ -732,8 +732,8 @@ Class<db::Edges> dec_Edges ("db", "Edges",
     "The boolean AND operation will return all parts of the edges in this collection which "
     "are coincident with parts of the edges in the other collection."
     "The result will be a merged edge collection.\n"
-  ) + 
-  method ("&", (db::Edges (db::Edges::*)(const db::Region &) const) &db::Edges::operator&, gsi::arg ("other"),
+  )) + 
+  gsi::release_gil (method ("&", (db::Edges (db::Edges::*)(const db::Region &) const) &db::Edges::operator&, gsi::arg ("other"),
     "@brief Returns the parts of the edges inside the given region\n"
     "\n"
     "@return The edges inside the given region\n"
@@ -744,8 +744,8 @@ Class<db::Edges> dec_Edges ("db", "Edges",
     "edges intersect.\n"
     "\n"
     "This method has been introduced in version 0.24."
-  ) + 
-  method ("&=", (db::Edges &(db::Edges::*)(const db::Region &)) &db::Edges::operator&=, gsi::arg ("other"),
+  )) + 
+  gsi::release_gil (method ("&=", (db::Edges &(db::Edges::*)(const db::Region &)) &db::Edges::operator&=, gsi::arg ("other"),
     "@brief Selects the parts of the edges inside the given region\n"
     "\n"
     "@return The edge collection after modification (self)\n"
@@ -756,8 +756,8 @@ Class<db::Edges> dec_Edges ("db", "Edges",
     "edges intersect.\n"
     "\n"
     "This method has been introduced in version 0.24."
-  ) + 
-  method ("-", (db::Edges (db::Edges::*)(const db::Edges &) const) &db::Edges::operator-, gsi::arg ("other"),
+  )) + 
+  gsi::release_gil (method ("-", (db::Edges (db::Edges::*)(const db::Edges &) const) &db::Edges::operator-, gsi::arg ("other"),
     "@brief Returns the boolean NOT between self and the other edge collection\n"
     "\n"
     "@return The result of the boolean NOT operation\n"
@@ -765,8 +765,8 @@ Class<db::Edges> dec_Edges ("db", "Edges",
     "The boolean NOT operation will return all parts of the edges in this collection which "
     "are not coincident with parts of the edges in the other collection."
     "The result will be a merged edge collection.\n"
-  ) + 
-  method ("-=", (db::Edges &(db::Edges::*)(const db::Edges &)) &db::Edges::operator-=, gsi::arg ("other"),
+  )) + 
+  gsi::release_gil (method ("-=", (db::Edges &(db::Edges::*)(const db::Edges &)) &db::Edges::operator-=, gsi::arg ("other"),
     "@brief Performs the boolean NOT between self and the other edge collection\n"
     "\n"
     "@return The edge collection after modification (self)\n"
@@ -774,8 +774,8 @@ Class<db::Edges> dec_Edges ("db", "Edges",
     "The boolean NOT operation will return all parts of the edges in this collection which "
     "are not coincident with parts of the edges in the other collection."
     "The result will be a merged edge collection.\n"
-  ) + 
-  method ("-", (db::Edges (db::Edges::*)(const db::Region &) const) &db::Edges::operator-, gsi::arg ("other"),
+  )) + 
+  gsi::release_gil (method ("-", (db::Edges (db::Edges::*)(const db::Region &) const) &db::Edges::operator-, gsi::arg ("other"),
     "@brief Returns the parts of the edges outside the given region\n"
     "\n"
     "@return The edges outside the given region\n"
@@ -786,8 +786,8 @@ Class<db::Edges> dec_Edges ("db", "Edges",
     "edges intersect.\n"
     "\n"
     "This method has been introduced in version 0.24."
-  ) + 
-  method ("-=", (db::Edges &(db::Edges::*)(const db::Region &)) &db::Edges::operator-=, gsi::arg ("other"),
+  )) + 
+  gsi::release_gil (method ("-=", (db::Edges &(db::Edges::*)(const db::Region &)) &db::Edges::operator-=, gsi::arg ("other"),
     "@brief Selects the parts of the edges outside the given region\n"
     "\n"
     "@return The edge collection after modification (self)\n"
@@ -798,8 +798,8 @@ Class<db::Edges> dec_Edges ("db", "Edges",
     "edges intersect.\n"
     "\n"
     "This method has been introduced in version 0.24."
-  ) + 
-  method ("^", &db::Edges::operator^, gsi::arg ("other"),
+  )) + 
+  gsi::release_gil (method ("^", &db::Edges::operator^, gsi::arg ("other"),
     "@brief Returns the boolean XOR between self and the other edge collection\n"
     "\n"
     "@return The result of the boolean XOR operation\n"
@@ -807,8 +807,8 @@ Class<db::Edges> dec_Edges ("db", "Edges",
     "The boolean XOR operation will return all parts of the edges in this and the other collection except "
     "the parts where both are coincident.\n"
     "The result will be a merged edge collection.\n"
-  ) + 
-  method ("^=", &db::Edges::operator^=, gsi::arg ("other"),
+  )) + 
+  gsi::release_gil (method ("^=", &db::Edges::operator^=, gsi::arg ("other"),
     "@brief Performs the boolean XOR between self and the other edge collection\n"
     "\n"
     "@return The edge collection after modification (self)\n"
@@ -816,7 +816,7 @@ Class<db::Edges> dec_Edges ("db", "Edges",
     "The boolean XOR operation will return all parts of the edges in this and the other collection except "
     "the parts where both are coincident.\n"
     "The result will be a merged edge collection.\n"
-  ) + 
+  )) + 
   method ("\\|", &db::Edges::operator|, gsi::arg ("other"),
     "@brief Returns the boolean OR between self and the other edge set\n"
     "\n"
@@ -1055,7 +1055,7 @@ Class<db::Edges> dec_Edges ("db", "Edges",
     "\n"
     "@return The transformed edge collection.\n"
   ) +
-  method_ext ("width_check", &width1, gsi::arg ("d"),
+  gsi::release_gil (method_ext ("width_check", &width1, gsi::arg ("d"),
     "@brief Performs a width check between edges\n"
     "@param d The minimum width for which the edges are checked\n"
     "@param other The other edge collection against which to check\n"
@@ -1071,8 +1071,8 @@ Class<db::Edges> dec_Edges ("db", "Edges",
     "\n"
     "A version of this method is available with more options (i.e. the option the deliver whole edges). "
     "Other checks with different edge relations are \\space_check, \\inside_check, \\overlap_check, \\separation_check and \\enclosing_check.\n"
-  ) +
-  method_ext ("width_check", &width2, gsi::arg ("d"), gsi::arg ("whole_edges"), gsi::arg ("metrics"), gsi::arg ("ignore_angle"), gsi::arg ("min_projection"), gsi::arg ("max_projection"),
+  )) +
+  gsi::release_gil (method_ext ("width_check", &width2, gsi::arg ("d"), gsi::arg ("whole_edges"), gsi::arg ("metrics"), gsi::arg ("ignore_angle"), gsi::arg ("min_projection"), gsi::arg ("max_projection"),
     "@brief Performs a width check with options\n"
     "@param d The minimum width for which the edges are checked\n"
     "@param whole_edges If true, deliver the whole edges\n"
@@ -1100,8 +1100,8 @@ Class<db::Edges> dec_Edges ("db", "Edges",
     "It is sufficient if the projection of one edge on the other matches the specified condition. "
     "The projected length must be larger or equal to \"min_projection\" and less than \"max_projection\". "
     "If you don't want to specify one threshold, pass nil to the respective value.\n"
-  ) +
-  method_ext ("space_check", &space1, gsi::arg ("d"),
+  )) +
+  gsi::release_gil (method_ext ("space_check", &space1, gsi::arg ("d"),
     "@brief Performs a space check between edges\n"
     "@param d The minimum distance for which the edges are checked\n"
     "To understand the space check for edges, one has to be familiar with the concept of the inside and outside "
@@ -1116,8 +1116,8 @@ Class<db::Edges> dec_Edges ("db", "Edges",
     "\n"
     "A version of this method is available with more options (i.e. the option the deliver whole edges). "
     "Other checks with different edge relations are \\width_check, \\inside_check, \\overlap_check, \\separation_check and \\enclosing_check.\n"
-  ) +
-  method_ext ("space_check", &space2, gsi::arg ("d"), gsi::arg ("whole_edges"), gsi::arg ("metrics"), gsi::arg ("ignore_angle"), gsi::arg ("min_projection"), gsi::arg ("max_projection"),
+  )) +
+  gsi::release_gil (method_ext ("space_check", &space2, gsi::arg ("d"), gsi::arg ("whole_edges"), gsi::arg ("metrics"), gsi::arg ("ignore_angle"), gsi::arg ("min_projection"), gsi::arg ("max_projection"),
     "@brief Performs a space check with options\n"
     "@param d The minimum distance for which the edges are checked\n"
     "@param whole_edges If true, deliver the whole edges\n"
@@ -1145,8 +1145,8 @@ Class<db::Edges> dec_Edges ("db", "Edges",
     "It is sufficient if the projection of one edge on the other matches the specified condition. "
     "The projected length must be larger or equal to \"min_projection\" and less than \"max_projection\". "
     "If you don't want to specify one threshold, pass nil to the respective value.\n"
-  ) +
-  method_ext ("inside_check", &inside1, gsi::arg ("other"), gsi::arg ("d"),
+  )) +
+  gsi::release_gil (method_ext ("inside_check", &inside1, gsi::arg ("other"), gsi::arg ("d"),
     "@brief Performs an inside check between edges\n"
     "@param d The minimum distance for which the edges are checked\n"
     "@param other The other edge collection against which to check\n"
@@ -1162,8 +1162,8 @@ Class<db::Edges> dec_Edges ("db", "Edges",
     "\n"
     "A version of this method is available with more options (i.e. the option the deliver whole edges). "
     "Other checks with different edge relations are \\width_check, \\space_check, \\overlap_check, \\separation_check and \\enclosing_check.\n"
-  ) +
-  method_ext ("inside_check", &inside2, gsi::arg ("other"), gsi::arg ("d"), gsi::arg ("whole_edges"), gsi::arg ("metrics"), gsi::arg ("ignore_angle"), gsi::arg ("min_projection"), gsi::arg ("max_projection"),
+  )) +
+  gsi::release_gil (method_ext ("inside_check", &inside2, gsi::arg ("other"), gsi::arg ("d"), gsi::arg ("whole_edges"), gsi::arg ("metrics"), gsi::arg ("ignore_angle"), gsi::arg ("min_projection"), gsi::arg ("max_projection"),
     "@brief Performs an inside check with options\n"
     "@param d The minimum distance for which the edges are checked\n"
     "@param other The other edge collection against which to check\n"
@@ -1192,8 +1192,8 @@ Class<db::Edges> dec_Edges ("db", "Edges",
     "It is sufficient if the projection of one edge on the other matches the specified condition. "
     "The projected length must be larger or equal to \"min_projection\" and less than \"max_projection\". "
     "If you don't want to specify one threshold, pass nil to the respective value.\n"
-  ) +
-  method_ext ("enclosing_check", &enclosing1, gsi::arg ("other"), gsi::arg ("d"),
+  )) +
+  gsi::release_gil (method_ext ("enclosing_check", &enclosing1, gsi::arg ("other"), gsi::arg ("d"),
     "@brief Performs an enclosing check between edges\n"
     "@param d The minimum distance for which the edges are checked\n"
     "@param other The other edge collection against which to check\n"
@@ -1209,8 +1209,8 @@ Class<db::Edges> dec_Edges ("db", "Edges",
     "\n"
     "A version of this method is available with more options (i.e. the option the deliver whole edges). "
     "Other checks with different edge relations are \\width_check, \\space_check, \\overlap_check, \\separation_check and \\inside_check.\n"
-  ) +
-  method_ext ("enclosing_check", &enclosing2, gsi::arg ("other"), gsi::arg ("d"), gsi::arg ("whole_edges"), gsi::arg ("metrics"), gsi::arg ("ignore_angle"), gsi::arg ("min_projection"), gsi::arg ("max_projection"),
+  )) +
+  gsi::release_gil (method_ext ("enclosing_check", &enclosing2, gsi::arg ("other"), gsi::arg ("d"), gsi::arg ("whole_edges"), gsi::arg ("metrics"), gsi::arg ("ignore_angle"), gsi::arg ("min_projection"), gsi::arg ("max_projection"),
     "@brief Performs an enclosing check with options\n"
     "@param d The minimum distance for which the edges are checked\n"
     "@param other The other edge collection against which to check\n"
@@ -1239,8 +1239,8 @@ Class<db::Edges> dec_Edges ("db", "Edges",
     "It is sufficient if the projection of one edge on the other matches the specified condition. "
     "The projected length must be larger or equal to \"min_projection\" and less than \"max_projection\". "
     "If you don't want to specify one threshold, pass nil to the respective value.\n"
-  ) +
-  method_ext ("overlap_check", &overlap1, gsi::arg ("other"), gsi::arg ("d"),
+  )) +
+  gsi::release_gil (method_ext ("overlap_check", &overlap1, gsi::arg ("other"), gsi::arg ("d"),
     "@brief Performs an overlap check between edges\n"
     "@param d The minimum distance for which the edges are checked\n"
     "@param other The other edge collection against which to check\n"
@@ -1254,8 +1254,8 @@ Class<db::Edges> dec_Edges ("db", "Edges",
     "\n"
     "A version of this method is available with more options (i.e. the option the deliver whole edges). "
     "Other checks with different edge relations are \\width_check, \\space_check, \\enclosing_check, \\separation_check and \\inside_check.\n"
-  ) +
-  method_ext ("overlap_check", &overlap2, gsi::arg ("other"), gsi::arg ("d"), gsi::arg ("whole_edges"), gsi::arg ("metrics"), gsi::arg ("ignore_angle"), gsi::arg ("min_projection"), gsi::arg ("max_projection"),
+  )) +
+  gsi::release_gil (method_ext ("overlap_check", &overlap2, gsi::arg ("other"), gsi::arg ("d"), gsi::arg ("whole_edges"), gsi::arg ("metrics"), gsi::arg ("ignore_angle"), gsi::arg ("min_projection"), gsi::arg ("max_projection"),
     "@brief Performs an overlap check with options\n"
     "@param d The minimum distance for which the edges are checked\n"
     "@param other The other edge collection against which to check\n"
@@ -1284,8 +1284,8 @@ Class<db::Edges> dec_Edges ("db", "Edges",
     "It is sufficient if the projection of one edge on the other matches the specified condition. "
     "The projected length must be larger or equal to \"min_projection\" and less than \"max_projection\". "
     "If you don't want to specify one threshold, pass nil to the respective value.\n"
-  ) +
-  method_ext ("separation_check", &separation1, gsi::arg ("other"), gsi::arg ("d"),
+  )) +
+  gsi::release_gil (method_ext ("separation_check", &separation1, gsi::arg ("other"), gsi::arg ("d"),
     "@brief Performs an separation check between edges\n"
     "@param d The minimum distance for which the edges are checked\n"
     "@param other The other edge collection against which to check\n"
@@ -1299,8 +1299,8 @@ Class<db::Edges> dec_Edges ("db", "Edges",
     "\n"
     "A version of this method is available with more options (i.e. the option the deliver whole edges). "
     "Other checks with different edge relations are \\width_check, \\space_check, \\enclosing_check, \\overlap_check and \\inside_check.\n"
-  ) +
-  method_ext ("separation_check", &separation2, gsi::arg ("other"), gsi::arg ("d"), gsi::arg ("whole_edges"), gsi::arg ("metrics"), gsi::arg ("ignore_angle"), gsi::arg ("min_projection"), gsi::arg ("max_projection"),
+  )) +
+  gsi::release_gil (method_ext ("separation_check", &separation2, gsi::arg ("other"), gsi::arg ("d"), gsi::arg ("whole_edges"), gsi::arg ("metrics"), gsi::arg ("ignore_angle"), gsi::arg ("min_projection"), gsi::arg ("max_projection"),
     "@brief Performs an overlap check with options\n"
     "@param d The minimum distance for which the edges are checked\n"
     "@param other The other edge collection against which to check\n"
@@ -1329,7 +1329,7 @@ Class<db::Edges> dec_Edges ("db", "Edges",
     "It is sufficient if the projection of one edge on the other matches the specified condition. "
     "The projected length must be larger or equal to \"min_projection\" and less than \"max_projection\". "
     "If you don't want to specify one threshold, pass nil to the respective value.\n"
-  ) +
+  )) +
   method_ext ("extents", &extents0,
     "@brief Returns a region with the bounding boxes of the edges\n"
     "This method will return a region consisting of the bounding boxes of the edges.\n"
@@ -25,6 +25,11 @@
 #define HDR_gsiDeclDbHelpers
 
 #include "dbLayoutUtils.h"
+#include "tlException.h"
+#include "tlString.h"
+
+#include <vector>
+#include <cstring>
 
 namespace gsi
 {
@@ -78,6 +83,73 @@ namespace gsi
     I m_i;
   };
 
+  /**
+   *  @brief Writes coordinates into a byte array
+   *
+   *  Byte arrays (std::vector<char>) are used for bulk transfer of coordinates:
+   *  the coordinates are stored in native binary representation and can be mapped to
+   *  typed arrays on the client side (e.g. with "numpy.frombuffer" in Python).
+   *  The writer is created for a given number of coordinates which need to be
+   *  delivered through "put" then.
+   */
+  template <class C>
+  class coord_buffer_writer
+  {
+  public:
+    coord_buffer_writer (std::vector<char> &data, size_t n)
+    {
+      data.resize (n * sizeof (C));
+      mp_wp = data.empty () ? 0 : &data.front ();
+    }
+
+    void put (C c)
+    {
+      memcpy (mp_wp, &c, sizeof (C));
+      mp_wp += sizeof (C);
+    }
+
+  private:
+    char *mp_wp;
+  };
+
+  /**
+   *  @brief Reads coordinates from a byte array
+   *
+   *  This is the counterpart of coord_buffer_writer. The byte array is expected to
+   *  hold a sequence of tuples with "tuple_size" coordinates each.
+   */
+  template <class C>
+  class coord_buffer_reader
+  {
+  public:
+    coord_buffer_reader (const std::vector<char> &data, size_t tuple_size)
+    {
+      size_t bytes = tuple_size * sizeof (C);
+      if (data.size () % bytes != 0) {
+        throw tl::Exception (tl::to_string (tr ("Invalid coordinate array: size (%d bytes) is not a multiple of %d bytes")), int (data.size ()), int (bytes));
+      }
+      m_n = data.size () / bytes;
+      mp_rp = data.empty () ? 0 : &data.front ();
+    }
+
+    size_t tuples () const
+    {
+      return m_n;
+    }
+
+    C get ()
+    {
+      C c;
+      memcpy (&c, mp_rp, sizeof (C));
+      mp_rp += sizeof (C);
+      return c;
+    }
+
+  private:
+    const char *mp_rp;
+    size_t m_n;
+  };
+
 }
 
 #endif
@@ -1725,7 +1725,7 @@ Class<db::Layout> decl_Layout ("db", "Layout",
     "variant with two parameters automatically determines the compression mode from the file name. "
     "The gzip parameter is ignored staring with version 0.23.\n"
   ) +
-  gsi::method_ext ("write", &write_options1,
+  gsi::release_gil (gsi::method_ext ("write", &write_options1,
     "@brief Writes the layout to a stream file\n"
     "@args filename, options\n"
     "@param filename The file to which to write the layout\n"
@@ -1735,12 +1735,12 @@ Class<db::Layout> decl_Layout ("db", "Layout",
     "The file is written with zlib compression if the suffix is \".gz\" or \".gzip\".\n"
     "\n"
     "This variant has been introduced in version 0.23.\n"
-  ) +
-  gsi::method_ext ("write", &write_simple,
+  )) +
+  gsi::release_gil (gsi::method_ext ("write", &write_simple,
     "@brief Writes the layout to a stream file\n"
     "@args filename\n"
     "@param filename The file to which to write the layout\n"
-  ) + 
+  )) + 
   gsi::method_ext ("clip", &clip,
     "@brief Clips the given cell by the given rectangle and produce a new cell with the clip\n"
     "@args cell, box\n"
@@ -288,7 +288,7 @@ Class<db::LayoutToNetlist> decl_dbLayoutToNetlist ("db", "LayoutToNetlist",
   gsi::method ("global_net_name", &db::LayoutToNetlist::global_net_name, gsi::arg ("global_net_id"),
     "@brief Gets the global net name for the given global net ID."
   ) +
-  gsi::method ("extract_netlist", &db::LayoutToNetlist::extract_netlist, gsi::arg ("join_net_names", std::string ()),
+  gsi::release_gil (gsi::method ("extract_netlist", &db::LayoutToNetlist::extract_netlist, gsi::arg ("join_net_names", std::string ()),
     "@brief Runs the netlist extraction\n"
     "'join_net_names' is a glob expression for labels. Nets on top level carrying the same label which matches this glob "
     "expression will be connected implicitly even if there is no physical connection. This feature is useful to simulate a connection "
@@ -306,7 +306,7 @@ Class<db::LayoutToNetlist> decl_dbLayoutToNetlist ("db", "LayoutToNetlist",
     "Label matching is case sensitive.\n"
     "\n"
     "See the class description for more details.\n"
-  ) +
+  )) +
   gsi::method_ext ("internal_layout", &l2n_internal_layout,
     "@brief Gets the internal layout\n"
     "Usually it should not be required to obtain the internal layout. If you need to do so, make sure not to modify the layout as\n"
@@ -28,6 +28,7 @@
 #include "dbPCellDeclaration.h"
 #include "dbLibrary.h"
 #include "dbLibraryManager.h"
+#include "dbPCellVariantCache.h"
 
 namespace gsi
 {
@@ -128,6 +129,22 @@ Class<db::Library> decl_Library ("db", "Library",
     "See \\technology for details. "
     "This attribute has been introduced in version 0.25."
   ) +
+  gsi::method ("threads", &db::Library::threads,
+    "@brief Gets the number of worker threads used for producing PCell variants\n"
+    "See \\threads= for details.\n"
+    "\n"
+    "This attribute has been introduced in version 0.26."
+  ) +
+  gsi::method ("threads=", &db::Library::set_threads, gsi::arg ("n"),
+    "@brief Sets the number of worker threads used for producing PCell variants\n"
+    "When a library is registered again (e.g. on refresh), the library proxies of the previous "
+    "library are mapped to the new one. This involves producing all PCell variants in use. With "
+    "a thread count larger than zero, variants of PCells implemented in C++ are produced "
+    "on that number of worker threads. PCells implemented in scripts are always produced "
+    "serially.\n"
+    "\n"
+    "This attribute has been introduced in version 0.26."
+  ) +
   gsi::method ("layout_const", (const db::Layout &(db::Library::*)() const) &db::Library::layout,
     "@brief The layout object where the cells reside that this library defines (const version)\n"
   ) +
@@ -317,6 +334,20 @@ public:
     }
   }
 
+  std::string cache_key_fb () const
+  {
+    return db::PCellDeclaration::cache_key ();
+  }
+
+  virtual std::string cache_key () const
+  {
+    if (cb_cache_key.can_issue ()) {
+      return cb_cache_key.issue<db::PCellDeclaration, std::string> (&db::PCellDeclaration::cache_key);
+    } else {
+      return db::PCellDeclaration::cache_key ();
+    }
+  }
+
   gsi::Callback cb_get_layer_declarations;
   gsi::Callback cb_get_parameter_declarations;
   gsi::Callback cb_produce;
@@ -325,8 +356,19 @@ public:
   gsi::Callback cb_transformation_from_shape;
   gsi::Callback cb_coerce_parameters;
   gsi::Callback cb_get_display_name;
+  gsi::Callback cb_cache_key;
 };
 
+static void set_variant_cache_path (const std::string &path)
+{
+  db::PCellVariantCache::instance ().set_path (path);
+}
+
+static std::string variant_cache_path ()
+{
+  return db::PCellVariantCache::instance ().path ();
+}
+
 Class<PCellDeclarationImpl> decl_PCellDeclaration (decl_PCellDeclaration_Native, "db", "PCellDeclaration",
   //  fallback implementations to reroute Ruby calls to the base class:
   gsi::method ("get_parameters", &PCellDeclarationImpl::get_parameter_declarations_fb, "@hide") +
@@ -335,6 +377,7 @@ Class<PCellDeclarationImpl> decl_PCellDeclaration (decl_PCellDeclaration_Native,
   gsi::method ("parameters_from_shape", &PCellDeclarationImpl::parameters_from_shape_fb, "@hide") +
   gsi::method ("transformation_from_shape", &PCellDeclarationImpl::transformation_from_shape_fb, "@hide") +
   gsi::method ("display_text", &PCellDeclarationImpl::get_display_name_fb, "@hide") +
+  gsi::method ("cache_key", &PCellDeclarationImpl::cache_key_fb, "@hide") +
   gsi::callback ("get_layers", &PCellDeclarationImpl::get_layer_declarations_impl, &PCellDeclarationImpl::cb_get_layer_declarations, 
     "@brief Returns a list of layer declarations\n"
     "@args parameters\n"
@@ -414,6 +457,34 @@ Class<PCellDeclarationImpl> decl_PCellDeclaration (decl_PCellDeclaration_Native,
     "@args parameters\n"
     "Reimplement this method to create a distinct display text for a PCell variant with \n"
     "the given parameter set. If this method is not implemented, a default text is created. \n"
+  ) +
+  gsi::callback ("cache_key", &PCellDeclarationImpl::cache_key, &PCellDeclarationImpl::cb_cache_key,
+    "@brief Returns a key identifying the implementation for the persistent variant cache\n"
+    "If the persistent variant cache is enabled (see \\variant_cache_path=) and this method returns a non-empty "
+    "string, the geometry of a variant is stored in the cache when it is produced. Later, the variant is "
+    "restored from the cache instead of calling \\produce and \\display_text again.\n"
+    "\n"
+    "The key must change whenever the result of \\produce changes for the same parameters and layers - "
+    "for example, a hash of the PCell's code plus the technology name. Only variants made of "
+    "boxes, polygons, paths, texts, edges and edge pairs without properties and without child instances "
+    "are cached.\n"
+    "\n"
+    "The default implementation returns an empty string, so the PCell is not cached.\n"
+    "\n"
+    "This method has been introduced in version 0.26.\n"
+  ) +
+  gsi::method ("variant_cache_path=", &set_variant_cache_path, gsi::arg ("path"),
+    "@brief Enables the persistent PCell variant cache with the given directory\n"
+    "Setting an empty string disables the cache. The directory is created if required. "
+    "The cache applies to all PCells implementing \\cache_key.\n"
+    "\n"
+    "This method has been introduced in version 0.26.\n"
+  ) +
+  gsi::method ("variant_cache_path", &variant_cache_path,
+    "@brief Gets the directory of the persistent PCell variant cache\n"
+    "An empty string indicates that the cache is disabled.\n"
+    "\n"
+    "This method has been introduced in version 0.26.\n"
   ),
   "@brief A PCell declaration providing the parameters and code to produce the PCell\n"
   "\n"
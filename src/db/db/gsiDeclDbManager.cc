@@ -118,6 +118,26 @@ Class<db::Manager> decl_Manager ("db", "Manager",
   ) +
   gsi::method_ext ("transaction_for_redo", &transaction_for_redo,
     "@brief Return the description of the next transaction for 'redo'\n"
+  ) +
+  gsi::method ("max_memory=", &db::Manager::set_max_memory, gsi::arg ("bytes"),
+    "@brief Sets the memory limit for the undo buffer\n"
+    "\n"
+    "If the memory used by the transactions exceeds this limit, the oldest transactions "
+    "are discarded when a transaction is committed. The latest transaction is always kept. "
+    "A value of 0 (the default) disables the limit.\n"
+    "\n"
+    "This method has been introduced in version 0.26.\n"
+  ) +
+  gsi::method ("max_memory", &db::Manager::max_memory,
+    "@brief Gets the memory limit for the undo buffer\n"
+    "See \\max_memory= for details.\n"
+    "\n"
+    "This method has been introduced in version 0.26.\n"
+  ) +
+  gsi::method ("memory_used", &db::Manager::memory_used,
+    "@brief Gets the approximate memory used by the transactions in bytes\n"
+    "\n"
+    "This method has been introduced in version 0.26.\n"
   ),
   "@brief A transaction manager class\n"
   "\n"
@@ -27,6 +27,7 @@
 #include "dbPolygonTools.h"
 #include "dbPolygonGenerators.h"
 #include "dbHash.h"
+#include "gsiDeclDbHelpers.h"
 
 namespace gsi
 {
@@ -844,6 +845,50 @@ struct polygon_defs
     }
   }
 
+  static std::vector<char> contour_coordinates (const typename C::contour_type &ctr)
+  {
+    std::vector<char> data;
+    gsi::coord_buffer_writer<coord_type> w (data, ctr.size () * 2);
+    for (size_t i = 0; i < ctr.size (); ++i) {
+      point_type p = ctr [i];
+      w.put (p.x ());
+      w.put (p.y ());
+    }
+    return data;
+  }
+
+  static std::vector<point_type> points_from_coordinates (const std::vector<char> &data)
+  {
+    gsi::coord_buffer_reader<coord_type> r (data, 2);
+    std::vector<point_type> pts;
+    pts.reserve (r.tuples ());
+    for (size_t i = 0; i < r.tuples (); ++i) {
+      coord_type x = r.get ();
+      coord_type y = r.get ();
+      pts.push_back (point_type (x, y));
+    }
+    return pts;
+  }
+
+  static std::vector<char> hull_coordinates (const C *c)
+  {
+    return contour_coordinates (c->hull ());
+  }
+
+  static std::vector<char> hole_coordinates (const C *c, unsigned int n)
+  {
+    if (c->holes () > n) {
+      return contour_coordinates (c->hole (n));
+    } else {
+      return std::vector<char> ();
+    }
+  }
+
+  static void set_hull_coordinates (C *c, const std::vector<char> &data, bool raw)
+  {
+    set_hull (c, points_from_coordinates (data), raw);
+  }
+
   static void set_hole_box (C *c, unsigned int n, const box_type &box)
   {
     if (c->holes () > n) {
@@ -1170,6 +1215,35 @@ struct polygon_defs
       "\n"
       "The 'raw' argument was added in version 0.24.\n"
     ) +
+    method_ext ("hull_coordinates", &hull_coordinates,
+      "@brief Gets the coordinates of the hull points as a byte array\n"
+      "\n"
+      "The byte array contains the x and y coordinates of the hull points in native binary "
+      "representation (x0, y0, x1, y1, ...). For \\Polygon objects, the coordinates are 32 bit integers "
+      "(64 bit integers in builds with 64 bit coordinates), for \\DPolygon objects they are "
+      "double-precision floats. In Python, the byte array is delivered as a 'bytes' object which "
+      "can be mapped to a NumPy array, e.g. 'numpy.frombuffer(poly.hull_coordinates(), dtype=numpy.int32).reshape(-1, 2)'. "
+      "This method is much faster than delivering individual point objects.\n"
+      "\n"
+      "This method has been introduced in version 0.26.\n"
+    ) +
+    method_ext ("hole_coordinates", &hole_coordinates, gsi::arg ("n"),
+      "@brief Gets the coordinates of the points of the given hole as a byte array\n"
+      "@param n The index of the hole\n"
+      "See \\hull_coordinates for a description of the format. If the hole index is not valid, an empty array is returned.\n"
+      "\n"
+      "This method has been introduced in version 0.26.\n"
+    ) +
+    method_ext ("assign_hull_coordinates", &set_hull_coordinates, gsi::arg ("data"), gsi::arg ("raw", false),
+      "@brief Sets the hull points from a byte array of coordinates\n"
+      "@param data The coordinates in the format delivered by \\hull_coordinates\n"
+      "@param raw If true, the points won't be compressed (see \\assign_hull)\n"
+      "\n"
+      "In Python, any object supporting the buffer protocol can be passed - e.g. a NumPy array of "
+      "the matching type. The size of the byte array needs to be a multiple of the size of one point.\n"
+      "\n"
+      "This method has been introduced in version 0.26.\n"
+    ) +
     method_ext ("assign_hole", &set_hole, gsi::arg ("n"), gsi::arg ("p"), gsi::arg ("raw", false),
       "@brief Set the points of the given hole of the polygon\n"
       "@param n The index of the hole to which the points should be assigned\n"
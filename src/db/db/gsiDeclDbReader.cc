@@ -262,7 +262,7 @@ namespace gsi
   //  extend the layout class by two reader methods
   static
   gsi::ClassExt<db::Layout> layout_reader_decl (
-    gsi::method_ext ("read", &load_without_options,
+    gsi::release_gil (gsi::method_ext ("read", &load_without_options,
       "@brief Load the layout from the given file\n"
       "@args filename\n"
       "The format of the file is determined automatically and automatic unzipping is provided. "
@@ -271,8 +271,8 @@ namespace gsi
       "@return A layer map that contains the mapping used by the reader including the layers that have been created."
       "\n"
       "This method has been added in version 0.18."
-    ) +
-    gsi::method_ext ("read", &load_with_options,
+    )) +
+    gsi::release_gil (gsi::method_ext ("read", &load_with_options,
       "@brief Load the layout from the given file with options\n"
       "@args filename,options\n"
       "The format of the file is determined automatically and automatic unzipping is provided. "
@@ -282,7 +282,7 @@ namespace gsi
       "@return A layer map that contains the mapping used by the reader including the layers that have been created."
       "\n"
       "This method has been added in version 0.18."
-    ),
+    )),
     ""
   );
 
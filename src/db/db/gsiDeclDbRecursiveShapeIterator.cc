@@ -314,6 +314,16 @@ Class<db::RecursiveShapeIterator> decl_RecursiveShapeIterator ("db", "RecursiveS
     "\n"
     "This method has been introduced in version 0.25.\n"
   ) +
+  gsi::method ("partition", &db::RecursiveShapeIterator::partition,
+    "@brief Splits the iteration into independent parts\n"
+    "@args n\n"
+    "This method delivers up to n iterators which together deliver the same shapes than this iterator. "
+    "Each shape is delivered by exactly one of them. The parts are formed by vertical stripes of the bounding box and "
+    "each shape is assigned to the stripe which contains the left edge of its bounding box. "
+    "The parts can be processed independently, e.g. in different threads.\n"
+    "\n"
+    "This method has been introduced in version 0.26.\n"
+  ) +
   gsi::method ("overlapping?", &db::RecursiveShapeIterator::overlapping,
     "@brief Gets a flag indicating whether overlapping shapes are selected when a region is used\n"
     "\n"
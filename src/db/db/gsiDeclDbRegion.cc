@@ -1143,15 +1143,15 @@ Class<db::Region> decl_Region ("db", "Region",
     "\n"
     "This function has been introduced in version 0.25.\n"
   ) +
-  method ("merge", (db::Region &(db::Region::*) ()) &db::Region::merge,
+  gsi::release_gil (method ("merge", (db::Region &(db::Region::*) ()) &db::Region::merge,
     "@brief Merge the region\n"
     "\n"
     "@return The region after is has been merged (self).\n"
     "\n"
     "Merging removes overlaps and joins touching polygons.\n"
     "If the region is already merged, this method does nothing\n"
-  ) +
-  method_ext ("merge", &merge_ext1,
+  )) +
+  gsi::release_gil (method_ext ("merge", &merge_ext1,
     "@brief Merge the region with options\n"
     "\n"
     "@args min_wc\n"
@@ -1164,8 +1164,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "means that output is only produced if two or more polygons overlap.\n"
     "\n"
     "This method is equivalent to \"merge(false, min_wc).\n"
-  ) +
-  method_ext ("merge", &merge_ext2,
+  )) +
+  gsi::release_gil (method_ext ("merge", &merge_ext2,
     "@brief Merge the region with options\n"
     "\n"
     "@args min_coherence, min_wc\n"
@@ -1178,8 +1178,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "resolved by producing separate polygons. \"min_wc\" controls whether output is only produced if multiple "
     "polygons overlap. The value specifies the number of polygons that need to overlap. A value of 2 "
     "means that output is only produced if two or more polygons overlap.\n"
-  ) +
-  method ("merged", (db::Region (db::Region::*) () const) &db::Region::merged,
+  )) +
+  gsi::release_gil (method ("merged", (db::Region (db::Region::*) () const) &db::Region::merged,
     "@brief Returns the merged region\n"
     "\n"
     "@return The region after is has been merged.\n"
@@ -1187,8 +1187,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "Merging removes overlaps and joins touching polygons.\n"
     "If the region is already merged, this method does nothing.\n"
     "In contrast to \\merge, this method does not modify the region but returns a merged copy.\n"
-  ) +
-  method_ext ("merged", &merged_ext1,
+  )) +
+  gsi::release_gil (method_ext ("merged", &merged_ext1,
     "@brief Returns the merged region (with options)\n"
     "@args min_wc\n"
     "\n"
@@ -1201,8 +1201,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "This method is equivalent to \"merged(false, min_wc)\".\n"
     "\n"
     "In contrast to \\merge, this method does not modify the region but returns a merged copy.\n"
-  ) +
-  method_ext ("merged", &merged_ext2,
+  )) +
+  gsi::release_gil (method_ext ("merged", &merged_ext2,
     "@brief Returns the merged region (with options)\n"
     "\n"
     "@args min_coherence, min_wc\n"
@@ -1217,7 +1217,7 @@ Class<db::Region> decl_Region ("db", "Region",
     "means that output is only produced if two or more polygons overlap.\n"
     "\n"
     "In contrast to \\merge, this method does not modify the region but returns a merged copy.\n"
-  ) +
+  )) +
   method ("round_corners", &db::Region::round_corners,
     "@brief Corner rounding\n"
     "@args r_inner, r_outer, n\n"
@@ -1262,7 +1262,7 @@ Class<db::Region> decl_Region ("db", "Region",
     "See \\smooth for a description of this method. This version returns a new region instead of "
     "modifying self (out-of-place). It has been introduced in version 0.25."
   ) +
-  method ("size", (db::Region & (db::Region::*) (db::Coord, db::Coord, unsigned int)) &db::Region::size,
+  gsi::release_gil (method ("size", (db::Region & (db::Region::*) (db::Coord, db::Coord, unsigned int)) &db::Region::size,
     "@brief Anisotropic sizing (biasing)\n"
     "\n"
     "@args dx, dy, mode\n"
@@ -1291,8 +1291,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "r.merge(false, 1)\n"
     "# r now is (50,-50;50,100;100,100;100,-50)\n"
     "@/code\n"
-  ) + 
-  method ("size", (db::Region & (db::Region::*) (db::Coord, unsigned int)) &db::Region::size,
+  )) + 
+  gsi::release_gil (method ("size", (db::Region & (db::Region::*) (db::Coord, unsigned int)) &db::Region::size,
     "@brief Isotropic sizing (biasing)\n"
     "\n"
     "@args d, mode\n"
@@ -1301,8 +1301,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "This method is equivalent to \"size(d, d, mode)\".\n"
     "\n"
     "Merged semantics applies for this method (see \\merged_semantics= of merged semantics)\n"
-  ) + 
-  method_ext ("size", size_ext,
+  )) + 
+  gsi::release_gil (method_ext ("size", size_ext,
     "@brief Isotropic sizing (biasing)\n"
     "\n"
     "@args d, mode\n"
@@ -1311,8 +1311,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "This method is equivalent to \"size(d, d, 2)\".\n"
     "\n"
     "Merged semantics applies for this method (see \\merged_semantics= of merged semantics)\n"
-  ) + 
-  method ("sized", (db::Region (db::Region::*) (db::Coord, db::Coord, unsigned int) const) &db::Region::sized,
+  )) + 
+  gsi::release_gil (method ("sized", (db::Region (db::Region::*) (db::Coord, db::Coord, unsigned int) const) &db::Region::sized,
     "@brief Returns the anisotropically sized region\n"
     "\n"
     "@args dx, dy, mode\n"
@@ -1321,8 +1321,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "This method is returns the sized region (see \\size), but does not modify self.\n"
     "\n"
     "Merged semantics applies for this method (see \\merged_semantics= of merged semantics)\n"
-  ) + 
-  method ("sized", (db::Region (db::Region::*) (db::Coord, unsigned int) const) &db::Region::sized,
+  )) + 
+  gsi::release_gil (method ("sized", (db::Region (db::Region::*) (db::Coord, unsigned int) const) &db::Region::sized,
     "@brief Returns the isotropically sized region\n"
     "\n"
     "@args d, mode\n"
@@ -1331,8 +1331,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "This method is returns the sized region (see \\size), but does not modify self.\n"
     "\n"
     "Merged semantics applies for this method (see \\merged_semantics= of merged semantics)\n"
-  ) + 
-  method_ext ("sized", sized_ext,
+  )) + 
+  gsi::release_gil (method_ext ("sized", sized_ext,
     "@brief Isotropic sizing (biasing)\n"
     "\n"
     "@args d, mode\n"
@@ -1341,8 +1341,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "This method is equivalent to \"sized(d, d, 2)\".\n"
     "\n"
     "Merged semantics applies for this method (see \\merged_semantics= of merged semantics)\n"
-  ) + 
-  method ("&", &db::Region::operator&,
+  )) + 
+  gsi::release_gil (method ("&", &db::Region::operator&,
     "@brief Returns the boolean AND between self and the other region\n"
     "\n"
     "@args other\n"
@@ -1350,8 +1350,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "\n"
     "This method will compute the boolean AND (intersection) between two regions. "
     "The result is often but not necessarily always merged.\n"
-  ) + 
-  method ("&=", &db::Region::operator&=,
+  )) + 
+  gsi::release_gil (method ("&=", &db::Region::operator&=,
     "@brief Performs the boolean AND between self and the other region\n"
     "\n"
     "@args other\n"
@@ -1359,8 +1359,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "\n"
     "This method will compute the boolean AND (intersection) between two regions. "
     "The result is often but not necessarily always merged.\n"
-  ) + 
-  method ("-", &db::Region::operator-,
+  )) + 
+  gsi::release_gil (method ("-", &db::Region::operator-,
     "@brief Returns the boolean NOT between self and the other region\n"
     "\n"
     "@args other\n"
@@ -1368,8 +1368,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "\n"
     "This method will compute the boolean NOT (intersection) between two regions. "
     "The result is often but not necessarily always merged.\n"
-  ) + 
-  method ("-=", &db::Region::operator-=,
+  )) + 
+  gsi::release_gil (method ("-=", &db::Region::operator-=,
     "@brief Performs the boolean NOT between self and the other region\n"
     "\n"
     "@args other\n"
@@ -1377,8 +1377,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "\n"
     "This method will compute the boolean NOT (intersection) between two regions. "
     "The result is often but not necessarily always merged.\n"
-  ) + 
-  method ("^", &db::Region::operator^,
+  )) + 
+  gsi::release_gil (method ("^", &db::Region::operator^,
     "@brief Returns the boolean NOT between self and the other region\n"
     "\n"
     "@args other\n"
@@ -1386,8 +1386,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "\n"
     "This method will compute the boolean XOR (intersection) between two regions. "
     "The result is often but not necessarily always merged.\n"
-  ) + 
-  method ("^=", &db::Region::operator^=,
+  )) + 
+  gsi::release_gil (method ("^=", &db::Region::operator^=,
     "@brief Performs the boolean XOR between self and the other region\n"
     "\n"
     "@args other\n"
@@ -1395,7 +1395,7 @@ Class<db::Region> decl_Region ("db", "Region",
     "\n"
     "This method will compute the boolean XOR (intersection) between two regions. "
     "The result is often but not necessarily always merged.\n"
-  ) + 
+  )) + 
   method ("\\|", &db::Region::operator|,
     "@brief Returns the boolean OR between self and the other region\n"
     "\n"
@@ -1432,22 +1432,22 @@ Class<db::Region> decl_Region ("db", "Region",
     "This operator adds the polygons of the other region to self. "
     "This usually creates unmerged regions and polygons may overlap. Use \\merge if you want to ensure the result region is merged.\n"
   ) + 
-  method ("inside", &db::Region::selected_inside,
+  gsi::release_gil (method ("inside", &db::Region::selected_inside,
     "@brief Returns the polygons of this region which are completely inside polygons from the other region\n"
     "\n"
     "@args other\n"
     "@return A new region containing the polygons which are inside polygons from the other region\n"
     "\n"
     "Merged semantics applies for this method (see \\merged_semantics= of merged semantics)\n"
-  ) + 
-  method ("not_inside", &db::Region::selected_not_inside,
+  )) + 
+  gsi::release_gil (method ("not_inside", &db::Region::selected_not_inside,
     "@brief Returns the polygons of this region which are not completely inside polygons from the other region\n"
     "\n"
     "@args other\n"
     "@return A new region containing the polygons which are not inside polygons from the other region\n"
     "\n"
     "Merged semantics applies for this method (see \\merged_semantics= of merged semantics)\n"
-  ) + 
+  )) + 
   method ("select_inside", &db::Region::select_inside,
     "@brief Selects the polygons of this region which are completely inside polygons from the other region\n"
     "\n"
@@ -1464,22 +1464,22 @@ Class<db::Region> decl_Region ("db", "Region",
     "\n"
     "Merged semantics applies for this method (see \\merged_semantics= of merged semantics)\n"
   ) + 
-  method ("outside", &db::Region::selected_outside,
+  gsi::release_gil (method ("outside", &db::Region::selected_outside,
     "@brief Returns the polygons of this region which are completely outside polygons from the other region\n"
     "\n"
     "@args other\n"
     "@return A new region containing the polygons which are outside polygons from the other region\n"
     "\n"
     "Merged semantics applies for this method (see \\merged_semantics= of merged semantics)\n"
-  ) + 
-  method ("not_outside", &db::Region::selected_not_outside,
+  )) + 
+  gsi::release_gil (method ("not_outside", &db::Region::selected_not_outside,
     "@brief Returns the polygons of this region which are not completely outside polygons from the other region\n"
     "\n"
     "@args other\n"
     "@return A new region containing the polygons which are not outside polygons from the other region\n"
     "\n"
     "Merged semantics applies for this method (see \\merged_semantics= of merged semantics)\n"
-  ) + 
+  )) + 
   method ("select_outside", &db::Region::select_outside,
     "@brief Selects the polygons of this region which are completely outside polygons from the other region\n"
     "\n"
@@ -1496,39 +1496,39 @@ Class<db::Region> decl_Region ("db", "Region",
     "\n"
     "Merged semantics applies for this method (see \\merged_semantics= of merged semantics)\n"
   ) + 
-  method ("interacting", (db::Region (db::Region::*) (const db::Region &) const) &db::Region::selected_interacting,
+  gsi::release_gil (method ("interacting", (db::Region (db::Region::*) (const db::Region &) const) &db::Region::selected_interacting,
     "@brief Returns the polygons of this region which overlap or touch polygons from the other region\n"
     "\n"
     "@args other\n"
     "@return A new region containing the polygons overlapping or touching polygons from the other region\n"
     "\n"
     "Merged semantics applies for this method (see \\merged_semantics= of merged semantics)\n"
-  ) + 
-  method ("not_interacting", (db::Region (db::Region::*) (const db::Region &) const) &db::Region::selected_not_interacting,
+  )) + 
+  gsi::release_gil (method ("not_interacting", (db::Region (db::Region::*) (const db::Region &) const) &db::Region::selected_not_interacting,
     "@brief Returns the polygons of this region which do not overlap or touch polygons from the other region\n"
     "\n"
     "@args other\n"
     "@return A new region containing the polygons not overlapping or touching polygons from the other region\n"
     "\n"
     "Merged semantics applies for this method (see \\merged_semantics= of merged semantics)\n"
-  ) + 
-  method ("select_interacting", (db::Region &(db::Region::*) (const db::Region &)) &db::Region::select_interacting,
+  )) + 
+  gsi::release_gil (method ("select_interacting", (db::Region &(db::Region::*) (const db::Region &)) &db::Region::select_interacting,
     "@brief Selects the polygons from this region which overlap or touch polygons from the other region\n"
     "\n"
     "@args other\n"
     "@return The region after the polygons have been selected (self)\n"
     "\n"
     "Merged semantics applies for this method (see \\merged_semantics= of merged semantics)\n"
-  ) + 
-  method ("select_not_interacting", (db::Region &(db::Region::*) (const db::Region &)) &db::Region::select_not_interacting,
+  )) + 
+  gsi::release_gil (method ("select_not_interacting", (db::Region &(db::Region::*) (const db::Region &)) &db::Region::select_not_interacting,
     "@brief Selects the polygons from this region which do not overlap or touch polygons from the other region\n"
     "\n"
     "@args other\n"
     "@return The region after the polygons have been selected (self)\n"
     "\n"
     "Merged semantics applies for this method (see \\merged_semantics= of merged semantics)\n"
-  ) + 
-  method ("interacting", (db::Region (db::Region::*) (const db::Edges &) const) &db::Region::selected_interacting,
+  )) + 
+  gsi::release_gil (method ("interacting", (db::Region (db::Region::*) (const db::Edges &) const) &db::Region::selected_interacting,
     "@brief Returns the polygons of this region which overlap or touch edges from the edge collection\n"
     "\n"
     "@args other\n"
@@ -1537,8 +1537,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "Merged semantics applies for this method (see \\merged_semantics= of merged semantics)\n"
     "\n"
     "This method has been introduced in version 0.25\n"
-  ) +
-  method ("not_interacting", (db::Region (db::Region::*) (const db::Edges &) const) &db::Region::selected_not_interacting,
+  )) +
+  gsi::release_gil (method ("not_interacting", (db::Region (db::Region::*) (const db::Edges &) const) &db::Region::selected_not_interacting,
     "@brief Returns the polygons of this region which do not overlap or touch edges from the edge collection\n"
     "\n"
     "@args other\n"
@@ -1547,8 +1547,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "Merged semantics applies for this method (see \\merged_semantics= of merged semantics)\n"
     "\n"
     "This method has been introduced in version 0.25\n"
-  ) +
-  method ("select_interacting", (db::Region &(db::Region::*) (const db::Edges &)) &db::Region::select_interacting,
+  )) +
+  gsi::release_gil (method ("select_interacting", (db::Region &(db::Region::*) (const db::Edges &)) &db::Region::select_interacting,
     "@brief Selects the polygons from this region which overlap or touch edges from the edge collection\n"
     "\n"
     "@args other\n"
@@ -1557,8 +1557,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "Merged semantics applies for this method (see \\merged_semantics= of merged semantics)\n"
     "\n"
     "This method has been introduced in version 0.25\n"
-  ) +
-  method ("select_not_interacting", (db::Region &(db::Region::*) (const db::Edges &)) &db::Region::select_not_interacting,
+  )) +
+  gsi::release_gil (method ("select_not_interacting", (db::Region &(db::Region::*) (const db::Edges &)) &db::Region::select_not_interacting,
     "@brief Selects the polygons from this region which do not overlap or touch edges from the edge collection\n"
     "\n"
     "@args other\n"
@@ -1567,39 +1567,39 @@ Class<db::Region> decl_Region ("db", "Region",
     "Merged semantics applies for this method (see \\merged_semantics= of merged semantics)\n"
     "\n"
     "This method has been introduced in version 0.25\n"
-  ) +
-  method ("overlapping", &db::Region::selected_overlapping,
+  )) +
+  gsi::release_gil (method ("overlapping", &db::Region::selected_overlapping,
     "@brief Returns the polygons of this region which overlap polygons from the other region\n"
     "\n"
     "@args other\n"
     "@return A new region containing the polygons overlapping polygons from the other region\n"
     "\n"
     "Merged semantics applies for this method (see \\merged_semantics= of merged semantics)\n"
-  ) + 
-  method ("not_overlapping", &db::Region::selected_not_overlapping,
+  )) + 
+  gsi::release_gil (method ("not_overlapping", &db::Region::selected_not_overlapping,
     "@brief Returns the polygons of this region which do not overlap polygons from the other region\n"
     "\n"
     "@args other\n"
     "@return A new region containing the polygons not overlapping polygons from the other region\n"
     "\n"
     "Merged semantics applies for this method (see \\merged_semantics= of merged semantics)\n"
-  ) + 
-  method ("select_overlapping", &db::Region::select_overlapping,
+  )) + 
+  gsi::release_gil (method ("select_overlapping", &db::Region::select_overlapping,
     "@brief Selects the polygons from this region which overlap polygons from the other region\n"
     "\n"
     "@args other\n"
     "@return The region after the polygons have been selected (self)\n"
     "\n"
     "Merged semantics applies for this method (see \\merged_semantics= of merged semantics)\n"
-  ) + 
-  method ("select_not_overlapping", &db::Region::select_not_overlapping,
+  )) + 
+  gsi::release_gil (method ("select_not_overlapping", &db::Region::select_not_overlapping,
     "@brief Selects the polygons from this region which do not overlap polygons from the other region\n"
     "\n"
     "@args other\n"
     "@return The region after the polygons have been selected (self)\n"
     "\n"
     "Merged semantics applies for this method (see \\merged_semantics= of merged semantics)\n"
-  ) + 
+  )) + 
   method ("is_box?", &db::Region::is_box,
     "@brief Returns true, if the region is a simple box\n"
     "\n"
@@ -1863,7 +1863,7 @@ Class<db::Region> decl_Region ("db", "Region",
     "\n"
     "@return The transformed region.\n"
   ) +
-  method_ext ("width_check", &width1, gsi::arg ("d"),
+  gsi::release_gil (method_ext ("width_check", &width1, gsi::arg ("d"),
     "@brief Performs a width check\n"
     "@param d The minimum width for which the polygons are checked\n"
     "Performs a width check against the minimum width \"d\". For locations where a polygon has a "
@@ -1873,8 +1873,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "See \\EdgePairs for a description of that collection object.\n"
     "\n"
     "Merged semantics applies for the input of this method (see \\merged_semantics= of merged semantics)\n"
-  ) +
-  method_ext ("width_check", &width2, gsi::arg ("d"), gsi::arg ("whole_edges"), gsi::arg ("metrics"), gsi::arg ("ignore_angle"), gsi::arg ("min_projection"), gsi::arg ("max_projection"),
+  )) +
+  gsi::release_gil (method_ext ("width_check", &width2, gsi::arg ("d"), gsi::arg ("whole_edges"), gsi::arg ("metrics"), gsi::arg ("ignore_angle"), gsi::arg ("min_projection"), gsi::arg ("max_projection"),
     "@brief Performs a width check with options\n"
     "@param d The minimum width for which the polygons are checked\n"
     "@param whole_edges If true, deliver the whole edges\n"
@@ -1904,8 +1904,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "If you don't want to specify one limit, pass nil to the respective value.\n"
     "\n"
     "Merged semantics applies for the input of this method (see \\merged_semantics= of merged semantics)\n"
-  ) +
-  method_ext ("space_check", &space1, gsi::arg ("d"),
+  )) +
+  gsi::release_gil (method_ext ("space_check", &space1, gsi::arg ("d"),
     "@brief Performs a space check\n"
     "@param d The minimum space for which the polygons are checked\n"
     "Performs a space check against the minimum space \"d\". For locations where a polygon has a "
@@ -1918,8 +1918,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "\\isolated_check is a version which checks spacing between different polygons only.\n"
     "\n"
     "Merged semantics applies for the input of this method (see \\merged_semantics= of merged semantics)\n"
-  ) +
-  method_ext ("space_check", &space2, gsi::arg ("d"), gsi::arg ("whole_edges"), gsi::arg ("metrics"), gsi::arg ("ignore_angle"), gsi::arg ("min_projection"), gsi::arg ("max_projection"),
+  )) +
+  gsi::release_gil (method_ext ("space_check", &space2, gsi::arg ("d"), gsi::arg ("whole_edges"), gsi::arg ("metrics"), gsi::arg ("ignore_angle"), gsi::arg ("min_projection"), gsi::arg ("max_projection"),
     "@brief Performs a space check with options\n"
     "@param d The minimum space for which the polygons are checked\n"
     "@param whole_edges If true, deliver the whole edges\n"
@@ -1949,8 +1949,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "If you don't want to specify one limit, pass nil to the respective value.\n"
     "\n"
     "Merged semantics applies for the input of this method (see \\merged_semantics= of merged semantics)\n"
-  ) +
-  method_ext ("notch_check", &notch1, gsi::arg ("d"),
+  )) +
+  gsi::release_gil (method_ext ("notch_check", &notch1, gsi::arg ("d"),
     "@brief Performs a space check between edges of the same polygon\n"
     "@param d The minimum space for which the polygons are checked\n"
     "Performs a space check against the minimum space \"d\". For locations where a polygon has a "
@@ -1965,8 +1965,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "\\isolated_check is a version which checks spacing between different polygons only.\n"
     "\n"
     "Merged semantics applies for the input of this method (see \\merged_semantics= of merged semantics)\n"
-  ) +
-  method_ext ("notch_check", &notch2, gsi::arg ("d"), gsi::arg ("whole_edges"), gsi::arg ("metrics"), gsi::arg ("ignore_angle"), gsi::arg ("min_projection"), gsi::arg ("max_projection"),
+  )) +
+  gsi::release_gil (method_ext ("notch_check", &notch2, gsi::arg ("d"), gsi::arg ("whole_edges"), gsi::arg ("metrics"), gsi::arg ("ignore_angle"), gsi::arg ("min_projection"), gsi::arg ("max_projection"),
     "@brief Performs a space check between edges of the same polygon with options\n"
     "@param d The minimum space for which the polygons are checked\n"
     "@param whole_edges If true, deliver the whole edges\n"
@@ -1996,8 +1996,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "If you don't want to specify one limit, pass nil to the respective value.\n"
     "\n"
     "Merged semantics applies for the input of this method (see \\merged_semantics= of merged semantics)\n"
-  ) +
-  method_ext ("isolated_check", &isolated1, gsi::arg ("d"),
+  )) +
+  gsi::release_gil (method_ext ("isolated_check", &isolated1, gsi::arg ("d"),
     "@brief Performs a space check between edges of different polygons\n"
     "@param d The minimum space for which the polygons are checked\n"
     "Performs a space check against the minimum space \"d\". For locations where a polygon has a "
@@ -2012,8 +2012,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "\\notch_check is a version which checks spacing of polygons edges of the same polygon only.\n"
     "\n"
     "Merged semantics applies for the input of this method (see \\merged_semantics= of merged semantics)\n"
-  ) +
-  method_ext ("isolated_check", &isolated2, gsi::arg ("d"), gsi::arg ("whole_edges"), gsi::arg ("metrics"), gsi::arg ("ignore_angle"), gsi::arg ("min_projection"), gsi::arg ("max_projection"),
+  )) +
+  gsi::release_gil (method_ext ("isolated_check", &isolated2, gsi::arg ("d"), gsi::arg ("whole_edges"), gsi::arg ("metrics"), gsi::arg ("ignore_angle"), gsi::arg ("min_projection"), gsi::arg ("max_projection"),
     "@brief Performs a space check between edges of different polygons with options\n"
     "@param d The minimum space for which the polygons are checked\n"
     "@param whole_edges If true, deliver the whole edges\n"
@@ -2043,8 +2043,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "If you don't want to specify one limit, pass nil to the respective value.\n"
     "\n"
     "Merged semantics applies for the input of this method (see \\merged_semantics= of merged semantics)\n"
-  ) +
-  method_ext ("inside_check", &inside1, gsi::arg ("other"), gsi::arg ("d"),
+  )) +
+  gsi::release_gil (method_ext ("inside_check", &inside1, gsi::arg ("other"), gsi::arg ("d"),
     "@brief Performs a check whether polygons of this region are inside polygons of the other region by some amount\n"
     "@param d The minimum overlap for which the polygons are checked\n"
     "@param other The other region against which to check\n"
@@ -2054,8 +2054,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "whether there is enough overlap of the other polygons vs. polygons of this region. "
     "\n"
     "Merged semantics applies for the input of this method (see \\merged_semantics= of merged semantics)\n"
-  ) +
-  method_ext ("inside_check", &inside2, gsi::arg ("other"), gsi::arg ("d"), gsi::arg ("whole_edges"), gsi::arg ("metrics"), gsi::arg ("ignore_angle"), gsi::arg ("min_projection"), gsi::arg ("max_projection"),
+  )) +
+  gsi::release_gil (method_ext ("inside_check", &inside2, gsi::arg ("other"), gsi::arg ("d"), gsi::arg ("whole_edges"), gsi::arg ("metrics"), gsi::arg ("ignore_angle"), gsi::arg ("min_projection"), gsi::arg ("max_projection"),
     "@brief Performs an inside check with options\n"
     "@param d The minimum distance for which the polygons are checked\n"
     "@param other The other region against which to check\n"
@@ -2086,8 +2086,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "If you don't want to specify one limit, pass nil to the respective value.\n"
     "\n"
     "Merged semantics applies for the input of this method (see \\merged_semantics= of merged semantics)\n"
-  ) +
-  method_ext ("overlap_check", &overlap1, gsi::arg ("other"), gsi::arg ("d"),
+  )) +
+  gsi::release_gil (method_ext ("overlap_check", &overlap1, gsi::arg ("other"), gsi::arg ("d"),
     "@brief Performs a check whether polygons of this region overlap polygons of the other region by some amount\n"
     "@param d The minimum overlap for which the polygons are checked\n"
     "@param other The other region against which to check\n"
@@ -2095,8 +2095,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "by less than the given value \"d\". "
     "\n"
     "Merged semantics applies for the input of this method (see \\merged_semantics= of merged semantics)\n"
-  ) +
-  method_ext ("overlap_check", &overlap2, gsi::arg ("other"), gsi::arg ("d"), gsi::arg ("whole_edges"), gsi::arg ("metrics"), gsi::arg ("ignore_angle"), gsi::arg ("min_projection"), gsi::arg ("max_projection"),
+  )) +
+  gsi::release_gil (method_ext ("overlap_check", &overlap2, gsi::arg ("other"), gsi::arg ("d"), gsi::arg ("whole_edges"), gsi::arg ("metrics"), gsi::arg ("ignore_angle"), gsi::arg ("min_projection"), gsi::arg ("max_projection"),
     "@brief Performs an overlap check with options\n"
     "@param d The minimum overlap for which the polygons are checked\n"
     "@param other The other region against which to check\n"
@@ -2127,8 +2127,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "If you don't want to specify one limit, pass nil to the respective value.\n"
     "\n"
     "Merged semantics applies for the input of this method (see \\merged_semantics= of merged semantics)\n"
-  ) +
-  method_ext ("enclosing_check", &enclosing1, gsi::arg ("other"), gsi::arg ("d"),
+  )) +
+  gsi::release_gil (method_ext ("enclosing_check", &enclosing1, gsi::arg ("other"), gsi::arg ("d"),
     "@brief Performs a check whether polygons of this region enclose polygons of the other region by some amount\n"
     "@param d The minimum overlap for which the polygons are checked\n"
     "@param other The other region against which to check\n"
@@ -2136,8 +2136,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "by less than the given value \"d\". "
     "\n"
     "Merged semantics applies for the input of this method (see \\merged_semantics= of merged semantics)\n"
-  ) +
-  method_ext ("enclosing_check", &enclosing2, gsi::arg ("other"), gsi::arg ("d"), gsi::arg ("whole_edges"), gsi::arg ("metrics"), gsi::arg ("ignore_angle"), gsi::arg ("min_projection"), gsi::arg ("max_projection"),
+  )) +
+  gsi::release_gil (method_ext ("enclosing_check", &enclosing2, gsi::arg ("other"), gsi::arg ("d"), gsi::arg ("whole_edges"), gsi::arg ("metrics"), gsi::arg ("ignore_angle"), gsi::arg ("min_projection"), gsi::arg ("max_projection"),
     "@brief Performs an enclosing check with options\n"
     "@param d The minimum enclosing distance for which the polygons are checked\n"
     "@param other The other region against which to check\n"
@@ -2168,8 +2168,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "If you don't want to specify one limit, pass nil to the respective value.\n"
     "\n"
     "Merged semantics applies for the input of this method (see \\merged_semantics= of merged semantics)\n"
-  ) +
-  method_ext ("separation_check", &separation1, gsi::arg ("other"), gsi::arg ("d"),
+  )) +
+  gsi::release_gil (method_ext ("separation_check", &separation1, gsi::arg ("other"), gsi::arg ("d"),
     "@brief Performs a check whether polygons of this region are separated from polygons of the other region by some amount\n"
     "@param d The minimum separation for which the polygons are checked\n"
     "@param other The other region against which to check\n"
@@ -2177,8 +2177,8 @@ Class<db::Region> decl_Region ("db", "Region",
     "by less than the given value \"d\". "
     "\n"
     "Merged semantics applies for the input of this method (see \\merged_semantics= of merged semantics)\n"
-  ) +
-  method_ext ("separation_check", &separation2, gsi::arg ("other"), gsi::arg ("d"), gsi::arg ("whole_edges"), gsi::arg ("metrics"), gsi::arg ("ignore_angle"), gsi::arg ("min_projection"), gsi::arg ("max_projection"),
+  )) +
+  gsi::release_gil (method_ext ("separation_check", &separation2, gsi::arg ("other"), gsi::arg ("d"), gsi::arg ("whole_edges"), gsi::arg ("metrics"), gsi::arg ("ignore_angle"), gsi::arg ("min_projection"), gsi::arg ("max_projection"),
     "@brief Performs a separation check with options\n"
     "@param d The minimum separation for which the polygons are checked\n"
     "@param other The other region against which to check\n"
@@ -2209,7 +2209,7 @@ Class<db::Region> decl_Region ("db", "Region",
     "If you don't want to specify one limit, pass nil to the respective value.\n"
     "\n"
     "Merged semantics applies for the input of this method (see \\merged_semantics= of merged semantics)\n"
-  ) +
+  )) +
   method_ext ("area", &area1,
     "@brief The area of the region\n"
     "\n"
@@ -67,6 +67,41 @@ static size_t shapes_size (const db::Shapes *shapes)
   return n;
 }
 
+static std::vector<char> box_coordinates (const db::Shapes *shapes)
+{
+  std::vector<db::Box> boxes;
+  for (db::Shapes::shape_iterator i = shapes->begin (db::ShapeIterator::Boxes); ! i.at_end (); ++i) {
+    boxes.push_back (i->box ());
+  }
+
+  std::vector<char> data;
+  gsi::coord_buffer_writer<db::Coord> w (data, boxes.size () * 4);
+  for (std::vector<db::Box>::const_iterator b = boxes.begin (); b != boxes.end (); ++b) {
+    w.put (b->left ());
+    w.put (b->bottom ());
+    w.put (b->right ());
+    w.put (b->top ());
+  }
+  return data;
+}
+
+static void insert_box_coordinates (db::Shapes *shapes, const std::vector<char> &data)
+{
+  gsi::coord_buffer_reader<db::Coord> r (data, 4);
+
+  std::vector<db::Box> boxes;
+  boxes.reserve (r.tuples ());
+  for (size_t i = 0; i < r.tuples (); ++i) {
+    db::Coord l = r.get ();
+    db::Coord b = r.get ();
+    db::Coord rr = r.get ();
+    db::Coord t = r.get ();
+    boxes.push_back (db::Box (l, b, rr, t));
+  }
+
+  shapes->insert (boxes.begin (), boxes.end ());
+}
+
 template<class Sh>
 static db::Shape insert (db::Shapes *s, const Sh &p)
 {
@@ -437,6 +472,27 @@ Class<db::Shapes> decl_Shapes ("db", "Shapes",
     "@return A reference (a \\Shape object) to the newly created shape\n"
     "This method has been introduced in version 0.16.\n"
   ) +
+  gsi::method_ext ("box_coordinates", &box_coordinates,
+    "@brief Gets the coordinates of all boxes as a byte array\n"
+    "\n"
+    "This method delivers the box shapes of this container in a compact binary form: for each box, "
+    "the left, bottom, right and top coordinates are stored as native integers (32 bit, 64 bit in "
+    "builds with 64 bit coordinates). Only box shapes are considered. In Python, the byte array is "
+    "delivered as a 'bytes' object which can be mapped to a NumPy array, e.g. "
+    "'numpy.frombuffer(shapes.box_coordinates(), dtype=numpy.int32).reshape(-1, 4)'. "
+    "This is much faster than iterating the shapes.\n"
+    "\n"
+    "This method has been introduced in version 0.26.\n"
+  ) +
+  gsi::method_ext ("insert_box_coordinates", &insert_box_coordinates, gsi::arg ("data"),
+    "@brief Inserts boxes from a byte array of coordinates\n"
+    "@param data The coordinates in the format delivered by \\box_coordinates\n"
+    "\n"
+    "In Python, any object supporting the buffer protocol can be passed - e.g. a NumPy array of "
+    "the matching integer type.\n"
+    "\n"
+    "This method has been introduced in version 0.26.\n"
+  ) +
   gsi::method_ext ("insert", &insert_shape_with_trans, gsi::arg ("shape"), gsi::arg ("trans"),
     "@brief Inserts a shape from a shape reference into the shapes list with a transformation\n"
     "@param shape The shape to insert\n"
@@ -632,6 +632,41 @@ Class<db::TilingProcessor> decl_TilingProcessor ("db", "TilingProcessor",
   method ("threads", &db::TilingProcessor::threads,
     "@brief Gets the number of threads to use\n"
   ) + 
+  method ("workers=", &db::TilingProcessor::set_workers,
+    "@brief Specifies the number of worker processes to use\n"
+    "@args n\n"
+    "\n"
+    "If this number is non-zero, the tiles are computed by the given number of separate processes "
+    "instead of threads. This way, the computation is not subject to the interpreter lock or the memory "
+    "limits of a single process. Worker processes are only used in tiled mode.\n"
+    "\n"
+    "The inputs are flattened and handed over to the worker processes together with the variables. "
+    "Hence variables and outputs are restricted to objects which can be transferred: \\Region, \\Edges and "
+    "\\EdgePairs collections, \\Box, \\Polygon, \\Edge and \\EdgePair objects, numbers, strings and "
+    "lists of those. Custom functions are not available in the worker processes.\n"
+    "\n"
+    "This method has been introduced in version 0.26."
+  ) + 
+  method ("workers", &db::TilingProcessor::workers,
+    "@brief Gets the number of worker processes to use\n"
+    "\n"
+    "This method has been introduced in version 0.26."
+  ) + 
+  method ("worker_command=", &db::TilingProcessor::set_worker_command,
+    "@brief Specifies the command to start a worker process\n"
+    "@args cmd\n"
+    "\n"
+    "The command is called with the setup and task file names as arguments and is expected "
+    "to deliver the results on stdout. The default is the \"tpworker\" program from KLayout's "
+    "installation path. Setting an empty string restores the default.\n"
+    "\n"
+    "This method has been introduced in version 0.26."
+  ) + 
+  method ("worker_command", &db::TilingProcessor::worker_command,
+    "@brief Gets the command to start a worker process\n"
+    "\n"
+    "This method has been introduced in version 0.26."
+  ) + 
   method ("queue", &db::TilingProcessor::queue,
     "@brief Queues a script for parallel execution\n"
     "@args script\n"
@@ -640,13 +675,13 @@ Class<db::TilingProcessor> decl_TilingProcessor ("db", "TilingProcessor",
     "The scripts have \"Expressions\" syntax and can make use of several predefined variables and functions.\n"
     "See the \\TilingProcessor class description for details.\n"
   ) + 
-  method ("execute", &db::TilingProcessor::execute,
+  gsi::release_gil (method ("execute", &db::TilingProcessor::execute,
     "@brief Runs the job\n"
     "@args desc\n"
     "\n"
     "This method will initiate execution of the queued scripts, once for every tile. The desc is a text "
     "shown in the progress bar for example.\n"
-  ),
+  )),
   "@brief A processor for layout which distributes tasks over tiles\n"
   "\n"
   "The tiling processor executes one or several scripts on one or multiple layouts providing "
@@ -1148,3 +1148,108 @@ TEST(two_2i)
 {
   run_test2_two(_this, 10000, 2, 10000);
 }
+
+struct BoxScannerTestRecorderCounting
+{
+  BoxScannerTestRecorderCounting () : finished (0) { }
+
+  void finish (const db::Box *, size_t) { ++finished; }
+
+  bool stop () const { return false; }
+
+  void add (const db::Box * /*b1*/, size_t p1, const db::Box * /*b2*/, size_t p2)
+  {
+    interactions [std::make_pair (std::min (p1, p2), std::max (p1, p2))] += 1;
+  }
+
+  std::map<std::pair<size_t, size_t>, int> interactions;
+  size_t finished;
+};
+
+TEST(12_MultiThreaded)
+{
+  std::vector<db::Box> bb;
+  int spread = 10000, size = 200;
+  for (int i = 0; i < 5000; ++i) {
+    db::Coord x = rand () % spread;
+    db::Coord y = rand () % spread;
+    bb.push_back (db::Box (x, y, x + rand () % size, y + rand () % size));
+  }
+  //  some long boxes crossing many stripes
+  bb.push_back (db::Box (0, 0, spread, 10));
+  bb.push_back (db::Box (100, 5000, spread - 100, 5000));
+
+  for (int enl = 0; enl < 3; ++enl) {
+
+    BoxScannerTestRecorderCounting tr_st;
+    db::box_scanner<db::Box, size_t> bs_st;
+    for (std::vector<db::Box>::const_iterator b = bb.begin (); b != bb.end (); ++b) {
+      bs_st.insert (&*b, b - bb.begin ());
+    }
+    bs_st.process (tr_st, enl, db::box_convert<db::Box> ());
+
+    BoxScannerTestRecorderCounting tr_mt;
+    db::box_scanner<db::Box, size_t> bs_mt;
+    bs_mt.set_threads (4);
+    for (std::vector<db::Box>::const_iterator b = bb.begin (); b != bb.end (); ++b) {
+      bs_mt.insert (&*b, b - bb.begin ());
+    }
+    bs_mt.process (tr_mt, enl, db::box_convert<db::Box> ());
+
+    EXPECT_EQ (tr_st.interactions.size () > 0, true);
+    EXPECT_EQ (tr_mt.interactions == tr_st.interactions, true);
+    EXPECT_EQ (tr_mt.finished, bb.size ());
+
+    //  each interaction is reported once
+    bool once = true;
+    for (std::map<std::pair<size_t, size_t>, int>::const_iterator i = tr_mt.interactions.begin (); i != tr_mt.interactions.end (); ++i) {
+      if (i->second != 1) {
+        once = false;
+      }
+    }
+    EXPECT_EQ (once, true);
+
+  }
+}
+
+TEST(two_3_MultiThreaded)
+{
+  std::vector<db::Box> bb;
+  std::vector<db::SimplePolygon> bb2;
+  int spread = 10000, size = 200;
+  for (int i = 0; i < 3000; ++i) {
+    db::Coord x = rand () % spread;
+    db::Coord y = rand () % spread;
+    bb.push_back (db::Box (x, y, x + rand () % size, y + rand () % size));
+  }
+  for (int i = 0; i < 3000; ++i) {
+    db::Coord x = rand () % spread;
+    db::Coord y = rand () % spread;
+    bb2.push_back (db::SimplePolygon (db::Box (x, y, x + rand () % size, y + rand () % size)));
+  }
+  bb2.push_back (db::SimplePolygon (db::Box (0, 0, spread, 10)));
+
+  BoxScannerTestRecorder2Two tr_st;
+  db::box_scanner2<db::Box, size_t, db::SimplePolygon, int> bs_st;
+  for (std::vector<db::Box>::const_iterator b = bb.begin (); b != bb.end (); ++b) {
+    bs_st.insert1 (&*b, b - bb.begin ());
+  }
+  for (std::vector<db::SimplePolygon>::const_iterator b = bb2.begin (); b != bb2.end (); ++b) {
+    bs_st.insert2 (&*b, int (b - bb2.begin ()));
+  }
+  bs_st.process (tr_st, 1, db::box_convert<db::Box> (), db::box_convert<db::SimplePolygon> ());
+
+  BoxScannerTestRecorder2Two tr_mt;
+  db::box_scanner2<db::Box, size_t, db::SimplePolygon, int> bs_mt;
+  bs_mt.set_threads (3);
+  for (std::vector<db::Box>::const_iterator b = bb.begin (); b != bb.end (); ++b) {
+    bs_mt.insert1 (&*b, b - bb.begin ());
+  }
+  for (std::vector<db::SimplePolygon>::const_iterator b = bb2.begin (); b != bb2.end (); ++b) {
+    bs_mt.insert2 (&*b, int (b - bb2.begin ()));
+  }
+  bs_mt.process (tr_mt, 1, db::box_convert<db::Box> (), db::box_convert<db::SimplePolygon> ());
+
+  EXPECT_EQ (tr_st.interactions.size () > 0, true);
+  EXPECT_EQ (tr_mt.interactions == tr_st.interactions, true);
+}
@@ -1032,3 +1032,108 @@ TEST(6U)
 }
 
 
+
+//  packed boxes vs. plain box converter: same results, timing comparison
+TEST(7U)
+{
+  Box2Box conv;
+  Box2BoxCmplx conv_cmplx;
+  UnstableTestTreeL t;
+  UnstableTestTreeCmplxL tc;
+
+  int n = 200000;
+
+  db::Box bbox;
+  for (int i = 0; i < n; ++i) {
+    //  insert some empty boxes ..
+    db::Box bx;
+    if (rvalue () % 3000 != 0) {
+      bx = rbox ();
+    }
+    t.insert (bx);
+    tc.insert (bx);
+    bbox += bx;
+  }
+
+  t.sort (conv);
+  tc.sort (conv_cmplx);
+
+  //  packed boxes are only built for "complex" converters
+  EXPECT_EQ (t.packed_boxes () == 0, true);
+  EXPECT_EQ (tc.packed_boxes () != 0, true);
+  EXPECT_EQ (tc.packed_boxes ()->size (), tc.size ());
+
+  std::vector<db::Box> sboxes;
+  sboxes.push_back (db::Box::world ());
+  for (unsigned int i = 0; i < 20; ++i) {
+    for (unsigned int j = 0; j < 20; ++j) {
+      sboxes.push_back (db::Box (bbox.left () + (bbox.width () * i) / 20,
+                                 bbox.bottom () + (bbox.height () * j) / 20,
+                                 bbox.left () + (bbox.width () * (i + 1)) / 20,
+                                 bbox.bottom () + (bbox.height () * (j + 1)) / 20));
+    }
+  }
+
+  size_t n1 = 0, n2 = 0;
+
+  {
+    tl::SelfTimer timer ("test 7 lookup (plain)");
+    for (unsigned int r = 0; r < 10; ++r) {
+      for (std::vector<db::Box>::const_iterator b = sboxes.begin (); b != sboxes.end (); ++b) {
+        for (UnstableTestTreeL::touching_iterator it = t.begin_touching (*b, conv); ! it.at_end (); ++it) {
+          ++n1;
+        }
+        for (UnstableTestTreeL::overlapping_iterator it = t.begin_overlapping (*b, conv); ! it.at_end (); ++it) {
+          ++n1;
+        }
+      }
+    }
+  }
+
+  {
+    tl::SelfTimer timer ("test 7 lookup (packed)");
+    for (unsigned int r = 0; r < 10; ++r) {
+      for (std::vector<db::Box>::const_iterator b = sboxes.begin (); b != sboxes.end (); ++b) {
+        for (UnstableTestTreeCmplxL::touching_iterator it = tc.begin_touching (*b, conv_cmplx); ! it.at_end (); ++it) {
+          ++n2;
+        }
+        for (UnstableTestTreeCmplxL::overlapping_iterator it = tc.begin_overlapping (*b, conv_cmplx); ! it.at_end (); ++it) {
+          ++n2;
+        }
+      }
+    }
+  }
+
+  EXPECT_EQ (n1, n2);
+
+  for (std::vector<db::Box>::const_iterator b = sboxes.begin (); b != sboxes.begin () + 50; ++b) {
+    test_tree_overlap (_this, tc, *b, conv_cmplx);
+    test_tree_touching (_this, tc, *b, conv_cmplx);
+  }
+
+  //  non-const access or modification discards the packed boxes
+  const UnstableTestTreeCmplxL &ctc = tc;
+  ctc.begin ();
+  EXPECT_EQ (tc.packed_boxes () != 0, true);
+  tc.begin ();
+  EXPECT_EQ (tc.packed_boxes () == 0, true);
+
+  tc.sort (conv_cmplx);
+  EXPECT_EQ (tc.packed_boxes () != 0, true);
+  tc.insert (db::Box (0, 0, 100, 100));
+  EXPECT_EQ (tc.packed_boxes () == 0, true);
+
+  tc.sort (conv_cmplx);
+  EXPECT_EQ (tc.packed_boxes () != 0, true);
+  tc.erase (tc.begin () + 10);
+  EXPECT_EQ (tc.packed_boxes () == 0, true);
+
+  //  after sorting again, the packed boxes are consistent with the modified tree
+  tc.sort (conv_cmplx);
+  EXPECT_EQ (tc.packed_boxes () != 0, true);
+
+  for (std::vector<db::Box>::const_iterator b = sboxes.begin (); b != sboxes.begin () + 50; ++b) {
+    test_tree_overlap (_this, tc, *b, conv_cmplx);
+    test_tree_touching (_this, tc, *b, conv_cmplx);
+  }
+}
@@ -0,0 +1,179 @@
+
+/*
+
+  KLayout Layout Viewer
+  Copyright (C) 2006-2019 Matthias Koefferlein
+
+  This program is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  This program is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with this program; if not, write to the Free Software
+  Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+*/
+
+
+#include "dbCellContentHash.h"
+#include "dbReader.h"
+#include "tlUnitTest.h"
+#include "tlStream.h"
+
+static std::string groups2str (const std::vector<std::vector<db::cell_index_type> > &groups)
+{
+  std::string res;
+  for (std::vector<std::vector<db::cell_index_type> >::const_iterator g = groups.begin (); g != groups.end (); ++g) {
+    if (! res.empty ()) {
+      res += ";";
+    }
+    for (std::vector<db::cell_index_type>::const_iterator c = g->begin (); c != g->end (); ++c) {
+      if (c != g->begin ()) {
+        res += ",";
+      }
+      res += tl::to_string (*c);
+    }
+  }
+  return res;
+}
+
+TEST(1_Basic)
+{
+  db::Layout ly;
+  unsigned int l1 = ly.insert_layer (db::LayerProperties (1, 0));
+  unsigned int l2 = ly.insert_layer (db::LayerProperties (2, 0));
+
+  db::Cell &a = ly.cell (ly.add_cell ("A"));
+  a.shapes (l1).insert (db::Box (0, 0, 100, 200));
+  a.shapes (l1).insert (db::Box (0, 0, 300, 100));
+  a.shapes (l2).insert (db::Text ("T", db::Trans (db::Vector (10, 20))));
+
+  //  same content, different name and insertion order
+  db::Cell &b = ly.cell (ly.add_cell ("B"));
+  b.shapes (l2).insert (db::Text ("T", db::Trans (db::Vector (10, 20))));
+  b.shapes (l1).insert (db::Box (0, 0, 300, 100));
+  b.shapes (l1).insert (db::Box (0, 0, 100, 200));
+
+  //  same shapes, different layers
+  db::Cell &c = ly.cell (ly.add_cell ("C"));
+  c.shapes (l2).insert (db::Box (0, 0, 100, 200));
+  c.shapes (l2).insert (db::Box (0, 0, 300, 100));
+  c.shapes (l1).insert (db::Text ("T", db::Trans (db::Vector (10, 20))));
+
+  //  empty
+  db::Cell &d = ly.cell (ly.add_cell ("D"));
+
+  db::CellContentHasher hasher (ly);
+
+  EXPECT_EQ (hasher.hash (a.cell_index ()) == hasher.hash (b.cell_index ()), true);
+  EXPECT_EQ (hasher.hash (a.cell_index ()) == hasher.hash (c.cell_index ()), false);
+  EXPECT_EQ (hasher.hash (a.cell_index ()) == hasher.hash (d.cell_index ()), false);
+  EXPECT_EQ (hasher.hash (a.cell_index ()).to_string ().size (), size_t (32));
+
+  EXPECT_EQ (groups2str (hasher.identical_cells ()), "0,1");
+}
+
+TEST(2_Hierarchy)
+{
+  db::Layout ly;
+  unsigned int l1 = ly.insert_layer (db::LayerProperties (1, 0));
+
+  db::Cell &a1 = ly.cell (ly.add_cell ("A1"));
+  a1.shapes (l1).insert (db::Box (0, 0, 100, 200));
+
+  db::Cell &a2 = ly.cell (ly.add_cell ("A2"));
+  a2.shapes (l1).insert (db::Box (0, 0, 100, 200));
+
+  db::Cell &t1 = ly.cell (ly.add_cell ("T1"));
+  t1.insert (db::CellInstArray (db::CellInst (a1.cell_index ()), db::Trans (db::Vector (0, 1000)), db::Vector (200, 0), db::Vector (0, 300), 5, 4));
+  t1.insert (db::CellInstArray (db::CellInst (a1.cell_index ()), db::Trans (db::Trans::r90, db::Vector (-1000, 0))));
+
+  db::Cell &t2 = ly.cell (ly.add_cell ("T2"));
+  t2.insert (db::CellInstArray (db::CellInst (a2.cell_index ()), db::Trans (db::Trans::r90, db::Vector (-1000, 0))));
+  t2.insert (db::CellInstArray (db::CellInst (a2.cell_index ()), db::Trans (db::Vector (0, 1000)), db::Vector (200, 0), db::Vector (0, 300), 5, 4));
+
+  db::CellContentHasher hasher (ly);
+
+  EXPECT_EQ (groups2str (hasher.identical_cells ()), "0,1;2,3");
+
+  //  incremental update after modification
+  a2.shapes (l1).insert (db::Box (0, 0, 10, 10));
+  hasher.invalidate (a2.cell_index ());
+
+  EXPECT_EQ (groups2str (hasher.identical_cells ()), "");
+  EXPECT_EQ (hasher.hash (t1.cell_index ()) == hasher.hash (t2.cell_index ()), false);
+
+  a1.shapes (l1).insert (db::Box (0, 0, 10, 10));
+  hasher.invalidate (a1.cell_index ());
+
+  EXPECT_EQ (hasher.hash (t1.cell_index ()) == hasher.hash (t2.cell_index ()), true);
+
+  //  instance modification
+  t2.insert (db::CellInstArray (db::CellInst (a2.cell_index ()), db::Trans ()));
+  hasher.invalidate (t2.cell_index ());
+
+  EXPECT_EQ (groups2str (hasher.identical_cells ()), "0,1");
+}
+
+TEST(3_LayerOrder)
+{
+  db::Layout ly1;
+  unsigned int l11 = ly1.insert_layer (db::LayerProperties (1, 0));
+  unsigned int l12 = ly1.insert_layer (db::LayerProperties ("NAME"));
+
+  db::Cell &a1 = ly1.cell (ly1.add_cell ("A"));
+  a1.shapes (l11).insert (db::Box (0, 0, 100, 200));
+  a1.shapes (l12).insert (db::Polygon (db::Box (0, 0, 300, 100)));
+
+  db::Layout ly2;
+  unsigned int l22 = ly2.insert_layer (db::LayerProperties ("NAME"));
+  unsigned int l21 = ly2.insert_layer (db::LayerProperties (1, 0));
+
+  db::Cell &a2 = ly2.cell (ly2.add_cell ("X"));
+  a2.shapes (l22).insert (db::Polygon (db::Box (0, 0, 300, 100)));
+  a2.shapes (l21).insert (db::Box (0, 0, 100, 200));
+
+  db::CellContentHasher h1 (ly1);
+  db::CellContentHasher h2 (ly2);
+
+  EXPECT_EQ (h1.hash (a1.cell_index ()).to_string (), h2.hash (a2.cell_index ()).to_string ());
+}
+
+TEST(4_AcrossLayoutsMultiThreaded)
+{
+  db::Layout ly1, ly2;
+
+  for (int i = 0; i < 2; ++i) {
+    std::string fn (tl::testsrc ());
+    fn += "/testdata/algo/deep_region_l1.gds";
+    tl::InputStream stream (fn);
+    db::Reader reader (stream);
+    reader.read (i == 0 ? ly1 : ly2);
+  }
+
+  db::cell_index_type top = *ly1.begin_top_down ();
+
+  db::CellContentHasher h1 (ly1);
+  db::CellContentHasher h2 (ly2);
+  h2.set_threads (4);
+
+  EXPECT_EQ (h1.hash (top).to_string (), h2.hash (top).to_string ());
+
+  for (db::Layout::const_iterator c = ly1.begin (); c != ly1.end (); ++c) {
+    EXPECT_EQ (h1.hash (c->cell_index ()) == h2.hash (c->cell_index ()), true);
+  }
+
+  //  a modification deep down in the hierarchy changes the top cell's hash
+  db::cell_index_type bottom = *ly2.begin_bottom_up ();
+  ly2.cell (bottom).shapes ((*ly2.begin_layers ()).first).insert (db::Box (0, 0, 1, 1));
+  h2.invalidate (bottom);
+
+  EXPECT_EQ (h1.hash (top) == h2.hash (top), false);
+  EXPECT_EQ (h1.hash (bottom) == h2.hash (bottom), false);
+}
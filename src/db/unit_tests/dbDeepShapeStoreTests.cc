@@ -208,3 +208,59 @@ TEST(4_FlatAndEmptyInput)
   EXPECT_EQ ((dr1 - dr3).to_string (), "(0,0;0,1000;1000,1000;1000,0)");
 }
 
+TEST(5_MultipleLayersInOnePass)
+{
+  db::Layout layout;
+
+  unsigned int l1 = layout.insert_layer ();
+  unsigned int l2 = layout.insert_layer ();
+  unsigned int l3 = layout.insert_layer ();
+  db::cell_index_type top = layout.add_cell ("TOP");
+  db::cell_index_type c1 = layout.add_cell ("C1");
+  db::cell_index_type c2 = layout.add_cell ("C2");
+
+  layout.cell (c1).shapes (l1).insert (db::Box (0, 0, 100, 200));
+  layout.cell (c1).shapes (l2).insert (db::Box (50, 50, 150, 250));
+  layout.cell (c2).shapes (l2).insert (db::Box (0, 0, 1000, 100));
+  layout.cell (c2).shapes (l3).insert (db::Box (0, 0, 10, 10));
+  layout.cell (top).shapes (l1).insert (db::Box (-100, -100, 0, 0));
+  layout.cell (top).insert (db::CellInstArray (db::CellInst (c1), db::Trans (db::Vector (0, 0))));
+  layout.cell (top).insert (db::CellInstArray (db::CellInst (c1), db::Trans (db::Vector (1000, 0))));
+  layout.cell (top).insert (db::CellInstArray (db::CellInst (c2), db::Trans (db::Vector (0, 1000))));
+
+  std::vector<unsigned int> layers;
+  layers.push_back (l1);
+  layers.push_back (l2);
+  layers.push_back (l3);
+
+  for (int with_region = 0; with_region < 2; ++with_region) {
+
+    db::Box region = with_region ? db::Box (0, 0, 1050, 1050) : db::Box::world ();
+
+    db::DeepShapeStore store;
+    std::vector<db::DeepLayer> dls = store.create_polygon_layers (db::RecursiveShapeIterator (layout, layout.cell (top), l1, region), layers);
+    EXPECT_EQ (dls.size (), size_t (3));
+
+    //  same as building the layers one by one
+    db::DeepShapeStore store_ref;
+    for (size_t i = 0; i < layers.size (); ++i) {
+      db::DeepLayer dl_ref = store_ref.create_polygon_layer (db::RecursiveShapeIterator (layout, layout.cell (top), layers [i], region));
+      EXPECT_EQ (db::Region (new db::DeepRegion (dls [i])).to_string (), db::Region (new db::DeepRegion (dl_ref)).to_string ());
+    }
+
+    //  all layers share one working layout
+    EXPECT_EQ (dls [0].layout_index (), dls [1].layout_index ());
+    EXPECT_EQ (dls [1].layout_index (), dls [2].layout_index ());
+    EXPECT_EQ (store.layouts (), (unsigned int) 1);
+
+  }
+
+  //  without a region, the working layout is shared with the single layers
+  db::DeepShapeStore store;
+  db::DeepLayer dl1 = store.create_polygon_layer (db::RecursiveShapeIterator (layout, layout.cell (top), l1));
+  std::vector<db::DeepLayer> dls = store.create_polygon_layers (db::RecursiveShapeIterator (layout, layout.cell (top), l1), layers);
+  EXPECT_EQ (store.layouts (), (unsigned int) 1);
+  EXPECT_EQ (dls [0].layout_index (), dl1.layout_index ());
+  EXPECT_NE (dls [0].layer (), dl1.layer ());
+  EXPECT_EQ (db::Region (new db::DeepRegion (dls [0])).to_string (), db::Region (new db::DeepRegion (dl1)).to_string ());
+}
@@ -801,6 +801,66 @@ TEST(3)
     EXPECT_EQ (s, "");
   }
 
+  {
+    db::LayoutQuery q ("shapes touching (0.002,0.003;0.005,0.005) of c2x");
+    db::LayoutQueryIterator iq (q, &g);
+    std::string s;
+    s = q2s_var (iq, "shape");
+    EXPECT_EQ (s, "box (0,1;2,3),polygon (0,1;0,3;2,3;2,1),edge (0,1;2,3)");
+    s = q2s_var (iq, "layer_index");
+    EXPECT_EQ (s, "0,1,1");
+  }
+
+  {
+    db::LayoutQuery q ("shapes overlapping box (0.002,0.003;0.005,0.005) of c2x");
+    db::LayoutQueryIterator iq (q, &g);
+    std::string s;
+    s = q2s_var (iq, "shape");
+    EXPECT_EQ (s, "");
+  }
+
+  {
+    db::LayoutQuery q ("shapes on layer l1, l2 touching (0.009,0.010;0.011,0.012) from c2x");
+    db::LayoutQueryIterator iq (q, &g);
+    std::string s;
+    s = q2s_var (iq, "shape");
+    EXPECT_EQ (s, "text ('hallo',r0 10,11)");
+  }
+
+  //  bounding box conditions are used as search regions
+  {
+    db::LayoutQuery q ("shapes of c2x where bbox.touches(Box.new(2,3,5,5))");
+    db::LayoutQueryIterator iq (q, &g);
+    std::string s;
+    s = q2s_var (iq, "shape");
+    EXPECT_EQ (s, "box (0,1;2,3),polygon (0,1;0,3;2,3;2,1),edge (0,1;2,3)");
+  }
+
+  {
+    db::LayoutQuery q ("shapes of c2x where shape.bbox.touches(Box.new(2, 3, 5, 5)) && layer_index == 1");
+    db::LayoutQueryIterator iq (q, &g);
+    std::string s;
+    s = q2s_var (iq, "shape");
+    EXPECT_EQ (s, "polygon (0,1;0,3;2,3;2,1),edge (0,1;2,3)");
+  }
+
+  {
+    db::LayoutQuery q ("shapes of c2x where shape_bbox.overlaps(Box.new(2,3,5,5))");
+    db::LayoutQueryIterator iq (q, &g);
+    std::string s;
+    s = q2s_var (iq, "shape");
+    EXPECT_EQ (s, "");
+  }
+
+  {
+    //  not a conjunction: no search region
+    db::LayoutQuery q ("shapes of c2x where bbox.touches(Box.new(2,3,5,5)) || shape.is_text");
+    db::LayoutQueryIterator iq (q, &g);
+    std::string s;
+    s = q2s_var (iq, "shape");
+    EXPECT_EQ (s, "box (0,1;2,3),polygon (0,1;0,3;2,3;2,1),edge (0,1;2,3),text ('hallo',r0 10,11)");
+  }
+
   c4.shapes (2).insert (db::Box (0, -1, 2, 1));
 
   {
@@ -22,6 +22,7 @@
 
 
 #include "dbObject.h"
+#include "dbLayout.h"
 #include "tlUnitTest.h"
 
 namespace {
@@ -230,3 +231,106 @@ TEST(2)
   EXPECT_EQ (BO::inst_count (), 0);
 }
 
+
+namespace {
+
+struct CO : public db::Op
+{
+  CO (int dd) : d (dd) { }
+  virtual size_t mem_size () const { return 1000; }
+  int d;
+};
+
+struct C : public db::Object
+{
+  C (db::Manager *m) : db::Object (m), x (0) { }
+
+  void add (int d)
+  {
+    if (transacting ()) {
+      manager ()->queue (this, new CO (d));
+    }
+    x += d;
+  }
+
+  void undo (db::Op *op)
+  {
+    x -= dynamic_cast<CO *> (op)->d;
+  }
+
+  void redo (db::Op *op)
+  {
+    x += dynamic_cast<CO *> (op)->d;
+  }
+
+  int x;
+};
+
+}
+
+TEST(3_MemoryLimit)
+{
+  db::Manager man;
+  EXPECT_EQ (man.max_memory (), size_t (0));
+  EXPECT_EQ (man.memory_used (), size_t (0));
+
+  C c (&man);
+  man.set_max_memory (3000);
+
+  for (int i = 1; i <= 5; ++i) {
+    man.transaction ("add");
+    c.add (i);
+    man.commit ();
+    EXPECT_EQ (man.memory_used () <= 3000, true);
+    EXPECT_EQ (man.memory_used () > 1000, true);
+  }
+
+  EXPECT_EQ (c.x, 15);
+
+  //  only the last two transactions are left
+  man.undo ();
+  EXPECT_EQ (c.x, 10);
+  man.undo ();
+  EXPECT_EQ (c.x, 6);
+  EXPECT_EQ (man.available_undo ().first, false);
+
+  //  the last transaction is kept even if it exceeds the limit
+  man.clear ();
+  EXPECT_EQ (man.memory_used (), size_t (0));
+
+  man.transaction ("add many");
+  for (int i = 0; i < 10; ++i) {
+    c.add (1);
+  }
+  man.commit ();
+  EXPECT_EQ (man.memory_used () > 3000, true);
+  EXPECT_EQ (man.available_undo ().first, true);
+
+  man.transaction ("add one");
+  c.add (1);
+  man.commit ();
+  EXPECT_EQ (man.memory_used () <= 3000, true);
+
+  man.undo ();
+  EXPECT_EQ (man.available_undo ().first, false);
+
+  //  shape operations report their memory
+  man.clear ();
+  man.set_max_memory (0);
+
+  db::Layout layout (true, &man);
+  unsigned int l1 = layout.insert_layer ();
+  db::Cell &top = layout.cell (layout.add_cell ("TOP"));
+
+  man.transaction ("insert");
+  for (int i = 0; i < 1000; ++i) {
+    top.shapes (l1).insert (db::Box (0, 0, i + 1, i + 1));
+  }
+  man.commit ();
+
+  EXPECT_EQ (man.memory_used () >= 1000 * sizeof (db::Box), true);
+  EXPECT_EQ (man.memory_used () < 4000 * sizeof (db::Box), true);
+
+  man.undo ();
+  EXPECT_EQ (top.shapes (l1).size (), size_t (0));
+}
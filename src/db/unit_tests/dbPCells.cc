@@ -25,6 +25,7 @@
 #include "dbPCellHeader.h"
 #include "dbPCellDeclaration.h"
 #include "dbPCellVariant.h"
+#include "dbPCellVariantCache.h"
 #include "dbWriter.h"
 #include "dbReader.h"
 #include "dbLayoutDiff.h"
@@ -252,3 +253,245 @@ TEST(1)
   }
 }
 
+class PDCached
+  : public db::PCellDeclaration
+{
+public:
+  PDCached (int *count)
+    : mp_count (count)
+  { }
+
+  virtual std::vector<db::PCellLayerDeclaration> get_layer_declarations (const db::pcell_parameters_type &) const
+  {
+    std::vector<db::PCellLayerDeclaration> layers;
+    layers.push_back (db::PCellLayerDeclaration ());
+    layers.back ().layer = 1;
+    layers.back ().datatype = 0;
+    layers.push_back (db::PCellLayerDeclaration ());
+    layers.back ().layer = 2;
+    layers.back ().datatype = 0;
+    return layers;
+  }
+
+  virtual std::vector<db::PCellParameterDeclaration> get_parameter_declarations () const
+  {
+    std::vector<db::PCellParameterDeclaration> parameters;
+    parameters.push_back (db::PCellParameterDeclaration ("w"));
+    parameters.back ().set_type (db::PCellParameterDeclaration::t_int);
+    return parameters;
+  }
+
+  virtual void produce (const db::Layout &, const std::vector<unsigned int> &layer_ids, const db::pcell_parameters_type &parameters, db::Cell &cell) const
+  {
+    ++*mp_count;
+
+    db::Coord w = db::Coord (parameters[0].to_long ());
+    cell.shapes (layer_ids [0]).insert (db::Box (0, 0, w, 2 * w));
+
+    db::Point pts[] = { db::Point (0, 0), db::Point (0, 3 * w), db::Point (w, w), db::Point (3 * w, 0) };
+    db::Polygon poly;
+    poly.assign_hull (pts, pts + sizeof (pts) / sizeof (pts[0]));
+    cell.shapes (layer_ids [1]).insert (poly);
+
+    db::Point ppts[] = { db::Point (0, 0), db::Point (w, 10 * w) };
+    cell.shapes (layer_ids [1]).insert (db::Path (ppts, ppts + 2, 20, -5, 10, true));
+    cell.shapes (layer_ids [1]).insert (db::Text ("T", db::Trans (1, true, db::Vector (-w, w)), 17, db::NoFont, db::HAlignCenter, db::VAlignTop));
+    cell.shapes (layer_ids [0]).insert (db::Edge (db::Point (1, 2), db::Point (-w, 4)));
+  }
+
+  virtual std::string get_display_name (const db::pcell_parameters_type &parameters) const
+  {
+    return std::string ("W=") + parameters[0].to_string ();
+  }
+
+  virtual std::string cache_key () const
+  {
+    return "v1";
+  }
+
+private:
+  int *mp_count;
+};
+
+static std::string cell_content (const db::Layout &layout, const db::Cell &cell)
+{
+  std::string s;
+  for (db::Layout::layer_iterator l = layout.begin_layers (); l != layout.end_layers (); ++l) {
+    for (db::ShapeIterator sh = cell.shapes ((*l).first).begin (db::ShapeIterator::All); ! sh.at_end (); ++sh) {
+      s += (*l).second->to_string () + ":" + sh->to_string () + "\n";
+    }
+  }
+  return s;
+}
+
+TEST(2_VariantCache)
+{
+  std::string cache_dir = tmp_file ("pcell_cache");
+  db::PCellVariantCache::instance ().set_path (cache_dir);
+
+  int count = 0;
+  std::string content, display_name;
+
+  try {
+
+    {
+      db::Layout layout;
+      db::pcell_id_type pd = layout.register_pcell ("PDC", new PDCached (&count));
+
+      std::vector<tl::Variant> parameters;
+      parameters.push_back (tl::Variant (100));
+      db::cell_index_type ci = layout.get_pcell_variant (pd, parameters);
+      EXPECT_EQ (count, 1);
+
+      content = cell_content (layout, layout.cell (ci));
+      display_name = layout.display_name (ci);
+      EXPECT_EQ (display_name, "W=100");
+    }
+
+    {
+      //  taken from the cache now
+      db::Layout layout;
+      db::pcell_id_type pd = layout.register_pcell ("PDC", new PDCached (&count));
+
+      std::vector<tl::Variant> parameters;
+      parameters.push_back (tl::Variant (100));
+      db::cell_index_type ci = layout.get_pcell_variant (pd, parameters);
+      EXPECT_EQ (count, 1);
+
+      EXPECT_EQ (cell_content (layout, layout.cell (ci)), content);
+      EXPECT_EQ (layout.display_name (ci), display_name);
+
+      //  a different parameter set needs to be produced
+      parameters [0] = tl::Variant (200);
+      layout.get_pcell_variant (pd, parameters);
+      EXPECT_EQ (count, 2);
+    }
+
+    {
+      //  a different database unit needs to be produced
+      db::Layout layout;
+      layout.dbu (0.01);
+      db::pcell_id_type pd = layout.register_pcell ("PDC", new PDCached (&count));
+
+      std::vector<tl::Variant> parameters;
+      parameters.push_back (tl::Variant (100));
+      layout.get_pcell_variant (pd, parameters);
+      EXPECT_EQ (count, 3);
+    }
+
+    {
+      //  shapes on other layers than the PCell's ones can't be cached
+      db::Layout layout;
+      unsigned int l1 = layout.insert_layer (db::LayerProperties (1, 0));
+      unsigned int l2 = layout.insert_layer (db::LayerProperties (2, 0));
+      db::Cell &cell = layout.cell (layout.add_cell ("C"));
+      cell.shapes (l1).insert (db::Box (0, 0, 100, 100));
+
+      std::vector<unsigned int> layer_ids;
+      layer_ids.push_back (l1);
+      EXPECT_EQ (db::PCellVariantCache::instance ().store ("k1", cell, layer_ids, "C"), true);
+
+      cell.shapes (l2).insert (db::Box (0, 0, 100, 100));
+      EXPECT_EQ (db::PCellVariantCache::instance ().store ("k2", cell, layer_ids, "C"), false);
+    }
+
+    //  disabled cache
+    db::PCellVariantCache::instance ().set_path (std::string ());
+
+    {
+      db::Layout layout;
+      db::pcell_id_type pd = layout.register_pcell ("PDC", new PDCached (&count));
+
+      std::vector<tl::Variant> parameters;
+      parameters.push_back (tl::Variant (100));
+      db::cell_index_type ci = layout.get_pcell_variant (pd, parameters);
+      EXPECT_EQ (count, 4);
+      EXPECT_EQ (cell_content (layout, layout.cell (ci)), content);
+    }
+
+  } catch (...) {
+    db::PCellVariantCache::instance ().set_path (std::string ());
+    throw;
+  }
+}
+
+class PDConcurrent
+  : public db::PCellDeclaration
+{
+public:
+  virtual std::vector<db::PCellLayerDeclaration> get_layer_declarations (const db::pcell_parameters_type &) const
+  {
+    std::vector<db::PCellLayerDeclaration> layers;
+    layers.push_back (db::PCellLayerDeclaration ());
+    layers.back ().layer = 1;
+    layers.back ().datatype = 0;
+    layers.push_back (db::PCellLayerDeclaration ());
+    layers.back ().layer = 2;
+    layers.back ().datatype = 0;
+    return layers;
+  }
+
+  virtual std::vector<db::PCellParameterDeclaration> get_parameter_declarations () const
+  {
+    std::vector<db::PCellParameterDeclaration> parameters;
+    parameters.push_back (db::PCellParameterDeclaration ("w"));
+    parameters.back ().set_type (db::PCellParameterDeclaration::t_int);
+    return parameters;
+  }
+
+  virtual void produce (const db::Layout &layout, const std::vector<unsigned int> &layer_ids, const db::pcell_parameters_type &parameters, db::Cell &cell) const
+  {
+    db::Coord w = db::Coord (parameters[0].to_long ());
+    if (w < 0) {
+      throw tl::Exception ("negative width");
+    }
+
+    cell.shapes (layer_ids [0]).insert (db::Box (0, 0, w, 2 * w));
+    cell.shapes (layer_ids [1]).insert (db::Text (layout.get_properties (layer_ids [1]).to_string (), db::Trans (db::Vector (w, 0))));
+  }
+
+  virtual std::string get_display_name (const db::pcell_parameters_type &parameters) const
+  {
+    return std::string ("W=") + parameters[0].to_string ();
+  }
+
+  virtual bool can_produce_concurrently () const
+  {
+    return true;
+  }
+};
+
+TEST(3_ConcurrentProduction)
+{
+  std::vector<std::vector<tl::Variant> > parameters;
+  for (int i = 0; i < 20; ++i) {
+    parameters.push_back (std::vector<tl::Variant> ());
+    parameters.back ().push_back (tl::Variant (i % 15 == 14 ? -1 : (i % 10) * 100 + 100));
+  }
+
+  db::Layout layout_ref;
+  db::pcell_id_type pd_ref = layout_ref.register_pcell ("PD", new PDConcurrent ());
+
+  db::Layout layout;
+  db::pcell_id_type pd = layout.register_pcell ("PD", new PDConcurrent ());
+
+  std::vector<db::cell_index_type> cells = layout.get_pcell_variants (pd, parameters, 4);
+  EXPECT_EQ (cells.size (), parameters.size ());
+
+  for (size_t i = 0; i < parameters.size (); ++i) {
+    db::cell_index_type ci_ref = layout_ref.get_pcell_variant (pd_ref, parameters [i]);
+    EXPECT_EQ (cell_content (layout, layout.cell (cells [i])), cell_content (layout_ref, layout_ref.cell (ci_ref)));
+    EXPECT_EQ (layout.display_name (cells [i]), layout_ref.display_name (ci_ref));
+    EXPECT_EQ (layout.cell (cells [i]).is_proxy (), true);
+  }
+
+  //  identical parameter sets deliver the same variant
+  EXPECT_EQ (cells [0] == cells [10], true);
+  EXPECT_EQ (cells [0] == cells [1], false);
+  EXPECT_EQ (layout.cells (), layout_ref.cells ());
+
+  //  existing variants are reused
+  std::vector<db::cell_index_type> cells2 = layout.get_pcell_variants (pd, parameters, 4);
+  EXPECT_EQ (cells2 == cells, true);
+  EXPECT_EQ (layout.cells (), layout_ref.cells ());
+}
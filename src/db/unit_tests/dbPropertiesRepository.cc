@@ -259,3 +259,63 @@ TEST(6)
   EXPECT_EQ (pid2, size_t (2));
 }
 
+
+TEST(7_HashedLookup)
+{
+  db::PropertiesRepository rep;
+
+  //  a lot of sets with a single name/value pair each
+  for (int i = 0; i < 10000; ++i) {
+    db::PropertiesRepository::properties_set set;
+    set.insert (std::make_pair (0, tl::Variant (tl::sprintf ("NET%d", i))));
+    EXPECT_EQ (rep.properties_id (set), db::properties_id_type (i + 1));
+  }
+
+  db::PropertiesRepository::properties_set set;
+  set.insert (std::make_pair (0, tl::Variant ("NET4711")));
+  EXPECT_EQ (rep.properties_id (set), db::properties_id_type (4712));
+
+  //  numerical values compare and hash by value
+  db::PropertiesRepository::properties_set set_int, set_double;
+  set_int.insert (std::make_pair (1, tl::Variant (17)));
+  set_double.insert (std::make_pair (1, tl::Variant (17.0)));
+  EXPECT_EQ (tl::Variant (17).hash () == tl::Variant (17.0).hash (), true);
+  EXPECT_EQ (tl::Variant (0.0).hash () == tl::Variant (-0.0).hash (), true);
+
+  db::properties_id_type id_int = rep.properties_id (set_int);
+  EXPECT_EQ (rep.properties_id (set_double), id_int);
+
+  //  the component table is built on demand
+  EXPECT_EQ (rep.properties_ids_by_name_value (std::make_pair (db::property_names_id_type (1), tl::Variant (17))).size (), size_t (1));
+  EXPECT_EQ (rep.properties_ids_by_name_value (std::make_pair (db::property_names_id_type (0), tl::Variant ("NET2"))).front (), db::properties_id_type (3));
+
+  //  changing properties updates the lookup tables
+  db::PropertiesRepository::properties_set set_new;
+  set_new.insert (std::make_pair (1, tl::Variant ("X")));
+  rep.change_properties (id_int, set_new);
+  EXPECT_EQ (rep.properties_id (set_new), id_int);
+  EXPECT_EQ (rep.properties_ids_by_name_value (std::make_pair (db::property_names_id_type (1), tl::Variant (17))).size (), size_t (0));
+  EXPECT_EQ (rep.properties_ids_by_name_value (std::make_pair (db::property_names_id_type (1), tl::Variant ("X"))).size (), size_t (1));
+
+  size_t n = rep.end_id ();
+  EXPECT_EQ (rep.properties_id (set_int), db::properties_id_type (n));
+
+  //  modifying the sets directly invalidates the lookup tables
+  for (db::PropertiesRepository::non_const_iterator p = rep.begin_non_const (); p != rep.end_non_const (); ++p) {
+    if (p->first == id_int) {
+      p->second.clear ();
+      p->second.insert (std::make_pair (1, tl::Variant ("Y")));
+    }
+  }
+
+  db::PropertiesRepository::properties_set set_y;
+  set_y.insert (std::make_pair (1, tl::Variant ("Y")));
+  EXPECT_EQ (rep.properties_id (set_y), id_int);
+  EXPECT_EQ (rep.properties_id (set_new), db::properties_id_type (n + 1));
+
+  //  copies have their own lookup tables
+  db::PropertiesRepository rep2;
+  rep2 = rep;
+  EXPECT_EQ (rep2.properties_id (set_y), id_int);
+  EXPECT_EQ (rep2.properties_id (set), db::properties_id_type (4712));
+}
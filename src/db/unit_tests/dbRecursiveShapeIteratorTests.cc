@@ -1304,3 +1304,131 @@ TEST(10)
     "end\n"
   );
 }
+
+//  set_layer/set_layers after construction with a region must not prune instances by the initial layer
+TEST(11)
+{
+  db::Layout layout;
+  unsigned int l1 = layout.insert_layer ();
+  unsigned int l2 = layout.insert_layer ();
+  db::cell_index_type top = layout.add_cell ("TOP");
+  db::cell_index_type c1 = layout.add_cell ("C1");
+  db::cell_index_type c2 = layout.add_cell ("C2");
+
+  layout.cell (c1).shapes (l1).insert (db::Box (0, 0, 100, 200));
+  layout.cell (c2).shapes (l2).insert (db::Box (0, 0, 1000, 100));
+  layout.cell (top).insert (db::CellInstArray (db::CellInst (c1), db::Trans (db::Vector (0, 0))));
+  layout.cell (top).insert (db::CellInstArray (db::CellInst (c2), db::Trans (db::Vector (0, 1000))));
+
+  std::vector<unsigned int> layers;
+  layers.push_back (l1);
+  layers.push_back (l2);
+
+  db::RecursiveShapeIterator i1 (layout, layout.cell (top), l1, db::Box (0, 0, 1050, 1050));
+  i1.set_layers (layers);
+  EXPECT_EQ (collect (i1, layout, true), "[C1](0,0;100,200)*0/[C2](0,1000;1000,1100)*1");
+
+  db::RecursiveShapeIterator i2 (layout, layout.cell (top), l1, db::Box (0, 0, 1050, 1050));
+  i2.set_layer (l2);
+  EXPECT_EQ (collect (i2, layout), "[C2](0,1000;1000,1100)");
+}
+
+static std::string collect_sorted (const std::vector<db::RecursiveShapeIterator> &parts)
+{
+  std::vector<std::string> boxes;
+  for (std::vector<db::RecursiveShapeIterator>::const_iterator p = parts.begin (); p != parts.end (); ++p) {
+    for (db::RecursiveShapeIterator i = *p; ! i.at_end (); ++i) {
+      boxes.push_back ((i.trans () * i->bbox ()).to_string ());
+    }
+  }
+  std::sort (boxes.begin (), boxes.end ());
+  return tl::join (boxes, ";");
+}
+
+TEST(12_Partition)
+{
+  db::Layout layout;
+  unsigned int l1 = layout.insert_layer ();
+  db::cell_index_type top = layout.add_cell ("TOP");
+  db::cell_index_type c1 = layout.add_cell ("C1");
+  db::cell_index_type c2 = layout.add_cell ("C2");
+
+  layout.cell (c1).shapes (l1).insert (db::Box (0, 0, 100, 200));
+  layout.cell (c1).shapes (l1).insert (db::Box (-50, 0, 700, 20));
+  layout.cell (c2).shapes (l1).insert (db::Box (0, 0, 10, 10));
+  layout.cell (c2).insert (db::CellInstArray (db::CellInst (c1), db::Trans (db::Vector (100, 0)), db::Vector (0, 300), db::Vector (400, 0), 2, 3));
+  layout.cell (top).insert (db::CellInstArray (db::CellInst (c2), db::Trans (db::Vector (0, 0)), db::Vector (0, 1000), db::Vector (1500, 0), 3, 4));
+  layout.cell (top).insert (db::CellInstArray (db::CellInst (c1), db::Trans (1, false, db::Vector (3000, 3000))));
+  layout.cell (top).shapes (l1).insert (db::Box (-100, -100, 7000, 0));
+
+  db::RecursiveShapeIterator iter (layout, layout.cell (top), l1);
+  std::vector<db::RecursiveShapeIterator> all;
+  all.push_back (iter);
+  std::string ref = collect_sorted (all);
+
+  for (unsigned int n = 1; n <= 7; ++n) {
+    std::vector<db::RecursiveShapeIterator> parts = iter.partition (n);
+    EXPECT_EQ (parts.size (), size_t (n));
+    EXPECT_EQ (collect_sorted (parts), ref);
+  }
+
+  //  the parts don't deliver everything
+  std::vector<db::RecursiveShapeIterator> parts = iter.partition (4);
+  std::vector<db::RecursiveShapeIterator> first_part;
+  first_part.push_back (parts.front ());
+  EXPECT_NE (collect_sorted (first_part), ref);
+
+  //  with a region and overlapping mode
+  db::RecursiveShapeIterator iter_r (layout, layout.cell (top), l1, db::Box (200, 100, 2500, 2500), true);
+  all.clear ();
+  all.push_back (iter_r);
+  ref = collect_sorted (all);
+  EXPECT_EQ (collect_sorted (iter_r.partition (5)), ref);
+
+  //  with a complex region
+  db::Region region;
+  region.insert (db::Box (0, 0, 1000, 1000));
+  region.insert (db::Box (2000, 500, 3500, 3500));
+  db::RecursiveShapeIterator iter_cr (layout, layout.cell (top), l1, region, false);
+  all.clear ();
+  all.push_back (iter_cr);
+  ref = collect_sorted (all);
+  EXPECT_EQ (collect_sorted (iter_cr.partition (3)), ref);
+
+  //  arbitrary-angle instances
+  layout.cell (top).insert (db::CellInstArray (db::CellInst (c1), db::ICplxTrans (1.0, 30.0, false, db::Vector (5000, 0))));
+  all.clear ();
+  all.push_back (iter);
+  ref = collect_sorted (all);
+  EXPECT_EQ (collect_sorted (iter.partition (6)), ref);
+}
+
+TEST(13_PartitionDegenerated)
+{
+  db::Layout layout;
+  unsigned int l1 = layout.insert_layer ();
+  db::cell_index_type top = layout.add_cell ("TOP");
+  db::cell_index_type c1 = layout.add_cell ("C1");
+
+  layout.cell (c1).shapes (l1).insert (db::Text ("A", db::Trans (db::Vector (0, 5))));
+  layout.cell (c1).shapes (l1).insert (db::Box (-10, 0, 10, 10));
+  layout.cell (top).insert (db::CellInstArray (db::CellInst (c1), db::Trans (db::Vector (500, 0))));
+
+  layout.cell (top).shapes (l1).insert (db::Box (0, 0, 1000, 1000));
+  //  on the stripe boundaries and the bbox edges
+  layout.cell (top).shapes (l1).insert (db::Text ("B", db::Trans (db::Vector (500, 1000))));
+  layout.cell (top).shapes (l1).insert (db::Text ("C", db::Trans (db::Vector (250, 0))));
+  layout.cell (top).shapes (l1).insert (db::Edge (500, 200, 500, 800));
+  layout.cell (top).shapes (l1).insert (db::Edge (0, 1000, 300, 1000));
+  layout.cell (top).shapes (l1).insert (db::Edge (1000, 0, 1000, 600));
+
+  db::RecursiveShapeIterator iter (layout, layout.cell (top), l1, db::Box (-100, -100, 1100, 1100), true);
+  std::vector<db::RecursiveShapeIterator> all;
+  all.push_back (iter);
+  std::string ref = collect_sorted (all);
+  EXPECT_EQ (ref, "(0,0;1000,1000);(0,1000;300,1000);(1000,0;1000,600);(250,0;250,0);(490,0;510,10);(500,1000;500,1000);(500,200;500,800);(500,5;500,5)");
+
+  for (unsigned int n = 2; n <= 5; ++n) {
+    EXPECT_EQ (collect_sorted (iter.partition (n)), ref);
+  }
+}
@@ -408,3 +408,80 @@ TEST(4)
 
 }
 
+static void insert_box_hole (db::Polygon &p, const db::Box &b)
+{
+  db::Polygon h (b);
+  p.insert_hole (h.begin_hull (), h.end_hull ());
+}
+
+TEST(5_Arena)
+{
+  db::GenericRepository rep;
+
+  //  a polygon with a hole and a non-orthogonal simple polygon
+  db::Polygon p (db::Box (0, 0, 1000, 1000));
+  insert_box_hole (p, db::Box (100, 100, 200, 200));
+
+  db::SimplePolygon sp;
+  db::Point pts[] = { db::Point (0, 0), db::Point (0, 100), db::Point (200, 50) };
+  sp.assign_hull (pts, pts + sizeof (pts) / sizeof (pts[0]));
+
+  std::vector<db::PolygonRef> prefs;
+  std::vector<db::SimplePolygonRef> sprefs;
+
+  for (int i = 0; i < 10000; ++i) {
+    db::Polygon pp = p.transformed (db::Trans (db::Vector (i * 10, 0)));
+    prefs.push_back (db::PolygonRef (pp, rep));
+    //  every 10th one is a new shape
+    db::Polygon pv = p.transformed (db::Trans (db::Vector (0, i / 10)));
+    insert_box_hole (pv, db::Box (300, 300, 300 + i / 10 + 1, 400));
+    prefs.push_back (db::PolygonRef (pv, rep));
+    sprefs.push_back (db::SimplePolygonRef (sp.transformed (db::Trans (db::Vector (i, 0))), rep));
+  }
+
+  //  a large one which gets a separate chunk
+  std::vector<db::Point> large;
+  for (int i = 0; i < 9998; ++i) {
+    large.push_back (db::Point (i * 10, (i % 2) * 5));
+  }
+  large.push_back (db::Point (99970, 1000));
+  large.push_back (db::Point (0, 1000));
+  db::SimplePolygon spl;
+  spl.assign_hull (large.begin (), large.end ());
+  db::SimplePolygonRef lref (spl, rep);
+
+  EXPECT_EQ (rep.repository (db::Polygon::tag ()).size (), size_t (1001));
+  EXPECT_EQ (rep.repository (db::SimplePolygon::tag ()).size (), size_t (2));
+
+  EXPECT_EQ (prefs [0].obj () == prefs [2].obj (), true);
+  EXPECT_EQ (prefs [0].ptr () == prefs [2].ptr (), true);
+  EXPECT_EQ (prefs [10 * 2 + 1].instantiate ().to_string (), "(0,1;0,1001;1000,1001;1000,1/100,101;200,101;200,201;100,201/300,300;302,300;302,400;300,400)");
+  EXPECT_EQ (prefs [5 * 2].instantiate () == p.transformed (db::Trans (db::Vector (50, 0))), true);
+  EXPECT_EQ (sprefs [17].instantiate () == sp.transformed (db::Trans (db::Vector (17, 0))), true);
+  EXPECT_EQ (lref.instantiate () == spl, true);
+  EXPECT_EQ (lref.obj ().hull ().size (), size_t (10000));
+
+  //  copying the repository copies the shapes into the new arena
+  db::GenericRepository rep2 (rep);
+  EXPECT_EQ (rep2.repository (db::Polygon::tag ()).size (), size_t (1001));
+  EXPECT_EQ (rep2.repository (db::SimplePolygon::tag ()).size (), size_t (2));
+
+  db::PolygonRef pref2 (prefs [10 * 2 + 1], rep2);
+  EXPECT_EQ (pref2.ptr () != prefs [10 * 2 + 1].ptr (), true);
+  EXPECT_EQ (pref2.instantiate () == prefs [10 * 2 + 1].instantiate (), true);
+  EXPECT_EQ (db::PolygonRef (prefs [10 * 2 + 1].instantiate (), rep2).ptr () == pref2.ptr (), true);
+
+  db::SimplePolygonRef lref2 (lref, rep2);
+  EXPECT_EQ (lref2.instantiate () == spl, true);
+  EXPECT_EQ (rep2.repository (db::SimplePolygon::tag ()).size (), size_t (2));
+
+  rep2 = db::GenericRepository ();
+  EXPECT_EQ (rep2.repository (db::Polygon::tag ()).size (), size_t (0));
+  EXPECT_EQ (rep.repository (db::Polygon::tag ()).size (), size_t (1001));
+
+  db::MemStatisticsSimple ms;
+  rep.mem_stat (&ms, db::MemStatistics::ShapesInfo, 0, false, 0);
+  EXPECT_EQ (ms.used () > 1001 * sizeof (db::Polygon), true);
+  EXPECT_EQ (ms.used () <= ms.size (), true);
+}
+
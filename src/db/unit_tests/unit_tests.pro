@@ -68,6 +68,7 @@ SOURCES = \
     dbLayoutToNetlistReaderTests.cc \
     dbNetlistWriterTests.cc \
     dbCellVariantsTests.cc \
+    dbCellContentHashTests.cc \
     dbDeepEdgesTests.cc \
     dbDeepEdgePairsTests.cc \
     dbNetlistCompareTests.cc \
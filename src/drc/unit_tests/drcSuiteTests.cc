@@ -25,7 +25,7 @@
 #include "dbTestSupport.h"
 #include "lymMacro.h"
 
-void runtest (tl::TestBase *_this, int mode)
+void runtest (tl::TestBase *_this, int mode, int au_mode = 0)
 {
   std::string rs = tl::testsrc ();
   rs += "/testdata/drc/drcSuiteTests.drc";
@@ -35,7 +35,7 @@ void runtest (tl::TestBase *_this, int mode)
 
   std::string au = tl::testsrc ();
   au += "/testdata/drc/drcSuiteTests_au";
-  au += tl::to_string (mode);
+  au += tl::to_string (au_mode > 0 ? au_mode : mode);
   au += ".oas";
 
   std::string output = _this->tmp_file ("tmp.gds");
@@ -105,3 +105,10 @@ TEST(6_BigHier)
   test_is_long_runner ();
   runtest (_this, 6);
 }
+
+TEST(7_BigTiledConcurrent)
+{
+  test_is_long_runner ();
+  //  same golden data as 4_BigTiled
+  runtest (_this, 7, 4);
+}
@@ -268,6 +268,26 @@ public:
     m_const = c;
   }
 
+  /**
+   *  @brief Gets a value indicating whether the interpreter lock can be released while the method executes
+   *
+   *  Such methods run for a long time and don't access interpreter objects except through
+   *  callbacks. Script interpreters may allow other threads to run while executing them.
+   *  Callbacks into the interpreter need to acquire the lock again.
+   */
+  bool releases_gil () const
+  {
+    return m_releases_gil;
+  }
+
+  /**
+   *  @brief Sets a value indicating whether the interpreter lock can be released while the method executes
+   */
+  void set_releases_gil (bool f)
+  {
+    m_releases_gil = f;
+  }
+
   /**
    *  @brief Gets a value indicating whether the method is a static method
    */
@@ -570,6 +590,7 @@ private:
   bool m_const : 1;
   bool m_static : 1;
   bool m_protected : 1;
+  bool m_releases_gil : 1;
   unsigned int m_argsize;
   std::vector<MethodSynonym> m_method_synonyms;
 
@@ -711,6 +732,13 @@ public:
     m_methods.push_back (method);
   }
 
+  void set_releases_gil (bool f)
+  {
+    for (std::vector<MethodBase *>::iterator m = m_methods.begin (); m != m_methods.end (); ++m) {
+      (*m)->set_releases_gil (f);
+    }
+  }
+
   size_t size () const
   {
     return m_methods.size ();
@@ -730,6 +758,31 @@ inline Methods operator+ (const Methods &a, const Methods &b)
   return Methods (a) + b;
 }
 
+/**
+ *  @brief Marks the given methods as releasing the interpreter lock
+ *
+ *  Use this function for long-running methods which don't need the interpreter
+ *  (see MethodBase::releases_gil):
+ *
+ *  @code
+ *  gsi::release_gil (method ("merged", &db::Region::merged, ...))
+ *  @endcode
+ *
+ *  NOTE: while the lock is released, other script threads may run and access objects
+ *  concurrently. The Python binding makes calls from other threads on "self" and on the
+ *  object arguments wait until the method has finished, but objects reachable from them
+ *  in other ways (e.g. cells of a layout, shapes of a cell) are not protected. Hence only
+ *  declare methods this way which work on their own object and their arguments.
+ *  Callbacks issued from worker threads of the method must not use these objects as they
+ *  would wait for the method forever.
+ */
+inline Methods release_gil (const Methods &m)
+{
+  Methods mm (m);
+  mm.set_releases_gil (true);
+  return mm;
+}
+
 template <class X>
 class MethodSpecificBase 
   : public MethodBase
@@ -111,7 +111,7 @@ ArgType::to_string () const
 
 ArgType::ArgType ()
   : m_type (T_void), mp_spec (0), mp_inner (0), mp_inner_k (0),
-    m_is_ref (false), m_is_ptr (false), m_is_cref (false), m_is_cptr (false), m_is_iter (false), 
+    m_is_ref (false), m_is_ptr (false), m_is_cref (false), m_is_cptr (false), m_is_iter (false), m_is_binary (false),
     m_owns_spec (false), m_pass_obj (false), m_prefer_copy (false),
     mp_cls (0), m_size (0)
 { }
@@ -131,7 +131,7 @@ ArgType::~ArgType ()
 
 ArgType::ArgType (const ArgType &other)
   : m_type (T_void), mp_spec (0), mp_inner (0), mp_inner_k (0),
-    m_is_ref (false), m_is_ptr (false), m_is_cref (false), m_is_cptr (false), m_is_iter (false), 
+    m_is_ref (false), m_is_ptr (false), m_is_cref (false), m_is_cptr (false), m_is_iter (false), m_is_binary (false),
     m_owns_spec (false), m_pass_obj (false), m_prefer_copy (false),
     mp_cls (0), m_size (0)
 {
@@ -162,6 +162,7 @@ ArgType::operator= (const ArgType &other)
     m_is_ptr = other.m_is_ptr;
     m_is_cptr = other.m_is_cptr;
     m_is_iter = other.m_is_iter;
+    m_is_binary = other.m_is_binary;
     mp_cls = other.mp_cls;
     m_size = other.m_size;
 
@@ -203,7 +204,7 @@ ArgType::operator== (const ArgType &b) const
   if (mp_inner_k && *mp_inner_k != *b.mp_inner_k) {
     return false;
   }
-  return m_type == b.m_type && m_is_iter == b.m_is_iter && 
+  return m_type == b.m_type && m_is_iter == b.m_is_iter && m_is_binary == b.m_is_binary &&
          m_is_ref == b.m_is_ref && m_is_cref == b.m_is_cref && m_is_ptr == b.m_is_ptr && m_is_cptr == b.m_is_cptr && 
          mp_cls == b.mp_cls && m_pass_obj == b.m_pass_obj && m_prefer_copy == b.m_prefer_copy;
 }
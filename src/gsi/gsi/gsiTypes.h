@@ -424,6 +424,7 @@ template <> struct type_traits<__int128>                    : generic_type_trait
 template <> struct type_traits<double>                      : generic_type_traits<double_tag, double, T_double> { };
 template <> struct type_traits<float>                       : generic_type_traits<float_tag, float, T_float> { };
 template <> struct type_traits<std::string>                 : generic_type_traits<string_tag, StringAdaptor, T_string> { };
+template <> struct type_traits<std::vector<char> >          : generic_type_traits<string_tag, StringAdaptor, T_string> { };
 #if defined(HAVE_QT)
 template <> struct type_traits<QString>                     : generic_type_traits<string_tag, StringAdaptor, T_string> { };
 template <> struct type_traits<QStringRef>                  : generic_type_traits<string_tag, StringAdaptor, T_string> { };
@@ -456,6 +457,7 @@ template <> struct type_traits<const __int128 &>            : generic_type_trait
 template <> struct type_traits<const double &>              : generic_type_traits<double_cref_tag, double, T_double> { };
 template <> struct type_traits<const float &>               : generic_type_traits<float_cref_tag, float, T_float> { };
 template <> struct type_traits<const std::string &>         : generic_type_traits<string_cref_tag, StringAdaptor, T_string> { };
+template <> struct type_traits<const std::vector<char> &>   : generic_type_traits<string_cref_tag, StringAdaptor, T_string> { };
 #if defined(HAVE_QT)
 template <> struct type_traits<const QString &>             : generic_type_traits<string_cref_tag, StringAdaptor, T_string> { };
 template <> struct type_traits<const QStringRef &>          : generic_type_traits<string_cref_tag, StringAdaptor, T_string> { };
@@ -1446,6 +1448,23 @@ struct compute_pass_obj<arg_pass_ownership, X>
   static bool value () { return true; }
 };
 
+/**
+ *  @brief A function computing the "is_binary" value
+ *
+ *  Binary strings (byte arrays) are strings represented by std::vector<char>.
+ */
+template <class X>
+struct compute_is_binary
+{
+  static bool value () { return false; }
+};
+
+template <> struct compute_is_binary<std::vector<char> > { static bool value () { return true; } };
+template <> struct compute_is_binary<const std::vector<char> &> { static bool value () { return true; } };
+template <> struct compute_is_binary<std::vector<char> &> { static bool value () { return true; } };
+template <> struct compute_is_binary<const std::vector<char> *> { static bool value () { return true; } };
+template <> struct compute_is_binary<std::vector<char> *> { static bool value () { return true; } };
+
 /**
  *  @brief Generic argument type declaration
  *
@@ -1551,6 +1570,7 @@ public:
 
     m_type        = type_traits<X>::code ();
     m_is_iter     = type_traits<X>::is_iter ();
+    m_is_binary   = compute_is_binary<X>::value ();
     mp_cls        = type_traits<X>::cls_decl ();
 
     m_pass_obj    = compute_pass_obj<arg_default_return_value_preference, X>::value ();
@@ -1595,6 +1615,7 @@ public:
 
     m_type        = type_traits<X>::code ();
     m_is_iter     = type_traits<X>::is_iter ();
+    m_is_binary   = compute_is_binary<X>::value ();
     mp_cls        = type_traits<X>::cls_decl ();
 
     m_pass_obj    = compute_pass_obj<Transfer, X>::value ();
@@ -1803,6 +1824,14 @@ public:
     m_is_iter = b;
   }
 
+  /**
+   *  @brief Returns a value indicating whether the type is a binary string (byte array)
+   */
+  bool is_binary () const
+  {
+    return m_is_binary;
+  }
+
   /**
    *  @brief Returns the size (in bytes) on the call stack
    */
@@ -1852,6 +1881,7 @@ private:
   bool m_is_cref : 1;
   bool m_is_cptr : 1;
   bool m_is_iter : 1;
+  bool m_is_binary : 1;
   bool m_owns_spec : 1;
   bool m_pass_obj : 1;
   bool m_prefer_copy : 1;
@@ -365,7 +365,7 @@ public:
       return false;
     }
 
-    const db::PropertiesRepository::properties_id_vector &idv = rep.properties_ids_by_name_value (std::make_pair (p.second, m_value));
+    db::PropertiesRepository::properties_id_vector idv = rep.properties_ids_by_name_value (std::make_pair (p.second, m_value));
     for (db::PropertiesRepository::properties_id_vector::const_iterator id = idv.begin (); id != idv.end (); ++id) {
       ids.insert (*id);
     }
@@ -60,6 +60,10 @@ public:
     layout ().register_pcell ("ROUND_POLYGON", new BasicRoundPolygon ());
     layout ().register_pcell ("STROKED_BOX", new BasicStrokedPolygon (true));
     layout ().register_pcell ("STROKED_POLYGON", new BasicStrokedPolygon (false));
+
+    //  all PCells except TEXT (which uses the shared font generators) can be produced on
+    //  worker threads when the library is remapped
+    set_threads (4);
   }
 };
 
@@ -58,6 +58,14 @@ public:
    */
   virtual void produce (const db::Layout &layout, const std::vector<unsigned int> &layer_ids, const db::pcell_parameters_type &parameters, db::Cell &cell) const;
 
+  /**
+   *  @brief Indicates that variants can be produced on worker threads
+   */
+  virtual bool can_produce_concurrently () const
+  {
+    return true;
+  }
+
   /**
    *  @brief Get the display name for a PCell with the given parameters
    */
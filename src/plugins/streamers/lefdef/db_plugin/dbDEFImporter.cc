@@ -24,6 +24,8 @@
 #include "dbDEFImporter.h"
 #include "dbPolygonTools.h"
 #include "tlGlobPattern.h"
+#include "tlThreadedWorkers.h"
+#include "tlTimer.h"
 
 #include <cmath>
 
@@ -31,7 +33,7 @@ namespace db
 {
 
 DEFImporter::DEFImporter ()
-  : LEFDEFImporter ()
+  : LEFDEFImporter (), m_threads (0)
 {
   //  .. nothing yet ..
 }
@@ -136,6 +138,205 @@ struct Group
   std::vector<tl::GlobPattern> comp_match;
 };
 
+/**
+ *  @brief Describes a routing wire as read from a NETS or SPECIALNETS section
+ *
+ *  The wire is a sequence of points with a width, an extension and an optional
+ *  style polygon. The geometry is produced from this description by "produce_wire".
+ */
+struct DEFWire
+{
+  DEFWire (unsigned int l, db::properties_id_type pi, db::Coord _w, db::Coord _e, const db::Polygon *s, const std::vector<db::Point> &p)
+    : layer (l), prop_id (pi), w (_w), e (_e), style (s), pts (p)
+  {
+    //  .. nothing yet ..
+  }
+
+  unsigned int layer;
+  db::properties_id_type prop_id;
+  db::Coord w, e;
+  const db::Polygon *style;
+  std::vector<db::Point> pts;
+};
+
+template <class Shape>
+static void insert_with_props (db::Shapes &shapes, const Shape &s, db::properties_id_type prop_id)
+{
+  if (prop_id != 0) {
+    shapes.insert (db::object_with_properties<Shape> (s, prop_id));
+  } else {
+    shapes.insert (s);
+  }
+}
+
+/**
+ *  @brief Produces the geometry for a wire
+ */
+static void produce_wire (const DEFWire &wire, db::Shapes &shapes)
+{
+  const std::vector<db::Point> &pts = wire.pts;
+  db::Coord w = wire.w;
+
+  if (! wire.style) {
+
+    //  Use the default style (octagon "pen" for non-manhattan segments, paths for
+    //  horizontal/vertical segments).
+
+    db::Coord e = wire.e;
+
+    std::vector<db::Point>::const_iterator pt = pts.begin ();
+    while (pt != pts.end ()) {
+
+      std::vector<db::Point>::const_iterator pt0 = pt;
+      do {
+        ++pt;
+      } while (pt != pts.end () && (pt[-1].x () == pt[0].x () || pt[-1].y () == pt[0].y()));
+
+      if (pt - pt0 > 1) {
+
+        db::Path p (pt0, pt, w, pt0 == pts.begin () ? e : 0, pt == pts.end () ? e : 0, false);
+        insert_with_props (shapes, p, wire.prop_id);
+
+        if (pt == pts.end ()) {
+          break;
+        }
+
+        --pt;
+
+      } else if (pt != pts.end ()) {
+
+        db::Coord s = (w + 1) / 2;
+        db::Coord t = db::Coord (ceil (w * (M_SQRT2 - 1) / 2));
+
+        db::Point octagon[8] = {
+          db::Point (-s, t),
+          db::Point (-t, s),
+          db::Point (t, s),
+          db::Point (s, t),
+          db::Point (s, -t),
+          db::Point (t, -s),
+          db::Point (-t, -s),
+          db::Point (-s, -t)
+        };
+
+        db::Polygon k;
+        k.assign_hull (octagon, octagon + sizeof (octagon) / sizeof (octagon[0]));
+
+        db::Polygon p = db::minkowsky_sum (k, db::Edge (*pt0, *pt));
+        insert_with_props (shapes, p, wire.prop_id);
+
+      }
+
+    }
+
+  } else {
+
+    for (size_t i = 0; i < pts.size () - 1; ++i) {
+      db::Polygon p = db::minkowsky_sum (*wire.style, db::Edge (pts [i], pts [i + 1]));
+      insert_with_props (shapes, p, wire.prop_id);
+    }
+
+  }
+}
+
+/**
+ *  @brief A batch of wires for multi-threaded geometry generation
+ *
+ *  The batch receives the geometry in per-layer shape containers which
+ *  are merged into the design cell in the order of the batches.
+ */
+struct DEFWireBatch
+{
+  std::vector<DEFWire> wires;
+  std::map<unsigned int, db::Shapes> shapes;
+
+  void produce ()
+  {
+    for (std::vector<DEFWire>::const_iterator w = wires.begin (); w != wires.end (); ++w) {
+      std::map<unsigned int, db::Shapes>::iterator s = shapes.find (w->layer);
+      if (s == shapes.end ()) {
+        s = shapes.insert (std::make_pair (w->layer, db::Shapes (false))).first;
+      }
+      produce_wire (*w, s->second);
+    }
+
+    //  the wires are no longer required
+    std::vector<DEFWire> ().swap (wires);
+  }
+};
+
+/**
+ *  @brief The number of wires per batch
+ */
+static const size_t wire_batch_size = 10000;
+
+class DEFWireTask
+  : public tl::Task
+{
+public:
+  DEFWireTask (DEFWireBatch *batch)
+    : tl::Task (), mp_batch (batch)
+  {
+    //  .. nothing yet ..
+  }
+
+  void perform ()
+  {
+    mp_batch->produce ();
+  }
+
+private:
+  DEFWireBatch *mp_batch;
+};
+
+class DEFWireWorker
+  : public tl::Worker
+{
+public:
+  DEFWireWorker ()
+    : tl::Worker ()
+  {
+    //  .. nothing yet ..
+  }
+
+  void perform_task (tl::Task *task)
+  {
+    static_cast<DEFWireTask *> (task)->perform ();
+  }
+};
+
+/**
+ *  @brief Produces the geometry for the collected wire batches in parallel and puts it into the cell
+ */
+static void produce_wire_batches (std::list<DEFWireBatch> &batches, db::Cell &cell, int nthreads)
+{
+  if (batches.empty ()) {
+    return;
+  }
+
+  tl::SelfTimer timer (tl::verbosity () >= 21, tl::to_string (tr ("Producing routing geometry")));
+
+  tl::Job<DEFWireWorker> job (nthreads);
+  for (std::list<DEFWireBatch>::iterator b = batches.begin (); b != batches.end (); ++b) {
+    job.schedule (new DEFWireTask (&*b));
+  }
+
+  job.start ();
+  job.wait ();
+
+  if (job.has_error ()) {
+    throw tl::Exception (tl::to_string (tr ("Errors occurred during producing the routing geometry. First error message says:\n")) + job.error_messages ().front ());
+  }
+
+  //  merge the results in a deterministic order
+  while (! batches.empty ()) {
+    for (std::map<unsigned int, db::Shapes>::const_iterator s = batches.front ().shapes.begin (); s != batches.front ().shapes.end (); ++s) {
+      cell.shapes (s->first).insert (s->second);
+    }
+    batches.pop_front ();
+  }
+}
+
 void 
 DEFImporter::do_read (db::Layout &layout)
 {
@@ -146,6 +347,7 @@ DEFImporter::do_read (db::Layout &layout)
   std::map<std::string, std::vector<db::Polygon> > regions;
   std::list<Group> groups;
   std::list<std::pair<std::string, db::CellInstArray> > instances;
+  std::list<DEFWireBatch> wire_batches;
 
   db::Cell &design = layout.cell (layout.add_cell ("TOP"));
 
@@ -638,81 +840,21 @@ DEFImporter::do_read (db::Layout &layout)
                     std::pair <bool, unsigned int> dl = open_layer (layout, ln, Routing);
                     if (dl.first) {
 
-                      if (! style) {
-
-                        //  Use the default style (octagon "pen" for non-manhattan segments, paths for 
-                        //  horizontal/vertical segments).
-
-                        db::Coord e = std::max (ext.front (), ext.back ());
-
-                        std::vector<db::Point>::const_iterator pt = pts.begin ();
-                        while (pt != pts.end ()) {
-
-                          std::vector<db::Point>::const_iterator pt0 = pt;
-                          do {
-                            ++pt;
-                          } while (pt != pts.end () && (pt[-1].x () == pt[0].x () || pt[-1].y () == pt[0].y()));
-
-                          if (pt - pt0 > 1) {
-
-                            db::Path p (pt0, pt, w, pt0 == pts.begin () ? e : 0, pt == pts.end () ? e : 0, false);
-                            if (prop_id != 0) {
-                              design.shapes (dl.second).insert (db::object_with_properties<db::Path> (p, prop_id));
-                            } else {
-                              design.shapes (dl.second).insert (p);
-                            }
-
-                            if (pt == pts.end ()) {
-                              break;
-                            }
-
-                            --pt;
-
-                          } else if (pt != pts.end ()) {
-
-                            db::Coord s = (w + 1) / 2;
-                            db::Coord t = db::Coord (ceil (w * (M_SQRT2 - 1) / 2));
-
-                            db::Point octagon[8] = {
-                              db::Point (-s, t),
-                              db::Point (-t, s),
-                              db::Point (t, s),
-                              db::Point (s, t),
-                              db::Point (s, -t),
-                              db::Point (t, -s),
-                              db::Point (-t, -s),
-                              db::Point (-s, -t)
-                            };
-
-                            db::Polygon k;
-                            k.assign_hull (octagon, octagon + sizeof (octagon) / sizeof (octagon[0]));
-
-                            db::Polygon p = db::minkowsky_sum (k, db::Edge (*pt0, *pt));
-                            if (prop_id != 0) {
-                              design.shapes (dl.second).insert (db::object_with_properties<db::Polygon> (p, prop_id));
-                            } else {
-                              design.shapes (dl.second).insert (p);
-                            }
-
-                          }
+                      DEFWire wire (dl.second, prop_id, w, std::max (ext.front (), ext.back ()), style, pts);
 
+                      if (m_threads > 0) {
+                        //  defer the geometry generation: it is done in parallel after reading
+                        if (wire_batches.empty () || wire_batches.back ().wires.size () >= wire_batch_size) {
+                          wire_batches.push_back (DEFWireBatch ());
+                          wire_batches.back ().wires.reserve (wire_batch_size);
                         }
-
+                        wire_batches.back ().wires.push_back (wire);
                       } else {
-
-                        for (size_t i = 0; i < pts.size () - 1; ++i) {
-                          db::Polygon p = db::minkowsky_sum (*style, db::Edge (pts [i], pts [i + 1]));
-                          if (prop_id != 0) {
-                            design.shapes (dl.second).insert (db::object_with_properties<db::Polygon> (p, prop_id));
-                          } else {
-                            design.shapes (dl.second).insert (p);
-                          }
-                        }
-
+                        produce_wire (wire, design.shapes (wire.layer));
                       }
 
                     }
-                    
+
                   }
 
                 } else if (! peek ("NEW") && ! peek ("+") && ! peek ("-") && ! peek (";")) {
@@ -1175,6 +1317,9 @@ DEFImporter::do_read (db::Layout &layout)
 
   }
 
+  //  produce the deferred routing geometry
+  produce_wire_batches (wire_batches, design, m_threads);
+
   //  now we have collected the groups, regions and instances we create new subcells for each group
   //  and put the instances for this group there
 
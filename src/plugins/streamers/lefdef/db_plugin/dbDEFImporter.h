@@ -56,12 +56,33 @@ public:
    */
   void read_lef (tl::InputStream &stream, db::Layout &layout, LEFDEFLayerDelegate &ld);
 
+  /**
+   *  @brief Sets the number of threads to use for producing the routing geometry
+   *
+   *  If the number of threads is 0, the geometry is produced while reading.
+   *  Otherwise, the wires of the NETS and SPECIALNETS sections are collected first
+   *  and their geometry is computed in parallel at the end of the file.
+   */
+  void set_threads (int n)
+  {
+    m_threads = n;
+  }
+
+  /**
+   *  @brief Gets the number of threads to use for producing the routing geometry
+   */
+  int threads () const
+  {
+    return m_threads;
+  }
+
 protected:
   void do_read (db::Layout &layout);
 
 private:
   LEFImporter m_lef_importer;
   std::map<std::string, std::map<std::string, double> > m_nondefault_widths;
+  int m_threads;
 
   db::FTrans get_orient (bool optional);
   void read_polygon (db::Polygon &poly, double scale);
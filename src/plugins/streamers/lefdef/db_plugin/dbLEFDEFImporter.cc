@@ -64,7 +64,8 @@ LEFDEFReaderOptions::LEFDEFReaderOptions ()
     m_labels_datatype (1),
     m_produce_routing (true),
     m_routing_suffix (""),
-    m_routing_datatype (0)
+    m_routing_datatype (0),
+    m_threads (0)
 {
   //  .. nothing yet ..
 }
@@ -101,6 +102,7 @@ LEFDEFReaderOptions::LEFDEFReaderOptions (const LEFDEFReaderOptions &d)
     m_produce_routing (d.m_produce_routing),
     m_routing_suffix (d.m_routing_suffix),
     m_routing_datatype (d.m_routing_datatype),
+    m_threads (d.m_threads),
     m_lef_files (d.m_lef_files)
 {
   //  .. nothing yet ..
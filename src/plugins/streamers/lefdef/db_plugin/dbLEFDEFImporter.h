@@ -385,6 +385,16 @@ public:
     m_routing_datatype = s;
   }
 
+  int threads () const
+  {
+    return m_threads;
+  }
+
+  void set_threads (int n)
+  {
+    m_threads = n;
+  }
+
   void clear_lef_files ()
   {
     m_lef_files.clear ();
@@ -447,6 +457,7 @@ private:
   bool m_produce_routing;
   std::string m_routing_suffix;
   int m_routing_datatype;
+  int m_threads;
   std::vector<std::string> m_lef_files;
 };
 
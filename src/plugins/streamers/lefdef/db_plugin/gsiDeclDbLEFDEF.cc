@@ -318,6 +318,20 @@ gsi::Class<db::LEFDEFReaderOptions> decl_lefdef_config ("db", "LEFDEFReaderConfi
     "@brief Sets the routing layer datatype value.\n"
     "See \\produce_via_geometry for details about the layer production rules."
   ) +
+  gsi::method ("threads", &db::LEFDEFReaderOptions::threads,
+    "@brief Gets the number of threads to use for producing the routing geometry of DEF files.\n"
+    "See \\threads= for details.\n"
+    "\n"
+    "This attribute has been introduced in version 0.26."
+  ) +
+  gsi::method ("threads=", &db::LEFDEFReaderOptions::set_threads, gsi::arg ("n"),
+    "@brief Sets the number of threads to use for producing the routing geometry of DEF files.\n"
+    "If this value is non-zero, the DEF reader will first parse the NETS and SPECIALNETS sections and "
+    "then compute the wire geometry of the nets on the given number of worker threads. "
+    "The default value is 0 which means the geometry is produced while reading.\n"
+    "\n"
+    "This attribute has been introduced in version 0.26."
+  ) +
   gsi::method ("lef_files", &db::LEFDEFReaderOptions::lef_files,
     "@brief Gets the list technology LEF files to additionally import\n"
     "Returns a list of path names for technology LEF files to read in addition to the primary file. "
@@ -30,7 +30,7 @@
 
 #include <cstdlib>
 
-static void run_test (tl::TestBase *_this, const char *lef_dir, const char *filename, const char *au, bool priv = true)
+static void run_test (tl::TestBase *_this, const char *lef_dir, const char *filename, const char *au, bool priv = true, int threads = 0)
 {
   db::LEFDEFReaderOptions tc;
   tc.set_via_geometry_datatype (0);
@@ -55,6 +55,7 @@ static void run_test (tl::TestBase *_this, const char *lef_dir, const char *file
   ld.prepare (layout);
 
   db::DEFImporter imp;
+  imp.set_threads (threads);
 
   while (! ex.at_end ()) {
 
@@ -238,3 +239,14 @@ TEST(20)
   run_test (_this, "issue-172", "lef:in.lef+def:in.def", "au.oas.gz", false);
 }
 
+//  multi-threaded routing geometry production
+TEST(21)
+{
+  run_test (_this, "issue-172", "lef:in.lef+def:in.def", "au.oas.gz", false, 4);
+}
+
+TEST(22)
+{
+  run_test (_this, "def6", "lef:cells.lef+lef:tech.lef+def:in.def.gz", "au.oas.gz", true, 4);
+}
+
@@ -283,6 +283,10 @@ PythonInterpreter::PythonInterpreter (bool embedded)
   Py_SetProgramName (make_string (app_path));
 
   Py_InitializeEx (0 /*don't set signals*/);
+#if PY_MAJOR_VERSION < 3 || PY_MINOR_VERSION < 7
+  //  needed for releasing the GIL in long-running methods (implicit in Python >= 3.7)
+  PyEval_InitThreads ();
+#endif
 
   //  Set dummy argv[]
   //  TODO: more?
@@ -313,6 +317,10 @@ PythonInterpreter::PythonInterpreter (bool embedded)
 
   PyImport_AppendInittab (pya_module_name, &init_pya_module);
   Py_InitializeEx (0 /*don't set signals*/);
+#if PY_MAJOR_VERSION < 3 || PY_MINOR_VERSION < 7
+  //  needed for releasing the GIL in long-running methods (implicit in Python >= 3.7)
+  PyEval_InitThreads ();
+#endif
 
   //  Set dummy argv[]
   //  TODO: more?
@@ -192,6 +192,22 @@ std::string python2c_func<std::string>::operator() (PyObject *rval)
   }
 }
 
+std::string python2c_binary (PyObject *rval)
+{
+  if (PyObject_CheckBuffer (rval)) {
+    //  objects supporting the buffer protocol (bytes, memoryview, NumPy arrays etc.) deliver their raw data
+    Py_buffer view;
+    if (PyObject_GetBuffer (rval, &view, PyBUF_C_CONTIGUOUS) != 0) {
+      check_error ();
+    }
+    std::string s ((const char *) view.buf, size_t (view.len));
+    PyBuffer_Release (&view);
+    return s;
+  } else {
+    return python2c<std::string> (rval);
+  }
+}
+
 #if defined(HAVE_QT)
 template <>
 QByteArray python2c_func<QByteArray>::operator() (PyObject *rval)
@@ -333,6 +333,16 @@ template <> PYA_PUBLIC double python2c_func<double>::operator() (PyObject *rval)
 template <> struct python2c_func<float> : public python2c_func_cast<float, double> { };
 
 template <> PYA_PUBLIC std::string python2c_func<std::string>::operator() (PyObject *rval);
+
+/**
+ *  @brief Converts a Python object to a binary string (byte array)
+ *
+ *  In addition to the string types, this function accepts every object supporting
+ *  the buffer protocol (memoryview, array.array, NumPy arrays etc.) and delivers
+ *  the raw data.
+ */
+PYA_PUBLIC std::string python2c_binary (PyObject *rval);
+
 #if defined(HAVE_QT)
 template <> PYA_PUBLIC QByteArray python2c_func<QByteArray>::operator() (PyObject *rval);
 template <> PYA_PUBLIC QString python2c_func<QString>::operator() (PyObject *rval);
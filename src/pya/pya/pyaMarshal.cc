@@ -42,8 +42,8 @@ class PythonBasedStringAdaptor
   : public gsi::StringAdaptor
 {
 public:
-  PythonBasedStringAdaptor (const PythonPtr &string)
-    : m_stdstr (python2c<std::string> (string.get ())), m_string (string)
+  PythonBasedStringAdaptor (const PythonPtr &string, bool binary)
+    : m_stdstr (binary ? python2c_binary (string.get ()) : python2c<std::string> (string.get ()))
   {
     //  .. nothing yet ..
   }
@@ -64,8 +64,9 @@ public:
   }
 
 private:
+  //  NOTE: this adaptor must not hold a reference to the Python object as it may be
+  //  destroyed while the GIL is released
   std::string m_stdstr;
-  PythonPtr m_string;
 };
 
 /**
@@ -295,7 +296,7 @@ struct writer<gsi::StringType>
       } else {
 
         //  NOTE: by convention we pass the ownership to the receiver for adaptors.
-        aa->write<void *> ((void *)new PythonBasedStringAdaptor (arg));
+        aa->write<void *> ((void *)new PythonBasedStringAdaptor (arg, atype.is_binary ()));
 
       }
 
@@ -527,6 +528,13 @@ struct reader<gsi::StringType>
     std::auto_ptr<gsi::StringAdaptor> a ((gsi::StringAdaptor *) rr->read<void *>(*heap));
     if (!a.get ()) {
       *ret = PythonRef (Py_None, false /*borrowed*/);
+    } else if (a->is_binary ()) {
+      //  byte arrays are delivered as "bytes" objects which support the buffer protocol
+#if PY_MAJOR_VERSION < 3
+      *ret = PythonRef (PyString_FromStringAndSize (a->c_str (), Py_ssize_t (a->size ())));
+#else
+      *ret = PythonRef (PyBytes_FromStringAndSize (a->c_str (), Py_ssize_t (a->size ())));
+#endif
     } else {
       *ret = c2python (std::string (a->c_str (), a->size ()));
     }
@@ -909,7 +917,7 @@ struct test_arg_func<gsi::VariantType>
 template <>
 struct test_arg_func<gsi::StringType>
 {
-  void operator() (bool *ret, PyObject *arg, const gsi::ArgType &, bool)
+  void operator() (bool *ret, PyObject *arg, const gsi::ArgType &atype, bool)
   {
 #if PY_MAJOR_VERSION < 3
     if (PyString_Check (arg)) {
@@ -924,6 +932,9 @@ struct test_arg_func<gsi::StringType>
       *ret = true;
     } else if (PyByteArray_Check (arg)) {
       *ret = true;
+    } else if (atype.is_binary () && PyObject_CheckBuffer (arg)) {
+      //  byte arrays also take memoryview, array.array, NumPy arrays etc.
+      *ret = true;
     } else {
       *ret = false;
     }
@@ -32,11 +32,20 @@
 #include "pyaSignalHandler.h"
 #include "pyaUtils.h"
 
+#include "tlThreads.h"
+
 #include <map>
+#include <set>
 
 namespace pya
 {
 
+/**
+ *  @brief The Python types created for GSI classes
+ *  These types live as long as the module and are used to identify GSI objects quickly.
+ */
+static std::set<PyTypeObject *> s_gsi_types;
+
 // -------------------------------------------------------------------
 //  The lookup table for the method overload resolution
 
@@ -51,6 +60,74 @@ class MethodTableEntry
 public:
   typedef std::vector<const gsi::MethodBase *>::const_iterator method_iterator;
 
+  /**
+   *  @brief A key for the overload resolution cache
+   *
+   *  The key is formed from the argument types. For GSI objects, the constness of the
+   *  object is included. Overload resolution for list, tuple and dict arguments depends
+   *  on the content, hence such arguments can't be cached. The same is true for arguments
+   *  of types created on the fly (e.g. Python classes), as their type objects may be
+   *  deleted and the addresses reused. In these cases, the key is not valid.
+   */
+  struct MethodVariantKey
+  {
+    MethodVariantKey ()
+      : m_is_valid (false), m_has_self (false), m_is_const (false)
+    {
+      //  .. nothing yet ..
+    }
+
+    MethodVariantKey (PyObject *args, bool has_self, bool is_const)
+      : m_is_valid (true), m_has_self (has_self), m_is_const (is_const)
+    {
+      int argc = args == NULL ? 0 : int (PyTuple_Size (args));
+      m_argtypes.reserve (size_t (argc));
+
+      for (int i = 0; i < argc && m_is_valid; ++i) {
+
+        PyObject *arg = PyTuple_GetItem (args, i);
+        PyTypeObject *type = Py_TYPE (arg);
+
+        if (PyList_Check (arg) || PyTuple_Check (arg) || PyDict_Check (arg)) {
+          m_is_valid = false;
+        } else if (s_gsi_types.find (type) != s_gsi_types.end ()) {
+          //  type objects are aligned, so we can use the lowest bit for the constness
+          m_argtypes.push_back (size_t (type) | (PYAObjectBase::from_pyobject (arg)->const_ref () ? 1 : 0));
+        } else if ((type->tp_flags & Py_TPFLAGS_HEAPTYPE) == 0) {
+          m_argtypes.push_back (size_t (type));
+        } else {
+          m_is_valid = false;
+        }
+
+      }
+    }
+
+    bool is_valid () const
+    {
+      return m_is_valid;
+    }
+
+    bool operator< (const MethodVariantKey &other) const
+    {
+      if (m_argtypes != other.m_argtypes) {
+        return m_argtypes < other.m_argtypes;
+      }
+      if (m_has_self != other.m_has_self) {
+        return m_has_self < other.m_has_self;
+      }
+      if (m_is_const != other.m_is_const) {
+        return m_is_const < other.m_is_const;
+      }
+      return false;
+    }
+
+  private:
+    std::vector<size_t> m_argtypes;
+    bool m_is_valid;
+    bool m_has_self;
+    bool m_is_const;
+  };
+
   MethodTableEntry (const std::string &name, bool st, bool prot)
     : m_name (name), m_is_static (st), m_is_protected (prot)
   { }
@@ -93,11 +170,29 @@ public:
     return m_methods.end ();
   }
 
+  /**
+   *  @brief Gets the cached overload variant for the given key or 0 if there is none
+   */
+  const gsi::MethodBase *cached_variant (const MethodVariantKey &key) const
+  {
+    std::map<MethodVariantKey, const gsi::MethodBase *>::const_iterator v = m_variants.find (key);
+    return v != m_variants.end () ? v->second : 0;
+  }
+
+  /**
+   *  @brief Stores the overload variant for the given key in the cache
+   */
+  void cache_variant (const MethodVariantKey &key, const gsi::MethodBase *meth) const
+  {
+    m_variants [key] = meth;
+  }
+
 private:
   std::string m_name;
   bool m_is_static : 1;
   bool m_is_protected : 1;
   std::vector<const gsi::MethodBase *> m_methods;
+  mutable std::map<MethodVariantKey, const gsi::MethodBase *> m_variants;
 };
 
 /**
@@ -335,6 +430,14 @@ public:
     return m_table[mid - m_method_offset].end ();
   }
 
+  /**
+   *  @brief Gets the method table entry for method ID mid
+   */
+  const MethodTableEntry &entry (size_t mid) const
+  {
+    return m_table[mid - m_method_offset];
+  }
+
   /**
    *  @brief Finishes construction of the table
    *  This method must be called after the add_method calls have been used
@@ -685,6 +788,145 @@ property_name_from_id (int mid, PyObject *self)
   return cls_decl->name () + "." + mt->property_name (mid);
 }
 
+/**
+ *  @brief Returns true, if the GIL can be released while the given method is executed
+ *
+ *  This is the case if the method is declared with "gsi::release_gil" and none of
+ *  the arguments is represented by an adaptor which needs to access Python objects
+ *  while the method executes (variants, lists and hashes).
+ */
+static bool
+may_release_gil (const gsi::MethodBase *meth)
+{
+  if (! meth->releases_gil ()) {
+    return false;
+  }
+
+  for (gsi::MethodBase::argument_iterator a = meth->begin_arguments (); a != meth->end_arguments (); ++a) {
+    if (a->type () == gsi::T_var || a->type () == gsi::T_vector || a->type () == gsi::T_map) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+//  Protects the busy state of the objects and signals its changes
+static tl::Mutex s_busy_lock;
+static tl::WaitCondition s_busy_changed;
+
+/**
+ *  @brief Waits until none of the given objects is in use by a method running without the GIL in another thread
+ *
+ *  This function needs to be called with the GIL held and s_busy_lock locked. It returns with
+ *  both being held again. While waiting, the GIL is released so the other thread can finish.
+ */
+static void
+wait_until_not_busy (const std::vector<PYAObjectBase *> &objects, unsigned long thread)
+{
+  while (true) {
+
+    bool busy = false;
+    for (std::vector<PYAObjectBase *>::const_iterator o = objects.begin (); o != objects.end () && ! busy; ++o) {
+      busy = (*o)->is_busy (thread);
+    }
+
+    if (! busy) {
+      return;
+    }
+
+    //  NOTE: the GIL must not be requested while s_busy_lock is held, as the thread releasing
+    //  an object takes the locks in the opposite order.
+    PyThreadState *state = PyEval_SaveThread ();
+    s_busy_changed.wait (&s_busy_lock);
+    s_busy_lock.unlock ();
+    PyEval_RestoreThread (state);
+    s_busy_lock.lock ();
+
+  }
+}
+
+/**
+ *  @brief Waits until the given object is no longer in use by a method running without the GIL
+ *
+ *  While the GIL is released, other Python threads could access the objects the method
+ *  works on. As the C++ objects are not thread-safe, such accesses are delayed until the
+ *  method has finished.
+ */
+static void
+wait_until_not_busy (PYAObjectBase *p)
+{
+  if (p) {
+    std::vector<PYAObjectBase *> objects;
+    objects.push_back (p);
+    tl::MutexLocker locker (&s_busy_lock);
+    wait_until_not_busy (objects, PyThread_get_thread_ident ());
+  }
+}
+
+/**
+ *  @brief Marks "self" and all object arguments of a method call as busy
+ *
+ *  If one of these objects is busy already in a different thread, the constructor waits
+ *  until it becomes available. If "enabled" is true the objects are marked busy for the
+ *  lifetime of this object. This is used for methods which are executed without the GIL.
+ *  All objects are acquired at once, so concurrent calls on overlapping sets of objects
+ *  do not deadlock.
+ */
+class BusyObjectsLocker
+{
+public:
+  BusyObjectsLocker (PYAObjectBase *self, PyObject *args, bool enabled)
+  {
+    if (self) {
+      m_objects.push_back (self);
+    }
+
+    int argc = args == NULL ? 0 : int (PyTuple_Size (args));
+    for (int i = 0; i < argc; ++i) {
+      PyObject *arg = PyTuple_GetItem (args, i);
+      if (arg != Py_None && PythonModule::cls_for_type (Py_TYPE (arg)) != 0) {
+        m_objects.push_back (PYAObjectBase::from_pyobject (arg));
+      }
+    }
+
+    if (m_objects.empty ()) {
+      return;
+    }
+
+    unsigned long thread = PyThread_get_thread_ident ();
+
+    tl::MutexLocker locker (&s_busy_lock);
+
+    wait_until_not_busy (m_objects, thread);
+
+    if (! enabled) {
+      m_objects.clear ();
+    } else {
+      for (std::vector<PYAObjectBase *>::const_iterator o = m_objects.begin (); o != m_objects.end (); ++o) {
+        (*o)->acquire_busy (thread);
+      }
+    }
+  }
+
+  ~BusyObjectsLocker ()
+  {
+    if (! m_objects.empty ()) {
+      tl::MutexLocker locker (&s_busy_lock);
+      for (std::vector<PYAObjectBase *>::const_iterator o = m_objects.begin (); o != m_objects.end (); ++o) {
+        (*o)->release_busy ();
+      }
+      s_busy_changed.wakeAll ();
+    }
+  }
+
+private:
+  std::vector<PYAObjectBase *> m_objects;
+
+  BusyObjectsLocker (const BusyObjectsLocker &);
+  BusyObjectsLocker &operator= (const BusyObjectsLocker &);
+};
+
 static PyObject *
 get_return_value (PYAObjectBase *self, gsi::SerialArgs &retlist, const gsi::MethodBase *meth, tl::Heap &heap)
 {
@@ -779,9 +1021,20 @@ match_method (int mid, PyObject *self, PyObject *args, bool strict)
 
   }
 
+  MethodTableEntry::MethodVariantKey key;
+
   //  more than one candidate -> refine by checking the arguments
   if (candidates > 1) {
 
+    //  try the overload resolution cache first
+    key = MethodTableEntry::MethodVariantKey (args, p != 0, p != 0 && p->const_ref ());
+    if (key.is_valid ()) {
+      const gsi::MethodBase *cached = mt->entry (mid).cached_variant (key);
+      if (cached) {
+        return cached;
+      }
+    }
+
     meth = 0;
     candidates = 0;
     int score = 0;
@@ -858,6 +1111,10 @@ match_method (int mid, PyObject *self, PyObject *args, bool strict)
     }
   }
 
+  if (key.is_valid ()) {
+    mt->entry (mid).cache_variant (key, meth);
+  }
+
   return meth;
 }
 
@@ -1049,7 +1306,16 @@ object_destroy (PyObject *self, PyObject *args)
     return NULL;
   }
 
-  (PYAObjectBase::from_pyobject (self))->destroy ();
+  PYAObjectBase *p = PYAObjectBase::from_pyobject (self);
+  wait_until_not_busy (p);
+
+  if (p->is_busy ()) {
+    //  called from inside the method using the object (e.g. from a callback)
+    PyErr_SetString (PyExc_RuntimeError, tl::to_string (tr ("Object cannot be destroyed while it is in use by a method")).c_str ());
+    return NULL;
+  }
+
+  p->destroy ();
   Py_RETURN_NONE;
 }
 
@@ -1133,6 +1399,11 @@ method_adaptor (int mid, PyObject *self, PyObject *args)
 
       int argc = args == NULL ? 0 : int (PyTuple_Size (args));
 
+      //  objects in use by another thread are not accessed. If the method runs without the GIL,
+      //  "self" and the object arguments are marked busy until the method has finished.
+      bool release_gil = may_release_gil (meth);
+      BusyObjectsLocker busy_locker (p, args, release_gil);
+
       void *obj = 0;
       if (p) {
         //  Hint: this potentially instantiates the object
@@ -1161,7 +1432,10 @@ method_adaptor (int mid, PyObject *self, PyObject *args)
 
       }
 
-      meth->call (obj, arglist, retlist);
+      {
+        PythonGILReleaser gil_releaser (release_gil);
+        meth->call (obj, arglist, retlist);
+      }
 
       ret = get_return_value (p, retlist, meth, heap);
 
@@ -1938,6 +2212,8 @@ property_getter_impl (int mid, PyObject *self)
       throw tl::Exception (tl::to_string (tr ("Internal error: getters must not have arguments")));
     }
 
+    wait_until_not_busy (p);
+
     void *obj = 0;
     if (p) {
       //  Hint: this potentially instantiates the object
@@ -2070,6 +2346,8 @@ property_setter_impl (int mid, PyObject *self, PyObject *value)
     throw tl::Exception (tl::to_string (tr ("Ambiguous overload variants - multiple setter declarations match arguments")));
   }
 
+  wait_until_not_busy (p);
+
   void *obj = 0;
   if (p) {
     //  Hint: this potentially instantiates the object
@@ -2204,6 +2482,11 @@ PythonModule::init (const char *mod_name, const char *description)
     new pya::PythonInterpreter (false);
   }
 
+#if PY_MAJOR_VERSION < 3 || PY_MINOR_VERSION < 7
+  //  needed for releasing the GIL in long-running methods (implicit in Python >= 3.7)
+  PyEval_InitThreads ();
+#endif
+
   //  do some checks before we create the module
   tl_assert (mod_name != 0);
   tl_assert (mp_module.get () == 0);
@@ -2456,6 +2739,7 @@ PythonModule::make_classes (const char *mod_name)
       type->tp_getattro = PyObject_GenericGetAttr;
 
       PythonClassClientData::initialize (*c, type);
+      s_gsi_types.insert (type);
 
       tl_assert (cls_for_type (type) == c.operator-> ());
 
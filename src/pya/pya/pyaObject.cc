@@ -124,6 +124,9 @@ Callee::call (int id, gsi::SerialArgs &args, gsi::SerialArgs &ret) const
 {
   const gsi::MethodBase *meth = m_cbfuncs [id].method ();
 
+  //  the callback may be issued from code that runs without the GIL
+  PythonGILLocker gil_locker;
+
   try {
 
     PythonRef callable (m_cbfuncs [id].callable ());
@@ -189,7 +192,9 @@ PYAObjectBase::PYAObjectBase(const gsi::ClassBase *_cls_decl, PyObject *py_objec
     m_owned (false),
     m_const_ref (false),
     m_destroyed (false),
-    m_can_destroy (false)
+    m_can_destroy (false),
+    m_busy_thread (0),
+    m_busy_count (0)
 {
   //  .. nothing yet ..
 }
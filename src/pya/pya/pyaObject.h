@@ -155,6 +155,45 @@ public:
     return m_const_ref;
   }
 
+  /**
+   *  @brief Returns a flag indicating that the object is in use by a method running without the GIL in another thread
+   *  "thread" is the Python thread ident of the thread asking. Such objects must not be used by this
+   *  thread until the method has finished. The thread running the method itself may use the object
+   *  (e.g. from callbacks).
+   */
+  bool is_busy (unsigned long thread) const
+  {
+    return m_busy_count > 0 && m_busy_thread != thread;
+  }
+
+  /**
+   *  @brief Returns a flag indicating that the object is in use by a method running without the GIL in any thread
+   */
+  bool is_busy () const
+  {
+    return m_busy_count > 0;
+  }
+
+  /**
+   *  @brief Marks the object as being in use by a method running without the GIL in the given thread
+   *  Calls may be nested. Each call needs to be balanced by "release_busy".
+   */
+  void acquire_busy (unsigned long thread)
+  {
+    m_busy_thread = thread;
+    ++m_busy_count;
+  }
+
+  /**
+   *  @brief Releases the object from being in use (see "acquire_busy")
+   */
+  void release_busy ()
+  {
+    if (m_busy_count > 0) {
+      --m_busy_count;
+    }
+  }
+
   /**
    *  @brief Sets a flag indicating that this Python object is a const reference to the C++ object
    *  See \set for a description of that flag.
@@ -228,6 +267,8 @@ private:
   bool m_const_ref : 1;
   bool m_destroyed : 1;
   bool m_can_destroy : 1;
+  unsigned long m_busy_thread;
+  unsigned int m_busy_count;
   std::map <const gsi::MethodBase *, pya::SignalHandler> m_signal_table;
 };
 
@@ -123,6 +123,9 @@ SignalHandler::~SignalHandler ()
 
 void SignalHandler::call (const gsi::MethodBase *meth, gsi::SerialArgs &args, gsi::SerialArgs &ret) const
 {
+  //  the signal may be issued from code that runs without the GIL
+  PythonGILLocker gil_locker;
+
   PYTHON_BEGIN_EXEC
 
     tl::Heap heap;
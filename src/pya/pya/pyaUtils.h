@@ -70,6 +70,65 @@ namespace pya
  */
 void check_error ();
 
+/**
+ *  @brief Releases the global interpreter lock for the lifetime of this object
+ *
+ *  This object is used to run C++ code without holding the GIL. No Python API
+ *  function must be called while the lock is released, except through PythonGILLocker.
+ *  If "enabled" is false, this object does nothing.
+ */
+class PythonGILReleaser
+{
+public:
+  PythonGILReleaser (bool enabled = true)
+    : mp_state (enabled ? PyEval_SaveThread () : 0)
+  {
+    //  .. nothing yet ..
+  }
+
+  ~PythonGILReleaser ()
+  {
+    if (mp_state) {
+      PyEval_RestoreThread (mp_state);
+    }
+  }
+
+private:
+  PyThreadState *mp_state;
+
+  PythonGILReleaser (const PythonGILReleaser &);
+  PythonGILReleaser &operator= (const PythonGILReleaser &);
+};
+
+/**
+ *  @brief Acquires the global interpreter lock for the lifetime of this object
+ *
+ *  This object needs to be placed in all entry points through which C++ code calls
+ *  back into Python. These may be called from C++ code which runs with the GIL
+ *  released or from other threads. If the current thread already holds the GIL,
+ *  this object does nothing.
+ */
+class PythonGILLocker
+{
+public:
+  PythonGILLocker ()
+    : m_state (PyGILState_Ensure ())
+  {
+    //  .. nothing yet ..
+  }
+
+  ~PythonGILLocker ()
+  {
+    PyGILState_Release (m_state);
+  }
+
+private:
+  PyGILState_STATE m_state;
+
+  PythonGILLocker (const PythonGILLocker &);
+  PythonGILLocker &operator= (const PythonGILLocker &);
+};
+
 }
 
 #endif
@@ -279,6 +279,12 @@ public:
     m_rvalue.swap (other);
   }
 
+  void set_by_swap (tl::Variant &other)
+  {
+    mp_lvalue = 0;
+    m_rvalue.swap (other);
+  }
+
   inline tl::Variant make_result ()
   {
     if (mp_lvalue != 0) {
@@ -395,6 +401,147 @@ public:
 
 ArrayClass ArrayClass::instance;
 
+// ----------------------------------------------------------------------------
+//  ExpressionProgram: the bytecode representation of an expression
+
+/**
+ *  @brief The bytecode program of a compiled expression
+ *
+ *  The program is a flat list of instructions working on a stack of EvalTarget
+ *  objects. Nodes which don't provide a compiled form are executed through the
+ *  tree walker ("op_node"). Binary and unary operators provide typed fast paths
+ *  for long and double arguments and fall back to the node's implementation
+ *  otherwise.
+ */
+class ExpressionProgram
+{
+public:
+  enum OpCode
+  {
+    op_const,         //  pushes constant #arg
+    op_rvar,          //  pushes the value of variable "var"
+    op_lvar,          //  pushes a reference to variable "var"
+    op_node,          //  executes "node" with the tree walker and pushes the result
+    op_pop,           //  drops the top value
+    op_jump,          //  jumps to "arg"
+    op_jump_unless,   //  pops the top value and jumps to "arg" unless it is true
+    op_and,           //  jumps to "arg" keeping the top value if it is false, otherwise pops it
+    op_or,            //  jumps to "arg" keeping the top value if it is true, otherwise pops it
+    op_binary,        //  applies the binary operator "node" to the two top values (or the top value and constant #arg)
+    op_add, op_sub, op_mul, op_div, op_mod, op_lt, op_le, op_gt, op_ge, op_eq, op_ne,
+    op_unary,         //  applies the unary operator "node" to the top value
+    op_neg, op_not,
+    op_call,          //  calls the function "node" with "arg" arguments from the stack
+    op_method         //  calls the method "node" with "arg" arguments on the object below them
+  };
+
+  struct Instruction
+  {
+    Instruction (OpCode _op, const ExpressionNode *_node, tl::Variant *_var, size_t _arg, bool _const_arg)
+      : op (_op), const_arg (_const_arg), node (_node), var (_var), arg (_arg)
+    { }
+
+    OpCode op;
+    bool const_arg;
+    const ExpressionNode *node;
+    tl::Variant *var;
+    size_t arg;
+  };
+
+  ExpressionProgram ()
+    : m_depth (0), m_max_depth (0)
+  {
+    //  .. nothing yet ..
+  }
+
+  void emit_const (const tl::Variant &value)
+  {
+    m_constants.push_back (value);
+    emit (op_const, 0, 0, m_constants.size () - 1);
+  }
+
+  void emit_var (const tl::Variant *var, bool lvalue)
+  {
+    emit (lvalue ? op_lvar : op_rvar, 0, const_cast<tl::Variant *> (var), 0);
+  }
+
+  void emit_node (const ExpressionNode *node)
+  {
+    emit (op_node, node, 0, 0);
+  }
+
+  /**
+   *  @brief Emits a binary operator whose second argument is the given constant
+   */
+  void emit_binary_with_const (OpCode op, const ExpressionNode *node, const tl::Variant &value)
+  {
+    m_constants.push_back (value);
+    m_code.push_back (Instruction (op, node, 0, m_constants.size () - 1, true));
+  }
+
+  size_t emit (OpCode op, const ExpressionNode *node, tl::Variant *var, size_t arg)
+  {
+    switch (op) {
+    case op_const:
+    case op_rvar:
+    case op_lvar:
+    case op_node:
+      ++m_depth;
+      break;
+    case op_call:
+      m_depth = m_depth + 1 - arg;
+      break;
+    case op_method:
+      m_depth -= arg;
+      break;
+    case op_jump:
+    case op_unary:
+    case op_neg:
+    case op_not:
+      break;
+    default:
+      //  NOTE: op_and and op_or keep the value if they jump. In this case, the stack depth
+      //  at the target is the same than after the alternative branch.
+      --m_depth;
+      break;
+    }
+
+    m_max_depth = std::max (m_max_depth, m_depth);
+
+    m_code.push_back (Instruction (op, node, var, arg, false));
+    return m_code.size () - 1;
+  }
+
+  size_t pc () const
+  {
+    return m_code.size ();
+  }
+
+  void set_jump_target (size_t at, size_t target)
+  {
+    m_code [at].arg = target;
+  }
+
+  size_t depth () const
+  {
+    return m_depth;
+  }
+
+  void set_depth (size_t d)
+  {
+    m_depth = d;
+  }
+
+  void execute (EvalTarget &out) const;
+
+private:
+  std::vector<Instruction> m_code;
+  std::vector<tl::Variant> m_constants;
+  size_t m_depth, m_max_depth;
+
+  void run (EvalTarget *stack, EvalTarget &out) const;
+};
+
 // ----------------------------------------------------------------------------
 //  ExpressionNode implementation
 
@@ -435,6 +582,159 @@ ExpressionNode::add_child (ExpressionNode *node)
   m_c.push_back (node);
 }
 
+void
+ExpressionNode::compile (ExpressionProgram &program) const
+{
+  program.emit_node (this);
+}
+
+bool
+ExpressionNode::is_constant () const
+{
+  return false;
+}
+
+/**
+ *  @brief Evaluates a constant node at compile time
+ *  Returns false if the evaluation fails. In that case, the node needs to be compiled
+ *  regularly, so the error is reported at execution time.
+ */
+static bool
+eval_constant (const ExpressionNode *node, tl::Variant &value)
+{
+  try {
+    EvalTarget v;
+    node->execute (v);
+    value = *v;
+    return true;
+  } catch (...) {
+    return false;
+  }
+}
+
+/**
+ *  @brief Evaluates a constant node at compile time and emits the result
+ */
+static bool
+fold_constant (const ExpressionNode *node, ExpressionProgram &program)
+{
+  tl::Variant value;
+  if (eval_constant (node, value)) {
+    program.emit_const (value);
+    return true;
+  } else {
+    return false;
+  }
+}
+
+/**
+ *  @brief A base class for binary operator nodes
+ *
+ *  The operation itself is implemented by "apply". This way, the compiled form
+ *  can use the operation on values taken from the stack.
+ */
+class TL_PUBLIC BinaryExpressionNode
+  : public ExpressionNode
+{
+public:
+  BinaryExpressionNode (const ExpressionParserContext &context, ExpressionNode *a, ExpressionNode *b)
+    : ExpressionNode (context, 2)
+  {
+    add_child (a);
+    add_child (b);
+  }
+
+  BinaryExpressionNode (const BinaryExpressionNode &other, const tl::Expression *expr)
+    : ExpressionNode (other, expr)
+  {
+    //  .. nothing yet ..
+  }
+
+  void execute (EvalTarget &v) const
+  {
+    EvalTarget b;
+    m_c[0]->execute (v);
+    m_c[1]->execute (b);
+    apply (v, b);
+  }
+
+  void compile (ExpressionProgram &program) const
+  {
+    if (is_constant () && fold_constant (this, program)) {
+      return;
+    }
+    m_c[0]->compile (program);
+
+    //  constant second arguments are taken from the program directly
+    tl::Variant value;
+    if (m_c[1]->is_constant () && eval_constant (m_c[1], value)) {
+      program.emit_binary_with_const (op_code (), this, value);
+    } else {
+      m_c[1]->compile (program);
+      program.emit (op_code (), this, 0, 0);
+    }
+  }
+
+  bool is_constant () const
+  {
+    return m_c[0]->is_constant () && m_c[1]->is_constant ();
+  }
+
+  virtual void apply (EvalTarget &v, EvalTarget &b) const = 0;
+
+  virtual ExpressionProgram::OpCode op_code () const
+  {
+    return ExpressionProgram::op_binary;
+  }
+};
+
+/**
+ *  @brief A base class for unary operator nodes
+ */
+class TL_PUBLIC UnaryExpressionNode
+  : public ExpressionNode
+{
+public:
+  UnaryExpressionNode (const ExpressionParserContext &context, ExpressionNode *a)
+    : ExpressionNode (context, 1)
+  {
+    add_child (a);
+  }
+
+  UnaryExpressionNode (const UnaryExpressionNode &other, const tl::Expression *expr)
+    : ExpressionNode (other, expr)
+  {
+    //  .. nothing yet ..
+  }
+
+  void execute (EvalTarget &v) const
+  {
+    m_c[0]->execute (v);
+    apply (v);
+  }
+
+  void compile (ExpressionProgram &program) const
+  {
+    if (is_constant () && fold_constant (this, program)) {
+      return;
+    }
+    m_c[0]->compile (program);
+    program.emit (op_code (), this, 0, 0);
+  }
+
+  bool is_constant () const
+  {
+    return m_c[0]->is_constant ();
+  }
+
+  virtual void apply (EvalTarget &v) const = 0;
+
+  virtual ExpressionProgram::OpCode op_code () const
+  {
+    return ExpressionProgram::op_unary;
+  }
+};
+
 // ----------------------------------------------------------------------------
 //  ExpressionNode implementations for some binary operators
 
@@ -480,18 +780,17 @@ public:
  *  @brief Less operator node
  */
 class TL_PUBLIC LessExpressionNode
-  : public ExpressionNode
+  : public BinaryExpressionNode
 {
 public:
   LessExpressionNode (const ExpressionParserContext &context, ExpressionNode *a, ExpressionNode *b)
-    : ExpressionNode (context, 2)
+    : BinaryExpressionNode (context, a, b)
   {
-    add_child (a);
-    add_child (b);
+    //  .. nothing yet ..
   }
 
   LessExpressionNode (const LessExpressionNode &other, const tl::Expression *expr)
-    : ExpressionNode (other, expr)
+    : BinaryExpressionNode (other, expr)
   {
     //  .. nothing yet ..
   }
@@ -501,12 +800,13 @@ public:
     return new LessExpressionNode (*this, expr);
   }
 
-  void execute (EvalTarget &v) const 
+  ExpressionProgram::OpCode op_code () const
   {
-    EvalTarget b;
-    m_c[0]->execute (v);
-    m_c[1]->execute (b);
+    return ExpressionProgram::op_lt;
+  }
 
+  void apply (EvalTarget &v, EvalTarget &b) const
+  {
     if (v->is_user ()) {
 
       const EvalClass *c = v->user_cls () ? v->user_cls ()->eval_cls () : 0;
@@ -530,18 +830,17 @@ public:
  *  @brief Less or equal operator node
  */
 class TL_PUBLIC LessOrEqualExpressionNode
-  : public ExpressionNode
+  : public BinaryExpressionNode
 {
 public:
   LessOrEqualExpressionNode (const ExpressionParserContext &context, ExpressionNode *a, ExpressionNode *b)
-    : ExpressionNode (context, 2)
+    : BinaryExpressionNode (context, a, b)
   {
-    add_child (a);
-    add_child (b);
+    //  .. nothing yet ..
   }
 
   LessOrEqualExpressionNode (const LessOrEqualExpressionNode &other, const tl::Expression *expr)
-    : ExpressionNode (other, expr)
+    : BinaryExpressionNode (other, expr)
   {
     //  .. nothing yet ..
   }
@@ -551,12 +850,13 @@ public:
     return new LessOrEqualExpressionNode (*this, expr);
   }
 
-  void execute (EvalTarget &v) const 
+  ExpressionProgram::OpCode op_code () const
   {
-    EvalTarget b;
-    m_c[0]->execute (v);
-    m_c[1]->execute (b);
+    return ExpressionProgram::op_le;
+  }
 
+  void apply (EvalTarget &v, EvalTarget &b) const
+  {
     if (v->is_user ()) {
 
       const EvalClass *c = v->user_cls () ? v->user_cls ()->eval_cls () : 0;
@@ -580,18 +880,17 @@ public:
  *  @brief Greater operator node
  */
 class TL_PUBLIC GreaterExpressionNode
-  : public ExpressionNode
+  : public BinaryExpressionNode
 {
 public:
   GreaterExpressionNode (const ExpressionParserContext &context, ExpressionNode *a, ExpressionNode *b)
-    : ExpressionNode (context, 2)
+    : BinaryExpressionNode (context, a, b)
   {
-    add_child (a);
-    add_child (b);
+    //  .. nothing yet ..
   }
 
   GreaterExpressionNode (const GreaterExpressionNode &other, const tl::Expression *expr)
-    : ExpressionNode (other, expr)
+    : BinaryExpressionNode (other, expr)
   {
     //  .. nothing yet ..
   }
@@ -601,12 +900,13 @@ public:
     return new GreaterExpressionNode (*this, expr);
   }
 
-  void execute (EvalTarget &v) const 
+  ExpressionProgram::OpCode op_code () const
   {
-    EvalTarget b;
-    m_c[0]->execute (v);
-    m_c[1]->execute (b);
+    return ExpressionProgram::op_gt;
+  }
 
+  void apply (EvalTarget &v, EvalTarget &b) const
+  {
     if (v->is_user ()) {
 
       const EvalClass *c = v->user_cls () ? v->user_cls ()->eval_cls () : 0;
@@ -630,18 +930,17 @@ public:
  *  @brief Greater or equal operator node
  */
 class TL_PUBLIC GreaterOrEqualExpressionNode
-  : public ExpressionNode
+  : public BinaryExpressionNode
 {
 public:
   GreaterOrEqualExpressionNode (const ExpressionParserContext &context, ExpressionNode *a, ExpressionNode *b)
-    : ExpressionNode (context, 2)
+    : BinaryExpressionNode (context, a, b)
   {
-    add_child (a);
-    add_child (b);
+    //  .. nothing yet ..
   }
 
   GreaterOrEqualExpressionNode (const GreaterOrEqualExpressionNode &other, const tl::Expression *expr)
-    : ExpressionNode (other, expr)
+    : BinaryExpressionNode (other, expr)
   {
     //  .. nothing yet ..
   }
@@ -651,12 +950,13 @@ public:
     return new GreaterOrEqualExpressionNode (*this, expr);
   }
 
-  void execute (EvalTarget &v) const 
+  ExpressionProgram::OpCode op_code () const
   {
-    EvalTarget b;
-    m_c[0]->execute (v);
-    m_c[1]->execute (b);
+    return ExpressionProgram::op_ge;
+  }
 
+  void apply (EvalTarget &v, EvalTarget &b) const
+  {
     if (v->is_user ()) {
 
       const EvalClass *c = v->user_cls () ? v->user_cls ()->eval_cls () : 0;
@@ -680,18 +980,17 @@ public:
  *  @brief Equal operator node
  */
 class TL_PUBLIC EqualExpressionNode
-  : public ExpressionNode
+  : public BinaryExpressionNode
 {
 public:
   EqualExpressionNode (const ExpressionParserContext &context, ExpressionNode *a, ExpressionNode *b)
-    : ExpressionNode (context, 2)
+    : BinaryExpressionNode (context, a, b)
   {
-    add_child (a);
-    add_child (b);
+    //  .. nothing yet ..
   }
 
   EqualExpressionNode (const EqualExpressionNode &other, const tl::Expression *expr)
-    : ExpressionNode (other, expr)
+    : BinaryExpressionNode (other, expr)
   {
     //  .. nothing yet ..
   }
@@ -701,12 +1000,13 @@ public:
     return new EqualExpressionNode (*this, expr);
   }
 
-  void execute (EvalTarget &v) const 
+  ExpressionProgram::OpCode op_code () const
   {
-    EvalTarget b;
-    m_c[0]->execute (v);
-    m_c[1]->execute (b);
+    return ExpressionProgram::op_eq;
+  }
 
+  void apply (EvalTarget &v, EvalTarget &b) const
+  {
     if (v->is_user ()) {
 
       const EvalClass *c = v->user_cls () ? v->user_cls ()->eval_cls () : 0;
@@ -730,18 +1030,17 @@ public:
  *  @brief Not equal operator node
  */
 class TL_PUBLIC NotEqualExpressionNode
-  : public ExpressionNode
+  : public BinaryExpressionNode
 {
 public:
   NotEqualExpressionNode (const ExpressionParserContext &context, ExpressionNode *a, ExpressionNode *b)
-    : ExpressionNode (context, 2)
+    : BinaryExpressionNode (context, a, b)
   {
-    add_child (a);
-    add_child (b);
+    //  .. nothing yet ..
   }
 
   NotEqualExpressionNode (const NotEqualExpressionNode &other, const tl::Expression *expr)
-    : ExpressionNode (other, expr)
+    : BinaryExpressionNode (other, expr)
   {
     //  .. nothing yet ..
   }
@@ -751,12 +1050,13 @@ public:
     return new NotEqualExpressionNode (*this, expr);
   }
 
-  void execute (EvalTarget &v) const 
+  ExpressionProgram::OpCode op_code () const
   {
-    EvalTarget b;
-    m_c[0]->execute (v);
-    m_c[1]->execute (b);
+    return ExpressionProgram::op_ne;
+  }
 
+  void apply (EvalTarget &v, EvalTarget &b) const
+  {
     if (v->is_user ()) {
 
       const EvalClass *c = v->user_cls () ? v->user_cls ()->eval_cls () : 0;
@@ -963,6 +1263,22 @@ public:
       }
     }
   }
+
+  void compile (ExpressionProgram &program) const
+  {
+    if (is_constant () && fold_constant (this, program)) {
+      return;
+    }
+    m_c[0]->compile (program);
+    size_t j = program.emit (ExpressionProgram::op_and, this, 0, 0);
+    m_c[1]->compile (program);
+    program.set_jump_target (j, program.pc ());
+  }
+
+  bool is_constant () const
+  {
+    return m_c[0]->is_constant () && m_c[1]->is_constant ();
+  }
 };
 
 /**
@@ -1004,6 +1320,22 @@ public:
       }
     }
   }
+
+  void compile (ExpressionProgram &program) const
+  {
+    if (is_constant () && fold_constant (this, program)) {
+      return;
+    }
+    m_c[0]->compile (program);
+    size_t j = program.emit (ExpressionProgram::op_or, this, 0, 0);
+    m_c[1]->compile (program);
+    program.set_jump_target (j, program.pc ());
+  }
+
+  bool is_constant () const
+  {
+    return m_c[0]->is_constant () && m_c[1]->is_constant ();
+  }
 };
 
 /**
@@ -1042,24 +1374,44 @@ public:
       m_c[2]->execute (v);
     }
   }
+
+  void compile (ExpressionProgram &program) const
+  {
+    if (is_constant () && fold_constant (this, program)) {
+      return;
+    }
+    m_c[0]->compile (program);
+    size_t jc = program.emit (ExpressionProgram::op_jump_unless, this, 0, 0);
+    size_t d = program.depth ();
+    m_c[1]->compile (program);
+    size_t jb = program.emit (ExpressionProgram::op_jump, this, 0, 0);
+    program.set_jump_target (jc, program.pc ());
+    program.set_depth (d);
+    m_c[2]->compile (program);
+    program.set_jump_target (jb, program.pc ());
+  }
+
+  bool is_constant () const
+  {
+    return m_c[0]->is_constant () && m_c[1]->is_constant () && m_c[2]->is_constant ();
+  }
 };
 
 /**
  *  @brief Shift left expression node
  */
 class TL_PUBLIC ShiftLeftExpressionNode
-  : public ExpressionNode
+  : public BinaryExpressionNode
 {
 public:
   ShiftLeftExpressionNode (const ExpressionParserContext &context, ExpressionNode *a, ExpressionNode *b)
-    : ExpressionNode (context, 2)
+    : BinaryExpressionNode (context, a, b)
   {
-    add_child (a);
-    add_child (b);
+    //  .. nothing yet ..
   }
 
   ShiftLeftExpressionNode (const ShiftLeftExpressionNode &other,const tl::Expression *expr)
-    : ExpressionNode (other, expr)
+    : BinaryExpressionNode (other, expr)
   {
     //  .. nothing yet ..
   }
@@ -1069,12 +1421,8 @@ public:
     return new ShiftLeftExpressionNode (*this, expr);
   }
 
-  void execute (EvalTarget &v) const 
+  void apply (EvalTarget &v, EvalTarget &b) const
   {
-    EvalTarget b;
-    m_c[0]->execute (v);
-    m_c[1]->execute (b);
-
     if (v->is_user ()) {
 
       const EvalClass *c = v->user_cls () ? v->user_cls ()->eval_cls () : 0;
@@ -1104,33 +1452,28 @@ public:
  *  @brief Shift right expression node
  */
 class TL_PUBLIC ShiftRightExpressionNode
-  : public ExpressionNode
+  : public BinaryExpressionNode
 {
 public:
   ShiftRightExpressionNode (const ExpressionParserContext &context, ExpressionNode *a, ExpressionNode *b)
-    : ExpressionNode (context, 2)
+    : BinaryExpressionNode (context, a, b)
   {
-    add_child (a);
-    add_child (b);
+    //  .. nothing yet ..
   }
 
   ShiftRightExpressionNode (const ShiftRightExpressionNode &other, const tl::Expression *expr)
-    : ExpressionNode (other, expr)
+    : BinaryExpressionNode (other, expr)
   {
     //  .. nothing yet ..
   }
 
   ExpressionNode *clone (const tl::Expression *expr) const 
-  {
-    return new ShiftRightExpressionNode (*this, expr);
-  }
-
-  void execute (EvalTarget &v) const 
-  {
-    EvalTarget b;
-    m_c[0]->execute (v);
-    m_c[1]->execute (b);
+  {
+    return new ShiftRightExpressionNode (*this, expr);
+  }
 
+  void apply (EvalTarget &v, EvalTarget &b) const
+  {
     if (v->is_user ()) {
 
       const EvalClass *c = v->user_cls () ? v->user_cls ()->eval_cls () : 0;
@@ -1160,18 +1503,17 @@ public:
  *  @brief Plus expression node
  */
 class TL_PUBLIC PlusExpressionNode
-  : public ExpressionNode
+  : public BinaryExpressionNode
 {
 public:
   PlusExpressionNode (const ExpressionParserContext &context, ExpressionNode *a, ExpressionNode *b)
-    : ExpressionNode (context, 2)
+    : BinaryExpressionNode (context, a, b)
   {
-    add_child (a);
-    add_child (b);
+    //  .. nothing yet ..
   }
 
   PlusExpressionNode (const PlusExpressionNode &other, const tl::Expression *expr)
-    : ExpressionNode (other, expr)
+    : BinaryExpressionNode (other, expr)
   {
     //  .. nothing yet ..
   }
@@ -1181,12 +1523,13 @@ public:
     return new PlusExpressionNode (*this, expr);
   }
 
-  void execute (EvalTarget &v) const 
+  ExpressionProgram::OpCode op_code () const
   {
-    EvalTarget b;
-    m_c[0]->execute (v);
-    m_c[1]->execute (b);
+    return ExpressionProgram::op_add;
+  }
 
+  void apply (EvalTarget &v, EvalTarget &b) const
+  {
     if (v->is_user ()) {
 
       const EvalClass *c = v->user_cls () ? v->user_cls ()->eval_cls () : 0;
@@ -1222,18 +1565,17 @@ public:
  *  @brief Minus expression node
  */
 class TL_PUBLIC MinusExpressionNode
-  : public ExpressionNode
+  : public BinaryExpressionNode
 {
 public:
   MinusExpressionNode (const ExpressionParserContext &context, ExpressionNode *a, ExpressionNode *b)
-    : ExpressionNode (context, 2)
+    : BinaryExpressionNode (context, a, b)
   {
-    add_child (a);
-    add_child (b);
+    //  .. nothing yet ..
   }
 
   MinusExpressionNode (const MinusExpressionNode &other, const tl::Expression *expr)
-    : ExpressionNode (other, expr)
+    : BinaryExpressionNode (other, expr)
   {
     //  .. nothing yet ..
   }
@@ -1243,12 +1585,13 @@ public:
     return new MinusExpressionNode (*this, expr);
   }
 
-  void execute (EvalTarget &v) const 
+  ExpressionProgram::OpCode op_code () const
   {
-    EvalTarget b;
-    m_c[0]->execute (v);
-    m_c[1]->execute (b);
+    return ExpressionProgram::op_sub;
+  }
 
+  void apply (EvalTarget &v, EvalTarget &b) const
+  {
     if (v->is_user ()) {
 
       const EvalClass *c = v->user_cls () ? v->user_cls ()->eval_cls () : 0;
@@ -1282,18 +1625,17 @@ public:
  *  @brief Star expression node
  */
 class TL_PUBLIC StarExpressionNode
-  : public ExpressionNode
+  : public BinaryExpressionNode
 {
 public:
   StarExpressionNode (const ExpressionParserContext &context, ExpressionNode *a, ExpressionNode *b)
-    : ExpressionNode (context, 2)
+    : BinaryExpressionNode (context, a, b)
   {
-    add_child (a);
-    add_child (b);
+    //  .. nothing yet ..
   }
 
   StarExpressionNode (const StarExpressionNode &other, const tl::Expression *expr)
-    : ExpressionNode (other, expr)
+    : BinaryExpressionNode (other, expr)
   {
     //  .. nothing yet ..
   }
@@ -1303,12 +1645,13 @@ public:
     return new StarExpressionNode (*this, expr);
   }
 
-  void execute (EvalTarget &v) const 
+  ExpressionProgram::OpCode op_code () const
   {
-    EvalTarget b;
-    m_c[0]->execute (v);
-    m_c[1]->execute (b);
+    return ExpressionProgram::op_mul;
+  }
 
+  void apply (EvalTarget &v, EvalTarget &b) const
+  {
     if (v->is_user ()) {
 
       const EvalClass *c = v->user_cls () ? v->user_cls ()->eval_cls () : 0;
@@ -1372,18 +1715,17 @@ public:
  *  @brief Slash expression node
  */
 class TL_PUBLIC SlashExpressionNode
-  : public ExpressionNode
+  : public BinaryExpressionNode
 {
 public:
   SlashExpressionNode (const ExpressionParserContext &context, ExpressionNode *a, ExpressionNode *b)
-    : ExpressionNode (context, 2)
+    : BinaryExpressionNode (context, a, b)
   {
-    add_child (a);
-    add_child (b);
+    //  .. nothing yet ..
   }
 
   SlashExpressionNode (const SlashExpressionNode &other, const tl::Expression *expr)
-    : ExpressionNode (other, expr)
+    : BinaryExpressionNode (other, expr)
   {
     //  .. nothing yet ..
   }
@@ -1393,12 +1735,13 @@ public:
     return new SlashExpressionNode (*this, expr);
   }
 
-  void execute (EvalTarget &v) const 
+  ExpressionProgram::OpCode op_code () const
   {
-    EvalTarget b;
-    m_c[0]->execute (v);
-    m_c[1]->execute (b);
+    return ExpressionProgram::op_div;
+  }
 
+  void apply (EvalTarget &v, EvalTarget &b) const
+  {
     if (v->is_user ()) {
 
       const EvalClass *c = v->user_cls () ? v->user_cls ()->eval_cls () : 0;
@@ -1456,18 +1799,17 @@ public:
  *  @brief Percent expression node
  */
 class TL_PUBLIC PercentExpressionNode
-  : public ExpressionNode
+  : public BinaryExpressionNode
 {
 public:
   PercentExpressionNode (const ExpressionParserContext &context, ExpressionNode *a, ExpressionNode *b)
-    : ExpressionNode (context, 2)
+    : BinaryExpressionNode (context, a, b)
   {
-    add_child (a);
-    add_child (b);
+    //  .. nothing yet ..
   }
 
   PercentExpressionNode (const PercentExpressionNode &other, const tl::Expression *expr)
-    : ExpressionNode (other, expr)
+    : BinaryExpressionNode (other, expr)
   {
     //  .. nothing yet ..
   }
@@ -1477,12 +1819,13 @@ public:
     return new PercentExpressionNode (*this, expr);
   }
 
-  void execute (EvalTarget &v) const 
+  ExpressionProgram::OpCode op_code () const
   {
-    EvalTarget b;
-    m_c[0]->execute (v);
-    m_c[1]->execute (b);
+    return ExpressionProgram::op_mod;
+  }
 
+  void apply (EvalTarget &v, EvalTarget &b) const
+  {
     if (v->is_user ()) {
 
       const EvalClass *c = v->user_cls () ? v->user_cls ()->eval_cls () : 0;
@@ -1528,18 +1871,17 @@ public:
  *  @brief Ampersand expression node
  */
 class TL_PUBLIC AmpersandExpressionNode
-  : public ExpressionNode
+  : public BinaryExpressionNode
 {
 public:
   AmpersandExpressionNode (const ExpressionParserContext &context, ExpressionNode *a, ExpressionNode *b)
-    : ExpressionNode (context, 2)
+    : BinaryExpressionNode (context, a, b)
   {
-    add_child (a);
-    add_child (b);
+    //  .. nothing yet ..
   }
 
   AmpersandExpressionNode (const AmpersandExpressionNode &other, const tl::Expression *expr)
-    : ExpressionNode (other, expr)
+    : BinaryExpressionNode (other, expr)
   {
     //  .. nothing yet ..
   }
@@ -1549,12 +1891,8 @@ public:
     return new AmpersandExpressionNode (*this, expr);
   }
 
-  void execute (EvalTarget &v) const 
+  void apply (EvalTarget &v, EvalTarget &b) const
   {
-    EvalTarget b;
-    m_c[0]->execute (v);
-    m_c[1]->execute (b);
-
     if (v->is_user ()) {
 
       const EvalClass *c = v->user_cls () ? v->user_cls ()->eval_cls () : 0;
@@ -1584,18 +1922,17 @@ public:
  *  @brief Pipe expression node
  */
 class TL_PUBLIC PipeExpressionNode
-  : public ExpressionNode
+  : public BinaryExpressionNode
 {
 public:
   PipeExpressionNode (const ExpressionParserContext &context, ExpressionNode *a, ExpressionNode *b)
-    : ExpressionNode (context, 2)
+    : BinaryExpressionNode (context, a, b)
   {
-    add_child (a);
-    add_child (b);
+    //  .. nothing yet ..
   }
 
   PipeExpressionNode (const PipeExpressionNode &other, const tl::Expression *expr)
-    : ExpressionNode (other, expr)
+    : BinaryExpressionNode (other, expr)
   {
     //  .. nothing yet ..
   }
@@ -1605,12 +1942,8 @@ public:
     return new PipeExpressionNode (*this, expr);
   }
 
-  void execute (EvalTarget &v) const 
+  void apply (EvalTarget &v, EvalTarget &b) const
   {
-    EvalTarget b;
-    m_c[0]->execute (v);
-    m_c[1]->execute (b);
-
     if (v->is_user ()) {
 
       const EvalClass *c = v->user_cls () ? v->user_cls ()->eval_cls () : 0;
@@ -1640,18 +1973,17 @@ public:
  *  @brief Acute expression node
  */
 class TL_PUBLIC AcuteExpressionNode
-  : public ExpressionNode
+  : public BinaryExpressionNode
 {
 public:
   AcuteExpressionNode (const ExpressionParserContext &context, ExpressionNode *a, ExpressionNode *b)
-    : ExpressionNode (context, 2)
+    : BinaryExpressionNode (context, a, b)
   {
-    add_child (a);
-    add_child (b);
+    //  .. nothing yet ..
   }
 
   AcuteExpressionNode (const AcuteExpressionNode &other, const tl::Expression *expr)
-    : ExpressionNode (other, expr)
+    : BinaryExpressionNode (other, expr)
   {
     //  .. nothing yet ..
   }
@@ -1661,12 +1993,8 @@ public:
     return new AcuteExpressionNode (*this, expr);
   }
 
-  void execute (EvalTarget &v) const 
+  void apply (EvalTarget &v, EvalTarget &b) const
   {
-    EvalTarget b;
-    m_c[0]->execute (v);
-    m_c[1]->execute (b);
-
     if (v->is_user ()) {
 
       const EvalClass *c = v->user_cls () ? v->user_cls ()->eval_cls () : 0;
@@ -1778,17 +2106,17 @@ public:
  *  @brief Unary minus expression node
  */
 class TL_PUBLIC UnaryMinusExpressionNode
-  : public ExpressionNode
+  : public UnaryExpressionNode
 {
 public:
   UnaryMinusExpressionNode (const ExpressionParserContext &context, ExpressionNode *a)
-    : ExpressionNode (context, 1)
+    : UnaryExpressionNode (context, a)
   {
-    add_child (a);
+    //  .. nothing yet ..
   }
 
   UnaryMinusExpressionNode (const UnaryMinusExpressionNode &other, const tl::Expression *expr)
-    : ExpressionNode (other, expr)
+    : UnaryExpressionNode (other, expr)
   {
     //  .. nothing yet ..
   }
@@ -1798,10 +2126,13 @@ public:
     return new UnaryMinusExpressionNode (*this, expr);
   }
 
-  void execute (EvalTarget &v) const 
+  ExpressionProgram::OpCode op_code () const
   {
-    m_c[0]->execute (v);
+    return ExpressionProgram::op_neg;
+  }
 
+  void apply (EvalTarget &v) const
+  {
     if (v->is_user ()) {
 
       throw EvalError (tl::to_string (tr ("Unary minus not implemented for objects")), m_context);
@@ -1835,17 +2166,17 @@ public:
  *  @brief Unary tilde expression node
  */
 class TL_PUBLIC UnaryTildeExpressionNode
-  : public ExpressionNode
+  : public UnaryExpressionNode
 {
 public:
   UnaryTildeExpressionNode (const ExpressionParserContext &context, ExpressionNode *a)
-    : ExpressionNode (context, 1)
+    : UnaryExpressionNode (context, a)
   {
-    add_child (a);
+    //  .. nothing yet ..
   }
 
   UnaryTildeExpressionNode (const UnaryTildeExpressionNode &other, const tl::Expression *expr)
-    : ExpressionNode (other, expr)
+    : UnaryExpressionNode (other, expr)
   {
     //  .. nothing yet ..
   }
@@ -1855,10 +2186,8 @@ public:
     return new UnaryTildeExpressionNode (*this, expr);
   }
 
-  void execute (EvalTarget &v) const 
+  void apply (EvalTarget &v) const
   {
-    m_c[0]->execute (v);
-
     if (v->is_user ()) {
 
       throw EvalError (tl::to_string (tr ("Unary tilde not implemented for objects")), m_context);
@@ -1890,17 +2219,17 @@ public:
  *  @brief Unary not expression node
  */
 class TL_PUBLIC UnaryNotExpressionNode
-  : public ExpressionNode
+  : public UnaryExpressionNode
 {
 public:
   UnaryNotExpressionNode (const ExpressionParserContext &context, ExpressionNode *a)
-    : ExpressionNode (context, 1)
+    : UnaryExpressionNode (context, a)
   {
-    add_child (a);
+    //  .. nothing yet ..
   }
 
   UnaryNotExpressionNode (const UnaryNotExpressionNode &other, const tl::Expression *expr)
-    : ExpressionNode (other, expr)
+    : UnaryExpressionNode (other, expr)
   {
     //  .. nothing yet ..
   }
@@ -1910,10 +2239,13 @@ public:
     return new UnaryNotExpressionNode (*this, expr);
   }
 
-  void execute (EvalTarget &v) const 
+  ExpressionProgram::OpCode op_code () const
   {
-    m_c[0]->execute (v);
+    return ExpressionProgram::op_not;
+  }
 
+  void apply (EvalTarget &v) const
+  {
     if (v->is_user ()) {
       //  objects act as true
       v.set (false);
@@ -1952,6 +2284,17 @@ public:
     v.set (m_value);
   }
 
+  void compile (ExpressionProgram &program) const
+  {
+    program.emit_const (m_value);
+  }
+
+  bool is_constant () const
+  {
+    //  objects may be modified through method calls, hence they are not constant
+    return ! m_value.is_user ();
+  }
+
 private:
   tl::Variant m_value;
 };
@@ -2032,6 +2375,23 @@ public:
       vv.push_back (*a);
     }
 
+    call (v, vv);
+  }
+
+  void compile (ExpressionProgram &program) const
+  {
+    for (std::vector<ExpressionNode *>::const_iterator c = m_c.begin (); c != m_c.end (); ++c) {
+      (*c)->compile (program);
+    }
+    program.emit (ExpressionProgram::op_method, this, 0, m_c.size () - 1);
+  }
+
+  /**
+   *  @brief Calls the method on the object v with the given arguments
+   *  The result is stored in v.
+   */
+  void call (EvalTarget &v, std::vector<tl::Variant> &vv) const
+  {
     const EvalClass *c = 0;
     
     if (v->is_list ()) {
@@ -2159,6 +2519,20 @@ public:
       (*c)->execute (v);
     }
   }
+
+  void compile (ExpressionProgram &program) const
+  {
+    if (m_c.empty ()) {
+      program.emit_const (tl::Variant ());
+      return;
+    }
+    for (std::vector<ExpressionNode *>::const_iterator c = m_c.begin (); c != m_c.end (); ++c) {
+      if (c != m_c.begin ()) {
+        program.emit (ExpressionProgram::op_pop, this, 0, 0);
+      }
+      (*c)->compile (program);
+    }
+  }
 };
 
 /**
@@ -2196,6 +2570,22 @@ public:
       vv.push_back (*a);
     }
 
+    call (v, vv);
+  }
+
+  void compile (ExpressionProgram &program) const
+  {
+    for (std::vector<ExpressionNode *>::const_iterator c = m_c.begin (); c != m_c.end (); ++c) {
+      (*c)->compile (program);
+    }
+    program.emit (ExpressionProgram::op_call, this, 0, m_c.size ());
+  }
+
+  /**
+   *  @brief Calls the function with the given arguments and stores the result in v
+   */
+  void call (EvalTarget &v, const std::vector<tl::Variant> &vv) const
+  {
     tl::Variant o;
     mp_func->execute (m_context, o, vv);
     v.swap (o);
@@ -2234,6 +2624,11 @@ public:
     v.set (*mp_var);
   }
 
+  void compile (ExpressionProgram &program) const
+  {
+    program.emit_var (mp_var, false);
+  }
+
 private:
   const tl::Variant *mp_var;
 };
@@ -2267,10 +2662,249 @@ public:
     v.set_lvalue (mp_var);
   }
 
+  void compile (ExpressionProgram &program) const
+  {
+    program.emit_var (mp_var, true);
+  }
+
 private:
   tl::Variant *mp_var;
 };
 
+// ----------------------------------------------------------------------------
+//  ExpressionProgram implementation
+
+/**
+ *  @brief Drops the value of a stack slot
+ */
+inline void
+clear_slot (EvalTarget &t)
+{
+  //  resets both the reference and the value
+  t.set_lvalue (0);
+}
+
+/**
+ *  @brief Sets the value of a stack slot
+ */
+template <class T>
+inline void
+set_slot (EvalTarget &t, const T &value)
+{
+  tl::Variant v (value);
+  t.set_by_swap (v);
+}
+
+void
+ExpressionProgram::execute (EvalTarget &out) const
+{
+  //  small stacks are kept locally to avoid the allocation and initialization of unused slots
+  if (m_max_depth <= 4) {
+    EvalTarget stack [4];
+    run (stack, out);
+  } else if (m_max_depth <= 16) {
+    EvalTarget stack [16];
+    run (stack, out);
+  } else {
+    std::vector<EvalTarget> stack (m_max_depth);
+    run (&stack.front (), out);
+  }
+}
+
+void
+ExpressionProgram::run (EvalTarget *stack, EvalTarget &out) const
+{
+  size_t sp = 0;
+
+  for (size_t pc = 0; pc < m_code.size (); ) {
+
+    const Instruction &i = m_code [pc++];
+
+    switch (i.op) {
+
+    case op_const:
+      stack [sp++].set (m_constants [i.arg]);
+      break;
+
+    case op_rvar:
+      stack [sp++].set (*i.var);
+      break;
+
+    case op_lvar:
+      stack [sp++].set_lvalue (i.var);
+      break;
+
+    case op_node:
+      i.node->execute (stack [sp++]);
+      break;
+
+    case op_pop:
+      clear_slot (stack [--sp]);
+      break;
+
+    case op_jump:
+      pc = i.arg;
+      break;
+
+    case op_jump_unless:
+      {
+        bool c = stack [--sp]->to_bool ();
+        clear_slot (stack [sp]);
+        if (! c) {
+          pc = i.arg;
+        }
+      }
+      break;
+
+    case op_and:
+      {
+        const tl::Variant &a = *stack [sp - 1];
+        if (! a.is_user () && ! a.to_bool ()) {
+          pc = i.arg;
+        } else {
+          clear_slot (stack [--sp]);
+        }
+      }
+      break;
+
+    case op_or:
+      {
+        const tl::Variant &a = *stack [sp - 1];
+        if (a.is_user () || a.to_bool ()) {
+          pc = i.arg;
+        } else {
+          clear_slot (stack [--sp]);
+        }
+      }
+      break;
+
+    case op_neg:
+    case op_not:
+    case op_unary:
+      {
+        EvalTarget &a = stack [sp - 1];
+        const tl::Variant &x = *a;
+
+        if (i.op == op_neg && x.is_long ()) {
+          set_slot (a, -x.to_long ());
+        } else if (i.op == op_neg && x.is_double ()) {
+          set_slot (a, -x.to_double ());
+        } else if (i.op == op_not && ! x.is_user ()) {
+          set_slot (a, ! x.to_bool ());
+        } else {
+          static_cast<const UnaryExpressionNode *> (i.node)->apply (a);
+        }
+      }
+      break;
+
+    case op_call:
+      {
+        std::vector<tl::Variant> args;
+        args.reserve (i.arg);
+        for (EvalTarget *a = stack + sp - i.arg; a != stack + sp; ++a) {
+          args.push_back (**a);
+          clear_slot (*a);
+        }
+        sp -= i.arg;
+        static_cast<const StaticFunctionExpressionNode *> (i.node)->call (stack [sp++], args);
+      }
+      break;
+
+    case op_method:
+      {
+        std::vector<tl::Variant> args;
+        args.reserve (i.arg);
+        for (EvalTarget *a = stack + sp - i.arg; a != stack + sp; ++a) {
+          args.push_back (**a);
+          clear_slot (*a);
+        }
+        sp -= i.arg;
+        static_cast<const MethodExpressionNode *> (i.node)->call (stack [sp - 1], args);
+      }
+      break;
+
+    default:
+      {
+        //  binary operators: the second argument is either a constant or the top of the stack
+        EvalTarget &a = stack [i.const_arg ? sp - 1 : sp - 2];
+        const tl::Variant &x = *a;
+        const tl::Variant &y = i.const_arg ? m_constants [i.arg] : *stack [sp - 1];
+
+        bool done = true;
+
+        if (x.is_long () && y.is_long ()) {
+
+          long xl = x.to_long (), yl = y.to_long ();
+
+          switch (i.op) {
+          case op_add: set_slot (a, xl + yl); break;
+          case op_sub: set_slot (a, xl - yl); break;
+          case op_mul: set_slot (a, xl * yl); break;
+          case op_div: if (yl != 0) { set_slot (a, xl / yl); } else { done = false; } break;
+          case op_mod: if (yl != 0) { set_slot (a, xl % yl); } else { done = false; } break;
+          case op_lt: set_slot (a, xl < yl); break;
+          case op_le: set_slot (a, xl <= yl); break;
+          case op_gt: set_slot (a, xl > yl); break;
+          case op_ge: set_slot (a, xl >= yl); break;
+          case op_eq: set_slot (a, xl == yl); break;
+          case op_ne: set_slot (a, xl != yl); break;
+          default: done = false; break;
+          }
+
+        } else if ((x.is_double () || x.is_long ()) && (y.is_double () || y.is_long ())) {
+
+          //  NOTE: mixed integer/double arguments are computed and compared as doubles by the nodes too
+          double xd = x.to_double (), yd = y.to_double ();
+
+          switch (i.op) {
+          case op_add: set_slot (a, xd + yd); break;
+          case op_sub: set_slot (a, xd - yd); break;
+          case op_mul: set_slot (a, xd * yd); break;
+          case op_div: if (yd != 0.0) { set_slot (a, xd / yd); } else { done = false; } break;
+          case op_lt: set_slot (a, xd < yd); break;
+          case op_le: set_slot (a, xd <= yd); break;
+          case op_gt: set_slot (a, xd > yd); break;
+          case op_ge: set_slot (a, xd >= yd); break;
+          case op_eq: set_slot (a, xd == yd); break;
+          case op_ne: set_slot (a, xd != yd); break;
+          default: done = false; break;
+          }
+
+        } else {
+          done = false;
+        }
+
+        if (! done) {
+          const BinaryExpressionNode *node = static_cast<const BinaryExpressionNode *> (i.node);
+          if (i.const_arg) {
+            EvalTarget b;
+            b.set (y);
+            node->apply (a, b);
+          } else {
+            node->apply (a, stack [sp - 1]);
+          }
+        }
+
+        if (! i.const_arg) {
+          clear_slot (stack [--sp]);
+        }
+      }
+      break;
+
+    }
+
+  }
+
+  tl_assert (sp == 1);
+
+  EvalTarget &r = stack [0];
+  if (r.lvalue ()) {
+    out.set_lvalue (r.lvalue ());
+  } else {
+    out.set_by_swap (r.get ());
+  }
+}
+
 // ----------------------------------------------------------------------------
 //  Implementation of functions
 
@@ -3090,6 +3724,11 @@ Expression::Expression (Eval *eval, const char *expr)
   // .. nothing yet ..
 }
 
+Expression::~Expression ()
+{
+  //  needs to be implemented here because ExpressionProgram is not known in the header
+}
+
 Expression &
 Expression::operator= (const Expression &d)
 {
@@ -3102,10 +3741,25 @@ Expression::operator= (const Expression &d)
     } else {
       m_root.reset (0);
     }
+    m_program.reset (0);
+    if (d.is_compiled ()) {
+      compile ();
+    }
   }
   return *this;
 }
 
+void
+Expression::compile ()
+{
+  m_program.reset (0);
+  if (m_root.get ()) {
+    std::auto_ptr<ExpressionProgram> program (new ExpressionProgram ());
+    m_root->compile (*program);
+    m_program = program;
+  }
+}
+
 tl::Variant 
 Expression::execute () const
 {
@@ -3117,7 +3771,9 @@ Expression::execute () const
 void
 Expression::execute (EvalTarget &v) const
 {
-  if (m_root.get ()) {
+  if (m_program.get ()) {
+    m_program->execute (v);
+  } else if (m_root.get ()) {
     m_root->execute (v);
   } 
 }
@@ -43,6 +43,7 @@ class EvalTarget;
 class Expression;
 class ExpressionNode;
 class ExpressionParserContext;
+class ExpressionProgram;
 
 /**
  *  @brief An interface handling the evaluation context
@@ -198,6 +199,22 @@ public:
    */
   virtual ExpressionNode *clone (const tl::Expression *expr) const = 0;
 
+  /**
+   *  @brief Compiles the node into the given bytecode program
+   *
+   *  The default implementation emits an instruction which executes the node
+   *  through "execute".
+   */
+  virtual void compile (ExpressionProgram &program) const;
+
+  /**
+   *  @brief Returns true, if the node delivers a constant value
+   *
+   *  Constant nodes are evaluated at compile time. The value must not depend on
+   *  variables or functions and the evaluation must not have side effects.
+   */
+  virtual bool is_constant () const;
+
 protected:
   std::vector <ExpressionNode *> m_c;
   ExpressionParserContext m_context;
@@ -289,11 +306,35 @@ public:
    */
   Expression (const Expression &d);
 
+  /**
+   *  @brief Destructor
+   */
+  ~Expression ();
+
   /**
    *  @brief Assignment
    */
   Expression &operator= (const Expression &d);
 
+  /**
+   *  @brief Compiles the expression into a bytecode program
+   *
+   *  After compilation, the expression is executed by a stack machine rather than by
+   *  walking the expression tree. Constant sub-expressions are folded and
+   *  numeric operations use typed fast paths. Compilation is useful for expressions
+   *  which are executed many times. The results are identical to the uncompiled form.
+   *  Parsing the expression again will discard the compiled program.
+   */
+  void compile ();
+
+  /**
+   *  @brief Returns true, if the expression has been compiled
+   */
+  bool is_compiled () const
+  {
+    return m_program.get () != 0;
+  }
+
   /**
    *  @brief Execution of the expression
    */
@@ -332,6 +373,7 @@ private:
   const char *mp_text;
   std::string m_local_text;
   std::auto_ptr<ExpressionNode> m_root;
+  std::auto_ptr<ExpressionProgram> m_program;
   Eval *mp_eval;
 
   friend class Eval;
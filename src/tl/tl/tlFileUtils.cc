@@ -24,8 +24,10 @@
 #include "tlStream.h"
 #include "tlLog.h"
 #include "tlInternational.h"
+#include "tlException.h"
 
 #include <cctype>
+#include <cstdlib>
 
 #if defined(_MSC_VER)
 
@@ -440,6 +442,45 @@ bool rm_file (const std::string &path)
 #endif
 }
 
+std::string make_tmp_file (const std::string &prefix, const std::string &dir)
+{
+#if defined(_WIN32)
+  wchar_t tmp_dir [MAX_PATH];
+  wchar_t path [MAX_PATH];
+  if (dir.empty ()) {
+    if (GetTempPathW (MAX_PATH, tmp_dir) == 0) {
+      throw tl::Exception (tl::to_string (tr ("Unable to create temporary file")));
+    }
+  } else {
+    std::wstring wdir = tl::to_wstring (dir);
+    if (wdir.size () >= MAX_PATH) {
+      throw tl::Exception (tl::to_string (tr ("Unable to create temporary file in ")) + dir);
+    }
+    wcscpy (tmp_dir, wdir.c_str ());
+  }
+  if (GetTempFileNameW (tmp_dir, tl::to_wstring (prefix).c_str (), 0, path) == 0) {
+    throw tl::Exception (tl::to_string (tr ("Unable to create temporary file")));
+  }
+  return tl::to_string (std::wstring (path));
+#else
+  std::string tmp_dir = dir;
+  if (tmp_dir.empty ()) {
+    const char *tmpdir = getenv ("TMPDIR");
+    tmp_dir = tmpdir && *tmpdir ? tl::to_string_from_local (tmpdir) : std::string ("/tmp");
+  }
+  std::string tmpl = tl::combine_path (tmp_dir, prefix + "XXXXXX");
+  std::string tmpl_local = tl::to_local (tmpl);
+  std::vector<char> buffer (tmpl_local.begin (), tmpl_local.end ());
+  buffer.push_back (0);
+  int fd = mkstemp (&buffer.front ());
+  if (fd < 0) {
+    throw tl::Exception (tl::to_string (tr ("Unable to create temporary file: ")) + tmpl);
+  }
+  ::close (fd);
+  return tl::to_string_from_local (&buffer.front ());
+#endif
+}
+
 bool rm_dir (const std::string &path)
 {
 #if defined(_WIN32)
@@ -130,6 +130,14 @@ std::vector<std::string> TL_PUBLIC dir_entries (const std::string &s, bool with_
  */
 bool TL_PUBLIC rm_file (const std::string &path);
 
+/**
+ *  @brief Creates a new, empty temporary file and returns its path
+ *  The file is created in the given directory or in the system's temporary directory if
+ *  "dir" is empty. "prefix" is the initial part of the file name. An exception is thrown
+ *  if the file cannot be created. The caller is responsible for removing the file.
+ */
+std::string TL_PUBLIC make_tmp_file (const std::string &prefix, const std::string &dir = std::string ());
+
 /**
  *  @brief Removes the given directory and returns true on success
  */
@@ -869,7 +869,8 @@ InputPipe::InputPipe (const std::string &path)
 {
   std::wstring wpath = tl::to_wstring (path);
   m_source = path;
-  m_file = _wpopen (wpath.c_str (), L"r");
+  //  NOTE: binary mode, so the data is not subject to CR/LF translation (same as for files)
+  m_file = _wpopen (wpath.c_str (), L"rb");
   if (m_file == NULL) {
     throw FilePOpenErrorException (m_source, errno);
   }
@@ -924,7 +925,8 @@ OutputPipe::OutputPipe (const std::string &path)
 {
   std::wstring wpath = tl::to_wstring (path);
   m_source = path;
-  m_file = _wpopen (wpath.c_str (), L"w");
+  //  NOTE: binary mode, so the data is not subject to CR/LF translation (same as for files)
+  m_file = _wpopen (wpath.c_str (), L"wb");
   if (m_file == NULL) {
     throw FilePOpenErrorException (m_source, errno);
   }
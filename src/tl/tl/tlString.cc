@@ -592,6 +592,49 @@ to_quoted_string (const std::string &s)
   return r;
 }
 
+std::string
+to_shell_argument (const std::string &s)
+{
+  std::string r;
+  r.reserve (s.size () + 2);
+
+#if defined(_WIN32)
+
+  //  backslashes are literal unless they precede a double quote
+  r += '"';
+  size_t nbs = 0;
+  for (const char *c = s.c_str (); *c; ++c) {
+    if (*c == '\\') {
+      ++nbs;
+    } else {
+      if (*c == '"') {
+        r += std::string (nbs + 1, '\\');
+      }
+      nbs = 0;
+    }
+    r += *c;
+  }
+  //  trailing backslashes must not escape the closing quote
+  r += std::string (nbs, '\\');
+  r += '"';
+
+#else
+
+  r += '\'';
+  for (const char *c = s.c_str (); *c; ++c) {
+    if (*c == '\'') {
+      r += "'\\''";
+    } else {
+      r += *c;
+    }
+  }
+  r += '\'';
+
+#endif
+
+  return r;
+}
+
 std::string
 escape_string (const std::string &s)
 {
@@ -313,6 +313,15 @@ std::string TL_PUBLIC to_string (const std::wstring &ws);
  */  
 TL_PUBLIC std::string to_quoted_string (const std::string &s);
 
+/**
+ *  @brief Quotes a string so it is passed as a single argument through the system's shell
+ *
+ *  On Unix-like systems, the string is put into single quotes which suppress all
+ *  expansions. On Windows, the string is put into double quotes following the rules
+ *  of the C runtime's command line parser.
+ */
+TL_PUBLIC std::string to_shell_argument (const std::string &s);
+
 /**
  *  @brief Escape special characters in a string
  *
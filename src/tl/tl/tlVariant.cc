@@ -1071,7 +1071,70 @@ Variant::operator< (const tl::Variant &d) const
   }
 }
 
-bool 
+static inline size_t
+hash_combine (size_t h1, size_t h2)
+{
+  return (h1 << 4) ^ (h1 >> 4) ^ h2;
+}
+
+static inline size_t
+hash_bytes (const char *s)
+{
+  //  FNV-1a
+  size_t h = 2166136261u;
+  while (*s) {
+    h = (h ^ (unsigned char) *s++) * 16777619u;
+  }
+  return h;
+}
+
+size_t
+Variant::hash () const
+{
+  type t = normalized_type (m_type);
+
+  if (t == t_nil) {
+    return 0;
+  } else if (t == t_bool) {
+    return m_var.m_bool ? 1 : 2;
+  } else if (t == t_id) {
+    return hash_combine (size_t (t_id), m_var.m_id);
+  } else if (t == t_double || is_integer_type (t)) {
+    //  NOTE: integer and double values compare equal if the values are equal. Hence
+    //  we use the double representation for the hash value. -0.0 is normalized to 0.0.
+    double d = to_double ();
+    if (d == 0.0) {
+      return 3;
+    }
+    size_t h = 0;
+    const unsigned char *b = reinterpret_cast<const unsigned char *> (&d);
+    for (size_t i = 0; i < sizeof (d); ++i) {
+      h = hash_combine (h, b [i]);
+    }
+    return h;
+  } else if (t == t_list) {
+    size_t h = size_t (t_list);
+    for (std::vector<tl::Variant>::const_iterator i = m_var.m_list->begin (); i != m_var.m_list->end (); ++i) {
+      h = hash_combine (h, i->hash ());
+    }
+    return h;
+  } else if (t == t_array) {
+    size_t h = size_t (t_array);
+    for (std::map<tl::Variant, tl::Variant>::const_iterator i = m_var.m_array->begin (); i != m_var.m_array->end (); ++i) {
+      h = hash_combine (hash_combine (h, i->first.hash ()), i->second.hash ());
+    }
+    return h;
+  } else if (t == t_user) {
+    return size_t (m_var.mp_user.cls);
+  } else if (t == t_user_ref) {
+    return size_t (m_var.mp_user_ref.cls);
+  } else {
+    //  strings, QString, QByteArray
+    return hash_bytes (to_string ());
+  }
+}
+
+bool
 Variant::can_convert_to_float () const
 {
   switch (m_type) {
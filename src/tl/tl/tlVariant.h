@@ -599,6 +599,16 @@ public:
    */
   bool operator< (const Variant &d) const;
 
+  /**
+   *  @brief Computes a hash value
+   *
+   *  The hash value is compatible with operator==: variants which compare equal
+   *  deliver the same hash value. Specifically, numerical values are hashed by
+   *  their value, not by their type. For user types, the hash value is derived
+   *  from the class only.
+   */
+  size_t hash () const;
+
   /**
    *  @brief Conversion to a string
    *
@@ -24,6 +24,7 @@
 #include "tlExpression.h"
 #include "tlVariantUserClasses.h"
 #include "tlUnitTest.h"
+#include "tlTimer.h"
 
 #include <stdlib.h>
 #define _USE_MATH_DEFINES // for MSVC
@@ -1189,3 +1190,149 @@ TEST(19)
   v = e.parse ("# A comment\nvar i=CellInstArray.new(17,tr,a,b,100,200); i.to_s(); # A final comment").execute ();
   EXPECT_EQ (v.to_string (), std::string ("#17 r90 10,20 [1,2*100;11,22*200]"));
 }
+
+static std::string eval_to_string (const tl::Expression &expr)
+{
+  try {
+    return expr.execute ().to_parsable_string ();
+  } catch (tl::Exception &ex) {
+    return "ERROR: " + ex.msg ();
+  }
+}
+
+// compiled expressions
+TEST(20)
+{
+  tl::Eval e;
+  e.set_var ("i", tl::Variant (17));
+  e.set_var ("l", tl::Variant (-5l));
+  e.set_var ("d", tl::Variant (2.5));
+  e.set_var ("s", tl::Variant ("abc"));
+  e.set_var ("n", tl::Variant ());
+
+  const char *exprs[] = {
+    "1+2*3-4/2",
+    "7%4",
+    "i+l*2",
+    "i/0",
+    "i%0",
+    "d/0",
+    "i/3",
+    "-i",
+    "-d",
+    "-s",
+    "!i",
+    "!n",
+    "~i",
+    "i+d",
+    "d*l",
+    "i<d",
+    "i==17.0",
+    "i!=l",
+    "d>=2.5",
+    "i<=l",
+    "i>l",
+    "s+i",
+    "s*3",
+    "s<'abd'",
+    "i<<2",
+    "i>>1",
+    "i&3|4^1",
+    "i>10 && d<3",
+    "i>20 && d<3",
+    "n || 5",
+    "i || 5",
+    "i==17 ? 'yes' : 'no'",
+    "l>0 ? 'yes' : 'no'",
+    "i && s",
+    "false && error('not executed')",
+    "true || error('not executed')",
+    "1+2 ? 3*4 : 5/0",
+    "false ? 3*4 : 5/0",
+    "var x=i; x=x+1; x",
+    "var y=1; y=y*3; y",
+    "[1,2,3][i%3]",
+    "{'a'=>1,'b'=>2}['b']+i",
+    "len(s)+i",
+    "sprintf('%d-%s',i,s)",
+    "s.len",
+    "'abc' ~ 'a*'",
+    "'abc' !~ 'b*'",
+    "(1+2; 3+4; i)",
+    "to_f(i)/2",
+    "abs(l)*d"
+  };
+
+  for (size_t j = 0; j < sizeof (exprs) / sizeof (exprs[0]); ++j) {
+
+    tl::Expression expr;
+    e.parse (expr, exprs[j]);
+    std::string tree_result = eval_to_string (expr);
+
+    tl::Expression cexpr;
+    e.parse (cexpr, exprs[j]);
+    cexpr.compile ();
+    EXPECT_EQ (cexpr.is_compiled (), true);
+    std::string compiled_result = eval_to_string (cexpr);
+
+    EXPECT_EQ (compiled_result, tree_result);
+
+  }
+
+  //  copies of compiled expressions are compiled too
+  tl::Expression expr;
+  e.parse (expr, "i*d+1");
+  expr.compile ();
+  tl::Expression expr2 = expr;
+  EXPECT_EQ (expr2.is_compiled (), true);
+  EXPECT_EQ (expr2.execute ().to_string (), std::string ("43.5"));
+
+  //  variables are fetched when the expression is executed
+  e.set_var ("d", tl::Variant (0.5));
+  EXPECT_EQ (expr.execute ().to_string (), std::string ("9.5"));
+  EXPECT_EQ (expr2.execute ().to_string (), std::string ("9.5"));
+
+  //  parsing again discards the program
+  e.parse (expr, "i-1");
+  EXPECT_EQ (expr.is_compiled (), false);
+  EXPECT_EQ (expr.execute ().to_string (), std::string ("16"));
+}
+
+// compiled expressions: performance
+TEST(21)
+{
+  tl::Eval e;
+  e.set_var ("layer", tl::Variant (1));
+  e.set_var ("area", tl::Variant (2500l));
+  e.set_var ("width", tl::Variant (1500));
+  e.set_var ("dbu", tl::Variant (0.001));
+
+  tl::Expression expr;
+  e.parse (expr, "layer == 1 && area > 1000 && (width * dbu) < 2.5");
+
+  const size_t n = 1000000;
+  size_t n1 = 0, n2 = 0;
+
+  {
+    tl::SelfTimer timer ("tree walker");
+    for (size_t i = 0; i < n; ++i) {
+      if (expr.execute ().to_bool ()) {
+        ++n1;
+      }
+    }
+  }
+
+  expr.compile ();
+
+  {
+    tl::SelfTimer timer ("compiled");
+    for (size_t i = 0; i < n; ++i) {
+      if (expr.execute ().to_bool ()) {
+        ++n2;
+      }
+    }
+  }
+
+  EXPECT_EQ (n1, n);
+  EXPECT_EQ (n2, n);
+}
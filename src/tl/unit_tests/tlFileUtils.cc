@@ -676,3 +676,34 @@ TEST (17)
   EXPECT_EQ (tl::is_same_file (yfile, tl::combine_path (dpath, "../d/y")), true);
 }
 
+
+//  make_tmp_file
+TEST (18)
+{
+  std::string a = tl::make_tmp_file ("klayout_test");
+  std::string b = tl::make_tmp_file ("klayout_test");
+
+  EXPECT_EQ (a != b, true);
+  EXPECT_EQ (tl::file_exists (a), true);
+  EXPECT_EQ (tl::file_exists (b), true);
+
+  {
+    tl::OutputStream os (a);
+    os << "hello, world!";
+  }
+  {
+    tl::InputStream is (a);
+    EXPECT_EQ (is.read_all (), "hello, world!");
+  }
+
+  EXPECT_EQ (tl::rm_file (a), true);
+  EXPECT_EQ (tl::rm_file (b), true);
+  EXPECT_EQ (tl::file_exists (a), false);
+
+  //  in a given directory
+  std::string p = tl::absolute_path (tmp_file ());
+  std::string c = tl::make_tmp_file ("klayout_test", p);
+  EXPECT_EQ (tl::file_exists (c), true);
+  EXPECT_EQ (tl::is_same_file (tl::dirname (c), p), true);
+  EXPECT_EQ (tl::rm_file (c), true);
+}
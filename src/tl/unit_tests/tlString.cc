@@ -535,3 +535,18 @@ TEST(15)
   EXPECT_EQ (tl::to_upper_case ("nOrMaliI(\xc3\xa4\xc3\x84\xc3\xbc\xc3\x9c\xc3\xb6\xc3\x96\xc3\x9f-42\xc2\xb0+6\xe2\x82\xac)"), "NORMALII(\xc3\x84\xc3\x84\xc3\x9c\xc3\x9c\xc3\x96\xc3\x96\xc3\x9f-42\xc2\xb0+6\xe2\x82\xac)");
   EXPECT_EQ (tl::to_lower_case ("nOrMaliI(\xc3\xa4\xc3\x84\xc3\xbc\xc3\x9c\xc3\xb6\xc3\x96\xc3\x9f-42\xc2\xb0+6\xe2\x82\xac)"), "normalii(\xc3\xa4\xc3\xa4\xc3\xbc\xc3\xbc\xc3\xb6\xc3\xb6\xc3\x9f-42\xc2\xb0+6\xe2\x82\xac)");
 }
+
+TEST(16)
+{
+#if defined(_WIN32)
+  EXPECT_EQ (tl::to_shell_argument (""), "\"\"");
+  EXPECT_EQ (tl::to_shell_argument ("a b"), "\"a b\"");
+  EXPECT_EQ (tl::to_shell_argument ("a\\b\\"), "\"a\\b\\\\\"");
+  EXPECT_EQ (tl::to_shell_argument ("a\"b"), "\"a\\\"b\"");
+#else
+  EXPECT_EQ (tl::to_shell_argument (""), "''");
+  EXPECT_EQ (tl::to_shell_argument ("a b"), "'a b'");
+  EXPECT_EQ (tl::to_shell_argument ("$HOME/\"x\"`y`"), "'$HOME/\"x\"`y`'");
+  EXPECT_EQ (tl::to_shell_argument ("it's"), "'it'\\''s'");
+#endif
+}
@@ -722,6 +722,53 @@ class DBPolygonTests(unittest.TestCase):
     self.assertEqual(str(p1), "(21,42;21,62;41,62;41,42)")
     self.assertEqual(str(pp), "(21,42;21,62;41,62;41,42)")
 
+  def test_coordinates(self):
+
+    import array
+
+    p = pya.Polygon(pya.Box(10, 20, 30, 40))
+    data = p.hull_coordinates()
+    self.assertEqual(type(data), bytes)
+    self.assertEqual(list(array.array("i", data)), [ 10, 20, 10, 40, 30, 40, 30, 20 ])
+    self.assertEqual(len(p.hole_coordinates(0)), 0)
+
+    p = pya.Polygon()
+    p.assign_hull_coordinates(array.array("i", [ 0, 0, 0, 100, 100, 100, 100, 0 ]))
+    self.assertEqual(str(p), "(0,0;0,100;100,100;100,0)")
+
+    p.assign_hull_coordinates(array.array("i", [ 0, 0, 0, 100, 100, 100, 100, 0 ]).tobytes())
+    self.assertEqual(str(p), "(0,0;0,100;100,100;100,0)")
+
+    error = False
+    try:
+      p.assign_hull_coordinates(array.array("i", [ 0, 0, 0 ]))
+    except:
+      error = True
+    self.assertEqual(error, True)
+
+    # buffer objects are accepted for byte arrays only, not for ordinary strings
+    error = False
+    try:
+      pya.Text(array.array("b", [ 65, 66 ]), pya.Trans())
+    except:
+      error = True
+    self.assertEqual(error, True)
+    self.assertEqual(pya.Text(b"AB", pya.Trans()).string, "AB")
+
+    dp = pya.DPolygon(pya.DBox(0.5, 1, 1.5, 2))
+    self.assertEqual(list(array.array("d", dp.hull_coordinates())), [ 0.5, 1, 0.5, 2, 1.5, 2, 1.5, 1 ])
+
+    shapes = pya.Shapes()
+    shapes.insert_box_coordinates(array.array("i", [ 0, 0, 10, 20, -5, -5, 5, 5 ]))
+    shapes.insert(pya.Polygon(pya.Box(0, 0, 1, 1)))
+    self.assertEqual(shapes.size(), 3)
+    self.assertEqual(sorted(array.array("i", shapes.box_coordinates())), sorted([ 0, 0, 10, 20, -5, -5, 5, 5 ]))
+
+    ep = pya.EdgePairs()
+    ep.insert_edge_pair_coordinates(array.array("i", [ 0, 0, 0, 10, 5, 10, 5, 0 ]))
+    self.assertEqual(str(ep), "(0,0;0,10)/(5,10;5,0)")
+    self.assertEqual(list(array.array("i", ep.edge_pair_coordinates())), [ 0, 0, 0, 10, 5, 10, 5, 0 ])
+
 # run unit tests
 if __name__ == '__main__':
   suite = unittest.TestLoader().loadTestsFromTestCase(DBPolygonTests)
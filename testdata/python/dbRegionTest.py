@@ -81,6 +81,103 @@ class DBRegionTest(unittest.TestCase):
     dss = None
     self.assertEqual(pya.DeepShapeStore.instance_count(), 0)
 
+  # Region operations running in parallel threads (GIL released)
+  def test_threads(self):
+
+    import threading
+
+    results = [ None ] * 4
+
+    def work(i):
+      r = pya.Region()
+      for x in range(0, 100):
+        for y in range(0, 100):
+          r.insert(pya.Box(x * 10, y * 10, x * 10 + 15, y * 10 + 15 + i))
+      results[i] = (r.merged().area(), (r - r.sized(-2)).count())
+
+    threads = [ threading.Thread(target = work, args = (i, )) for i in range(0, 4) ]
+    for t in threads:
+      t.start()
+    for t in threads:
+      t.join()
+
+    for i in range(0, 4):
+      self.assertEqual(results[i][0], 1005 * (1005 + i))
+      self.assertEqual(results[i][1], 1)
+
+  # Objects used by a method running without the GIL are locked against other threads
+  def test_threads_shared(self):
+
+    import threading
+
+    r = pya.Region()
+    for x in range(0, 100):
+      for y in range(0, 100):
+        r.insert(pya.Box(x * 10, y * 10, x * 10 + 15, y * 10 + 15))
+
+    errors = []
+
+    def work():
+      try:
+        for i in range(0, 20):
+          r.merged()
+      except Exception as ex:
+        errors.append(str(ex))
+
+    t = threading.Thread(target = work)
+    t.start()
+
+    # the main thread competes for the same region -
+    # these calls wait while "merged" is running
+    other = pya.Region(pya.Box(0, 0, 100, 100))
+    while t.is_alive():
+      r.insert(pya.Box(0, 0, 1, 1))
+      r.count()
+      other & r
+
+    t.join()
+
+    self.assertEqual(errors, [])
+
+    # the region is intact
+    self.assertEqual(r.merged().area(), 1005 * 1005)
+    self.assertEqual((other & r).area(), 100 * 100)
+
+  def test_threads_serialized(self):
+
+    import threading
+    import time
+
+    started = threading.Event()
+    log = []
+
+    class SlowReceiver(pya.TileOutputReceiver):
+      def put(self, ix, iy, tile, obj, dbu, clip):
+        started.set()
+        time.sleep(0.3)
+        log.append("put")
+      def finish(self, success):
+        log.append("finish")
+
+    tp = pya.TilingProcessor()
+    tp.input("in", pya.Region(pya.Box(0, 0, 1000, 1000)))
+    receiver = SlowReceiver()
+    tp.output("out", receiver)
+    tp.dbu = 0.001
+    tp.queue("_output(out, in)")
+
+    # "execute" runs without the GIL, but keeps "tp" locked
+    t = threading.Thread(target = lambda: tp.execute("A job"))
+    t.start()
+
+    self.assertEqual(started.wait(10.0), True)
+
+    # this call has to wait until "execute" has finished
+    self.assertEqual(tp.dbu, 0.001)
+    self.assertEqual(log, [ "put", "finish" ])
+
+    t.join()
+
 # run unit tests
 if __name__ == '__main__':
   suite = unittest.TestLoader().loadTestsFromTestCase(DBRegionTest)
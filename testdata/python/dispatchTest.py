@@ -0,0 +1,71 @@
+# KLayout Layout Viewer
+# Copyright (C) 2006-2019 Matthias Koefferlein
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+
+
+import pya
+import unittest
+import sys
+import time
+
+class DispatchTest(unittest.TestCase):
+
+  # overload resolution must not be confused by the cache
+  def test_1_Overloads(self):
+
+    p = pya.Polygon(pya.Box(0, 0, 100, 100))
+
+    for i in range(0, 3):
+      self.assertEqual(p.touches(pya.Box(100, 0, 200, 100)), True)
+      self.assertEqual(p.touches(pya.Edge(200, 0, 300, 100)), False)
+      self.assertEqual(p.touches(pya.SimplePolygon(pya.Box(50, 50, 150, 150))), True)
+      self.assertEqual(p.touches(pya.Polygon(pya.Box(101, 0, 200, 100))), False)
+      self.assertEqual(str(p.moved(10, 20)), "(10,20;10,120;110,120;110,20)")
+      self.assertEqual(str(p.moved(pya.Vector(10, 20))), "(10,20;10,120;110,120;110,20)")
+      self.assertEqual(str(pya.Box(1, 2, 3, 4) * 2), "(2,4;6,8)")
+      self.assertEqual(str(pya.Box(1, 2, 3, 4) * pya.Box(0, 0, 1, 1)), "(1,2;4,5)")
+      self.assertEqual(str(pya.Box(1, 2, 3, 4) * 2.0), "(2,4;6,8)")
+
+    # derived Python classes are not cached but resolved properly
+    class MyBox(pya.Box):
+      pass
+
+    for i in range(0, 3):
+      self.assertEqual(p.touches(MyBox(100, 0, 200, 100)), True)
+      self.assertEqual(p.touches(pya.Edge(200, 0, 300, 100)), False)
+
+  # a micro-benchmark for method dispatch
+  def test_2_Benchmark(self):
+
+    p = pya.Polygon(pya.Box(0, 0, 100, 100))
+    b = pya.Box(100, 0, 200, 100)
+    e = pya.Edge(200, 0, 300, 100)
+
+    n = 100000
+    start = time.time()
+    for i in range(0, n):
+      p.touches(b)
+      p.touches(e)
+    t = time.time() - start
+
+    sys.stderr.write("Overloaded dispatch: %.3f us per call\n" % (t * 1e6 / (2 * n)))
+
+# run unit tests
+if __name__ == '__main__':
+  suite = unittest.TestLoader().loadTestsFromTestCase(DispatchTest)
+
+  if not unittest.TextTestRunner(verbosity = 1).run(suite).wasSuccessful():
+    sys.exit(1)
@@ -1881,6 +1881,23 @@ END
     assert_equal(rem.to_s, "")
     assert_equal(missed.to_s, "(0,0;0,150;200,150;200,0);(0,350;0,400;200,400;200,350)")
 
+    # multi-threaded fill, fill cells are combined into arrays
+    init.call
+
+    fr = RBA::Region::new
+    fr.insert(RBA::Box::new(0, 0, 300, 400))
+    fr.insert(RBA::Box::new(1000, 0, 1100, 200))
+    fr.insert(RBA::Box::new(2000, 0, 2050, 50))
+
+    missed = RBA::Region::new
+    c0.fill_region(fr, cf.cell_index, b, RBA::Point::new, nil, RBA::Point::new, missed, 2)
+
+    assert_equal(c0.child_instances, 2)
+    flat = RBA::Region::new(c0.begin_shapes_rec(0))
+    assert_equal(flat.size, 7)
+    assert_equal(flat.area, 7 * 20000)
+    assert_equal(missed.to_s, "(2000,0;2000,50;2050,50;2050,0)")
+
   end
 
   def test_17
@@ -905,6 +905,45 @@ class DBRegion_TestClass < TestBase
 
   end
 
+  # deep regions for multiple layers
+  def test_deep2
+
+    ly = RBA::Layout::new
+    top = ly.create_cell("TOP")
+    a = ly.create_cell("A")
+    l1 = ly.layer(1, 0)
+    l2 = ly.layer(2, 0)
+    l3 = ly.layer(3, 0)
+    a.shapes(l1).insert(RBA::Box::new(0, 0, 100, 200))
+    a.shapes(l2).insert(RBA::Box::new(50, 50, 300, 100))
+    top.shapes(l2).insert(RBA::Box::new(-100, -100, 0, 0))
+    top.insert(RBA::CellInstArray::new(a.cell_index, RBA::Trans::new(1000, 0), RBA::Vector::new(0, 1000), RBA::Vector::new(1000, 0), 2, 3))
+
+    dss = RBA::DeepShapeStore::new
+    regions = dss.create_regions(top.begin_shapes_rec(l1), [ l1, l2, l3 ])
+    assert_equal(regions.size, 3)
+    regions.each { |r| assert_equal(r.is_deep?, true) }
+
+    assert_equal(regions[0].area, 6 * 100 * 200)
+    assert_equal(regions[1].area, 6 * 250 * 50 + 100 * 100)
+    assert_equal(regions[2].is_empty?, true)
+
+    # the same than the regions created individually
+    [ l1, l2, l3 ].each_with_index do |l,i|
+      ref = RBA::Region::new(top.begin_shapes_rec(l), dss)
+      assert_equal((regions[i] ^ ref).is_empty?, true)
+    end
+
+    # with a transformation
+    regions = dss.create_regions(top.begin_shapes_rec(l1), [ l2 ], RBA::ICplxTrans::new(2.0))
+    assert_equal(regions.size, 1)
+    assert_equal(regions[0].area, 4 * (6 * 250 * 50 + 100 * 100))
+
+    regions = nil
+    dss._destroy
+
+  end
+
 end
 
 load("test_epilogue.rb")